@@ -11,6 +11,7 @@ HEADERS += \
     $$PWD/qquicklineextruder_p.h \
     $$PWD/qquickmaskextruder_p.h \
     $$PWD/qquickparticleaffector_p.h \
+    $$PWD/qquickparticlebatch_p.h \
     $$PWD/qquickparticleemitter_p.h \
     $$PWD/qquickparticleextruder_p.h \
     $$PWD/qquickparticlepainter_p.h \
@@ -43,6 +44,7 @@ SOURCES += \
     $$PWD/qquicklineextruder.cpp \
     $$PWD/qquickmaskextruder.cpp \
     $$PWD/qquickparticleaffector.cpp \
+    $$PWD/qquickparticlebatch.cpp \
     $$PWD/qquickparticleemitter.cpp \
     $$PWD/qquickparticleextruder.cpp \
     $$PWD/qquickparticlepainter.cpp \
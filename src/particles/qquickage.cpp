@@ -82,6 +82,7 @@ QT_BEGIN_NAMESPACE
 QQuickAgeAffector::QQuickAgeAffector(QQuickItem *parent) :
     QQuickParticleAffector(parent), m_lifeLeft(0), m_advancePosition(true)
 {
+    m_threadSafeBatch = true;
 }
 
 
@@ -112,6 +113,33 @@ bool QQuickAgeAffector::affectParticle(QQuickParticleData *d, qreal dt)
     }
     return false;
 }
+
+void QQuickAgeAffector::affectBatch(QQuickParticleData *const *particles, int count, qreal dt, bool *affected)
+{
+    Q_UNUSED(dt);
+    const float curT = m_system->timeInt / 1000.0f;
+    const float ttl = m_lifeLeft / 1000.0f;
+    const bool keepPosition = !m_advancePosition && ttl > 0;
+    for (int i = 0; i < count; ++i) {
+        QQuickParticleData *d = particles[i];
+        if (!d->stillAlive(m_system))
+            continue;
+        const float age = d->lifeSpan - ttl;
+        if (keepPosition) {
+            //Does what the setInstantaneous calls in affectParticle do, in one go
+            const float oldAge = curT - d->t;
+            const float x = d->x + d->vx * oldAge + 0.5f * d->ax * oldAge * oldAge;
+            const float y = d->y + d->vy * oldAge + 0.5f * d->ay * oldAge * oldAge;
+            d->vx = d->vx + d->ax * (oldAge - age);
+            d->vy = d->vy + d->ay * (oldAge - age);
+            d->x = x - d->vx * age - 0.5f * d->ax * age * age;
+            d->y = y - d->vy * age - 0.5f * d->ay * age * age;
+        }
+        d->t = curT - age;
+        affected[i] = true;
+    }
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qquickage_p.cpp"
@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qquickcustomaffector_p.h"
+#include "qquickparticlebatch_p.h"
 #include <private/qv8engine_p.h>
 #include <private/qqmlengine_p.h>
 #include <private/qqmlglobal_p.h>
@@ -59,6 +60,24 @@ QT_BEGIN_NAMESPACE
     high-volume particle systems.
 
     The corresponding handler is \c onAffectParticles.
+
+    \sa affectParticleBatch
+*/
+
+/*!
+    \qmlsignal QtQuick.Particles::Affector::affectParticleBatch(ParticleBatch batch, real dt)
+
+    This signal is emitted when particles are selected to be affected, like
+    affectParticles. batch holds the attributes of all the selected particles
+    in typed arrays, and values written to them are applied to the particles
+    when the handler returns. Particles whose values were changed are treated as
+    affected.
+
+    This requires one call into JavaScript per simulation step rather than an
+    access to a Particle object per attribute and particle, which makes it the
+    preferred way to affect many particles from JavaScript.
+
+    The corresponding handler is \c onAffectParticleBatch.
 */
 
 /*!
@@ -106,6 +125,11 @@ bool QQuickCustomAffector::isAffectConnected()
     IS_SIGNAL_CONNECTED(this, QQuickCustomAffector, affectParticles, (QQmlV4Handle,qreal));
 }
 
+bool QQuickCustomAffector::isAffectBatchConnected()
+{
+    IS_SIGNAL_CONNECTED(this, QQuickCustomAffector, affectParticleBatch, (QQmlV4Handle,qreal));
+}
+
 void QQuickCustomAffector::affectSystem(qreal dt)
 {
     //Acts a bit differently, just emits affected for everyone it might affect, when the only thing is connecting to affected(x,y)
@@ -113,7 +137,9 @@ void QQuickCustomAffector::affectSystem(qreal dt)
         && m_velocity == &m_nullVector
         && m_position == &m_nullVector
         && isAffectedConnected());
-    if (!isAffectConnected() && !justAffected) {
+    const bool affectConnected = isAffectConnected();
+    const bool batchConnected = isAffectBatchConnected();
+    if (!affectConnected && !batchConnected && !justAffected) {
         QQuickParticleAffector::affectSystem(dt);
         return;
     }
@@ -151,28 +177,43 @@ void QQuickCustomAffector::affectSystem(qreal dt)
     QV4::ExecutionEngine *v4 = QV8Engine::getV4(qmlEngine->handle());
 
     QV4::Scope scope(v4);
-    QV4::ScopedArrayObject array(scope, v4->newArrayObject(toAffect.size()));
-    QV4::ScopedValue v(scope);
-    for (int i=0; i<toAffect.size(); i++)
-        array->putIndexed(i, (v = toAffect[i]->v4Value(m_system)));
+    QV4::ScopedArrayObject array(scope);
+    if (affectConnected) {
+        array = v4->newArrayObject(toAffect.size());
+        QV4::ScopedValue v(scope);
+        for (int i=0; i<toAffect.size(); i++)
+            array->putIndexed(i, (v = toAffect[i]->v4Value(m_system)));
+    }
+
+    QScopedPointer<QQuickParticleBatch> batch;
+    if (batchConnected)
+        batch.reset(new QQuickParticleBatch(v4, m_system, toAffect));
+
+    auto affectStep = [&](qreal stepDt) {
+        affectProperties(toAffect, stepDt);
+        if (affectConnected)
+            emit affectParticles(QQmlV4Handle(array), stepDt);
+        if (batchConnected) {
+            batch->load();
+            emit affectParticleBatch(batch->v4Value(), stepDt);
+            foreach (QQuickParticleData* d, batch->store())
+                d->update = 1.0;
+        }
+    };
 
     if (dt >= simulationCutoff || dt <= simulationDelta) {
-        affectProperties(toAffect, dt);
-        emit affectParticles(QQmlV4Handle(array), dt);
+        affectStep(dt);
     } else {
         int realTime = m_system->timeInt;
         m_system->timeInt -= dt * 1000.0;
         while (dt > simulationDelta) {
             m_system->timeInt += simulationDelta * 1000.0;
             dt -= simulationDelta;
-            affectProperties(toAffect, simulationDelta);
-            emit affectParticles(QQmlV4Handle(array), simulationDelta);
+            affectStep(simulationDelta);
         }
         m_system->timeInt = realTime;
-        if (dt > 0.0) {
-            affectProperties(toAffect, dt);
-            emit affectParticles(QQmlV4Handle(array), dt);
-        }
+        if (dt > 0.0)
+            affectStep(dt);
     }
 
     foreach (QQuickParticleData* d, toAffect)
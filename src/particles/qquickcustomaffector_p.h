@@ -109,6 +109,7 @@ public:
 
 Q_SIGNALS:
     void affectParticles(QQmlV4Handle particles, qreal dt);
+    void affectParticleBatch(QQmlV4Handle batch, qreal dt);
 
     void positionChanged(QQuickDirection * arg);
 
@@ -153,6 +154,7 @@ public Q_SLOTS:
 
 protected:
     bool isAffectConnected();
+    bool isAffectBatchConnected();
     bool affectParticle(QQuickParticleData *d, qreal dt) override;
 
 private:
@@ -71,45 +71,62 @@ static qreal sign(qreal a)
 
 static const qreal epsilon = 0.00001;
 
-QQuickFrictionAffector::QQuickFrictionAffector(QQuickItem *parent) :
-    QQuickParticleAffector(parent), m_factor(0.0), m_threshold(0.0)
-{
-}
-
-bool QQuickFrictionAffector::affectParticle(QQuickParticleData *d, qreal dt)
+static inline bool applyFriction(QQuickParticleData *d, qreal dt, qreal factor, qreal threshold,
+                                 QQuickParticleSystem *system)
 {
-    if (!m_factor)
-        return false;
-    qreal curVX = d->curVX(m_system);
-    qreal curVY = d->curVY(m_system);
+    qreal curVX = d->curVX(system);
+    qreal curVY = d->curVY(system);
     if (!curVX && !curVY)
         return false;
-    qreal newVX = curVX + (curVX * m_factor * -1 * dt);
-    qreal newVY = curVY + (curVY * m_factor * -1 * dt);
+    qreal newVX = curVX + (curVX * factor * -1 * dt);
+    qreal newVY = curVY + (curVY * factor * -1 * dt);
 
-    if (!m_threshold) {
+    if (!threshold) {
         if (sign(curVX) != sign(newVX))
             newVX = 0;
         if (sign(curVY) != sign(newVY))
             newVY = 0;
     } else {
         qreal curMag = qSqrt(curVX*curVX + curVY*curVY);
-        if (curMag <= m_threshold + epsilon)
+        if (curMag <= threshold + epsilon)
             return false;
         qreal newMag = qSqrt(newVX*newVX + newVY*newVY);
-        if (newMag <= m_threshold + epsilon || //went past the threshold, stop there instead
+        if (newMag <= threshold + epsilon || //went past the threshold, stop there instead
             sign(curVX) != sign(newVX) || //went so far past maybe it came out the other side!
             sign(curVY) != sign(newVY)) {
-            qreal theta = qAtan2(curVY, curVX);
-            newVX = m_threshold * qCos(theta);
-            newVY = m_threshold * qSin(theta);
+            //Same direction as the current velocity, without the round trip through the angle
+            newVX = threshold * curVX / curMag;
+            newVY = threshold * curVY / curMag;
         }
     }
 
-    d->setInstantaneousVX(newVX, m_system);
-    d->setInstantaneousVY(newVY, m_system);
+    d->setInstantaneousVX(newVX, system);
+    d->setInstantaneousVY(newVY, system);
     return true;
 }
+
+QQuickFrictionAffector::QQuickFrictionAffector(QQuickItem *parent) :
+    QQuickParticleAffector(parent), m_factor(0.0), m_threshold(0.0)
+{
+    m_threadSafeBatch = true;
+}
+
+bool QQuickFrictionAffector::affectParticle(QQuickParticleData *d, qreal dt)
+{
+    if (!m_factor)
+        return false;
+    return applyFriction(d, dt, m_factor, m_threshold, m_system);
+}
+
+void QQuickFrictionAffector::affectBatch(QQuickParticleData *const *particles, int count, qreal dt, bool *affected)
+{
+    if (!m_factor)
+        return;
+    for (int i = 0; i < count; ++i) {
+        if (applyFriction(particles[i], dt, m_factor, m_threshold, m_system))
+            affected[i] = true;
+    }
+}
 QT_END_NAMESPACE
 
 #include "moc_qquickfriction_p.cpp"
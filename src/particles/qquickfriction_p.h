@@ -74,6 +74,7 @@ public:
 
 protected:
     bool affectParticle(QQuickParticleData *d, qreal dt) override;
+    void affectBatch(QQuickParticleData *const *particles, int count, qreal dt, bool *affected) override;
 
 Q_SIGNALS:
 
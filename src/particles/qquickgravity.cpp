@@ -114,23 +114,57 @@ qreal QQuickGravityAffector::angle() const
 QQuickGravityAffector::QQuickGravityAffector(QQuickItem *parent) :
     QQuickParticleAffector(parent), m_magnitude(-10), m_angle(90), m_needRecalc(true)
 {
+    m_threadSafeBatch = true;
 }
 
-bool QQuickGravityAffector::affectParticle(QQuickParticleData *d, qreal dt)
+void QQuickGravityAffector::recalculate()
 {
-    if (!m_magnitude)
-        return false;
     if (m_needRecalc) {
         m_needRecalc = false;
         m_dx = m_magnitude * std::cos(m_angle * CONV);
         m_dy = m_magnitude * std::sin(m_angle * CONV);
     }
+}
+
+bool QQuickGravityAffector::affectParticle(QQuickParticleData *d, qreal dt)
+{
+    if (!m_magnitude)
+        return false;
+    recalculate();
 
     d->setInstantaneousVX(d->curVX(m_system) + m_dx*dt, m_system);
     d->setInstantaneousVY(d->curVY(m_system) + m_dy*dt, m_system);
     return true;
 }
 
+void QQuickGravityAffector::affectSystem(qreal dt)
+{
+    //Before the batches, which may run on several threads
+    recalculate();
+    QQuickParticleAffector::affectSystem(dt);
+}
+
+void QQuickGravityAffector::affectBatch(QQuickParticleData *const *particles, int count, qreal dt, bool *affected)
+{
+    if (!m_magnitude)
+        return;
+
+    //Changing the velocity by dv while keeping the current position, like setInstantaneousVX
+    //and setInstantaneousVY, moves the starting position back by dv for every second lived
+    const float time = m_system->timeInt / 1000.0f;
+    const float dvx = m_dx * dt;
+    const float dvy = m_dy * dt;
+    for (int i = 0; i < count; ++i) {
+        QQuickParticleData *d = particles[i];
+        const float t = time - d->t;
+        d->vx += dvx;
+        d->x -= dvx * t;
+        d->vy += dvy;
+        d->y -= dvy * t;
+        affected[i] = true;
+    }
+}
+
 
 
 QT_END_NAMESPACE
@@ -64,9 +64,11 @@ public:
     explicit QQuickGravityAffector(QQuickItem *parent = 0);
     qreal magnitude() const;
     qreal angle() const;
+    void affectSystem(qreal dt) override;
 
 protected:
     bool affectParticle(QQuickParticleData *d, qreal dt) override;
+    void affectBatch(QQuickParticleData *const *particles, int count, qreal dt, bool *affected) override;
 
 Q_SIGNALS:
     void magnitudeChanged(qreal arg);
@@ -78,6 +80,8 @@ public Q_SLOTS:
     void setAngle(qreal arg);
 
 private:
+    void recalculate();
+
     qreal m_magnitude;
     qreal m_angle;
 
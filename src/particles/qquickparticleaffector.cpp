@@ -39,9 +39,82 @@
 
 #include "qquickparticleaffector_p.h"
 #include <QDebug>
+#include <QThreadPool>
+#include <QVarLengthArray>
 #include <private/qqmlglobal_p.h>
+#include <private/qqmlpooledjob_p.h>
 QT_BEGIN_NAMESPACE
 
+//Large batches are split across this many extra threads, if the affector allows it.
+//-1 until it has been read from the environment
+static QBasicAtomicInt particleThreads = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+static int particleThreadCount()
+{
+    int count = particleThreads.loadAcquire();
+    if (count < 0) {
+        count = qMax(0, qEnvironmentVariableIntValue("QT_QUICK_PARTICLE_THREADS"));
+        if (!particleThreads.testAndSetRelease(-1, count))
+            count = particleThreads.loadAcquire();
+    }
+    return count;
+}
+
+//Smaller parts are not worth handing to another thread
+static const int minimumParticlesPerThread = 512;
+
+class QQuickParticleThreadPool : public QThreadPool
+{
+public:
+    QQuickParticleThreadPool()
+    {
+        setMaxThreadCount(particleThreadCount());
+    }
+};
+
+Q_GLOBAL_STATIC(QQuickParticleThreadPool, particleThreadPool)
+
+//For autotests, to compare threaded and single threaded results in one process
+Q_QUICKPARTICLES_PRIVATE_EXPORT void qt_quick_particles_set_thread_count(int count)
+{
+    particleThreads.storeRelease(qMax(0, count));
+    if (particleThreadPool.exists())
+        particleThreadPool()->setMaxThreadCount(qMax(1, count));
+}
+
+//0 makes affectSystem() call affectParticle() per particle instead of the affectBatch() overrides
+static QBasicAtomicInt particleBatching = Q_BASIC_ATOMIC_INITIALIZER(1);
+
+//For autotests, to compare the batch implementations with affectParticle() in one process
+Q_QUICKPARTICLES_PRIVATE_EXPORT void qt_quick_particles_set_batching(bool enabled)
+{
+    particleBatching.storeRelease(enabled ? 1 : 0);
+}
+
+class QQuickParticleBatchJob : public QQmlPooledJob
+{
+public:
+    QQuickParticleBatchJob(QQuickParticleAffector *affector, QQuickParticleData *const *particles,
+                           int count, qreal dt, bool *affected)
+        : m_affector(affector), m_particles(particles), m_count(count), m_dt(dt)
+        , m_affected(affected)
+    {
+    }
+
+protected:
+    void execute() override
+    {
+        m_affector->affectBatch(m_particles, m_count, m_dt, m_affected);
+    }
+
+private:
+    QQuickParticleAffector *m_affector;
+    QQuickParticleData *const *m_particles;
+    int m_count;
+    qreal m_dt;
+    bool *m_affected;
+};
+
 /*!
     \qmltype Affector
     \instantiates QQuickParticleAffector
@@ -131,6 +204,7 @@ QT_BEGIN_NAMESPACE
 */
 QQuickParticleAffector::QQuickParticleAffector(QQuickItem *parent) :
     QQuickItem(parent), m_needsReset(false), m_ignoresTime(false), m_onceOff(false), m_enabled(true)
+    , m_threadSafeBatch(false)
     , m_system(0), m_updateIntSet(false), m_shape(new QQuickParticleExtruder(this))
 {
 }
@@ -158,6 +232,37 @@ bool QQuickParticleAffector::activeGroup(int g) {
     return m_groupIds.isEmpty() || m_groupIds.contains(g);
 }
 
+void QQuickParticleAffector::affectBatchConcurrently(QQuickParticleData *const *particles, int count, qreal dt, bool *affected)
+{
+    if (!particleBatching.loadAcquire()) {
+        QQuickParticleAffector::affectBatch(particles, count, dt, affected);
+        return;
+    }
+
+    const int parts = m_threadSafeBatch ? qMin(particleThreadCount() + 1, count / minimumParticlesPerThread) : 1;
+    if (parts < 2) {
+        affectBatch(particles, count, dt, affected);
+        return;
+    }
+
+    //The other parts run on the pool while this thread does the first one. Only the
+    //particles themselves are written, and signals are emitted afterwards from postAffect
+    const int partSize = (count + parts - 1) / parts;
+    QVarLengthArray<QQuickParticleBatchJob *, 16> jobs;
+    for (int begin = partSize; begin < count; begin += partSize) {
+        QQuickParticleBatchJob *job = new QQuickParticleBatchJob(this, particles + begin, qMin(partSize, count - begin),
+                                                                 dt, affected + begin);
+        job->start(particleThreadPool());
+        jobs.append(job);
+    }
+    affectBatch(particles, partSize, dt, affected);
+    //Parts no thread has picked up yet are done here
+    for (QQuickParticleBatchJob *job : qAsConst(jobs)) {
+        job->waitForFinished();
+        delete job;
+    }
+}
+
 bool QQuickParticleAffector::shouldAffect(QQuickParticleData* d)
 {
     if (!d)
@@ -200,28 +305,52 @@ void QQuickParticleAffector::affectSystem(qreal dt)
     if (m_onceOff)
         dt = 1.0;
     foreach (QQuickParticleGroupData* gd, m_system->groupData) {
-        if (activeGroup(gd->index)) {
-            foreach (QQuickParticleData* d, gd->data) {
-                if (shouldAffect(d)) {
-                    bool affected = false;
-                    qreal myDt = dt;
-                    if (!m_ignoresTime && myDt < simulationCutoff) {
-                        int realTime = m_system->timeInt;
-                        m_system->timeInt -= myDt * 1000.0;
-                        while (myDt > simulationDelta) {
-                            m_system->timeInt += simulationDelta * 1000.0;
-                            if (d->alive(m_system))//Only affect during the parts it was alive for
-                                affected = affectParticle(d, simulationDelta) || affected;
-                            myDt -= simulationDelta;
-                        }
-                        m_system->timeInt = realTime;
+        if (!activeGroup(gd->index))
+            continue;
+
+        //Particles are independent of each other, so each simulation step can be applied to all of them at once
+        m_batch.clear();
+        for (QQuickParticleData *d : qAsConst(gd->data)) {
+            if (shouldAffect(d))
+                m_batch.append(d);
+        }
+        const int count = m_batch.size();
+        if (!count)
+            continue;
+        m_batchAffected.fill(false, count);
+
+        qreal myDt = dt;
+        if (!m_ignoresTime && myDt < simulationCutoff) {
+            int realTime = m_system->timeInt;
+            m_system->timeInt -= myDt * 1000.0;
+            while (myDt > simulationDelta) {
+                m_system->timeInt += simulationDelta * 1000.0;
+                m_alive.clear();
+                m_aliveIndexes.clear();
+                for (int i = 0; i < count; ++i) {
+                    if (m_batch.at(i)->alive(m_system)) {//Only affect during the parts it was alive for
+                        m_alive.append(m_batch.at(i));
+                        m_aliveIndexes.append(i);
+                    }
+                }
+                if (!m_alive.isEmpty()) {
+                    m_aliveAffected.fill(false, m_alive.size());
+                    affectBatchConcurrently(m_alive.constData(), m_alive.size(), simulationDelta, m_aliveAffected.data());
+                    for (int i = 0; i < m_alive.size(); ++i) {
+                        if (m_aliveAffected.at(i))
+                            m_batchAffected[m_aliveIndexes.at(i)] = true;
                     }
-                    if (myDt > 0.0)
-                        affected = affectParticle(d, myDt) || affected;
-                    if (affected)
-                        postAffect(d);
                 }
+                myDt -= simulationDelta;
             }
+            m_system->timeInt = realTime;
+        }
+        if (myDt > 0.0)
+            affectBatchConcurrently(m_batch.constData(), count, myDt, m_batchAffected.data());
+
+        for (int i = 0; i < count; ++i) {
+            if (m_batchAffected.at(i))
+                postAffect(m_batch.at(i));
         }
     }
 }
@@ -231,6 +360,19 @@ bool QQuickParticleAffector::affectParticle(QQuickParticleData *, qreal )
     return true;
 }
 
+/*
+    The default implementation calls affectParticle() for each particle. Affectors
+    which apply the same alteration to many particles reimplement it to avoid the
+    virtual call and to work out what is common to all particles only once.
+*/
+void QQuickParticleAffector::affectBatch(QQuickParticleData *const *particles, int count, qreal dt, bool *affected)
+{
+    for (int i = 0; i < count; ++i) {
+        if (affectParticle(particles[i], dt))
+            affected[i] = true;
+    }
+}
+
 void QQuickParticleAffector::reset(QQuickParticleData* pd)
 {//TODO: This, among other ones, should be restructured so they don't all need to remember to call the superclass
     if (m_onceOff)
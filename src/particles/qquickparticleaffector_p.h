@@ -174,11 +174,15 @@ public Q_SLOTS:
 
 protected:
     friend class QQuickParticleSystem;
+    friend class QQuickParticleBatchJob;
     virtual bool affectParticle(QQuickParticleData *d, qreal dt);
+    //Affects count particles at once, and sets affected[i] for each one that was altered
+    virtual void affectBatch(QQuickParticleData *const *particles, int count, qreal dt, bool *affected);
     bool m_needsReset:1;//### What is this really saving?
     bool m_ignoresTime:1;
     bool m_onceOff:1;
     bool m_enabled:1;
+    bool m_threadSafeBatch:1;//affectBatch only touches the particles passed, so it can run on disjoint ranges at once
 
     QQuickParticleSystem* m_system;
     QStringList m_groups;
@@ -193,9 +197,18 @@ protected:
     QPointF m_offset;
     QSet<QPair<int, int> > m_onceOffed;
 private:
+    void affectBatchConcurrently(QQuickParticleData *const *particles, int count, qreal dt, bool *affected);
+
     QSet<int> m_groupIds;
     bool m_updateIntSet;
 
+    //Reused between frames, see affectSystem
+    QVector<QQuickParticleData*> m_batch;
+    QVector<bool> m_batchAffected;
+    QVector<QQuickParticleData*> m_alive;
+    QVector<int> m_aliveIndexes;
+    QVector<bool> m_aliveAffected;
+
     QQuickParticleExtruder* m_shape;
 
     QStringList m_whenCollidingWith;
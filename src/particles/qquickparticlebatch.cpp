@@ -0,0 +1,233 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qquickparticlebatch_p.h"
+#include "qquickparticlesystem_p.h"
+#include <private/qv4engine_p.h>
+#include <private/qv4arraybuffer_p.h>
+#include <private/qv4typedarray_p.h>
+#include <private/qv4scopedvalue_p.h>
+#include <QtCore/qnumeric.h>
+#include <math.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \qmltype ParticleBatch
+    \inqmlmodule QtQuick.Particles
+    \brief Represents many particles at once, as arrays of their attributes
+    \ingroup qtquick-particles
+
+    A ParticleBatch is passed to the Affector::affectParticleBatch and
+    Emitter::emitParticleBatch handlers instead of an array of Particle objects.
+    Each attribute is a Float32Array holding one value per particle, so that a
+    handler can process a large number of particles in a single loop:
+
+    \code
+    Affector {
+        onAffectParticleBatch: {
+            for (var i = 0; i < batch.count; i++)
+                batch.vy[i] += 10 * dt;
+        }
+    }
+    \endcode
+
+    Values written to the arrays are applied to the particles when the handler
+    returns. The attributes have the same meaning as the corresponding properties
+    of Particle: x, y, vx, vy, ax, ay, initialX, initialY, initialVX, initialVY,
+    initialAX, initialAY, t, lifeSpan, startSize, endSize, rotation,
+    rotationVelocity, red, green, blue and alpha.
+
+    The arrays are only valid while the handler runs.
+*/
+
+/*!
+    \qmlproperty int QtQuick.Particles::ParticleBatch::count
+    The number of particles in the batch, which is the length of each of the arrays.
+*/
+
+namespace {
+
+enum Field {
+    //Written back first, as they change the basis of the current values
+    InitialX, InitialY, InitialVX, InitialVY, InitialAX, InitialAY,
+    T, LifeSpan, StartSize, EndSize, Rotation, RotationVelocity,
+    Red, Green, Blue, Alpha,
+    //Written back in the order used by Affector, so that setting several of them is consistent
+    AX, AY, VX, VY, X, Y,
+    NFields
+};
+
+const char *const fieldNames[NFields] = {
+    "initialX", "initialY", "initialVX", "initialVY", "initialAX", "initialAY",
+    "t", "lifeSpan", "startSize", "endSize", "rotation", "rotationVelocity",
+    "red", "green", "blue", "alpha",
+    "ax", "ay", "vx", "vy", "x", "y"
+};
+
+inline uchar toColorComponent(float value)
+{
+    return qMin(255, qMax(0, (int)::floor(value * 255.0)));
+}
+
+}
+
+QQuickParticleBatch::QQuickParticleBatch(QV4::ExecutionEngine *v4, QQuickParticleSystem *system,
+                                         const QList<QQuickParticleData*> &particles)
+    : m_system(system)
+    , m_particles(particles)
+    , m_loaded(NFields * particles.size())
+{
+    const uint count = particles.size();
+    QV4::Scope scope(v4);
+    QV4::Scoped<QV4::ArrayBuffer> buffer(scope, v4->newArrayBuffer(m_loaded.size() * sizeof(float)));
+    QV4::ScopedObject o(scope, v4->newObject());
+    QV4::Scoped<QV4::TypedArray> array(scope);
+    for (int f = 0; f < NFields; f++) {
+        array = QV4::TypedArray::create(v4, QV4::Heap::TypedArray::Float32Array);
+        array->d()->buffer.set(v4, buffer->d());
+        array->d()->byteLength = count * sizeof(float);
+        array->d()->byteOffset = f * count * sizeof(float);
+        o->defineReadonlyProperty(QLatin1String(fieldNames[f]), array);
+    }
+    o->defineReadonlyProperty(QStringLiteral("count"), QV4::Primitive::fromUInt32(count));
+
+    m_buffer.set(v4, buffer->d());
+    m_v4Value.set(v4, o->d());
+}
+
+QQmlV4Handle QQuickParticleBatch::v4Value() const
+{
+    return QQmlV4Handle(m_v4Value.value());
+}
+
+float *QQuickParticleBatch::fields() const
+{
+    //The handler may have transferred the buffer away, e.g. to a WorkerScript
+    QV4::ArrayBuffer *buffer = m_buffer.as<QV4::ArrayBuffer>();
+    if (!buffer || buffer->isNeutered() || buffer->byteLength() < m_loaded.size() * sizeof(float))
+        return 0;
+    return reinterpret_cast<float *>(buffer->d()->data->data());
+}
+
+void QQuickParticleBatch::load()
+{
+    const int count = m_particles.size();
+    float *loaded = m_loaded.data();
+    for (int i = 0; i < count; i++) {
+        const QQuickParticleData *d = m_particles.at(i);
+        loaded[InitialX * count + i] = d->x;
+        loaded[InitialY * count + i] = d->y;
+        loaded[InitialVX * count + i] = d->vx;
+        loaded[InitialVY * count + i] = d->vy;
+        loaded[InitialAX * count + i] = d->ax;
+        loaded[InitialAY * count + i] = d->ay;
+        loaded[T * count + i] = d->t;
+        loaded[LifeSpan * count + i] = d->lifeSpan;
+        loaded[StartSize * count + i] = d->size;
+        loaded[EndSize * count + i] = d->endSize;
+        loaded[Rotation * count + i] = d->rotation;
+        loaded[RotationVelocity * count + i] = d->rotationVelocity;
+        loaded[Red * count + i] = d->color.r / 255.0f;
+        loaded[Green * count + i] = d->color.g / 255.0f;
+        loaded[Blue * count + i] = d->color.b / 255.0f;
+        loaded[Alpha * count + i] = d->color.a / 255.0f;
+        loaded[AX * count + i] = d->curAX();
+        loaded[AY * count + i] = d->curAY();
+        loaded[VX * count + i] = d->curVX(m_system);
+        loaded[VY * count + i] = d->curVY(m_system);
+        loaded[X * count + i] = d->curX(m_system);
+        loaded[Y * count + i] = d->curY(m_system);
+    }
+
+    if (float *values = fields())
+        memcpy(values, loaded, m_loaded.size() * sizeof(float));
+}
+
+QList<QQuickParticleData*> QQuickParticleBatch::store()
+{
+    QList<QQuickParticleData*> changed;
+    const float *values = fields();
+    if (!values)
+        return changed;
+
+    const int count = m_particles.size();
+    const float *loaded = m_loaded.constData();
+    for (int i = 0; i < count; i++) {
+        QQuickParticleData *d = m_particles.at(i);
+        bool particleChanged = false;
+        for (int f = 0; f < NFields; f++) {
+            const int index = f * count + i;
+            const float value = values[index];
+            if (value == loaded[index] || (qIsNaN(value) && qIsNaN(loaded[index])))
+                continue;
+            particleChanged = true;
+            switch (f) {
+            case InitialX: d->x = value; break;
+            case InitialY: d->y = value; break;
+            case InitialVX: d->vx = value; break;
+            case InitialVY: d->vy = value; break;
+            case InitialAX: d->ax = value; break;
+            case InitialAY: d->ay = value; break;
+            case T: d->t = value; break;
+            case LifeSpan: d->lifeSpan = value; break;
+            case StartSize: d->size = value; break;
+            case EndSize: d->endSize = value; break;
+            case Rotation: d->rotation = value; break;
+            case RotationVelocity: d->rotationVelocity = value; break;
+            case Red: d->color.r = toColorComponent(value); break;
+            case Green: d->color.g = toColorComponent(value); break;
+            case Blue: d->color.b = toColorComponent(value); break;
+            case Alpha: d->color.a = toColorComponent(value); break;
+            case AX: d->setInstantaneousAX(value, m_system); break;
+            case AY: d->setInstantaneousAY(value, m_system); break;
+            case VX: d->setInstantaneousVX(value, m_system); break;
+            case VY: d->setInstantaneousVY(value, m_system); break;
+            case X: d->setInstantaneousX(value, m_system); break;
+            case Y: d->setInstantaneousY(value, m_system); break;
+            }
+        }
+        if (particleChanged)
+            changed << d;
+    }
+    return changed;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,93 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QQUICKPARTICLEBATCH_P_H
+#define QQUICKPARTICLEBATCH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QList>
+#include <QVector>
+#include <private/qv8engine_p.h>
+#include <private/qv4persistent_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQuickParticleData;
+class QQuickParticleSystem;
+
+//Exposes the fields of many particles to JavaScript as one object of Float32Arrays,
+//so that a handler can process them all without going through a Particle object each
+class QQuickParticleBatch
+{
+public:
+    QQuickParticleBatch(QV4::ExecutionEngine *engine, QQuickParticleSystem *system,
+                        const QList<QQuickParticleData*> &particles);
+
+    QQmlV4Handle v4Value() const;
+
+    //Copies the current state of the particles into the arrays
+    void load();
+    //Writes the values changed from JavaScript since load() back to the particles.
+    //Returns the particles that were changed.
+    QList<QQuickParticleData*> store();
+
+private:
+    float *fields() const;
+
+    QQuickParticleSystem *m_system;
+    QList<QQuickParticleData*> m_particles;
+    QVector<float> m_loaded;
+    QV4::PersistentValue m_buffer;
+    QV4::PersistentValue m_v4Value;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQUICKPARTICLEBATCH_P_H
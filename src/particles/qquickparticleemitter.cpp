@@ -40,6 +40,7 @@
 #include "qquickparticleemitter_p.h"
 #include <private/qqmlengine_p.h>
 #include <private/qqmlglobal_p.h>
+#include "qquickparticlebatch_p.h"
 #include <QRandomGenerator>
 QT_BEGIN_NAMESPACE
 
@@ -197,6 +198,21 @@ QT_BEGIN_NAMESPACE
     high-volume particle systems.
 
     The corresponding handler is \c onEmitParticles.
+
+    \sa emitParticleBatch
+*/
+
+/*!
+    \qmlsignal QtQuick.Particles::Emitter::emitParticleBatch(ParticleBatch batch)
+
+    This signal is emitted when particles are emitted, like emitParticles. batch
+    holds the attributes of all the emitted particles in typed arrays, and values
+    written to them are applied to the particles when the handler returns.
+
+    This requires a single call into JavaScript however many particles are
+    emitted, which makes it the preferred way to customize many particles.
+
+    The corresponding handler is \c onEmitParticleBatch.
 */
 
 /*! \qmlmethod QtQuick.Particles::Emitter::burst(int count)
@@ -260,6 +276,11 @@ bool QQuickParticleEmitter::isEmitConnected()
     IS_SIGNAL_CONNECTED(this, QQuickParticleEmitter, emitParticles, (QQmlV4Handle));
 }
 
+bool QQuickParticleEmitter::isEmitBatchConnected()
+{
+    IS_SIGNAL_CONNECTED(this, QQuickParticleEmitter, emitParticleBatch, (QQmlV4Handle));
+}
+
 void QQuickParticleEmitter::reclaculateGroupId() const
 {
     if (!m_system) {
@@ -499,6 +520,14 @@ void QQuickParticleEmitter::emitWindow(int timeStamp)
         emitParticles(QQmlV4Handle(array));//A chance for arbitrary JS changes
     }
 
+    if (!toEmit.isEmpty() && isEmitBatchConnected()) {
+        QQmlEngine *qmlEngine = ::qmlEngine(this);
+        QQuickParticleBatch batch(QV8Engine::getV4(qmlEngine->handle()), m_system, toEmit);
+        batch.load();
+        emitParticleBatch(batch.v4Value());
+        batch.store();
+    }
+
     m_last_emission = pt;
 
     m_last_last_last_emitter = m_last_last_emitter;
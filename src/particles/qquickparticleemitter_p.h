@@ -136,6 +136,7 @@ public:
     void componentComplete() override;
 Q_SIGNALS:
     void emitParticles(QQmlV4Handle particles);
+    void emitParticleBatch(QQmlV4Handle batch);
     void particlesPerSecondChanged(qreal);
     void particleDurationChanged(int);
     void enabledChanged(bool);
@@ -360,6 +361,7 @@ protected:
        QPointF m_last_last_last_emitter;
 
        bool isEmitConnected();
+       bool isEmitBatchConnected();
 
 private: // data
        QString m_group;
@@ -105,6 +105,11 @@ DEFINE_BOOL_CONFIG_OPTION(qmlParticlesDebug, QML_PARTICLES_DEBUG)
     \brief A system which includes particle painter, emitter, and affector types
     \ingroup qtquick-particles
 
+    If the \c QT_QUICK_PARTICLE_THREADS environment variable is set to a number
+    greater than zero, the Gravity, Friction, Attractor and Age affectors split
+    large numbers of particles across up to that many additional threads in each
+    simulation step. Emitters, other affectors and all signal handlers still run
+    on the GUI thread, after the threads have finished.
 */
 
 /*!
@@ -324,8 +329,8 @@ QQuickParticleGroupData::QQuickParticleGroupData(const QString &name, QQuickPart
 
 QQuickParticleGroupData::~QQuickParticleGroupData()
 {
-    foreach (QQuickParticleData* d, data)
-        delete d;
+    for (QQuickParticleData *block : qAsConst(m_blocks))
+        delete[] block;
 }
 
 QString QQuickParticleGroupData::name()//### Worth caching as well?
@@ -340,8 +345,11 @@ void QQuickParticleGroupData::setSize(int newSize)
     Q_ASSERT(newSize > m_size);//XXX allow shrinking
     data.resize(newSize);
     freeList.resize(newSize);
+    //One allocation for all new particles keeps them next to each other for the affectors
+    QQuickParticleData *block = new QQuickParticleData[newSize - m_size];
+    m_blocks.append(block);
     for (int i=m_size; i<newSize; i++) {
-        data[i] = new QQuickParticleData;
+        data[i] = block + (i - m_size);
         data[i]->groupId = index;
         data[i]->index = i;
     }
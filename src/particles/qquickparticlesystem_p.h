@@ -229,6 +229,7 @@ public:
 private:
     int m_size;
     QQuickParticleSystem* m_system;
+    QVector<QQuickParticleData*> m_blocks;//Own the particles in data, which are allocated contiguously
 };
 
 struct Color4ub {
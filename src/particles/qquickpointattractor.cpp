@@ -109,16 +109,14 @@ QQuickAttractorAffector::QQuickAttractorAffector(QQuickItem *parent) :
     QQuickParticleAffector(parent), m_strength(0.0), m_x(0), m_y(0)
   , m_physics(Velocity), m_proportionalToDistance(Linear)
 {
+    m_threadSafeBatch = true;
 }
 
-bool QQuickAttractorAffector::affectParticle(QQuickParticleData *d, qreal dt)
+void QQuickAttractorAffector::attract(QQuickParticleData *d, qreal targetX, qreal targetY, qreal dt)
 {
-    if (m_strength == 0.0)
-        return false;
-    qreal dx = m_x+m_offset.x() - d->curX(m_system);
-    qreal dy = m_y+m_offset.y() - d->curY(m_system);
+    qreal dx = targetX - d->curX(m_system);
+    qreal dy = targetY - d->curY(m_system);
     qreal r = std::sqrt((dx*dx) + (dy*dy));
-    qreal theta = std::atan2(dy,dx);
     qreal ds = 0;
     switch (m_proportionalToDistance){
     case InverseQuadratic:
@@ -137,8 +135,14 @@ bool QQuickAttractorAffector::affectParticle(QQuickParticleData *d, qreal dt)
         ds = m_strength;
     }
     ds *= dt;
-    dx = ds * std::cos(theta);
-    dy = ds * std::sin(theta);
+    //Towards the target, a particle right on it is pushed along the x axis like atan2(0, 0) would
+    if (r > 0) {
+        dx = ds * dx / r;
+        dy = ds * dy / r;
+    } else {
+        dx = ds;
+        dy = 0;
+    }
     qreal vx,vy;
     switch (m_physics){
     case Position:
@@ -156,9 +160,27 @@ bool QQuickAttractorAffector::affectParticle(QQuickParticleData *d, qreal dt)
         d->setInstantaneousVX(vx + dx, m_system);
         d->setInstantaneousVY(vy + dy, m_system);
     }
+}
 
+bool QQuickAttractorAffector::affectParticle(QQuickParticleData *d, qreal dt)
+{
+    if (m_strength == 0.0)
+        return false;
+    attract(d, m_x + m_offset.x(), m_y + m_offset.y(), dt);
     return true;
 }
+
+void QQuickAttractorAffector::affectBatch(QQuickParticleData *const *particles, int count, qreal dt, bool *affected)
+{
+    if (m_strength == 0.0)
+        return;
+    const qreal targetX = m_x + m_offset.x();
+    const qreal targetY = m_y + m_offset.y();
+    for (int i = 0; i < count; ++i) {
+        attract(particles[i], targetX, targetY, dt);
+        affected[i] = true;
+    }
+}
 QT_END_NAMESPACE
 
 #include "moc_qquickpointattractor_p.cpp"
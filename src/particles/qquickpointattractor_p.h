@@ -161,8 +161,11 @@ void setProportionalToDistance(Proportion arg)
 
 protected:
     bool affectParticle(QQuickParticleData *d, qreal dt) override;
+    void affectBatch(QQuickParticleData *const *particles, int count, qreal dt, bool *affected) override;
 
 private:
+inline void attract(QQuickParticleData *d, qreal targetX, qreal targetY, qreal dt);
+
 qreal m_strength;
 qreal m_x;
 qreal m_y;
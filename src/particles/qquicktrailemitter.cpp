@@ -40,6 +40,7 @@
 #include "qquicktrailemitter_p.h"
 #include <private/qqmlengine_p.h>
 #include <private/qqmlglobal_p.h>
+#include "qquickparticlebatch_p.h"
 #include <QRandomGenerator>
 #include <cmath>
 QT_BEGIN_NAMESPACE
@@ -122,7 +123,7 @@ QQuickTrailEmitter::QQuickTrailEmitter(QQuickItem *parent) :
 
     This signal is emitted when particles are emitted from the \a followed particle. \a particles contains an array of particle objects which can be directly manipulated.
 
-    The corresponding handler is \c onEmitFollowParticles. If you use this signal handler, emitParticles will not be emitted.
+    The corresponding handler is \c onEmitFollowParticles. If you use this signal handler, emitParticles and emitParticleBatch will not be emitted.
 */
 
 bool QQuickTrailEmitter::isEmitFollowConnected()
@@ -280,6 +281,14 @@ void QQuickTrailEmitter::emitWindow(int timeStamp)
             else if (isEmitConnected())
                 emitParticles(QQmlV4Handle(array));//A chance for arbitrary JS changes
         }
+
+        if (!toEmit.isEmpty() && !isEmitFollowConnected() && isEmitBatchConnected()) {
+            QQmlEngine *qmlEngine = ::qmlEngine(this);
+            QQuickParticleBatch batch(QV8Engine::getV4(qmlEngine->handle()), m_system, toEmit);
+            batch.load();
+            emitParticleBatch(batch.v4Value());
+            batch.store();
+        }
         m_lastEmission[d->index] = pt;
     }
 
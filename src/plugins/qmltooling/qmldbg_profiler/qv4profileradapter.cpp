@@ -40,10 +40,17 @@
 #include "qv4profileradapter.h"
 #include "qqmlprofilerservice.h"
 
+#include <private/qv4compileddata_p.h>
+#include <private/qv4lookup_p.h>
+
 QT_BEGIN_NAMESPACE
 
+Q_STATIC_ASSERT(int(QV4::CompiledData::Lookup::Type_IndexedSetter)
+                == int(QQmlProfilerDefinitions::LookupIndexedSetter));
+Q_STATIC_ASSERT(int(QV4::Lookup::Generic) == int(QQmlProfilerDefinitions::LookupGeneric));
+
 QV4ProfilerAdapter::QV4ProfilerAdapter(QQmlProfilerService *service, QV4::ExecutionEngine *engine) :
-    m_functionCallPos(0), m_memoryPos(0)
+    m_functionCallPos(0), m_memoryPos(0), m_lookupPos(0)
 {
     setService(service);
     engine->setProfiler(new QV4::Profiling::Profiler(engine));
@@ -66,6 +73,8 @@ QV4ProfilerAdapter::QV4ProfilerAdapter(QQmlProfilerService *service, QV4::Execut
             engine->profiler(), &QV4::Profiling::Profiler::setTimer);
     connect(engine->profiler(), &QV4::Profiling::Profiler::dataReady,
             this, &QV4ProfilerAdapter::receiveData);
+    connect(engine->profiler(), &QV4::Profiling::Profiler::lookupDataReady,
+            this, &QV4ProfilerAdapter::receiveLookupData);
 }
 
 qint64 QV4ProfilerAdapter::appendMemoryEvents(qint64 until, QList<QByteArray> &messages,
@@ -84,6 +93,24 @@ qint64 QV4ProfilerAdapter::appendMemoryEvents(qint64 until, QList<QByteArray> &m
     return memoryData.length() == m_memoryPos ? -1 : memoryData[m_memoryPos].timestamp;
 }
 
+qint64 QV4ProfilerAdapter::appendLookupEvents(qint64 until, QList<QByteArray> &messages,
+                                              QQmlDebugPacket &d)
+{
+    // Make it const, so that we cannot accidentally detach it.
+    const QVector<QV4::Profiling::LookupProperties> &lookupData = m_lookupData;
+
+    while (lookupData.length() > m_lookupPos && lookupData[m_lookupPos].timestamp <= until) {
+        const QV4::Profiling::LookupProperties &props = lookupData[m_lookupPos];
+        d << props.timestamp << int(LookupStatistics) << props.type << props.state
+          << props.hitCount << props.missCount << props.file << props.line << props.column
+          << props.name << qint64(props.unit) << props.index;
+        ++m_lookupPos;
+        messages.append(d.squeezedData());
+        d.clear();
+    }
+    return lookupData.length() == m_lookupPos ? -1 : lookupData[m_lookupPos].timestamp;
+}
+
 qint64 QV4ProfilerAdapter::finalizeMessages(qint64 until, QList<QByteArray> &messages,
                                             qint64 callNext, QQmlDebugPacket &d)
 {
@@ -94,14 +121,24 @@ qint64 QV4ProfilerAdapter::finalizeMessages(qint64 until, QList<QByteArray> &mes
     }
 
     qint64 memoryNext = appendMemoryEvents(until, messages, d);
+    qint64 lookupNext = appendLookupEvents(until, messages, d);
 
     if (memoryNext == -1) {
         m_memoryData.clear();
         m_memoryPos = 0;
-        return callNext;
     }
 
-    return callNext == -1 ? memoryNext : qMin(callNext, memoryNext);
+    if (lookupNext == -1) {
+        m_lookupData.clear();
+        m_lookupPos = 0;
+    }
+
+    qint64 next = callNext;
+    for (qint64 other : {memoryNext, lookupNext}) {
+        if (other != -1 && (next == -1 || other < next))
+            next = other;
+    }
+    return next;
 }
 
 qint64 QV4ProfilerAdapter::sendMessages(qint64 until, QList<QByteArray> &messages,
@@ -120,6 +157,7 @@ qint64 QV4ProfilerAdapter::sendMessages(qint64 until, QList<QByteArray> &message
                 return finalizeMessages(until, messages, m_stack.top(), d);
 
             appendMemoryEvents(m_stack.top(), messages, d);
+            appendLookupEvents(m_stack.top(), messages, d);
             d << m_stack.pop() << int(RangeEnd) << int(Javascript);
             messages.append(d.squeezedData());
             d.clear();
@@ -132,6 +170,7 @@ qint64 QV4ProfilerAdapter::sendMessages(qint64 until, QList<QByteArray> &message
                 return finalizeMessages(until, messages, props.start, d);
 
             appendMemoryEvents(props.start, messages, d);
+            appendLookupEvents(props.start, messages, d);
             auto location = m_functionLocations.find(props.id);
 
             d << props.start << int(RangeStart) << int(Javascript);
@@ -188,6 +227,16 @@ void QV4ProfilerAdapter::receiveData(
     service->dataReady(this);
 }
 
+void QV4ProfilerAdapter::receiveLookupData(
+        const QVector<QV4::Profiling::LookupProperties> &lookupData)
+{
+    // Sent along with the next dataReady() from the profiler, which is emitted right after this.
+    if (m_lookupData.isEmpty())
+        m_lookupData = lookupData;
+    else
+        m_lookupData.append(lookupData);
+}
+
 quint64 QV4ProfilerAdapter::translateFeatures(quint64 qmlFeatures)
 {
     quint64 v4Features = 0;
@@ -196,6 +245,8 @@ quint64 QV4ProfilerAdapter::translateFeatures(quint64 qmlFeatures)
         v4Features |= (one << QV4::Profiling::FeatureFunctionCall);
     if (qmlFeatures & (one << ProfileMemory))
         v4Features |= (one << QV4::Profiling::FeatureMemoryAllocation);
+    if (qmlFeatures & (one << ProfileLookups))
+        v4Features |= (one << QV4::Profiling::FeatureLookups);
     return v4Features;
 }
 
@@ -71,12 +71,12 @@ public:
     CompiledData::Unit *open(const QString &cacheFilePath, const QDateTime &sourceTimeStamp, QString *errorString);
     void close();
 
+    size_t size() const { return length; }
+
 private:
     static bool verifyHeader(const QV4::CompiledData::Unit *header, QDateTime sourceTimeStamp, QString *errorString);
 
-#if defined(Q_OS_UNIX)
     size_t length;
-#endif
     void *dataPtr;
 };
 
@@ -58,11 +58,11 @@ CompiledData::Unit *CompilationUnitMapper::open(const QString &cacheFileName, co
     HANDLE handle =
 #if defined(Q_OS_WINRT)
         CreateFile2(reinterpret_cast<const wchar_t*>(cacheFileName.constData()),
-                   GENERIC_READ | GENERIC_EXECUTE, FILE_SHARE_READ,
+                   GENERIC_READ, FILE_SHARE_READ,
                    OPEN_EXISTING, nullptr);
 #else
         CreateFile(reinterpret_cast<const wchar_t*>(cacheFileName.constData()),
-                   GENERIC_READ | GENERIC_EXECUTE, FILE_SHARE_READ,
+                   GENERIC_READ, FILE_SHARE_READ,
                    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
                    nullptr);
 #endif
@@ -90,14 +90,18 @@ CompiledData::Unit *CompilationUnitMapper::open(const QString &cacheFileName, co
     if (!verifyHeader(&header, sourceTimeStamp, errorString))
         return nullptr;
 
-    const uint mappingFlags = header.flags & QV4::CompiledData::Unit::ContainsMachineCode
-                              ? PAGE_EXECUTE_READ : PAGE_READONLY;
-    const uint viewFlags = header.flags & QV4::CompiledData::Unit::ContainsMachineCode
-                           ? (FILE_MAP_READ | FILE_MAP_EXECUTE) : FILE_MAP_READ;
-
     // Data structure and qt version matched, so now we can access the rest of the file safely.
 
-    HANDLE fileMappingHandle = CreateFileMapping(handle, 0, mappingFlags, 0, 0, 0);
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize)) {
+        *errorString = qt_error_string(GetLastError());
+        return nullptr;
+    }
+    length = static_cast<size_t>(fileSize.QuadPart);
+
+    // Machine code is copied into executable memory when the unit is linked, the file
+    // itself never needs to be mapped with execute permissions.
+    HANDLE fileMappingHandle = CreateFileMapping(handle, 0, PAGE_READONLY, 0, 0, 0);
     if (!fileMappingHandle) {
         *errorString = qt_error_string(GetLastError());
         return nullptr;
@@ -107,7 +111,7 @@ CompiledData::Unit *CompilationUnitMapper::open(const QString &cacheFileName, co
         CloseHandle(fileMappingHandle);
     });
 
-    dataPtr = MapViewOfFile(fileMappingHandle, viewFlags, 0, 0, 0);
+    dataPtr = MapViewOfFile(fileMappingHandle, FILE_MAP_READ, 0, 0, 0);
     if (!dataPtr) {
         *errorString = qt_error_string(GetLastError());
         return nullptr;
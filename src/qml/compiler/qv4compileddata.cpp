@@ -58,6 +58,11 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <private/qv4identifiertable_p.h>
+#include <private/qv4script_p.h>
+#include <private/qqmlpooledjob_p.h>
+#ifndef QT_NO_THREAD
+#include <QThreadPool>
+#endif
 #endif
 #include <private/qqmlirbuilder_p.h>
 #include <QCoreApplication>
@@ -79,7 +84,7 @@ namespace QV4 {
 namespace CompiledData {
 
 #if !defined(V4_BOOTSTRAP)
-static QString cacheFilePath(const QUrl &url)
+QString CompilationUnit::cacheFilePath(const QUrl &url)
 {
     const QString localSourcePath = QQmlFile::urlToLocalFileOrQrc(url);
     const QString localCachePath = localSourcePath + QLatin1Char('c');
@@ -94,10 +99,13 @@ static QString cacheFilePath(const QUrl &url)
 #endif
 
 #ifndef V4_BOOTSTRAP
+static QBasicAtomicInt unitSerial = Q_BASIC_ATOMIC_INITIALIZER(1);
+
 CompilationUnit::CompilationUnit()
     : data(0)
     , engine(0)
     , qmlEngine(0)
+    , unitId(unitSerial.fetchAndAddRelaxed(1))
     , runtimeLookups(0)
     , runtimeRegularExpressions(0)
     , runtimeClasses(0)
@@ -108,6 +116,7 @@ CompilationUnit::CompilationUnit()
     , metaTypeId(-1)
     , listMetaTypeId(-1)
     , isRegisteredWithEngine(false)
+    , tierUpJob(nullptr)
 {}
 
 CompilationUnit::~CompilationUnit()
@@ -171,6 +180,8 @@ QV4::Function *CompilationUnit::linkToEngine(ExecutionEngine *engine)
             l->level = -1;
             l->index = UINT_MAX;
             l->nameIndex = compiledLookups[i].nameIndex;
+            l->hitCount = 0;
+            l->missCount = 0;
         }
     }
 
@@ -235,10 +246,14 @@ void CompilationUnit::unlink()
     runtimeStrings = 0;
     delete [] runtimeLookups;
     runtimeLookups = 0;
+    qDeleteAll(polymorphicLookupCaches);
+    polymorphicLookupCaches.clear();
     delete [] runtimeRegularExpressions;
     runtimeRegularExpressions = 0;
     free(runtimeClasses);
     runtimeClasses = 0;
+    cancelTierUp();
+    tierUpSource.reset();
     qDeleteAll(runtimeFunctions);
     runtimeFunctions.clear();
 #if Q_BYTE_ORDER == Q_BIG_ENDIAN
@@ -247,6 +262,63 @@ void CompilationUnit::unlink()
 #endif
 }
 
+struct CompilationUnit::TierUpJob : public QQmlPooledJob
+{
+    TierUpJob(TierUpSource *source, EvalISelFactory *iselFactory, ExecutableAllocator *executableAllocator)
+        : source(source)
+        , iselFactory(iselFactory)
+        , executableAllocator(executableAllocator)
+    {
+    }
+
+    // Runs without the engine: the unit gets linked once the engine thread picks it up.
+    void execute() override
+    {
+        result = Script::compileForTierUp(iselFactory, executableAllocator, *source);
+    }
+
+    QScopedPointer<TierUpSource> source;
+    EvalISelFactory *iselFactory;
+    ExecutableAllocator *executableAllocator;
+    QQmlRefPointer<CompilationUnit> result;
+};
+
+#ifndef QT_NO_THREAD
+Q_GLOBAL_STATIC(QThreadPool, tierUpThreadPool)
+#else
+static QThreadPool *tierUpThreadPool() { return nullptr; }
+#endif
+
+void CompilationUnit::startTierUp()
+{
+    Q_ASSERT(engine && tierUpSource && !tierUpJob);
+    tierUpJob = new TierUpJob(tierUpSource.take(), engine->iselFactory.data(), engine->executableAllocator);
+    tierUpJob->start(tierUpThreadPool());
+}
+
+bool CompilationUnit::finishTierUp()
+{
+    Q_ASSERT(tierUpJob);
+    if (!tierUpJob->isFinished())
+        return false;
+
+    tierUpJob->waitForFinished();
+    if (tierUpJob->result && tierUpJob->result->linkToEngine(engine))
+        optimizedUnit = tierUpJob->result;
+    delete tierUpJob;
+    tierUpJob = nullptr;
+    return true;
+}
+
+void CompilationUnit::cancelTierUp()
+{
+    if (!tierUpJob)
+        return;
+    tierUpJob->cancel();
+    delete tierUpJob;
+    tierUpJob = nullptr;
+}
+
 void CompilationUnit::markObjects(QV4::MarkStack *markStack)
 {
     for (uint i = 0; i < data->stringTableSize; ++i)
@@ -387,6 +459,9 @@ bool CompilationUnit::loadFromDisk(const QUrl &url, const QDateTime &sourceTimeS
         }
     }
 
+    if (!data->verifyCodeChecksum(cacheFile->size(), errorString))
+        return false;
+
     if (!memoryMapCode(errorString))
         return false;
 
@@ -794,6 +869,58 @@ void Unit::generateChecksum()
 #endif
 }
 
+void Unit::generateCodeChecksum(const QVector<QByteArray> &code)
+{
+    Q_ASSERT(code.size() == int(functionTableSize));
+#ifndef V4_BOOTSTRAP
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(md5Checksum, sizeof(md5Checksum));
+    for (const QByteArray &functionCode : code)
+        hash.addData(functionCode);
+
+    QByteArray checksum = hash.result();
+    Q_ASSERT(checksum.size() == sizeof(codeMD5Checksum));
+    memcpy(codeMD5Checksum, checksum.constData(), sizeof(codeMD5Checksum));
+#else
+    Q_UNUSED(code);
+    memset(codeMD5Checksum, 0, sizeof(codeMD5Checksum));
+#endif
+}
+
+#ifndef V4_BOOTSTRAP
+bool Unit::verifyCodeChecksum(size_t fileSize, QString *errorString) const
+{
+    for (uint i = 0; i < functionTableSize; ++i) {
+        const Function *compiledFunction = functionAt(i);
+        if (quint64(compiledFunction->codeOffset) + compiledFunction->codeSize > fileSize) {
+            *errorString = QStringLiteral("Code of function %1 is outside of the cache file.").arg(i);
+            return false;
+        }
+    }
+
+    // Ahead-of-time generated units don't carry a checksum, like their md5Checksum
+    static const char noChecksum[sizeof(codeMD5Checksum)] = {};
+    if (memcmp(codeMD5Checksum, noChecksum, sizeof(codeMD5Checksum)) == 0)
+        return true;
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(md5Checksum, sizeof(md5Checksum));
+    const char *basePtr = reinterpret_cast<const char *>(this);
+    for (uint i = 0; i < functionTableSize; ++i) {
+        const Function *compiledFunction = functionAt(i);
+        hash.addData(basePtr + compiledFunction->codeOffset, compiledFunction->codeSize);
+    }
+
+    const QByteArray checksum = hash.result();
+    Q_ASSERT(checksum.size() == sizeof(codeMD5Checksum));
+    if (memcmp(codeMD5Checksum, checksum.constData(), sizeof(codeMD5Checksum)) != 0) {
+        *errorString = QStringLiteral("Checksum mismatch of the code in the cache file.");
+        return false;
+    }
+    return true;
+}
+#endif
+
 }
 
 }
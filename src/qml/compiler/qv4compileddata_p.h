@@ -71,7 +71,7 @@
 QT_BEGIN_NAMESPACE
 
 // Bump this whenever the compiler data structures change in an incompatible way.
-#define QV4_DATA_STRUCTURE_VERSION 0x11
+#define QV4_DATA_STRUCTURE_VERSION 0x14
 
 class QIODevice;
 class QQmlPropertyCache;
@@ -166,6 +166,7 @@ struct Lookup
         quint32_le_bitfield<0, 4> type_and_flags;
         quint32_le_bitfield<4, 28> nameIndex;
     };
+    Location location; // of the statement performing the lookup
 
     Lookup() : _dummy(0) { }
 };
@@ -662,6 +663,11 @@ struct Unit
     quint32_le architectureIndex; // string index to QSysInfo::buildAbi()
     quint32_le codeGeneratorIndex;
     char dependencyMD5Checksum[16];
+    // Checksum of md5Checksum followed by the code of all functions, in function table order.
+    // Guards the code stored after the unit data in cache files.
+    char codeMD5Checksum[16];
+    void generateCodeChecksum(const QVector<QByteArray> &code);
+    bool verifyCodeChecksum(size_t fileSize, QString *errorString) const;
 
     enum : unsigned int {
         IsJavascript = 0x1,
@@ -873,7 +879,11 @@ struct Q_QML_PRIVATE_EXPORT CompilationUnit : public CompilationUnitBase, public
     QString fileName() const { return data->stringAt(data->sourceFileIndex); }
     QUrl url() const { if (m_url.isNull) m_url = QUrl(fileName()); return m_url; }
 
+    // Identifies the unit in profiling data. Unlike its address, it is not reused for later units.
+    quint32 unitId;
+
     QV4::Lookup *runtimeLookups;
+    QVector<QV4::PolymorphicLookupCache *> polymorphicLookupCaches; // owned, created by lookups that see several classes
     QV4::Value *runtimeRegularExpressions;
     QV4::InternalClass **runtimeClasses;
     QVector<QV4::Function *> runtimeFunctions;
@@ -915,6 +925,30 @@ struct Q_QML_PRIVATE_EXPORT CompilationUnit : public CompilationUnitBase, public
 
     QScopedPointer<CompilationUnitMapper> backingFile;
 
+    // Tiered execution: units compiled by the interpreter from source at run time keep
+    // what is needed to compile them again with the JIT once one of their functions gets
+    // hot (see QV4::Function::tierUp()). The JIT compiles on a worker thread, and the
+    // resulting unit is owned by this one. The source is handed to the job, and so released
+    // once the unit tiered up. Units without functions besides their top level code can't
+    // get hot and don't keep it in the first place.
+    struct TierUpSource {
+        QString sourceCode;
+        QString sourceFile;
+        int line;
+        bool strictMode;
+        bool parseAsBinding;
+        bool useFastLookups;
+        QStringList inheritedLocals;
+    };
+    struct TierUpJob;
+    QScopedPointer<TierUpSource> tierUpSource;
+    TierUpJob *tierUpJob;
+    QQmlRefPointer<CompilationUnit> optimizedUnit;
+
+    void startTierUp();
+    bool finishTierUp(); // false while the job is still running
+    void cancelTierUp();
+
     // --- interface for QQmlPropertyCacheCreator
     typedef Object CompiledObject;
     int objectCount() const { return data->nObjects; }
@@ -946,6 +980,7 @@ struct Q_QML_PRIVATE_EXPORT CompilationUnit : public CompilationUnitBase, public
     void destroy() Q_DECL_OVERRIDE;
 
     bool loadFromDisk(const QUrl &url, const QDateTime &sourceTimeStamp, EvalISelFactory *iselFactory, QString *errorString);
+    static QString cacheFilePath(const QUrl &url);
 
 protected:
     virtual void linkBackendToEngine(QV4::ExecutionEngine *engine) = 0;
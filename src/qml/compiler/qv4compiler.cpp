@@ -105,48 +105,53 @@ QV4::Compiler::JSUnitGenerator::JSUnitGenerator(QV4::IR::Module *module)
     registerString(QString());
 }
 
-uint QV4::Compiler::JSUnitGenerator::registerIndexedGetterLookup()
+uint QV4::Compiler::JSUnitGenerator::registerIndexedGetterLookup(const CompiledData::Location &location)
 {
     CompiledData::Lookup l;
     l.type_and_flags = CompiledData::Lookup::Type_IndexedGetter;
     l.nameIndex = 0;
+    l.location = location;
     lookups << l;
     return lookups.size() - 1;
 }
 
-uint QV4::Compiler::JSUnitGenerator::registerIndexedSetterLookup()
+uint QV4::Compiler::JSUnitGenerator::registerIndexedSetterLookup(const CompiledData::Location &location)
 {
     CompiledData::Lookup l;
     l.type_and_flags = CompiledData::Lookup::Type_IndexedSetter;
     l.nameIndex = 0;
+    l.location = location;
     lookups << l;
     return lookups.size() - 1;
 }
 
-uint QV4::Compiler::JSUnitGenerator::registerGetterLookup(const QString &name)
+uint QV4::Compiler::JSUnitGenerator::registerGetterLookup(const QString &name, const CompiledData::Location &location)
 {
     CompiledData::Lookup l;
     l.type_and_flags = CompiledData::Lookup::Type_Getter;
     l.nameIndex = registerString(name);
+    l.location = location;
     lookups << l;
     return lookups.size() - 1;
 }
 
 
-uint QV4::Compiler::JSUnitGenerator::registerSetterLookup(const QString &name)
+uint QV4::Compiler::JSUnitGenerator::registerSetterLookup(const QString &name, const CompiledData::Location &location)
 {
     CompiledData::Lookup l;
     l.type_and_flags = CompiledData::Lookup::Type_Setter;
     l.nameIndex = registerString(name);
+    l.location = location;
     lookups << l;
     return lookups.size() - 1;
 }
 
-uint QV4::Compiler::JSUnitGenerator::registerGlobalGetterLookup(const QString &name)
+uint QV4::Compiler::JSUnitGenerator::registerGlobalGetterLookup(const QString &name, const CompiledData::Location &location)
 {
     CompiledData::Lookup l;
     l.type_and_flags = CompiledData::Lookup::Type_GlobalGetter;
     l.nameIndex = registerString(name);
+    l.location = location;
     lookups << l;
     return lookups.size() - 1;
 }
@@ -96,11 +96,11 @@ struct Q_QML_PRIVATE_EXPORT JSUnitGenerator {
     int getStringId(const QString &string) const { return stringTable.getStringId(string); }
     QString stringForIndex(int index) const { return stringTable.stringForIndex(index); }
 
-    uint registerGetterLookup(const QString &name);
-    uint registerSetterLookup(const QString &name);
-    uint registerGlobalGetterLookup(const QString &name);
-    uint registerIndexedGetterLookup();
-    uint registerIndexedSetterLookup();
+    uint registerGetterLookup(const QString &name, const CompiledData::Location &location = CompiledData::Location());
+    uint registerSetterLookup(const QString &name, const CompiledData::Location &location = CompiledData::Location());
+    uint registerGlobalGetterLookup(const QString &name, const CompiledData::Location &location = CompiledData::Location());
+    uint registerIndexedGetterLookup(const CompiledData::Location &location = CompiledData::Location());
+    uint registerIndexedSetterLookup(const CompiledData::Location &location = CompiledData::Location());
 
     int registerRegExp(IR::RegExp *regexp);
 
@@ -253,6 +253,8 @@ void InstructionSelection::run(int functionIndex)
             _currentStatement = s;
 
             if (s->location.isValid()) {
+                lookupLocation.line = s->location.startLine;
+                lookupLocation.column = s->location.startColumn;
                 if (s->location.startLine != currentLine) {
                     blockNeedsDebugInstruction = false;
                     currentLine = s->location.startLine;
@@ -1483,6 +1485,7 @@ void CompilationUnit::prepareCodeOffsetsForDiskStorage(CompiledData::Unit *unit)
         compiledFunction->codeSize = codeRefs.at(i).size();
         offset = WTF::roundUpToMultipleOf(codeAlignment, offset + compiledFunction->codeSize);
     }
+    unit->generateCodeChecksum(codeRefs);
 }
 
 bool CompilationUnit::saveCodeToDisk(QIODevice *device, const CompiledData::Unit *unit, QString *errorString)
@@ -81,11 +81,11 @@ public:
     void setUseTypeInference(bool onoff) { useTypeInference = onoff; }
 
     int registerString(const QString &str) { return jsGenerator->registerString(str); }
-    uint registerIndexedGetterLookup() { return jsGenerator->registerIndexedGetterLookup(); }
-    uint registerIndexedSetterLookup() { return jsGenerator->registerIndexedSetterLookup(); }
-    uint registerGetterLookup(const QString &name) { return jsGenerator->registerGetterLookup(name); }
-    uint registerSetterLookup(const QString &name) { return jsGenerator->registerSetterLookup(name); }
-    uint registerGlobalGetterLookup(const QString &name) { return jsGenerator->registerGlobalGetterLookup(name); }
+    uint registerIndexedGetterLookup() { return jsGenerator->registerIndexedGetterLookup(lookupLocation); }
+    uint registerIndexedSetterLookup() { return jsGenerator->registerIndexedSetterLookup(lookupLocation); }
+    uint registerGetterLookup(const QString &name) { return jsGenerator->registerGetterLookup(name, lookupLocation); }
+    uint registerSetterLookup(const QString &name) { return jsGenerator->registerSetterLookup(name, lookupLocation); }
+    uint registerGlobalGetterLookup(const QString &name) { return jsGenerator->registerGlobalGetterLookup(name, lookupLocation); }
     int registerRegExp(IR::RegExp *regexp) { return jsGenerator->registerRegExp(regexp); }
     int registerJSClass(int count, IR::ExprList *args) { return jsGenerator->registerJSClass(count, args); }
     QV4::Compiler::JSUnitGenerator *jsUnitGenerator() const { return jsGenerator; }
@@ -100,6 +100,7 @@ protected:
     QV4::Compiler::JSUnitGenerator *jsGenerator;
     QScopedPointer<QV4::Compiler::JSUnitGenerator> ownJSGenerator;
     IR::Module *irModule;
+    CompiledData::Location lookupLocation; // of the statement being selected, recorded with its lookups
 };
 
 class Q_QML_PRIVATE_EXPORT EvalISelFactory
@@ -69,6 +69,7 @@ struct QQmlProfilerDefinitions {
         PixmapCacheEvent,
         SceneGraphFrame,
         MemoryAllocation,
+        LookupStatistics,
 
         MaximumMessage
     };
@@ -130,6 +131,29 @@ struct QQmlProfilerDefinitions {
 
     typedef QV4::Profiling::MemoryType MemoryType;
 
+    // Same values as QV4::CompiledData::Lookup::Type
+    enum LookupType {
+        LookupGetter,
+        LookupSetter,
+        LookupGlobalGetter,
+        LookupIndexedGetter,
+        LookupIndexedSetter,
+
+        MaximumLookupType
+    };
+
+    // Same values as QV4::Lookup::State
+    enum LookupState {
+        LookupUnresolved,
+        LookupMonomorphic,
+        LookupTwoClasses,
+        LookupPolymorphic,
+        LookupMegamorphic,
+        LookupGeneric,
+
+        MaximumLookupState
+    };
+
     enum ProfileFeature {
         ProfileJavaScript,
         ProfileMemory,
@@ -143,6 +167,7 @@ struct QQmlProfilerDefinitions {
         ProfileHandlingSignal,
         ProfileInputEvents,
         ProfileDebugMessages,
+        ProfileLookups,
 
         MaximumProfileFeature
     };
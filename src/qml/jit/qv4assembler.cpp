@@ -53,6 +53,7 @@
 #include <iostream>
 #include <QBuffer>
 #include <QCoreApplication>
+#include <QMutex>
 
 #if ENABLE(ASSEMBLER)
 
@@ -71,6 +72,9 @@ CompilationUnit::~CompilationUnit()
 
 void CompilationUnit::linkBackendToEngine(ExecutionEngine *engine)
 {
+    if (codeRefs.size() != int(data->functionTableSize))
+        copyCodeToExecutableMemory(engine);
+
     runtimeFunctions.resize(data->functionTableSize);
     runtimeFunctions.fill(0);
     for (int i = 0 ;i < runtimeFunctions.size(); ++i) {
@@ -85,25 +89,48 @@ void CompilationUnit::linkBackendToEngine(ExecutionEngine *engine)
 bool CompilationUnit::memoryMapCode(QString *errorString)
 {
     Q_UNUSED(errorString);
-    codeRefs.resize(data->functionTableSize);
+    // The cache file stays mapped read-only. Its code is copied into executable memory
+    // of the engine once the unit gets linked, see copyCodeToExecutableMemory().
+    codeRefs.clear();
+    return true;
+}
 
-    const char *basePtr = reinterpret_cast<const char *>(data);
+void CompilationUnit::copyCodeToExecutableMemory(ExecutionEngine *engine)
+{
+    const uint functionCount = data->functionTableSize;
+    codeRefs.resize(functionCount);
+    if (!functionCount)
+        return;
 
-    for (uint i = 0; i < data->functionTableSize; ++i) {
+    // prepareCodeOffsetsForDiskStorage() lays out the functions in order, aligned to 16
+    // bytes. The generated code is position independent, so the whole section can be
+    // copied in one go into an allocation that is aligned the same way.
+    const quint64 begin = data->functionAt(0)->codeOffset;
+    const CompiledData::Function *lastFunction = data->functionAt(functionCount - 1);
+    const size_t size = lastFunction->codeOffset + lastFunction->codeSize - begin;
+
+    JSC::JSGlobalData globalData(engine->executableAllocator);
+    RefPtr<JSC::ExecutableMemoryHandle> memory = globalData.executableAllocator.allocate(globalData, size, 0, 0);
+    char *start = static_cast<char *>(memory->start());
+    JSC::ExecutableAllocator::makeWritable(start, size);
+    memcpy(start, reinterpret_cast<const char *>(data) + begin, size);
+    JSC::ExecutableAllocator::makeExecutable(start, size);
+
+    static const bool showCode = qEnvironmentVariableIsSet("QV4_SHOW_ASM");
+    for (uint i = 0; i < functionCount; ++i) {
         const CompiledData::Function *compiledFunction = data->functionAt(i);
-        void *codePtr = const_cast<void *>(reinterpret_cast<const void *>(basePtr + compiledFunction->codeOffset));
-        JSC::MacroAssemblerCodeRef codeRef = JSC::MacroAssemblerCodeRef::createSelfManagedCodeRef(JSC::MacroAssemblerCodePtr(codePtr));
-        JSC::ExecutableAllocator::makeExecutable(codePtr, compiledFunction->codeSize);
-        codeRefs[i] = codeRef;
+        void *codePtr = start + (compiledFunction->codeOffset - begin);
+        // The first function owns the memory, the others point into it
+        if (i == 0)
+            codeRefs[i] = JSC::MacroAssemblerCodeRef(memory);
+        else
+            codeRefs[i] = JSC::MacroAssemblerCodeRef::createSelfManagedCodeRef(JSC::MacroAssemblerCodePtr(codePtr));
 
-        static const bool showCode = qEnvironmentVariableIsSet("QV4_SHOW_ASM");
         if (showCode) {
             WTF::dataLogF("Mapped JIT code for %s\n", qPrintable(stringAt(compiledFunction->nameIndex)));
-            disassemble(codeRef.code(), compiledFunction->codeSize, "    ", WTF::dataFile());
+            disassemble(codeRefs[i].code(), compiledFunction->codeSize, "    ", WTF::dataFile());
         }
     }
-
-    return true;
 }
 
 #endif // !defined(V4_BOOTSTRAP)
@@ -113,12 +140,17 @@ void CompilationUnit::prepareCodeOffsetsForDiskStorage(CompiledData::Unit *unit)
     const int codeAlignment = 16;
     quint64 offset = WTF::roundUpToMultipleOf(codeAlignment, unit->unitSize);
     Q_ASSERT(int(unit->functionTableSize) == codeRefs.size());
+    QVector<QByteArray> code;
+    code.reserve(codeRefs.size());
     for (int i = 0; i < codeRefs.size(); ++i) {
         CompiledData::Function *compiledFunction = const_cast<CompiledData::Function *>(unit->functionAt(i));
         compiledFunction->codeOffset = offset;
         compiledFunction->codeSize = codeRefs.at(i).size();
         offset = WTF::roundUpToMultipleOf(codeAlignment, offset + compiledFunction->codeSize);
+        code.append(QByteArray::fromRawData(reinterpret_cast<const char *>(codeRefs.at(i).code().dataLocation()),
+                                            compiledFunction->codeSize));
     }
+    unit->generateCodeChecksum(code);
 }
 
 bool CompilationUnit::saveCodeToDisk(QIODevice *device, const CompiledData::Unit *unit, QString *errorString)
@@ -594,6 +626,11 @@ static void printDisassembledOutputWithCalls(QByteArray processedOutput, const Q
     qDebug("%s", processedOutput.constData());
 }
 
+#if !defined(QT_NO_THREAD)
+// Functions that got hot are compiled on worker threads, keep their debug output apart
+static QBasicMutex debugOutputMutex;
+#endif
+
 #if defined(Q_OS_LINUX)
 static FILE *pmap;
 
@@ -648,6 +685,9 @@ JSC::MacroAssemblerCodeRef Assembler<TargetConfiguration>::link(int *codeSize)
 
     static const bool showCode = qEnvironmentVariableIsSet("QV4_SHOW_ASM");
     if (showCode) {
+#if !defined(QT_NO_THREAD)
+        QMutexLocker locker(&debugOutputMutex);
+#endif
         QHash<void*, const char*> functions;
 #ifndef QT_NO_DEBUG
         for (CallInfo call : qAsConst(_callInfos))
@@ -678,6 +718,9 @@ JSC::MacroAssemblerCodeRef Assembler<TargetConfiguration>::link(int *codeSize)
     // https://github.com/torvalds/linux/blob/master/tools/perf/Documentation/jit-interface.txt
     static bool doProfile = !qEnvironmentVariableIsEmpty("QV4_PROFILE_WRITE_PERF_MAP");
     static bool profileInitialized = false;
+#if !defined(QT_NO_THREAD)
+    QMutexLocker locker(doProfile ? &debugOutputMutex : nullptr);
+#endif
     if (doProfile && !profileInitialized) {
         profileInitialized = true;
 
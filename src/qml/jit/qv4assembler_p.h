@@ -82,6 +82,7 @@ struct CompilationUnit : public QV4::CompiledData::CompilationUnit
 #if !defined(V4_BOOTSTRAP)
     void linkBackendToEngine(QV4::ExecutionEngine *engine) Q_DECL_OVERRIDE;
     bool memoryMapCode(QString *errorString) Q_DECL_OVERRIDE;
+    void copyCodeToExecutableMemory(QV4::ExecutionEngine *engine);
 #endif
     void prepareCodeOffsetsForDiskStorage(CompiledData::Unit *unit) Q_DECL_OVERRIDE;
     bool saveCodeToDisk(QIODevice *device, const CompiledData::Unit *unit, QString *errorString) Q_DECL_OVERRIDE;
@@ -191,8 +192,24 @@ struct RegisterSizeDependentAssembler<JITAssembler, MacroAssembler, TargetPlatfo
         as->pop(TargetPlatform::EngineRegister);
     }
 
-#if WRITEBARRIER(none)
-    static Q_ALWAYS_INLINE void emitWriteBarrier(JITAssembler *, Address) {}
+#if WRITEBARRIER(steele)
+    static void emitWriteBarrier(JITAssembler *as, Address addr)
+    {
+        // Only writes into ExecutionContexts get here, and addr.base points to the start
+        // of the context. emitSetGrayBit clobbers its input and the scratch/return value
+        // registers, which can still be live at this point, so preserve them.
+        Jump noBarrier = as->branch8(RelationalCondition::Equal,
+                                     Address(TargetPlatform::EngineRegister, JITAssembler::targetStructureOffset(offsetof(EngineBase, writeBarrierActive))),
+                                     TrustedImm32(0));
+        as->push(TargetPlatform::ScratchRegister);
+        as->push(TargetPlatform::ReturnValueRegister);
+        as->push(addr.base);
+        emitSetGrayBit(as, addr.base);
+        as->pop(addr.base);
+        as->pop(TargetPlatform::ReturnValueRegister);
+        as->pop(TargetPlatform::ScratchRegister);
+        noBarrier.link(as);
+    }
 #endif
 
     static void loadDouble(JITAssembler *as, Address addr, FPRegisterID dest)
@@ -487,8 +504,24 @@ struct RegisterSizeDependentAssembler<JITAssembler, MacroAssembler, TargetPlatfo
         as->pop(TargetPlatform::EngineRegister);
     }
 
-#if WRITEBARRIER(none)
-    static Q_ALWAYS_INLINE void emitWriteBarrier(JITAssembler *, Address) {}
+#if WRITEBARRIER(steele)
+    static void emitWriteBarrier(JITAssembler *as, Address addr)
+    {
+        // Only writes into ExecutionContexts get here, and addr.base points to the start
+        // of the context. emitSetGrayBit clobbers its input and the scratch/return value
+        // registers, which can still be live at this point, so preserve them.
+        Jump noBarrier = as->branch8(RelationalCondition::Equal,
+                                     Address(TargetPlatform::EngineRegister, JITAssembler::targetStructureOffset(offsetof(EngineBase, writeBarrierActive))),
+                                     TrustedImm32(0));
+        as->push(TargetPlatform::ScratchRegister);
+        as->push(TargetPlatform::ReturnValueRegister);
+        as->push(addr.base);
+        emitSetGrayBit(as, addr.base);
+        as->pop(addr.base);
+        as->pop(TargetPlatform::ReturnValueRegister);
+        as->pop(TargetPlatform::ScratchRegister);
+        noBarrier.link(as);
+    }
 #endif
 
     static void loadDouble(JITAssembler *as, Address addr, FPRegisterID dest)
@@ -131,6 +131,8 @@ void InstructionSelection<JITAssembler>::run(int functionIndex)
 
         for (IR::Stmt *s : _block->statements()) {
             if (s->location.isValid()) {
+                lookupLocation.line = s->location.startLine;
+                lookupLocation.column = s->location.startColumn;
                 if (int(s->location.startLine) != lastLine) {
                     _as->loadPtr(Address(JITTargetPlatform::EngineRegister, JITAssembler::targetStructureOffset(offsetof(QV4::EngineBase, current))), JITTargetPlatform::ScratchRegister);
                     Address lineAddr(JITTargetPlatform::ScratchRegister, JITAssembler::targetStructureOffset(Heap::ExecutionContextData::baseOffset + offsetof(Heap::ExecutionContextData, lineNumber)));
@@ -176,7 +176,9 @@ bool ArgumentsObject::putIndexed(Managed *m, uint index, const Value &value)
     if (args->fullyCreated())
         return Object::putIndexed(m, index, value);
 
-    args->context()->callData->args[index] = value;
+    // The arguments of a call context live inside the context on the heap
+    Heap::CallContext *ctx = args->context();
+    WriteBarrier::write(args->engine(), ctx, ctx->callData->args + index, value);
     return true;
 }
 
@@ -232,7 +234,9 @@ void ArgumentsSetterFunction::call(const Managed *setter, Scope &scope, CallData
     }
 
     Q_ASSERT(s->index() < static_cast<unsigned>(o->context()->callData->argc));
-    o->context()->callData->args[s->index()] = callData->argc ? callData->args[0].asReturnedValue() : Encode::undefined();
+    Heap::CallContext *ctx = o->context();
+    WriteBarrier::write(v4, ctx, ctx->callData->args + s->index(),
+                        callData->argc ? callData->args[0] : Primitive::undefinedValue());
     scope.result = Encode::undefined();
 }
 
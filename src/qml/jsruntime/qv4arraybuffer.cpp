@@ -108,6 +108,7 @@ void Heap::ArrayBuffer::init(size_t length)
     }
     data->size = int(length);
     memset(data->data(), 0, length + 1);
+    neutered = false;
 }
 
 void Heap::ArrayBuffer::init(const QByteArray& array)
@@ -115,6 +116,7 @@ void Heap::ArrayBuffer::init(const QByteArray& array)
     Object::init();
     data = const_cast<QByteArray&>(array).data_ptr();
     data->ref.ref();
+    neutered = false;
 }
 
 void Heap::ArrayBuffer::destroy()
@@ -131,6 +133,23 @@ QByteArray ArrayBuffer::asByteArray() const
     return QByteArray(ba);
 }
 
+/*
+    Hands the contents of the buffer over to the returned byte array without
+    copying them, unless they are shared. The buffer and all views on it are
+    empty afterwards.
+ */
+QByteArray ArrayBuffer::transfer()
+{
+    detach();
+    if (engine()->hasException)
+        return QByteArray();
+
+    QByteArrayDataPtr ba = { d()->data };
+    d()->data = QTypedArrayData<char>::sharedNull();
+    d()->neutered = true;
+    return QByteArray(ba);
+}
+
 void ArrayBuffer::detach() {
     if (!d()->data->ref.isShared())
         return;
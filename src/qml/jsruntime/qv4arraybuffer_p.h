@@ -68,6 +68,7 @@ struct Q_QML_PRIVATE_EXPORT ArrayBuffer : Object {
     void init(const QByteArray& array);
     void destroy();
     QTypedArrayData<char> *data;
+    bool neutered; // the contents were transferred to another thread
 
     uint byteLength() const { return data->size; }
 };
@@ -96,6 +97,9 @@ struct Q_QML_PRIVATE_EXPORT ArrayBuffer : Object
     char *data() { detach(); return d()->data ? d()->data->data() : 0; }
     const char *constData() { detach(); return d()->data ? d()->data->data() : 0; }
 
+    bool isNeutered() const { return d()->neutered; }
+    QByteArray transfer();
+
 private:
     void detach();
 };
@@ -266,6 +266,7 @@ void ExecutionContext::call(Scope &scope, CallData *callData, Function *function
 {
     ExecutionContextSaver ctxSaver(scope);
 
+    function = function->executableFunction(scope.engine);
     Scoped<CallContext> ctx(scope, newCallContext(function, callData));
     if (f)
         ctx->d()->function.set(scope.engine, f->d());
@@ -284,6 +285,8 @@ void QV4::ExecutionContext::simpleCall(Scope &scope, CallData *callData, Functio
 
     ExecutionContextSaver ctxSaver(scope);
 
+    function = function->executableFunction(scope.engine);
+
     SimpleCallContext::Data *ctx = scope.engine->memoryManager->allocSimpleCallContext();
 
     ctx->strictMode = function->isStrict();
@@ -345,7 +348,7 @@ void ExecutionContext::setProperty(String *name, const Value &value)
                 uint index = c->v4Function->internalClass->find(id);
                 if (index < UINT_MAX) {
                     if (index < c->v4Function->nFormals) {
-                        c->callData->args[c->v4Function->nFormals - index - 1] = value;
+                        WriteBarrier::write(scope.engine, c, c->callData->args + c->v4Function->nFormals - index - 1, value);
                     } else {
                         Q_ASSERT(c->type == Heap::ExecutionContext::Type_CallContext);
                         index -= c->v4Function->nFormals;
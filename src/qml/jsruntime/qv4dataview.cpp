@@ -137,7 +137,7 @@ void DataViewPrototype::method_get_byteLength(const BuiltinFunction *, Scope &sc
     if (!v)
         THROW_TYPE_ERROR();
 
-    scope.result = Encode(v->d()->byteLength);
+    scope.result = Encode(v->d()->buffer->neutered ? 0 : v->d()->byteLength);
 }
 
 void DataViewPrototype::method_get_byteOffset(const BuiltinFunction *, Scope &scope, CallData *callData)
@@ -157,7 +157,7 @@ void DataViewPrototype::method_getChar(const BuiltinFunction *, Scope &scope, Ca
         THROW_TYPE_ERROR();
     double l = callData->args[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->d()->byteLength || v->d()->buffer->neutered)
         THROW_TYPE_ERROR();
     idx += v->d()->byteOffset;
 
@@ -174,7 +174,7 @@ void DataViewPrototype::method_get(const BuiltinFunction *, Scope &scope, CallDa
         THROW_TYPE_ERROR();
     double l = callData->args[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->d()->byteLength || v->d()->buffer->neutered)
         THROW_TYPE_ERROR();
     idx += v->d()->byteOffset;
 
@@ -195,7 +195,7 @@ void DataViewPrototype::method_getFloat(const BuiltinFunction *, Scope &scope, C
         THROW_TYPE_ERROR();
     double l = callData->args[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->d()->byteLength || v->d()->buffer->neutered)
         THROW_TYPE_ERROR();
     idx += v->d()->byteOffset;
 
@@ -232,7 +232,7 @@ void DataViewPrototype::method_setChar(const BuiltinFunction *, Scope &scope, Ca
         THROW_TYPE_ERROR();
     double l = callData->args[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->d()->byteLength || v->d()->buffer->neutered)
         THROW_TYPE_ERROR();
     idx += v->d()->byteOffset;
 
@@ -250,7 +250,7 @@ void DataViewPrototype::method_set(const BuiltinFunction *, Scope &scope, CallDa
         THROW_TYPE_ERROR();
     double l = callData->args[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->d()->byteLength || v->d()->buffer->neutered)
         THROW_TYPE_ERROR();
     idx += v->d()->byteOffset;
 
@@ -274,7 +274,7 @@ void DataViewPrototype::method_setFloat(const BuiltinFunction *, Scope &scope, C
         THROW_TYPE_ERROR();
     double l = callData->args[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->d()->byteLength || v->d()->buffer->neutered)
         THROW_TYPE_ERROR();
     idx += v->d()->byteOffset;
 
@@ -132,6 +132,10 @@ qint32 ExecutionEngine::maxCallDepth = -1;
 ExecutionEngine::ExecutionEngine(EvalISelFactory *factory)
     : executableAllocator(new QV4::ExecutableAllocator)
     , regExpAllocator(new QV4::ExecutableAllocator)
+    , jitCallThreshold(0)
+    , jitLoopThreshold(0)
+    , megamorphicLookupCache(nullptr)
+    , countLookups(false)
     , bumperPointerAllocator(new WTF::BumpPointerAllocator)
     , jsStack(new WTF::PageAllocation)
     , gcStack(new WTF::PageAllocation)
@@ -170,6 +174,20 @@ ExecutionEngine::ExecutionEngine(EvalISelFactory *factory)
         } else {
             factory = new JIT::ISelFactory<>;
             jitDisabled = false;
+
+            // QV4_JIT_CALL_THRESHOLD=0 compiles everything with the JIT right away
+            bool ok = false;
+            int callThreshold = qEnvironmentVariableIntValue("QV4_JIT_CALL_THRESHOLD", &ok);
+            if (!ok || callThreshold < 0)
+                callThreshold = DefaultJitCallThreshold;
+            int loopThreshold = qEnvironmentVariableIntValue("QV4_JIT_LOOP_THRESHOLD", &ok);
+            if (!ok || loopThreshold <= 0)
+                loopThreshold = DefaultJitLoopThreshold;
+            if (callThreshold > 0) {
+                interpreterFactory.reset(new Moth::ISelFactory);
+                jitCallThreshold = callThreshold;
+                jitLoopThreshold = loopThreshold;
+            }
         }
 #else // !V4_ENABLE_JIT
         factory = new Moth::ISelFactory;
@@ -528,6 +546,7 @@ ExecutionEngine::~ExecutionEngine()
     gcStack->deallocate();
     delete gcStack;
     delete [] argumentsAccessors;
+    delete megamorphicLookupCache;
 }
 
 #ifndef QT_NO_QML_DEBUGGER
@@ -101,12 +101,32 @@ public:
     ExecutableAllocator *regExpAllocator;
     QScopedPointer<EvalISelFactory> iselFactory;
 
+    // Tiered execution: when set, code compiled from source at run time starts out in the
+    // interpreter, and its functions are compiled with iselFactory once they were called
+    // jitCallThreshold times or ran jitLoopThreshold loop iterations.
+    QScopedPointer<EvalISelFactory> interpreterFactory;
+    quint32 jitCallThreshold;
+    quint32 jitLoopThreshold;
+
+    // Shared by all megamorphic property lookups, and by global lookups after the global
+    // object changed its class. Created on first use.
+    MegamorphicLookupCache *megamorphicLookupCache;
+
+    // Set while the profiler records lookup statistics. Lookups only count their cache hits
+    // and misses then.
+    bool countLookups;
+
     WTF::BumpPointerAllocator *bumperPointerAllocator; // Used by Yarr Regex engine.
 
     enum {
         JSStackLimit = 4*1024*1024,
         GCStackLimit = 2*1024*1024
     };
+
+    enum {
+        DefaultJitCallThreshold = 10,
+        DefaultJitLoopThreshold = 1000
+    };
     WTF::PageAllocation *jsStack;
 
     WTF::PageAllocation *gcStack;
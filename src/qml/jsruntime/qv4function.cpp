@@ -57,6 +57,10 @@ Function::Function(ExecutionEngine *engine, CompiledData::CompilationUnit *unit,
         , code(codePtr)
         , codeData(0)
         , hasQmlDependencies(function->hasQmlDependencies())
+        , tierUpCandidate(!unit->tierUpSource.isNull())
+        , callCount(0)
+        , backEdgeCount(0)
+        , optimizedFunction(0)
 {
     internalClass = engine->internalClasses[EngineBase::Class_Empty];
     const quint32_le *formalsIndices = compiledFunction->formalsTable();
@@ -115,6 +119,49 @@ void Function::updateInternalClass(ExecutionEngine *engine, const QList<QByteArr
         internalClass = internalClass->addMember(engine->identifierTable->identifier(compilationUnit->runtimeStrings[localsIndices[i]]), Attr_NotConfigurable);
 
     canUseSimpleCall = false;
+
+    // the JIT compiled version knows nothing about the new parameters
+    tierUpCandidate = false;
+    optimizedFunction = 0;
+}
+
+Function *Function::countCall(ExecutionEngine *engine)
+{
+    if (++callCount < engine->jitCallThreshold && backEdgeCount < engine->jitLoopThreshold)
+        return this;
+    return tierUp(engine);
+}
+
+Function *Function::tierUp(ExecutionEngine *engine)
+{
+    CompiledData::CompilationUnit *unit = compilationUnit;
+    if (!unit->optimizedUnit) {
+        if (engine->debugger()) {
+            unit->cancelTierUp();
+            unit->tierUpSource.reset();
+        }
+        if (unit->tierUpSource)
+            unit->startTierUp();
+        // keep interpreting until the JIT is done
+        if (unit->tierUpJob && !unit->finishTierUp())
+            return this;
+    }
+
+    // whatever happens below, this function won't be looked at again
+    tierUpCandidate = false;
+    if (!unit->optimizedUnit)
+        return this;
+
+    // both units were generated from the same source, so their functions line up
+    const int index = unit->runtimeFunctions.indexOf(this);
+    Function *optimized = unit->optimizedUnit->runtimeFunctions.value(index);
+    if (!optimized || optimized->nFormals != nFormals
+            || optimized->compiledFunction->nLocals != compiledFunction->nLocals
+            || optimized->canUseSimpleCall != canUseSimpleCall)
+        return this;
+
+    optimizedFunction = optimized;
+    return optimizedFunction;
 }
 
 QT_END_NAMESPACE
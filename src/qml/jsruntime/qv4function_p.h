@@ -72,6 +72,14 @@ struct Q_QML_EXPORT Function {
     bool hasQmlDependencies;
     bool canUseSimpleCall;
 
+    // Tiered execution: functions of units compiled by the interpreter count their calls
+    // and loop iterations, and are replaced by their JIT compiled version on the next
+    // entry once they got hot.
+    bool tierUpCandidate;
+    quint32 callCount;
+    quint32 backEdgeCount;
+    Function *optimizedFunction;
+
     Function(ExecutionEngine *engine, CompiledData::CompilationUnit *unit, const CompiledData::Function *function,
              ReturnedValue (*codePtr)(ExecutionEngine *, const uchar *));
     ~Function();
@@ -90,6 +98,18 @@ struct Q_QML_EXPORT Function {
 
     inline bool canUseSimpleFunction() const { return canUseSimpleCall; }
 
+    // returns the function to run when entering this one
+    inline Function *executableFunction(ExecutionEngine *engine)
+    {
+        if (optimizedFunction)
+            return optimizedFunction;
+        if (Q_LIKELY(!tierUpCandidate))
+            return this;
+        return countCall(engine);
+    }
+    Function *countCall(ExecutionEngine *engine);
+    Function *tierUp(ExecutionEngine *engine);
+
     QQmlSourceLocation sourceLocation() const
     {
         return QQmlSourceLocation(sourceFile(), compiledFunction->location.line, compiledFunction->location.column);
@@ -196,6 +196,8 @@ struct Value;
 template<size_t> struct HeapValue;
 template<size_t> struct ValueArray;
 struct Lookup;
+struct PolymorphicLookupCache;
+struct MegamorphicLookupCache;
 struct ArrayData;
 struct VTable;
 struct Function;
@@ -117,6 +117,51 @@ ReturnedValue Lookup::lookup(const Object *thisObject, PropertyAttributes *attrs
     return Primitive::emptyValue().asReturnedValue();
 }
 
+Lookup::State Lookup::state(uint type) const
+{
+    switch (type) {
+    case CompiledData::Lookup::Type_Getter:
+        if (getter == getterGeneric)
+            return Unresolved;
+        if (getter == getterFallback)
+            return Generic;
+        if (getter == getterPolymorphic)
+            return Polymorphic;
+        if (getter == getterMegamorphic)
+            return Megamorphic;
+        if (getter == getter0Inlinegetter0Inline || getter == getter0Inlinegetter0MemberData
+                || getter == getter0MemberDatagetter0MemberData || getter == getter0Inlinegetter1
+                || getter == getter0MemberDatagetter1 || getter == getter1getter1)
+            return TwoClasses;
+        return Monomorphic;
+    case CompiledData::Lookup::Type_Setter:
+        if (setter == setterGeneric)
+            return Unresolved;
+        if (setter == setterFallback)
+            return Generic;
+        if (setter == setterPolymorphic)
+            return Polymorphic;
+        if (setter == setterMegamorphic)
+            return Megamorphic;
+        if (setter == setter0setter0)
+            return TwoClasses;
+        return Monomorphic;
+    case CompiledData::Lookup::Type_GlobalGetter:
+        return globalGetter == globalGetterGeneric ? Unresolved : Monomorphic;
+    case CompiledData::Lookup::Type_IndexedGetter:
+        if (indexedGetter == indexedGetterGeneric)
+            return Unresolved;
+        return indexedGetter == indexedGetterFallback ? Generic : Monomorphic;
+    case CompiledData::Lookup::Type_IndexedSetter:
+        if (indexedSetter == indexedSetterGeneric)
+            return Unresolved;
+        return indexedSetter == indexedSetterFallback ? Generic : Monomorphic;
+    default:
+        Q_UNREACHABLE();
+        return Unresolved;
+    }
+}
+
 ReturnedValue Lookup::indexedGetterGeneric(Lookup *l, ExecutionEngine *engine, const Value &object, const Value &index)
 {
     uint idx;
@@ -129,7 +174,7 @@ ReturnedValue Lookup::indexedGetterGeneric(Lookup *l, ExecutionEngine *engine, c
 
 ReturnedValue Lookup::indexedGetterFallback(Lookup *l, ExecutionEngine *engine, const Value &object, const Value &index)
 {
-    Q_UNUSED(l);
+    countMiss(l, engine);
     Scope scope(engine);
     uint idx = 0;
     bool isInt = index.asArrayIndex(idx);
@@ -183,9 +228,12 @@ ReturnedValue Lookup::indexedGetterObjectInt(Lookup *l, ExecutionEngine *engine,
                 Heap::Object *o = static_cast<Heap::Object *>(b);
                 if (o->arrayData && o->arrayData->type == Heap::ArrayData::Simple) {
                     Heap::SimpleArrayData *s = o->arrayData.cast<Heap::SimpleArrayData>();
-                    if (idx < s->values.size)
-                        if (!s->data(idx).isEmpty())
+                    if (idx < s->values.size) {
+                        if (!s->data(idx).isEmpty()) {
+                            countHit(l, engine);
                             return s->data(idx).asReturnedValue();
+                        }
+                    }
                 }
             }
         }
@@ -207,8 +255,9 @@ void Lookup::indexedSetterGeneric(Lookup *l, ExecutionEngine *engine, const Valu
     indexedSetterFallback(l, engine, object, index, v);
 }
 
-void Lookup::indexedSetterFallback(Lookup *, ExecutionEngine *engine, const Value &object, const Value &index, const Value &value)
+void Lookup::indexedSetterFallback(Lookup *l, ExecutionEngine *engine, const Value &object, const Value &index, const Value &value)
 {
+    countMiss(l, engine);
     Scope scope(engine);
     ScopedObject o(scope, object.toObject(scope.engine));
     if (scope.engine->hasException)
@@ -241,6 +290,7 @@ void Lookup::indexedSetterObjectInt(Lookup *l, ExecutionEngine *engine, const Va
                 if (o->arrayData && o->arrayData->type == Heap::ArrayData::Simple) {
                     Heap::SimpleArrayData *s = o->arrayData.cast<Heap::SimpleArrayData>();
                     if (idx < s->values.size) {
+                        countHit(l, engine);
                         s->setData(engine, idx, v);
                         return;
                     }
@@ -251,8 +301,192 @@ void Lookup::indexedSetterObjectInt(Lookup *l, ExecutionEngine *engine, const Va
     indexedSetterFallback(l, engine, object, index, v);
 }
 
+static ReturnedValue fallbackGet(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    QV4::Scope scope(engine);
+    QV4::ScopedObject o(scope, object.toObject(scope.engine));
+    if (!o)
+        return Encode::undefined();
+    ScopedString name(scope, engine->current->compilationUnit->runtimeStrings[l->nameIndex]);
+    return o->get(name);
+}
+
+static void fallbackPut(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
+{
+    QV4::Scope scope(engine);
+    QV4::ScopedObject o(scope, object.toObject(scope.engine));
+    if (o) {
+        ScopedString name(scope, engine->current->compilationUnit->runtimeStrings[l->nameIndex]);
+        o->put(name, value);
+    }
+}
+
+// Returns the slot holding the property, or nullptr if the prototype changed its shape.
+static inline const Value *cachedPropertyData(const LookupCacheEntry &e, Heap::Object *o)
+{
+    switch (e.kind) {
+    case LookupCacheEntry::Inline:
+        return o->inlinePropertyData(e.index);
+    case LookupCacheEntry::MemberData:
+        return o->memberData->values.data() + e.index;
+    case LookupCacheEntry::Prototype: {
+        Heap::Object *p = o->prototype();
+        return p->internalClass == e.protoClass ? p->propertyData(e.index) : nullptr;
+    }
+    default:
+        return nullptr;
+    }
+}
+
+static inline void setCachedProperty(const LookupCacheEntry &e, ExecutionEngine *engine, Heap::Object *o, const Value &value)
+{
+    Q_ASSERT(e.writable && (e.kind == LookupCacheEntry::Inline || e.kind == LookupCacheEntry::MemberData));
+    if (e.kind == LookupCacheEntry::Inline)
+        o->setInlineProperty(engine, e.index, value);
+    else
+        o->setProperty(engine, e.index + o->vtable()->nInlineProperties, value);
+}
+
+// Resolves the property through Object::getLookup() on a copy of the lookup, and describes
+// the result in entry if it is a data property of the object or its prototype.
+static ReturnedValue resolveGetter(const Lookup *l, const Object *o, LookupCacheEntry *entry)
+{
+    Lookup resolved = *l;
+    resolved.getter = Lookup::getterGeneric;
+    ReturnedValue v = o->getLookup(&resolved);
+
+    entry->kind = LookupCacheEntry::Empty;
+    if (resolved.index == UINT_MAX)
+        return v;
+    InternalClass *c = resolved.classList[0];
+    if (resolved.getter == Lookup::getter0Inline) {
+        entry->kind = LookupCacheEntry::Inline;
+        entry->protoClass = nullptr;
+        entry->writable = c->propertyData.at(resolved.index).isWritable();
+    } else if (resolved.getter == Lookup::getter0MemberData) {
+        entry->kind = LookupCacheEntry::MemberData;
+        entry->protoClass = nullptr;
+        entry->writable = c->propertyData.at(resolved.index + c->vtable->nInlineProperties).isWritable();
+    } else if (resolved.getter == Lookup::getter1) {
+        entry->kind = LookupCacheEntry::Prototype;
+        entry->protoClass = resolved.classList[1];
+        entry->writable = false;
+    } else {
+        return v;
+    }
+    entry->objectClass = c;
+    entry->index = resolved.index;
+    return v;
+}
+
+static void addMegamorphicEntry(ExecutionEngine *engine, Identifier *id, const LookupCacheEntry &entry)
+{
+    if (!engine->megamorphicLookupCache)
+        engine->megamorphicLookupCache = new MegamorphicLookupCache;
+    MegamorphicLookupCache::Entry &e = engine->megamorphicLookupCache->entry(entry.objectClass, id);
+    static_cast<LookupCacheEntry &>(e) = entry;
+    e.identifier = id;
+}
+
+static const MegamorphicLookupCache::Entry *findMegamorphicEntry(ExecutionEngine *engine, InternalClass *c, Identifier *id)
+{
+    if (!engine->megamorphicLookupCache)
+        return nullptr;
+    const MegamorphicLookupCache::Entry &e = engine->megamorphicLookupCache->entry(c, id);
+    return (e.objectClass == c && e.identifier == id) ? &e : nullptr;
+}
+
+// Adds entry to the polymorphic cache of l, replacing an older one for the same class. Sites
+// that see more than PolymorphicLookupCache::Size classes become megamorphic. Returns false
+// if that happened.
+static bool addPolymorphicEntry(Lookup *l, ExecutionEngine *engine, const LookupCacheEntry &entry)
+{
+    PolymorphicLookupCache *cache = l->polymorphicCache;
+    for (uint i = 0; i < cache->nEntries; ++i) {
+        if (cache->entries[i].objectClass == entry.objectClass) {
+            cache->entries[i] = entry;
+            return true;
+        }
+    }
+    if (cache->nEntries < PolymorphicLookupCache::Size) {
+        cache->entries[cache->nEntries++] = entry;
+        return true;
+    }
+
+    l->identifier = engine->identifierTable->identifier(engine->current->compilationUnit->runtimeStrings[l->nameIndex]);
+    for (uint i = 0; i < cache->nEntries; ++i)
+        addMegamorphicEntry(engine, l->identifier, cache->entries[i]);
+    addMegamorphicEntry(engine, l->identifier, entry);
+    return false;
+}
+
+// The caches are owned by the compilation unit the lookup belongs to
+static PolymorphicLookupCache *newPolymorphicCache(ExecutionEngine *engine)
+{
+    PolymorphicLookupCache *cache = new PolymorphicLookupCache;
+    static_cast<CompiledData::CompilationUnit *>(engine->current->compilationUnit)->polymorphicLookupCaches.append(cache);
+    return cache;
+}
+
+static ReturnedValue polymorphicGetterMiss(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    countMiss(l, engine);
+    const Object *o = object.as<Object>();
+    if (!o)
+        return fallbackGet(l, engine, object);
+
+    LookupCacheEntry entry;
+    ReturnedValue v = resolveGetter(l, o, &entry);
+    // the lookup might have run a getter, which could have used this site as well
+    if (entry.kind != LookupCacheEntry::Empty && l->getter == Lookup::getterPolymorphic) {
+        if (!addPolymorphicEntry(l, engine, entry))
+            l->getter = Lookup::getterMegamorphic;
+    }
+    return v;
+}
+
+static ReturnedValue startPolymorphicGetter(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    l->polymorphicCache = newPolymorphicCache(engine);
+    l->getter = Lookup::getterPolymorphic;
+    return polymorphicGetterMiss(l, engine, object);
+}
+
+static void polymorphicSetterMiss(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
+{
+    countMiss(l, engine);
+    Object *o = object.as<Object>();
+    if (!o) {
+        fallbackPut(l, engine, object, value);
+        return;
+    }
+
+    Lookup resolved = *l;
+    resolved.setter = Lookup::setterGeneric;
+    o->setLookup(&resolved, value);
+    if (l->setter != Lookup::setterPolymorphic)
+        return;
+
+    LookupCacheEntry entry;
+    if (resolved.setter == Lookup::setter0Inline) {
+        entry.kind = LookupCacheEntry::Inline;
+        entry.index = resolved.index;
+    } else if (resolved.setter == Lookup::setter0) {
+        entry.kind = LookupCacheEntry::MemberData;
+        entry.index = resolved.index - resolved.classList[0]->vtable->nInlineProperties;
+    } else {
+        return;
+    }
+    entry.objectClass = resolved.classList[0];
+    entry.protoClass = nullptr;
+    entry.writable = true;
+    if (!addPolymorphicEntry(l, engine, entry))
+        l->setter = Lookup::setterMegamorphic;
+}
+
 ReturnedValue Lookup::getterGeneric(Lookup *l, ExecutionEngine *engine, const Value &object)
 {
+    countMiss(l, engine);
     if (const Object *o = object.as<Object>())
         return o->getLookup(l);
 
@@ -312,6 +546,7 @@ ReturnedValue Lookup::getterGeneric(Lookup *l, ExecutionEngine *engine, const Va
 
 ReturnedValue Lookup::getterTwoClasses(Lookup *l, ExecutionEngine *engine, const Value &object)
 {
+    countMiss(l, engine);
     Lookup l1 = *l;
 
     if (l1.getter == Lookup::getter0MemberData || l1.getter == Lookup::getter0Inline || l1.getter == Lookup::getter1) {
@@ -360,17 +595,13 @@ ReturnedValue Lookup::getterTwoClasses(Lookup *l, ExecutionEngine *engine, const
     }
 
     l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    return fallbackGet(l, engine, object);
 }
 
 ReturnedValue Lookup::getterFallback(Lookup *l, ExecutionEngine *engine, const Value &object)
 {
-    QV4::Scope scope(engine);
-    QV4::ScopedObject o(scope, object.toObject(scope.engine));
-    if (!o)
-        return Encode::undefined();
-    ScopedString name(scope, engine->current->compilationUnit->runtimeStrings[l->nameIndex]);
-    return o->get(name);
+    countMiss(l, engine);
+    return fallbackGet(l, engine, object);
 }
 
 ReturnedValue Lookup::getter0MemberData(Lookup *l, ExecutionEngine *engine, const Value &object)
@@ -379,8 +610,10 @@ ReturnedValue Lookup::getter0MemberData(Lookup *l, ExecutionEngine *engine, cons
     // the internal class won't match
     Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
     if (o) {
-        if (l->classList[0] == o->internalClass)
+        if (l->classList[0] == o->internalClass) {
+            countHit(l, engine);
             return o->memberData->values.data()[l->index].asReturnedValue();
+        }
     }
     return getterTwoClasses(l, engine, object);
 }
@@ -391,8 +624,10 @@ ReturnedValue Lookup::getter0Inline(Lookup *l, ExecutionEngine *engine, const Va
     // the internal class won't match
     Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
     if (o) {
-        if (l->classList[0] == o->internalClass)
+        if (l->classList[0] == o->internalClass) {
+            countHit(l, engine);
             return o->inlinePropertyData(l->index)->asReturnedValue();
+        }
     }
     return getterTwoClasses(l, engine, object);
 }
@@ -403,8 +638,10 @@ ReturnedValue Lookup::getter1(Lookup *l, ExecutionEngine *engine, const Value &o
     // the internal class won't match
     Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
     if (o) {
-        if (l->classList[0] == o->internalClass && l->classList[1] == l->proto->internalClass)
+        if (l->classList[0] == o->internalClass && l->classList[1] == l->proto->internalClass) {
+            countHit(l, engine);
             return l->proto->propertyData(l->index)->asReturnedValue();
+        }
     }
     return getterTwoClasses(l, engine, object);
 }
@@ -419,8 +656,10 @@ ReturnedValue Lookup::getter2(Lookup *l, ExecutionEngine *engine, const Value &o
             Q_ASSERT(l->proto == o->prototype());
             if (l->classList[1] == l->proto->internalClass) {
                 Heap::Object *p = l->proto->prototype();
-                if (l->classList[2] == p->internalClass)
+                if (l->classList[2] == p->internalClass) {
+                    countHit(l, engine);
                     return p->propertyData(l->index)->asReturnedValue();
+                }
             }
         }
     }
@@ -434,13 +673,16 @@ ReturnedValue Lookup::getter0Inlinegetter0Inline(Lookup *l, ExecutionEngine *eng
     // the internal class won't match
     Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
     if (o) {
-        if (l->classList[0] == o->internalClass)
+        if (l->classList[0] == o->internalClass) {
+            countHit(l, engine);
             return o->inlinePropertyData(l->index)->asReturnedValue();
-        if (l->classList[2] == o->internalClass)
+        }
+        if (l->classList[2] == o->internalClass) {
+            countHit(l, engine);
             return o->inlinePropertyData(l->index2)->asReturnedValue();
+        }
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    return startPolymorphicGetter(l, engine, object);
 }
 
 ReturnedValue Lookup::getter0Inlinegetter0MemberData(Lookup *l, ExecutionEngine *engine, const Value &object)
@@ -449,13 +691,16 @@ ReturnedValue Lookup::getter0Inlinegetter0MemberData(Lookup *l, ExecutionEngine
     // the internal class won't match
     Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
     if (o) {
-        if (l->classList[0] == o->internalClass)
+        if (l->classList[0] == o->internalClass) {
+            countHit(l, engine);
             return o->inlinePropertyData(l->index)->asReturnedValue();
-        if (l->classList[2] == o->internalClass)
+        }
+        if (l->classList[2] == o->internalClass) {
+            countHit(l, engine);
             return o->memberData->values.data()[l->index2].asReturnedValue();
+        }
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    return startPolymorphicGetter(l, engine, object);
 }
 
 ReturnedValue Lookup::getter0MemberDatagetter0MemberData(Lookup *l, ExecutionEngine *engine, const Value &object)
@@ -464,13 +709,16 @@ ReturnedValue Lookup::getter0MemberDatagetter0MemberData(Lookup *l, ExecutionEng
     // the internal class won't match
     Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
     if (o) {
-        if (l->classList[0] == o->internalClass)
+        if (l->classList[0] == o->internalClass) {
+            countHit(l, engine);
             return o->memberData->values.data()[l->index].asReturnedValue();
-        if (l->classList[2] == o->internalClass)
+        }
+        if (l->classList[2] == o->internalClass) {
+            countHit(l, engine);
             return o->memberData->values.data()[l->index2].asReturnedValue();
+        }
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    return startPolymorphicGetter(l, engine, object);
 }
 
 ReturnedValue Lookup::getter0Inlinegetter1(Lookup *l, ExecutionEngine *engine, const Value &object)
@@ -479,13 +727,16 @@ ReturnedValue Lookup::getter0Inlinegetter1(Lookup *l, ExecutionEngine *engine, c
     // the internal class won't match
     Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
     if (o) {
-        if (l->classList[0] == o->internalClass)
+        if (l->classList[0] == o->internalClass) {
+            countHit(l, engine);
             return o->inlinePropertyData(l->index)->asReturnedValue();
-        if (l->classList[2] == o->internalClass && l->classList[3] == o->prototype()->internalClass)
+        }
+        if (l->classList[2] == o->internalClass && l->classList[3] == o->prototype()->internalClass) {
+            countHit(l, engine);
             return o->prototype()->propertyData(l->index2)->asReturnedValue();
+        }
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    return startPolymorphicGetter(l, engine, object);
 }
 
 ReturnedValue Lookup::getter0MemberDatagetter1(Lookup *l, ExecutionEngine *engine, const Value &object)
@@ -494,13 +745,16 @@ ReturnedValue Lookup::getter0MemberDatagetter1(Lookup *l, ExecutionEngine *engin
     // the internal class won't match
     Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
     if (o) {
-        if (l->classList[0] == o->internalClass)
+        if (l->classList[0] == o->internalClass) {
+            countHit(l, engine);
             return o->memberData->values.data()[l->index].asReturnedValue();
-        if (l->classList[2] == o->internalClass && l->classList[3] == o->prototype()->internalClass)
+        }
+        if (l->classList[2] == o->internalClass && l->classList[3] == o->prototype()->internalClass) {
+            countHit(l, engine);
             return o->prototype()->propertyData(l->index2)->asReturnedValue();
+        }
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    return startPolymorphicGetter(l, engine, object);
 }
 
 ReturnedValue Lookup::getter1getter1(Lookup *l, ExecutionEngine *engine, const Value &object)
@@ -510,15 +764,62 @@ ReturnedValue Lookup::getter1getter1(Lookup *l, ExecutionEngine *engine, const V
     Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
     if (o) {
         if (l->classList[0] == o->internalClass &&
-            l->classList[1] == o->prototype()->internalClass)
+            l->classList[1] == o->prototype()->internalClass) {
+            countHit(l, engine);
             return o->prototype()->propertyData(l->index)->asReturnedValue();
+        }
         if (l->classList[2] == o->internalClass &&
-            l->classList[3] == o->prototype()->internalClass)
+            l->classList[3] == o->prototype()->internalClass) {
+            countHit(l, engine);
             return o->prototype()->propertyData(l->index2)->asReturnedValue();
-        return getterFallback(l, engine, object);
+        }
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    return startPolymorphicGetter(l, engine, object);
+}
+
+ReturnedValue Lookup::getterPolymorphic(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    // we can safely cast to a QV4::Object here. If object is actually a string,
+    // the internal class won't match
+    Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
+    if (o) {
+        const PolymorphicLookupCache *cache = l->polymorphicCache;
+        for (uint i = 0; i < cache->nEntries; ++i) {
+            if (cache->entries[i].objectClass != o->internalClass)
+                continue;
+            if (const Value *v = cachedPropertyData(cache->entries[i], o)) {
+                countHit(l, engine);
+                return v->asReturnedValue();
+            }
+            break;
+        }
+    }
+    return polymorphicGetterMiss(l, engine, object);
+}
+
+ReturnedValue Lookup::getterMegamorphic(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    // we can safely cast to a QV4::Object here. If object is actually a string,
+    // the internal class won't match
+    Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
+    if (o) {
+        if (const MegamorphicLookupCache::Entry *e = findMegamorphicEntry(engine, o->internalClass, l->identifier)) {
+            if (const Value *v = cachedPropertyData(*e, o)) {
+                countHit(l, engine);
+                return v->asReturnedValue();
+            }
+        }
+    }
+
+    countMiss(l, engine);
+    const Object *obj = object.as<Object>();
+    if (!obj)
+        return fallbackGet(l, engine, object);
+    LookupCacheEntry entry;
+    ReturnedValue v = resolveGetter(l, obj, &entry);
+    if (entry.kind != LookupCacheEntry::Empty)
+        addMegamorphicEntry(engine, l->identifier, entry);
+    return v;
 }
 
 
@@ -529,6 +830,7 @@ ReturnedValue Lookup::getterAccessor0(Lookup *l, ExecutionEngine *engine, const
     Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
     if (o) {
         if (l->classList[0] == o->internalClass) {
+            countHit(l, engine);
             Scope scope(o->internalClass->engine);
             ScopedFunctionObject getter(scope, o->propertyData(l->index + Object::GetterOffset));
             if (!getter)
@@ -552,6 +854,7 @@ ReturnedValue Lookup::getterAccessor1(Lookup *l, ExecutionEngine *engine, const
     if (o) {
         if (l->classList[0] == o->internalClass &&
             l->classList[1] == l->proto->internalClass) {
+            countHit(l, engine);
             Scope scope(o->internalClass->engine);
             ScopedFunctionObject getter(scope, o->prototype()->propertyData(l->index + Object::GetterOffset));
             if (!getter)
@@ -578,6 +881,7 @@ ReturnedValue Lookup::getterAccessor2(Lookup *l, ExecutionEngine *engine, const
             if (l->classList[1] == l->proto->internalClass) {
                 o = l->proto->prototype();
                 if (l->classList[2] == o->internalClass) {
+                    countHit(l, engine);
                     Scope scope(o->internalClass->engine);
                     ScopedFunctionObject getter(scope, o->propertyData(l->index + Object::GetterOffset));
                     if (!getter)
@@ -599,8 +903,10 @@ ReturnedValue Lookup::primitiveGetter0Inline(Lookup *l, ExecutionEngine *engine,
 {
     if (object.type() == l->type) {
         Heap::Object *o = l->proto;
-        if (l->classList[0] == o->internalClass)
+        if (l->classList[0] == o->internalClass) {
+            countHit(l, engine);
             return o->inlinePropertyData(l->index)->asReturnedValue();
+        }
     }
     l->getter = getterGeneric;
     return getterGeneric(l, engine, object);
@@ -610,8 +916,10 @@ ReturnedValue Lookup::primitiveGetter0MemberData(Lookup *l, ExecutionEngine *eng
 {
     if (object.type() == l->type) {
         Heap::Object *o = l->proto;
-        if (l->classList[0] == o->internalClass)
+        if (l->classList[0] == o->internalClass) {
+            countHit(l, engine);
             return o->memberData->values.data()[l->index].asReturnedValue();
+        }
     }
     l->getter = getterGeneric;
     return getterGeneric(l, engine, object);
@@ -622,8 +930,10 @@ ReturnedValue Lookup::primitiveGetter1(Lookup *l, ExecutionEngine *engine, const
     if (object.type() == l->type) {
         Heap::Object *o = l->proto;
         if (l->classList[0] == o->internalClass &&
-            l->classList[1] == o->prototype()->internalClass)
+            l->classList[1] == o->prototype()->internalClass) {
+            countHit(l, engine);
             return o->prototype()->propertyData(l->index)->asReturnedValue();
+        }
     }
     l->getter = getterGeneric;
     return getterGeneric(l, engine, object);
@@ -634,6 +944,7 @@ ReturnedValue Lookup::primitiveGetterAccessor0(Lookup *l, ExecutionEngine *engin
     if (object.type() == l->type) {
         Heap::Object *o = l->proto;
         if (l->classList[0] == o->internalClass) {
+            countHit(l, engine);
             Scope scope(o->internalClass->engine);
             ScopedFunctionObject getter(scope, o->propertyData(l->index + Object::GetterOffset));
             if (!getter)
@@ -655,6 +966,7 @@ ReturnedValue Lookup::primitiveGetterAccessor1(Lookup *l, ExecutionEngine *engin
         Heap::Object *o = l->proto;
         if (l->classList[0] == o->internalClass &&
             l->classList[1] == o->prototype()->internalClass) {
+            countHit(l, engine);
             Scope scope(o->internalClass->engine);
             ScopedFunctionObject getter(scope, o->prototype()->propertyData(l->index + Object::GetterOffset));
             if (!getter)
@@ -672,8 +984,10 @@ ReturnedValue Lookup::primitiveGetterAccessor1(Lookup *l, ExecutionEngine *engin
 
 ReturnedValue Lookup::stringLengthGetter(Lookup *l, ExecutionEngine *engine, const Value &object)
 {
-    if (const String *s = object.as<String>())
+    if (const String *s = object.as<String>()) {
+        countHit(l, engine);
         return Encode(s->d()->length());
+    }
 
     l->getter = getterGeneric;
     return getterGeneric(l, engine, object);
@@ -681,8 +995,10 @@ ReturnedValue Lookup::stringLengthGetter(Lookup *l, ExecutionEngine *engine, con
 
 ReturnedValue Lookup::arrayLengthGetter(Lookup *l, ExecutionEngine *engine, const Value &object)
 {
-    if (const ArrayObject *a = object.as<ArrayObject>())
+    if (const ArrayObject *a = object.as<ArrayObject>()) {
+        countHit(l, engine);
         return a->propertyData(Heap::ArrayObject::LengthPropertyIndex)->asReturnedValue();
+    }
 
     l->getter = getterGeneric;
     return getterGeneric(l, engine, object);
@@ -691,22 +1007,55 @@ ReturnedValue Lookup::arrayLengthGetter(Lookup *l, ExecutionEngine *engine, cons
 
 ReturnedValue Lookup::globalGetterGeneric(Lookup *l, ExecutionEngine *engine)
 {
+    countMiss(l, engine);
     Object *o = engine->globalObject;
+    Identifier *id = engine->identifierTable->identifier(engine->current->compilationUnit->runtimeStrings[l->nameIndex]);
+
+    // Other global lookups of the same name may already have resolved it for the current
+    // class of the global object
+    if (const MegamorphicLookupCache::Entry *e = findMegamorphicEntry(engine, o->internalClass(), id)) {
+        if (const Value *v = cachedPropertyData(*e, o->d())) {
+            l->classList[0] = e->objectClass;
+            l->classList[1] = e->protoClass;
+            l->index = e->index;
+            if (e->kind == LookupCacheEntry::Inline)
+                l->globalGetter = globalGetter0Inline;
+            else if (e->kind == LookupCacheEntry::MemberData)
+                l->globalGetter = globalGetter0MemberData;
+            else
+                l->globalGetter = globalGetter1;
+            return v->asReturnedValue();
+        }
+    }
+
     PropertyAttributes attrs;
     ReturnedValue v = l->lookup(o, &attrs);
     if (v != Primitive::emptyValue().asReturnedValue()) {
         if (attrs.isData()) {
+            LookupCacheEntry entry;
+            entry.objectClass = l->classList[0];
+            entry.protoClass = nullptr;
+            entry.writable = attrs.isWritable();
             if (l->level == 0) {
                 uint nInline = o->d()->vtable()->nInlineProperties;
-                if (l->index < nInline)
+                if (l->index < nInline) {
                     l->globalGetter = globalGetter0Inline;
-                else {
+                    entry.kind = LookupCacheEntry::Inline;
+                } else {
                     l->index -= nInline;
                     l->globalGetter = globalGetter0MemberData;
+                    entry.kind = LookupCacheEntry::MemberData;
                 }
-            } else if (l->level == 1)
+                entry.index = l->index;
+                addMegamorphicEntry(engine, id, entry);
+            } else if (l->level == 1) {
                 l->globalGetter = globalGetter1;
-            else if (l->level == 2)
+                entry.kind = LookupCacheEntry::Prototype;
+                entry.protoClass = l->classList[1];
+                entry.writable = false;
+                entry.index = l->index;
+                addMegamorphicEntry(engine, id, entry);
+            } else if (l->level == 2)
                 l->globalGetter = globalGetter2;
             return v;
         } else {
@@ -727,8 +1076,10 @@ ReturnedValue Lookup::globalGetterGeneric(Lookup *l, ExecutionEngine *engine)
 ReturnedValue Lookup::globalGetter0Inline(Lookup *l, ExecutionEngine *engine)
 {
     Object *o = engine->globalObject;
-    if (l->classList[0] == o->internalClass())
+    if (l->classList[0] == o->internalClass()) {
+        countHit(l, engine);
         return o->d()->inlinePropertyData(l->index)->asReturnedValue();
+    }
 
     l->globalGetter = globalGetterGeneric;
     return globalGetterGeneric(l, engine);
@@ -737,8 +1088,10 @@ ReturnedValue Lookup::globalGetter0Inline(Lookup *l, ExecutionEngine *engine)
 ReturnedValue Lookup::globalGetter0MemberData(Lookup *l, ExecutionEngine *engine)
 {
     Object *o = engine->globalObject;
-    if (l->classList[0] == o->internalClass())
+    if (l->classList[0] == o->internalClass()) {
+        countHit(l, engine);
         return o->d()->memberData->values.data()[l->index].asReturnedValue();
+    }
 
     l->globalGetter = globalGetterGeneric;
     return globalGetterGeneric(l, engine);
@@ -748,8 +1101,10 @@ ReturnedValue Lookup::globalGetter1(Lookup *l, ExecutionEngine *engine)
 {
     Object *o = engine->globalObject;
     if (l->classList[0] == o->internalClass() &&
-        l->classList[1] == o->prototype()->internalClass)
+        l->classList[1] == o->prototype()->internalClass) {
+        countHit(l, engine);
         return o->prototype()->propertyData(l->index)->asReturnedValue();
+    }
 
     l->globalGetter = globalGetterGeneric;
     return globalGetterGeneric(l, engine);
@@ -763,6 +1118,7 @@ ReturnedValue Lookup::globalGetter2(Lookup *l, ExecutionEngine *engine)
         if (l->classList[1] == o->internalClass) {
             o = o->prototype();
             if (l->classList[2] == o->internalClass) {
+                countHit(l, engine);
                 return o->prototype()->propertyData(l->index)->asReturnedValue();
             }
         }
@@ -775,6 +1131,7 @@ ReturnedValue Lookup::globalGetterAccessor0(Lookup *l, ExecutionEngine *engine)
 {
     Object *o = engine->globalObject;
     if (l->classList[0] == o->internalClass()) {
+        countHit(l, engine);
         Scope scope(o->engine());
         ScopedFunctionObject getter(scope, o->propertyData(l->index + Object::GetterOffset));
         if (!getter)
@@ -794,6 +1151,7 @@ ReturnedValue Lookup::globalGetterAccessor1(Lookup *l, ExecutionEngine *engine)
     Object *o = engine->globalObject;
     if (l->classList[0] == o->internalClass() &&
         l->classList[1] == o->prototype()->internalClass) {
+        countHit(l, engine);
         Scope scope(o->engine());
         ScopedFunctionObject getter(scope, o->prototype()->propertyData(l->index + Object::GetterOffset));
         if (!getter)
@@ -816,6 +1174,7 @@ ReturnedValue Lookup::globalGetterAccessor2(Lookup *l, ExecutionEngine *engine)
         if (l->classList[1] == o->internalClass) {
             o = o->prototype();
             if (l->classList[2] == o->internalClass) {
+                countHit(l, engine);
                 Scope scope(o->internalClass->engine);
                 ScopedFunctionObject getter(scope, o->propertyData(l->index + Object::GetterOffset));
                 if (!getter)
@@ -834,6 +1193,7 @@ ReturnedValue Lookup::globalGetterAccessor2(Lookup *l, ExecutionEngine *engine)
 
 void Lookup::setterGeneric(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
 {
+    countMiss(l, engine);
     Scope scope(engine);
     ScopedObject o(scope, object);
     if (!o) {
@@ -849,6 +1209,7 @@ void Lookup::setterGeneric(Lookup *l, ExecutionEngine *engine, Value &object, co
 
 void Lookup::setterTwoClasses(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
 {
+    countMiss(l, engine);
     Lookup l1 = *l;
 
     if (Object *o = object.as<Object>()) {
@@ -863,23 +1224,20 @@ void Lookup::setterTwoClasses(Lookup *l, ExecutionEngine *engine, Value &object,
     }
 
     l->setter = setterFallback;
-    setterFallback(l, engine, object, value);
+    fallbackPut(l, engine, object, value);
 }
 
 void Lookup::setterFallback(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
 {
-    QV4::Scope scope(engine);
-    QV4::ScopedObject o(scope, object.toObject(scope.engine));
-    if (o) {
-        ScopedString name(scope, engine->current->compilationUnit->runtimeStrings[l->nameIndex]);
-        o->put(name, value);
-    }
+    countMiss(l, engine);
+    fallbackPut(l, engine, object, value);
 }
 
 void Lookup::setter0(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
 {
     Object *o = static_cast<Object *>(object.managed());
     if (o && o->internalClass() == l->classList[0]) {
+        countHit(l, engine);
         o->setProperty(engine, l->index, value);
         return;
     }
@@ -891,6 +1249,7 @@ void Lookup::setter0Inline(Lookup *l, ExecutionEngine *engine, Value &object, co
 {
     Object *o = static_cast<Object *>(object.managed());
     if (o && o->internalClass() == l->classList[0]) {
+        countHit(l, engine);
         o->d()->setInlineProperty(engine, l->index, value);
         return;
     }
@@ -903,6 +1262,7 @@ void Lookup::setterInsert0(Lookup *l, ExecutionEngine *engine, Value &object, co
     Object *o = static_cast<Object *>(object.managed());
     if (o && o->internalClass() == l->classList[0]) {
         Q_ASSERT(!o->prototype());
+        countHit(l, engine);
         o->setInternalClass(l->classList[3]);
         o->setProperty(l->index, value);
         return;
@@ -920,6 +1280,7 @@ void Lookup::setterInsert1(Lookup *l, ExecutionEngine *engine, Value &object, co
         Q_ASSERT(p);
         if (p->internalClass == l->classList[1]) {
             Q_ASSERT(!p->prototype());
+            countHit(l, engine);
             o->setInternalClass(l->classList[3]);
             o->setProperty(l->index, value);
             return;
@@ -941,6 +1302,7 @@ void Lookup::setterInsert2(Lookup *l, ExecutionEngine *engine, Value &object, co
             Q_ASSERT(p);
             if (p->internalClass == l->classList[2]) {
                 Q_ASSERT(!p->prototype());
+                countHit(l, engine);
                 o->setInternalClass(l->classList[3]);
                 o->setProperty(l->index, value);
                 return;
@@ -957,18 +1319,73 @@ void Lookup::setter0setter0(Lookup *l, ExecutionEngine *engine, Value &object, c
     Object *o = static_cast<Object *>(object.managed());
     if (o) {
         if (o->internalClass() == l->classList[0]) {
+            countHit(l, engine);
             o->setProperty(l->index, value);
             return;
         }
         if (o->internalClass() == l->classList[1]) {
+            countHit(l, engine);
             o->setProperty(l->index2, value);
             return;
         }
     }
 
-    l->setter = setterFallback;
-    setterFallback(l, engine, object, value);
+    l->polymorphicCache = newPolymorphicCache(engine);
+    l->setter = setterPolymorphic;
+    polymorphicSetterMiss(l, engine, object, value);
+}
+
+void Lookup::setterPolymorphic(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
+{
+    Object *o = static_cast<Object *>(object.managed());
+    if (o) {
+        const PolymorphicLookupCache *cache = l->polymorphicCache;
+        for (uint i = 0; i < cache->nEntries; ++i) {
+            if (cache->entries[i].objectClass == o->internalClass()) {
+                countHit(l, engine);
+                setCachedProperty(cache->entries[i], engine, o->d(), value);
+                return;
+            }
+        }
+    }
+    polymorphicSetterMiss(l, engine, object, value);
+}
 
+void Lookup::setterMegamorphic(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
+{
+    Object *o = static_cast<Object *>(object.managed());
+    if (o) {
+        const MegamorphicLookupCache::Entry *e = findMegamorphicEntry(engine, o->internalClass(), l->identifier);
+        if (e && e->writable && e->kind != LookupCacheEntry::Prototype) {
+            countHit(l, engine);
+            setCachedProperty(*e, engine, o->d(), value);
+            return;
+        }
+    }
+
+    countMiss(l, engine);
+    Object *obj = object.as<Object>();
+    if (!obj) {
+        fallbackPut(l, engine, object, value);
+        return;
+    }
+    Lookup resolved = *l;
+    resolved.setter = setterGeneric;
+    obj->setLookup(&resolved, value);
+    LookupCacheEntry entry;
+    if (resolved.setter == setter0Inline) {
+        entry.kind = LookupCacheEntry::Inline;
+        entry.index = resolved.index;
+    } else if (resolved.setter == setter0) {
+        entry.kind = LookupCacheEntry::MemberData;
+        entry.index = resolved.index - resolved.classList[0]->vtable->nInlineProperties;
+    } else {
+        return;
+    }
+    entry.objectClass = resolved.classList[0];
+    entry.protoClass = nullptr;
+    entry.writable = true;
+    addMegamorphicEntry(engine, l->identifier, entry);
 }
 
 QT_END_NAMESPACE
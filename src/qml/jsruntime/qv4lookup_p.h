@@ -54,6 +54,7 @@
 #include "qv4runtime_p.h"
 #include "qv4engine_p.h"
 #include "qv4context_p.h"
+#include "qv4identifier_p.h"
 
 #if !defined(V4_BOOTSTRAP)
 #include "qv4object_p.h"
@@ -64,6 +65,47 @@ QT_BEGIN_NAMESPACE
 
 namespace QV4 {
 
+// Where a named property lives for objects of a given InternalClass: in the object itself
+// (inline or in its member data), or in its prototype as long as that still has protoClass.
+struct LookupCacheEntry {
+    enum Kind {
+        Empty,
+        Inline,
+        MemberData,
+        Prototype
+    };
+
+    InternalClass *objectClass;
+    InternalClass *protoClass;
+    uint index; // relative to the member data for MemberData
+    uint kind;
+    bool writable;
+};
+
+// Sites that saw more shapes than the two class getters handle keep up to Size of them
+// here. Owned by the compilation unit of the lookup.
+struct PolymorphicLookupCache {
+    enum { Size = 8 };
+    LookupCacheEntry entries[Size];
+    uint nEntries = 0;
+};
+
+// Once a site overflows its polymorphic cache it goes through this engine wide, direct mapped
+// cache keyed by (InternalClass, Identifier), which is shared by all such sites. Global
+// lookups consult it as well when the global object changed its shape.
+struct MegamorphicLookupCache {
+    enum { Size = 1024 };
+    struct Entry : LookupCacheEntry {
+        Identifier *identifier;
+    };
+    Entry entries[Size];
+
+    MegamorphicLookupCache() { memset(entries, 0, sizeof(entries)); }
+
+    Entry &entry(InternalClass *c, Identifier *id)
+    { return entries[((quintptr(c) >> 4) ^ id->hashValue) & (Size - 1)]; }
+};
+
 struct Lookup {
     enum { Size = 4 };
     union {
@@ -81,6 +123,10 @@ struct Lookup {
             void *dummy2;
             Heap::Object *proto;
         };
+        struct {
+            PolymorphicLookupCache *polymorphicCache;
+            Identifier *identifier; // set once megamorphic
+        };
     };
     union {
         int level;
@@ -90,6 +136,43 @@ struct Lookup {
     uint index;
     uint nameIndex;
 
+    // how often the cached path served the access, and how often the property had to be
+    // looked up the slow way, see ExecutionEngine::countLookups
+    uint hitCount;
+    uint missCount;
+
+    static void countHit(Lookup *l, ExecutionEngine *engine)
+    {
+#ifndef QT_NO_QML_DEBUGGER
+        if (Q_UNLIKELY(engine->countLookups))
+            ++l->hitCount;
+#else
+        Q_UNUSED(l);
+        Q_UNUSED(engine);
+#endif
+    }
+    static void countMiss(Lookup *l, ExecutionEngine *engine)
+    {
+#ifndef QT_NO_QML_DEBUGGER
+        if (Q_UNLIKELY(engine->countLookups))
+            ++l->missCount;
+#else
+        Q_UNUSED(l);
+        Q_UNUSED(engine);
+#endif
+    }
+
+    // What the lookup currently caches, derived from its handler
+    enum State {
+        Unresolved, // not run yet, or nothing could be cached so far
+        Monomorphic,
+        TwoClasses,
+        Polymorphic,
+        Megamorphic,
+        Generic // gave up caching
+    };
+    State state(uint type) const; // type is a CompiledData::Lookup::Type
+
     static ReturnedValue indexedGetterGeneric(Lookup *l, ExecutionEngine *engine, const Value &object, const Value &index);
     static ReturnedValue indexedGetterFallback(Lookup *l, ExecutionEngine *engine, const Value &object, const Value &index);
     static ReturnedValue indexedGetterObjectInt(Lookup *l, ExecutionEngine *engine, const Value &object, const Value &index);
@@ -101,6 +184,8 @@ struct Lookup {
     static ReturnedValue getterGeneric(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterTwoClasses(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterFallback(Lookup *l, ExecutionEngine *engine, const Value &object);
+    static ReturnedValue getterPolymorphic(Lookup *l, ExecutionEngine *engine, const Value &object);
+    static ReturnedValue getterMegamorphic(Lookup *l, ExecutionEngine *engine, const Value &object);
 
     static ReturnedValue getter0MemberData(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getter0Inline(Lookup *l, ExecutionEngine *engine, const Value &object);
@@ -136,6 +221,8 @@ struct Lookup {
     static void setterGeneric(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
     static void setterTwoClasses(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
     static void setterFallback(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
+    static void setterPolymorphic(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
+    static void setterMegamorphic(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
     static void setter0(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
     static void setter0Inline(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
     static void setterInsert0(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
@@ -40,6 +40,7 @@
 #include "qv4profiling_p.h"
 #include <private/qv4mm_p.h>
 #include <private/qv4string_p.h>
+#include <private/qv4lookup_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -69,6 +70,7 @@ Profiler::Profiler(QV4::ExecutionEngine *engine) : featuresEnabled(0), m_engine(
     static const int metatypes[] = {
         qRegisterMetaType<QVector<QV4::Profiling::FunctionCallProperties> >(),
         qRegisterMetaType<QVector<QV4::Profiling::MemoryAllocationProperties> >(),
+        qRegisterMetaType<QVector<QV4::Profiling::LookupProperties> >(),
         qRegisterMetaType<FunctionLocationHash>()
     };
     Q_UNUSED(metatypes);
@@ -77,7 +79,11 @@ Profiler::Profiler(QV4::ExecutionEngine *engine) : featuresEnabled(0), m_engine(
 
 void Profiler::stopProfiling()
 {
+    const bool reportLookups = featuresEnabled & (1 << FeatureLookups);
     featuresEnabled = 0;
+    m_engine->countLookups = false;
+    if (reportLookups)
+        emit lookupDataReady(lookupStatistics(m_engine, m_timer.nsecsElapsed()));
     reportData(true);
     m_sentLocations.clear();
 }
@@ -109,6 +115,8 @@ void Profiler::reportData(bool trackLocations)
         }
     }
 
+    if (featuresEnabled & (1 << FeatureLookups))
+        emit lookupDataReady(lookupStatistics(m_engine, m_timer.nsecsElapsed()));
     emit dataReady(locations, properties, m_memory_data);
     m_data.clear();
     m_memory_data.clear();
@@ -117,6 +125,11 @@ void Profiler::reportData(bool trackLocations)
 void Profiler::startProfiling(quint64 features)
 {
     if (featuresEnabled == 0) {
+        if (features & (1 << FeatureLookups)) {
+            resetLookupStatistics(m_engine);
+            m_engine->countLookups = true;
+        }
+
         if (features & (1 << FeatureMemoryAllocation)) {
             qint64 timestamp = m_timer.nsecsElapsed();
             MemoryAllocationProperties heap = {timestamp,
@@ -137,6 +150,53 @@ void Profiler::startProfiling(quint64 features)
     }
 }
 
+QVector<LookupProperties> Profiler::lookupStatistics(ExecutionEngine *engine, qint64 timestamp)
+{
+    QVector<LookupProperties> result;
+    for (const CompiledData::CompilationUnit *unit : qAsConst(engine->compilationUnits)) {
+        if (!unit->runtimeLookups)
+            continue;
+        const QString file = unit->fileName();
+        const CompiledData::Lookup *compiledLookups = unit->data->lookupTable();
+        for (uint i = 0; i < unit->data->lookupTableSize; ++i) {
+            const Lookup &l = unit->runtimeLookups[i];
+            if (l.hitCount == 0 && l.missCount == 0)
+                continue;
+            const CompiledData::Lookup &compiled = compiledLookups[i];
+            const uint type = compiled.type_and_flags;
+            const bool named = type != CompiledData::Lookup::Type_IndexedGetter
+                    && type != CompiledData::Lookup::Type_IndexedSetter;
+            LookupProperties props = {
+                timestamp,
+                int(type),
+                int(l.state(type)),
+                l.hitCount,
+                l.missCount,
+                named ? unit->runtimeStrings[compiled.nameIndex]->toQString() : QString(),
+                file,
+                int(compiled.location.line),
+                int(compiled.location.column),
+                unit->unitId,
+                int(i)
+            };
+            result.append(props);
+        }
+    }
+    return result;
+}
+
+void Profiler::resetLookupStatistics(ExecutionEngine *engine)
+{
+    for (CompiledData::CompilationUnit *unit : qAsConst(engine->compilationUnits)) {
+        if (!unit->runtimeLookups)
+            continue;
+        for (uint i = 0; i < unit->data->lookupTableSize; ++i) {
+            unit->runtimeLookups[i].hitCount = 0;
+            unit->runtimeLookups[i].missCount = 0;
+        }
+    }
+}
+
 } // namespace Profiling
 } // namespace QV4
 
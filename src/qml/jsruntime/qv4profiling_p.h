@@ -99,7 +99,8 @@ namespace Profiling {
 
 enum Features {
     FeatureFunctionCall,
-    FeatureMemoryAllocation
+    FeatureMemoryAllocation,
+    FeatureLookups
 };
 
 enum MemoryType {
@@ -139,6 +140,23 @@ struct MemoryAllocationProperties {
     MemoryType type;
 };
 
+// Snapshot of one property lookup site, see QV4::Lookup. Hits and misses are counted since
+// profiling of lookups started. QML bindings are compiled without fast lookups, so only
+// functions and scripts run as plain JavaScript show up here.
+struct LookupProperties {
+    qint64 timestamp;
+    int type;  // CompiledData::Lookup::Type
+    int state; // Lookup::State
+    quint32 hitCount;
+    quint32 missCount;
+    QString name; // empty for indexed lookups
+    QString file;
+    int line;
+    int column;
+    quint32 unit; // CompilationUnit::unitId, together with index identifies the site
+    int index;     // in the lookup table of the unit
+};
+
 class FunctionCall {
 public:
 
@@ -249,10 +267,17 @@ public:
     void reportData(bool trackLocations);
     void setTimer(const QElapsedTimer &timer) { m_timer = timer; }
 
+    // All lookup sites of the engine's compilation units that ran since their counters were
+    // last reset. Lookups only count while ExecutionEngine::countLookups is set, which
+    // startProfiling() does for FeatureLookups.
+    static QVector<LookupProperties> lookupStatistics(ExecutionEngine *engine, qint64 timestamp = 0);
+    static void resetLookupStatistics(ExecutionEngine *engine);
+
 signals:
     void dataReady(const QV4::Profiling::FunctionLocationHash &,
                    const QVector<QV4::Profiling::FunctionCallProperties> &,
                    const QVector<QV4::Profiling::MemoryAllocationProperties> &);
+    void lookupDataReady(const QVector<QV4::Profiling::LookupProperties> &);
 
 private:
     QV4::ExecutionEngine *m_engine;
@@ -296,6 +321,7 @@ public:
 
 Q_DECLARE_TYPEINFO(QV4::Profiling::MemoryAllocationProperties, Q_MOVABLE_TYPE);
 Q_DECLARE_TYPEINFO(QV4::Profiling::FunctionCallProperties, Q_MOVABLE_TYPE);
+Q_DECLARE_TYPEINFO(QV4::Profiling::LookupProperties, Q_MOVABLE_TYPE);
 Q_DECLARE_TYPEINFO(QV4::Profiling::FunctionCall, Q_MOVABLE_TYPE);
 Q_DECLARE_TYPEINFO(QV4::Profiling::FunctionLocation, Q_MOVABLE_TYPE);
 Q_DECLARE_TYPEINFO(QV4::Profiling::Profiler::SentMarker, Q_MOVABLE_TYPE);
@@ -304,6 +330,7 @@ QT_END_NAMESPACE
 Q_DECLARE_METATYPE(QV4::Profiling::FunctionLocationHash)
 Q_DECLARE_METATYPE(QVector<QV4::Profiling::FunctionCallProperties>)
 Q_DECLARE_METATYPE(QVector<QV4::Profiling::MemoryAllocationProperties>)
+Q_DECLARE_METATYPE(QVector<QV4::Profiling::LookupProperties>)
 
 #endif // QT_NO_QML_DEBUGGER
 
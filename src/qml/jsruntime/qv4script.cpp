@@ -131,11 +131,31 @@ void Script::parse()
         if (v4->hasException)
             return;
 
+        // With tiered execution the unit starts out in the interpreter, and is compiled again
+        // by the JIT when one of its functions gets hot. Not when debugging though, as that
+        // needs the debug mode code of the interpreter.
+        const bool interpreted = v4->interpreterFactory && !v4->debugger();
+        EvalISelFactory *factory = interpreted ? v4->interpreterFactory.data() : v4->iselFactory.data();
+        // The top level code runs once per script, so only units that declare functions can
+        // get hot. The others don't need to keep a copy of their source.
+        const bool tiered = interpreted && module.functions.size() > 1;
+
         QV4::Compiler::JSUnitGenerator jsGenerator(&module);
-        QScopedPointer<EvalInstructionSelection> isel(v4->iselFactory->create(QQmlEnginePrivate::get(v4), v4->executableAllocator, &module, &jsGenerator));
+        QScopedPointer<EvalInstructionSelection> isel(factory->create(QQmlEnginePrivate::get(v4), v4->executableAllocator, &module, &jsGenerator));
         if (inheritContext)
             isel->setUseFastLookups(false);
         compilationUnit = isel->compile();
+        if (tiered) {
+            CompiledData::CompilationUnit::TierUpSource *source = new CompiledData::CompilationUnit::TierUpSource;
+            source->sourceCode = sourceCode;
+            source->sourceFile = sourceFile;
+            source->line = line;
+            source->strictMode = strictMode;
+            source->parseAsBinding = parseAsBinding;
+            source->useFastLookups = !inheritContext;
+            source->inheritedLocals = inheritedLocals;
+            compilationUnit->tierUpSource.reset(source);
+        }
         vmFunction = compilationUnit->linkToEngine(v4);
     }
 
@@ -157,16 +177,17 @@ ReturnedValue Script::run()
     QV4::Scope valueScope(engine);
 
     if (qmlContext.isUndefined()) {
-        TemporaryAssignment<Function*> savedGlobalCode(engine->globalCode, vmFunction);
+        Function *function = vmFunction->executableFunction(engine);
+        TemporaryAssignment<Function*> savedGlobalCode(engine->globalCode, function);
 
         ExecutionContextSaver ctxSaver(valueScope);
         ContextStateSaver stateSaver(valueScope, scope);
-        scope->d()->strictMode = vmFunction->isStrict();
-        scope->d()->lookups = vmFunction->compilationUnit->runtimeLookups;
-        scope->d()->constantTable = vmFunction->compilationUnit->constants;
-        scope->d()->compilationUnit = vmFunction->compilationUnit;
+        scope->d()->strictMode = function->isStrict();
+        scope->d()->lookups = function->compilationUnit->runtimeLookups;
+        scope->d()->constantTable = function->compilationUnit->constants;
+        scope->d()->compilationUnit = function->compilationUnit;
 
-        return Q_V4_PROFILE(engine, vmFunction);
+        return Q_V4_PROFILE(engine, function);
     } else {
         Scoped<QmlContext> qml(valueScope, qmlContext.value());
         ScopedCallData callData(valueScope);
@@ -244,6 +265,39 @@ QQmlRefPointer<QV4::CompiledData::CompilationUnit> Script::precompile(IR::Module
     return isel->compile(/*generate unit data*/false);
 }
 
+// Called on a worker thread, so this must not touch the engine. The returned unit still needs
+// to be linked.
+QQmlRefPointer<CompiledData::CompilationUnit> Script::compileForTierUp(EvalISelFactory *iselFactory, ExecutableAllocator *executableAllocator,
+                                                                       const CompiledData::CompilationUnit::TierUpSource &source)
+{
+    using namespace QQmlJS;
+
+    QQmlJS::Engine ee;
+    Lexer lexer(&ee);
+    lexer.setCode(source.sourceCode, source.line, source.parseAsBinding);
+    Parser parser(&ee);
+    if (!parser.parseProgram())
+        return nullptr;
+
+    AST::Program *program = AST::cast<AST::Program *>(parser.rootNode());
+    if (!program)
+        return nullptr;
+
+    // The source compiled fine into the interpreter's unit already, so any error here
+    // just means we stay in the interpreter. Don't throw it into the engine.
+    IR::Module module(/*debugMode*/false);
+    Codegen cg(source.strictMode);
+    cg.generateFromProgram(source.sourceFile, source.sourceCode, program, &module, Codegen::EvalCode, source.inheritedLocals);
+    if (!cg.errors().isEmpty())
+        return nullptr;
+
+    QV4::Compiler::JSUnitGenerator jsGenerator(&module);
+    QScopedPointer<EvalInstructionSelection> isel(iselFactory->create(/*qmlEngine*/nullptr, executableAllocator, &module, &jsGenerator));
+    if (!source.useFastLookups)
+        isel->setUseFastLookups(false);
+    return isel->compile();
+}
+
 QV4::ReturnedValue Script::evaluate(ExecutionEngine *engine, const QString &script, QmlContext *qmlContext)
 {
     QV4::Scope scope(engine);
@@ -142,6 +142,9 @@ struct Q_QML_EXPORT Script {
     static QQmlRefPointer<CompiledData::CompilationUnit> precompile(IR::Module *module, Compiler::JSUnitGenerator *unitGenerator, ExecutionEngine *engine, const QUrl &url, const QString &source,
                                                                     QList<QQmlError> *reportedErrors = 0, QQmlJS::Directives *directivesCollector = 0);
 
+    static QQmlRefPointer<CompiledData::CompilationUnit> compileForTierUp(EvalISelFactory *iselFactory, ExecutableAllocator *executableAllocator,
+                                                                          const CompiledData::CompilationUnit::TierUpSource &source);
+
     static ReturnedValue evaluate(ExecutionEngine *engine, const QString &script, QmlContext *qmlContext);
 };
 
@@ -49,6 +49,8 @@
 #include <private/qv4sequenceobject_p.h>
 #include <private/qv4objectproto_p.h>
 #include <private/qv4qobjectwrapper_p.h>
+#include <private/qv4arraybuffer_p.h>
+#include <private/qv4typedarray_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -66,6 +68,8 @@ using namespace QV4;
 //    + Number
 //    + Date
 //    + RegExp
+//    + ArrayBuffer
+//    + TypedArray
 // <quint8 type><quint24 size><data>
 
 enum Type {
@@ -83,7 +87,10 @@ enum Type {
     WorkerDate,
     WorkerRegexp,
     WorkerListModel,
-    WorkerSequence
+    WorkerSequence,
+    WorkerArrayBuffer,
+    WorkerTransferredArrayBuffer,
+    WorkerTypedArray
 };
 
 static inline quint32 valueheader(Type type, quint32 size = 0)
@@ -146,7 +153,29 @@ static inline void *popPtr(const char *&data)
 // serialization/deserialization failures
 
 #define ALIGN(size) (((size) + 3) & ~3)
-void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine *engine)
+
+static void pushArrayBuffer(QByteArray &data, const char *bytes, quint32 length)
+{
+    reserve(data, 2 * sizeof(quint32) + ALIGN(length));
+    push(data, valueheader(WorkerArrayBuffer));
+    push(data, length);
+
+    int offset = data.size();
+    data.resize(data.size() + ALIGN(length));
+    memcpy(data.data() + offset, bytes, length);
+}
+
+struct Serialize::Transfer
+{
+    // The ArrayBuffers to transfer, a WorkerTransferredArrayBuffer refers to them by index
+    QVector<Heap::ArrayBuffer *> sources;
+
+    // The transferred contents and the ArrayBuffers that adopted them when deserializing
+    QVector<QByteArray> *buffers = nullptr;
+    Value *received = nullptr;
+};
+
+void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine *engine, Transfer *transfer)
 {
     QV4::Scope scope(engine);
 
@@ -189,7 +218,7 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         push(data, valueheader(WorkerArray, length));
         ScopedValue val(scope);
         for (uint ii = 0; ii < length; ++ii)
-            serialize(data, (val = array->getIndexed(ii)), engine);
+            serialize(data, (val = array->getIndexed(ii)), engine, transfer);
     } else if (v.isInteger()) {
         reserve(data, 2 * sizeof(quint32));
         push(data, valueheader(WorkerInt32));
@@ -225,6 +254,24 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         char *buffer = data.data() + offset;
 
         memcpy(buffer, pattern.constData(), length*sizeof(QChar));
+    } else if (const ArrayBuffer *buffer = v.as<ArrayBuffer>()) {
+        const int index = transfer->sources.indexOf(buffer->d());
+        if (index >= 0)
+            push(data, valueheader(WorkerTransferredArrayBuffer, index));
+        else
+            pushArrayBuffer(data, buffer->d()->data->data(), buffer->byteLength());
+    } else if (const TypedArray *array = v.as<TypedArray>()) {
+        // Only the range of a copied buffer that is covered by the array is sent
+        Heap::ArrayBuffer *buffer = array->d()->buffer;
+        const int index = transfer->sources.indexOf(buffer);
+        reserve(data, 3 * sizeof(quint32));
+        push(data, valueheader(WorkerTypedArray, array->arrayType()));
+        push(data, index >= 0 ? array->d()->byteOffset : 0u);
+        push(data, array->byteLength());
+        if (index >= 0)
+            push(data, valueheader(WorkerTransferredArrayBuffer, index));
+        else
+            pushArrayBuffer(data, buffer->data->data() + array->d()->byteOffset, array->byteLength());
     } else if (const QObjectWrapper *qobjectWrapper = v.as<QV4::QObjectWrapper>()) {
         // XXX TODO: Generalize passing objects between the main thread and worker scripts so
         // that others can trivially plug in their elements.
@@ -249,10 +296,10 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
             }
             reserve(data, sizeof(quint32) + length * sizeof(quint32));
             push(data, valueheader(WorkerSequence, length));
-            serialize(data, QV4::Primitive::fromInt32(QV4::SequencePrototype::metaTypeForSequence(o)), engine); // sequence type
+            serialize(data, QV4::Primitive::fromInt32(QV4::SequencePrototype::metaTypeForSequence(o)), engine, transfer); // sequence type
             ScopedValue val(scope);
             for (uint ii = 0; ii < seqLength; ++ii)
-                serialize(data, (val = o->getIndexed(ii)), engine); // sequence elements
+                serialize(data, (val = o->getIndexed(ii)), engine, transfer); // sequence elements
 
             return;
         }
@@ -270,14 +317,14 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         QV4::ScopedValue s(scope);
         for (quint32 ii = 0; ii < length; ++ii) {
             s = properties->getIndexed(ii);
-            serialize(data, s, engine);
+            serialize(data, s, engine, transfer);
 
             QV4::String *str = s->as<String>();
             val = o->get(str);
             if (scope.hasException())
                 scope.engine->catchException();
 
-            serialize(data, val, engine);
+            serialize(data, val, engine, transfer);
         }
         return;
     } else {
@@ -285,7 +332,7 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
     }
 }
 
-ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
+ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine, Transfer *transfer)
 {
     quint32 header = popUint32(data);
     Type type = headertype(header);
@@ -317,7 +364,7 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         ScopedArrayObject a(scope, engine->newArrayObject());
         ScopedValue v(scope);
         for (quint32 ii = 0; ii < size; ++ii) {
-            v = deserialize(data, engine);
+            v = deserialize(data, engine, transfer);
             a->putIndexed(ii, v);
         }
         return a.asReturnedValue();
@@ -330,8 +377,8 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         ScopedString n(scope);
         ScopedValue value(scope);
         for (quint32 ii = 0; ii < size; ++ii) {
-            name = deserialize(data, engine);
-            value = deserialize(data, engine);
+            name = deserialize(data, engine, transfer);
+            value = deserialize(data, engine, transfer);
             n = name->asReturnedValue();
             o->put(n, value);
         }
@@ -375,34 +422,104 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         bool succeeded = false;
         quint32 length = headersize(header);
         quint32 seqLength = length - 1;
-        value = deserialize(data, engine);
+        value = deserialize(data, engine, transfer);
         int sequenceType = value->integerValue();
         ScopedArrayObject array(scope, engine->newArrayObject());
         array->arrayReserve(seqLength);
         for (quint32 ii = 0; ii < seqLength; ++ii) {
-            value = deserialize(data, engine);
+            value = deserialize(data, engine, transfer);
             array->arrayPut(ii, value);
         }
         array->setArrayLengthUnchecked(seqLength);
         QVariant seqVariant = QV4::SequencePrototype::toVariant(array, sequenceType, &succeeded);
         return QV4::SequencePrototype::fromVariant(engine, seqVariant, &succeeded);
     }
+    case WorkerArrayBuffer:
+    {
+        quint32 length = popUint32(data);
+        Scoped<ArrayBuffer> buffer(scope, engine->newArrayBuffer(length));
+        if (buffer->d()->data)
+            memcpy(buffer->d()->data->data(), data, length);
+        data += ALIGN(length);
+        return buffer.asReturnedValue();
+    }
+    case WorkerTransferredArrayBuffer:
+    {
+        quint32 index = headersize(header);
+        if (!transfer->buffers || index >= quint32(transfer->buffers->size()))
+            return QV4::Encode::undefined();
+        Value &received = transfer->received[index];
+        if (received.isUndefined()) {
+            received = engine->newArrayBuffer(transfer->buffers->at(index))->asReturnedValue();
+            // Leave the new ArrayBuffer as the only owner, so that it is not copied on write
+            (*transfer->buffers)[index] = QByteArray();
+        }
+        return received.asReturnedValue();
+    }
+    case WorkerTypedArray:
+    {
+        quint32 type = headersize(header);
+        quint32 byteOffset = popUint32(data);
+        quint32 byteLength = popUint32(data);
+        Scoped<ArrayBuffer> buffer(scope, deserialize(data, engine, transfer));
+        if (!buffer || type >= Heap::TypedArray::NTypes
+                || byteOffset + byteLength > buffer->byteLength()) {
+            return QV4::Encode::undefined();
+        }
+        Scoped<TypedArray> array(scope, TypedArray::create(engine, Heap::TypedArray::Type(type)));
+        array->d()->buffer.set(engine, buffer->d());
+        array->d()->byteLength = byteLength;
+        array->d()->byteOffset = byteOffset;
+        return array.asReturnedValue();
+    }
     }
     Q_ASSERT(!"Unreachable");
     return QV4::Encode::undefined();
 }
 
-QByteArray Serialize::serialize(const QV4::Value &value, ExecutionEngine *engine)
+QByteArray Serialize::serialize(const QV4::Value &value, ExecutionEngine *engine,
+                                const Value &transferList, QVector<QByteArray> *buffers)
 {
+    Scope scope(engine);
+    Transfer transfer;
+    ScopedArrayObject list(scope, transferList);
+    if (buffers && !!list) {
+        Scoped<ArrayBuffer> buffer(scope);
+        const uint length = list->getLength();
+        for (uint ii = 0; ii < length; ++ii) {
+            buffer = list->getIndexed(ii);
+            if (!!buffer && !buffer->isNeutered() && !transfer.sources.contains(buffer->d()))
+                transfer.sources.append(buffer->d());
+        }
+    }
+
     QByteArray rv;
-    serialize(rv, value, engine);
+    serialize(rv, value, engine, &transfer);
+
+    // The buffers can only be given up once everything referring to them is written
+    if (!transfer.sources.isEmpty()) {
+        buffers->reserve(buffers->size() + transfer.sources.size());
+        Scoped<ArrayBuffer> buffer(scope);
+        for (Heap::ArrayBuffer *source : qAsConst(transfer.sources)) {
+            buffer = source;
+            buffers->append(buffer->transfer());
+        }
+    }
     return rv;
 }
 
-ReturnedValue Serialize::deserialize(const QByteArray &data, ExecutionEngine *engine)
+ReturnedValue Serialize::deserialize(const QByteArray &data, ExecutionEngine *engine,
+                                     QVector<QByteArray> *buffers)
 {
+    Scope scope(engine);
+    Transfer transfer;
+    if (buffers && !buffers->isEmpty()) {
+        transfer.buffers = buffers;
+        transfer.received = scope.alloc(buffers->size());
+    }
+
     const char *stream = data.constData();
-    return deserialize(stream, engine);
+    return deserialize(stream, engine, &transfer);
 }
 
 QT_END_NAMESPACE
@@ -52,6 +52,7 @@
 //
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qvector.h>
 #include <private/qv4value_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -61,12 +62,20 @@ namespace QV4 {
 class Serialize {
 public:
 
-    static QByteArray serialize(const Value &, ExecutionEngine *);
-    static ReturnedValue deserialize(const QByteArray &, ExecutionEngine *);
+    // The contents of the ArrayBuffers listed in transfer are moved to buffers
+    // instead of being copied, and the ArrayBuffers are left empty.
+    static QByteArray serialize(const Value &, ExecutionEngine *,
+                                const Value &transfer = Primitive::undefinedValue(),
+                                QVector<QByteArray> *buffers = nullptr);
+    // Adopts the transferred contents of buffers into new ArrayBuffers
+    static ReturnedValue deserialize(const QByteArray &, ExecutionEngine *,
+                                     QVector<QByteArray> *buffers = nullptr);
 
 private:
-    static void serialize(QByteArray &, const Value &, ExecutionEngine *);
-    static ReturnedValue deserialize(const char *&, ExecutionEngine *);
+    struct Transfer;
+
+    static void serialize(QByteArray &, const Value &, ExecutionEngine *, Transfer *);
+    static ReturnedValue deserialize(const char *&, ExecutionEngine *, Transfer *);
 };
 
 }
@@ -243,7 +243,7 @@ void TypedArrayCtor::construct(const Managed *m, Scope &scope, CallData *callDat
         Scoped<ArrayBuffer> buffer(scope, typedArray->d()->buffer);
         uint srcElementSize = typedArray->d()->type->bytesPerElement;
         uint destElementSize = operations[that->d()->type].bytesPerElement;
-        uint byteLength = typedArray->d()->byteLength;
+        uint byteLength = typedArray->byteLength();
         uint destByteLength = byteLength*destElementSize/srcElementSize;
 
         Scoped<ArrayBuffer> newBuffer(scope, scope.engine->newArrayBuffer(destByteLength));
@@ -450,7 +450,7 @@ void TypedArrayPrototype::method_get_byteLength(const BuiltinFunction *, Scope &
     if (!v)
         THROW_TYPE_ERROR();
 
-    scope.result = Encode(v->d()->byteLength);
+    scope.result = Encode(v->byteLength());
 }
 
 void TypedArrayPrototype::method_get_byteOffset(const BuiltinFunction *, Scope &scope, CallData *callData)
@@ -468,7 +468,7 @@ void TypedArrayPrototype::method_get_length(const BuiltinFunction *, Scope &scop
     if (!v)
         THROW_TYPE_ERROR();
 
-    scope.result = Encode(v->d()->byteLength/v->d()->type->bytesPerElement);
+    scope.result = Encode(v->length());
 }
 
 void TypedArrayPrototype::method_set(const BuiltinFunction *, Scope &scope, CallData *callData)
@@ -531,15 +531,15 @@ void TypedArrayPrototype::method_set(const BuiltinFunction *, Scope &scope, Call
     const char *src = srcBuffer->d()->data->data() + srcTypedArray->d()->byteOffset;
     if (srcTypedArray->d()->type == a->d()->type) {
         // same type of typed arrays, use memmove (as srcbuffer and buffer could be the same)
-        memmove(dest, src, srcTypedArray->d()->byteLength);
+        memmove(dest, src, srcTypedArray->byteLength());
         RETURN_UNDEFINED();
     }
 
     char *srcCopy = 0;
     if (buffer->d() == srcBuffer->d()) {
         // same buffer, need to take a temporary copy, to not run into problems
-        srcCopy = new char[srcTypedArray->d()->byteLength];
-        memcpy(srcCopy, src, srcTypedArray->d()->byteLength);
+        srcCopy = new char[srcTypedArray->byteLength()];
+        memcpy(srcCopy, src, srcTypedArray->byteLength());
         src = srcCopy;
     }
 
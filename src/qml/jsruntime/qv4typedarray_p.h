@@ -118,11 +118,11 @@ struct Q_QML_PRIVATE_EXPORT TypedArray : Object
     static Heap::TypedArray *create(QV4::ExecutionEngine *e, Heap::TypedArray::Type t);
 
     uint byteLength() const {
-        return d()->byteLength;
+        return d()->buffer->neutered ? 0 : d()->byteLength;
     }
 
     uint length() const {
-        return d()->byteLength/d()->type->bytesPerElement;
+        return byteLength()/d()->type->bytesPerElement;
     }
 
     QTypedArrayData<char> *arrayData() {
@@ -362,6 +362,10 @@ Param traceParam(const Param &param)
     if (engine->hasException) \
         goto catchException
 
+#define COUNT_BACK_EDGE(offset) \
+    if (offset < 0 && tierUpFunction) \
+        ++tierUpFunction->backEdgeCount;
+
 QV4::ReturnedValue VME::run(ExecutionEngine *engine, const uchar *code)
 {
 #ifdef DO_TRACE_INSTR
@@ -429,6 +433,17 @@ QV4::ReturnedValue VME::run(ExecutionEngine *engine, const uchar *code)
         }
     }
 
+    // Loop iterations are counted for tiered execution, see Function::executableFunction().
+    // Eval code runs in the context of its caller, but must not make the caller hot. It is not
+    // counted at all, as it is never entered again and tiering up only affects the next entry.
+    QV4::Function *tierUpFunction = 0;
+    {
+        QV4::Heap::ExecutionContext *ctx = engine->current;
+        QV4::Function *function = ctx->type >= QV4::Heap::ExecutionContext::Type_SimpleCallContext
+                ? static_cast<QV4::Heap::SimpleCallContext *>(ctx)->v4Function : engine->globalCode;
+        if (function && function->tierUpCandidate && function->codeData == code)
+            tierUpFunction = function;
+    }
 
     for (;;) {
         const Instr *genericInstr = reinterpret_cast<const Instr *>(code);
@@ -791,21 +806,26 @@ QV4::ReturnedValue VME::run(ExecutionEngine *engine, const uchar *code)
     MOTH_END_INSTR(ConstructGlobalLookup)
 
     MOTH_BEGIN_INSTR(Jump)
+        COUNT_BACK_EDGE(instr.offset)
         code = ((const uchar *)&instr.offset) + instr.offset;
     MOTH_END_INSTR(Jump)
 
     MOTH_BEGIN_INSTR(JumpEq)
         bool cond = VALUEPTR(instr.condition)->toBoolean();
         TRACE(condition, "%s", cond ? "TRUE" : "FALSE");
-        if (cond)
+        if (cond) {
+            COUNT_BACK_EDGE(instr.offset)
             code = ((const uchar *)&instr.offset) + instr.offset;
+        }
     MOTH_END_INSTR(JumpEq)
 
     MOTH_BEGIN_INSTR(JumpNe)
         bool cond = VALUEPTR(instr.condition)->toBoolean();
         TRACE(condition, "%s", cond ? "TRUE" : "FALSE");
-        if (!cond)
+        if (!cond) {
+            COUNT_BACK_EDGE(instr.offset)
             code = ((const uchar *)&instr.offset) + instr.offset;
+        }
     MOTH_END_INSTR(JumpNe)
 
     MOTH_BEGIN_INSTR(UNot)
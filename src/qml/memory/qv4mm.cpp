@@ -53,6 +53,10 @@
 #include <QElapsedTimer>
 #include <QMap>
 #include <QScopedValueRollback>
+#ifndef QT_NO_THREAD
+#include <QThreadPool>
+#endif
+#include <private/qqmlpooledjob_p.h>
 
 #include <iostream>
 #include <cstdlib>
@@ -99,7 +103,11 @@ namespace QV4 {
 
 enum {
     MinSlotsGCLimit = QV4::Chunk::AvailableSlots*16,
-    GCOverallocation = 200 /* Max overallocation by the GC in % */
+    GCOverallocation = 200, /* Max overallocation by the GC in % */
+    IncrementalSliceAllocations = 1024, /* Allocations between two incremental mark slices */
+    OldGenerationGrowth = 2, /* Growth of the old generation that triggers a full GC */
+    DefaultIncrementalSliceTime = 1000, /* in us */
+    IdleGCFillLevel = 75 /* Usage of the heap in % above which idle time is used to collect */
 };
 
 struct MemorySegment {
@@ -348,7 +356,7 @@ static void increaseFreedCountForClass(const char *className)
     (*freedObjectStatsGlobal())[className]++;
 }
 
-bool Chunk::sweep(ClassDestroyStatsCallback classCountPtr)
+bool Chunk::sweep(ClassDestroyStatsCallback classCountPtr, bool destructorsDone)
 {
     bool hasUsedSlots = false;
     SDUMP() << "sweeping chunk" << this;
@@ -384,6 +392,9 @@ bool Chunk::sweep(ClassDestroyStatsCallback classCountPtr)
             result |= mask; // ensure we don't clear stuff to the right of the current object
             e &= result;
 
+            if (destructorsDone)
+                continue;
+
             HeapItem *itemToFree = o + index;
             Heap::Base *b = *itemToFree;
             const VTable *v = b->vtable();
@@ -408,6 +419,26 @@ bool Chunk::sweep(ClassDestroyStatsCallback classCountPtr)
     return hasUsedSlots;
 }
 
+void Chunk::runDestructors()
+{
+    HeapItem *o = realBase();
+    for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
+        quintptr toFree = objectBitmap[i] ^ blackBitmap[i];
+        while (toFree) {
+            uint index = qCountTrailingZeroBits(toFree);
+            toFree ^= (static_cast<quintptr>(1) << index);
+
+            Heap::Base *b = *(o + index);
+            const VTable *v = b->vtable();
+            if (v->destroy) {
+                v->destroy(b);
+                b->_checkIsDestroyed();
+            }
+        }
+        o += Chunk::Bits;
+    }
+}
+
 void Chunk::freeAll()
 {
     //    DEBUG << "sweeping chunk" << this << (*freeList);
@@ -490,7 +521,9 @@ void Chunk::collectGrayItems(MarkStack *markStack)
 
 }
 
-void Chunk::sortIntoBins(HeapItem **bins, uint nBins)
+// With usedBefore, only slots that were used before and are free now are sorted into the bins.
+// The others are expected to be on the free lists already.
+void Chunk::sortIntoBins(HeapItem **bins, uint nBins, HeapItem **tails, const quintptr *usedBefore)
 {
 //    qDebug() << "sortIntoBins:";
     HeapItem *base = realBase();
@@ -505,6 +538,8 @@ void Chunk::sortIntoBins(HeapItem **bins, uint nBins)
 #endif
     for (int i = start; i < EntriesInBitmap; ++i) {
         quintptr usedSlots = (objectBitmap[i]|extendsBitmap[i]);
+        if (usedBefore)
+            usedSlots |= ~usedBefore[i];
 #if QT_POINTER_SIZE == 8
         if (!i)
             usedSlots |= (static_cast<quintptr>(1) << (HeaderSize/SlotSize)) - 1;
@@ -526,6 +561,8 @@ void Chunk::sortIntoBins(HeapItem **bins, uint nBins)
                     break;
                 }
                 usedSlots = (objectBitmap[i]|extendsBitmap[i]);
+                if (usedBefore)
+                    usedSlots |= ~usedBefore[i];
 #ifdef MM_STATS
                 allocatedSlots += qPopulationCount(usedSlots);
 //                qDebug() << hex << "   i=" << i << "used=" << usedSlots;
@@ -544,6 +581,8 @@ void Chunk::sortIntoBins(HeapItem **bins, uint nBins)
             Q_ASSERT(freeEnd > freeStart && freeEnd <= NumSlots);
             freeItem->freeData.availableSlots = nSlots;
             uint bin = qMin(nBins - 1, nSlots);
+            if (tails && !bins[bin])
+                tails[bin] = freeItem;
             freeItem->freeData.next = bins[bin];
             bins[bin] = freeItem;
         }
@@ -609,6 +648,7 @@ HeapItem *BlockAllocator::allocate(size_t size, bool forceAllocation) {
 
     HeapItem *m;
 
+retry:
     if (slotsRequired < NumBins - 1) {
         m = freeBins[slotsRequired];
         if (m) {
@@ -678,6 +718,9 @@ HeapItem *BlockAllocator::allocate(size_t size, bool forceAllocation) {
     }
 
     if (!m) {
+        // Each adoption takes over at least one more chunk, so this ends once all are swept
+        if (sweepJob && adoptSweptChunks())
+            goto retry;
         if (!forceAllocation)
             return 0;
         Chunk *newChunk = chunkAllocator->allocate();
@@ -690,6 +733,14 @@ HeapItem *BlockAllocator::allocate(size_t size, bool forceAllocation) {
     }
 
 done:
+    slotsAllocatedSinceLastSweep += slotsRequired;
+    if (trackYoungChunks) {
+        Chunk *c = m->chunk();
+        if (c != lastYoungChunk) {
+            youngChunks.insert(c);
+            lastYoungChunk = c;
+        }
+    }
     m->setAllocatedSlots(slotsRequired);
     //        DEBUG << "   " << hex << m->chunk() << m->chunk()->objectBitmap[0] << m->chunk()->extendsBitmap[0] << (m - m->chunk()->realBase());
     return m;
@@ -697,12 +748,17 @@ done:
 
 void BlockAllocator::sweep(ClassDestroyStatsCallback classCountPtr)
 {
+    finishConcurrentSweep();
+
     nextFree = 0;
     nFree = 0;
     memset(freeBins, 0, sizeof(freeBins));
 
 //    qDebug() << "BlockAlloc: sweep";
     usedSlotsAfterLastSweep = 0;
+    slotsAllocatedSinceLastSweep = 0;
+    youngChunks.clear();
+    lastYoungChunk = nullptr;
 
     auto isFree = [this, classCountPtr] (Chunk *c) {
         bool isUsed = c->sweep(classCountPtr);
@@ -720,8 +776,190 @@ void BlockAllocator::sweep(ClassDestroyStatsCallback classCountPtr)
     chunks.erase(newEnd, chunks.end());
 }
 
+void BlockAllocator::setTrackYoungChunks(bool track)
+{
+    trackYoungChunks = track;
+    youngChunks.clear();
+    lastYoungChunk = nullptr;
+    // nothing has been marked with the sticky mark bits yet
+    if (track) {
+        for (auto c : chunks)
+            youngChunks.insert(c);
+    }
+}
+
+void BlockAllocator::sweepYoungChunks()
+{
+    Q_ASSERT(!sweepJob);
+
+    size_t freedSlots = 0;
+    quintptr usedBefore[Chunk::EntriesInBitmap];
+    for (Chunk *c : qAsConst(youngChunks)) {
+        for (uint i = 0; i < Chunk::EntriesInBitmap; ++i)
+            usedBefore[i] = c->objectBitmap[i] | c->extendsBitmap[i];
+        const uint usedSlotsBefore = c->nUsedSlots();
+        c->sweep(nullptr);
+        // The free lists and the bump allocation area still point into the memory that was
+        // free before, so empty chunks are only released by a full sweep.
+        c->sortIntoBins(freeBins, NumBins, nullptr, usedBefore);
+        freedSlots += usedSlotsBefore - c->nUsedSlots();
+    }
+    usedSlotsAfterLastSweep = usedSlotsAfterLastSweep + slotsAllocatedSinceLastSweep - freedSlots;
+    slotsAllocatedSinceLastSweep = 0;
+    youngChunks.clear();
+    lastYoungChunk = nullptr;
+}
+
+struct SweptChunk {
+    Chunk *chunk = nullptr;
+    HeapItem *bins[BlockAllocator::NumBins];
+    HeapItem *tails[BlockAllocator::NumBins];
+    uint usedSlots = 0;
+    bool isUsed = false;
+    QAtomicInt done;
+};
+
+struct SweepJob : public QQmlPooledJob
+{
+    SweepJob(const std::vector<Chunk *> &toSweep)
+        : chunks(toSweep.size())
+    {
+        for (size_t i = 0; i < toSweep.size(); ++i)
+            chunks[i].chunk = toSweep[i];
+    }
+
+    void execute() override
+    {
+        while (sweepNext())
+            ;
+    }
+
+    // Can be called from the worker and the engine thread. Only touches the bitmaps and the
+    // free memory of the chunk, the destructors have been run before the job got started.
+    bool sweepNext()
+    {
+        const uint i = nextToSweep.fetchAndAddRelaxed(1);
+        if (i >= chunks.size())
+            return false;
+        SweptChunk &s = chunks[i];
+        memset(s.bins, 0, sizeof(s.bins));
+        memset(s.tails, 0, sizeof(s.tails));
+        s.isUsed = s.chunk->sweep(nullptr, /*destructorsDone*/ true);
+        s.chunk->resetBlackBits();
+        if (s.isUsed) {
+            s.chunk->sortIntoBins(s.bins, BlockAllocator::NumBins, s.tails);
+            s.usedSlots = s.chunk->nUsedSlots();
+        }
+        s.done.storeRelease(1);
+        return true;
+    }
+
+    std::vector<SweptChunk> chunks;
+    QAtomicInteger<uint> nextToSweep;
+    uint nextToAdopt = 0; // only accessed from the engine thread
+};
+
+#ifndef QT_NO_THREAD
+Q_GLOBAL_STATIC(QThreadPool, sweepThreadPool)
+#else
+static QThreadPool *sweepThreadPool() { return nullptr; }
+#endif
+
+void BlockAllocator::startConcurrentSweep()
+{
+    Q_ASSERT(!sweepJob);
+
+    nextFree = 0;
+    nFree = 0;
+    memset(freeBins, 0, sizeof(freeBins));
+    usedSlotsAfterLastSweep = 0;
+    slotsAllocatedSinceLastSweep = 0;
+    youngChunks.clear();
+    lastYoungChunk = nullptr;
+
+    // Destructors need to run on the engine thread, and before the memory of their object can
+    // get reused.
+    for (auto c : chunks)
+        c->runDestructors();
+
+    sweepJob = new SweepJob(chunks);
+    sweepJob->start(sweepThreadPool());
+}
+
+bool BlockAllocator::adoptFinishedChunks()
+{
+    bool gotMemory = false;
+    std::vector<Chunk *> emptyChunks;
+    while (sweepJob->nextToAdopt < sweepJob->chunks.size()) {
+        SweptChunk &s = sweepJob->chunks[sweepJob->nextToAdopt];
+        if (!s.done.loadAcquire())
+            break;
+        ++sweepJob->nextToAdopt;
+
+        if (!s.isUsed) {
+            emptyChunks.push_back(s.chunk);
+            continue;
+        }
+        usedSlotsAfterLastSweep += s.usedSlots;
+        for (uint i = 0; i < NumBins; ++i) {
+            if (!s.bins[i])
+                continue;
+            s.tails[i]->freeData.next = freeBins[i];
+            freeBins[i] = s.bins[i];
+            gotMemory = true;
+        }
+    }
+
+    if (!emptyChunks.empty()) {
+        std::sort(emptyChunks.begin(), emptyChunks.end());
+        auto isEmpty = [&emptyChunks] (Chunk *c) {
+            return std::binary_search(emptyChunks.begin(), emptyChunks.end(), c);
+        };
+        chunks.erase(std::remove_if(chunks.begin(), chunks.end(), isEmpty), chunks.end());
+        for (auto c : emptyChunks)
+            chunkAllocator->free(c);
+    }
+    return gotMemory;
+}
+
+bool BlockAllocator::adoptSweptChunks()
+{
+    Q_ASSERT(sweepJob);
+
+    // Don't wait for the worker, sweep the next chunk ourselves if nothing is ready yet
+    if (sweepJob->nextToAdopt < sweepJob->chunks.size()
+            && !sweepJob->chunks[sweepJob->nextToAdopt].done.loadAcquire())
+        sweepJob->sweepNext();
+
+    bool gotMemory = adoptFinishedChunks();
+
+    if (sweepJob->nextToAdopt == sweepJob->chunks.size()) {
+        // All chunks are swept, the worker only needs to let go of the job
+        sweepJob->cancel();
+        delete sweepJob;
+        sweepJob = nullptr;
+    }
+    return gotMemory;
+}
+
+void BlockAllocator::finishConcurrentSweep()
+{
+    if (!sweepJob)
+        return;
+
+    while (sweepJob->sweepNext())
+        ;
+    sweepJob->cancel();
+    adoptFinishedChunks();
+    Q_ASSERT(sweepJob->nextToAdopt == sweepJob->chunks.size());
+    delete sweepJob;
+    sweepJob = nullptr;
+}
+
 void BlockAllocator::freeAll()
 {
+    finishConcurrentSweep();
+
     for (auto c : chunks) {
         c->freeAll();
         chunkAllocator->free(c);
@@ -730,6 +968,9 @@ void BlockAllocator::freeAll()
 
 void BlockAllocator::resetBlackBits()
 {
+    // the sweep job resets the black bits of the chunks it sweeps
+    if (sweepJob)
+        return;
     for (auto c : chunks)
         c->resetBlackBits();
 }
@@ -809,8 +1050,10 @@ void HugeItemAllocator::sweep(ClassDestroyStatsCallback classCountPtr)
 
 void HugeItemAllocator::resetBlackBits()
 {
-    for (auto c : chunks)
+    for (auto c : chunks) {
         Chunk::clearBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase());
+        Chunk::clearBit(c.chunk->grayBitmap, c.chunk->first() - c.chunk->realBase());
+    }
 }
 
 void HugeItemAllocator::collectGrayItems(MarkStack *markStack)
@@ -821,7 +1064,8 @@ void HugeItemAllocator::collectGrayItems(MarkStack *markStack)
             Chunk::testBit(c.chunk->grayBitmap, c.chunk->first() - c.chunk->realBase())) {
             HeapItem *i = c.chunk->first();
             Heap::Base *b = *i;
-            b->mark(markStack);
+            Chunk::clearBit(c.chunk->grayBitmap, i - c.chunk->realBase());
+            markStack->push(b);
         }
 }
 
@@ -844,7 +1088,19 @@ MemoryManager::MemoryManager(ExecutionEngine *engine)
     , unmanagedHeapSizeGCLimit(MIN_UNMANAGED_HEAPSIZE_GC_LIMIT)
     , aggressiveGC(!qEnvironmentVariableIsEmpty("QV4_MM_AGGRESSIVE_GC"))
     , gcStats(!qEnvironmentVariableIsEmpty(QV4_MM_STATS))
+    , incrementalGC(!qEnvironmentVariableIsEmpty(QV4_MM_INCREMENTAL))
+    , concurrentSweep(!qEnvironmentVariableIsEmpty(QV4_MM_CONCURRENT_SWEEP))
+    , generationalGC(!qEnvironmentVariableIsEmpty(QV4_MM_GENERATIONAL))
 {
+    // the remembered set of the generational GC is fed by the write barrier
+    engine->writeBarrierActive = generationalGC;
+    blockAllocator.setTrackYoungChunks(generationalGC);
+
+    bool ok = false;
+    incrementalGCSliceTime = qEnvironmentVariableIntValue(QV4_MM_INCREMENTAL_SLICE, &ok);
+    if (!ok || incrementalGCSliceTime <= 0)
+        incrementalGCSliceTime = DefaultIncrementalSliceTime;
+
 #ifdef V4_USE_VALGRIND
     VALGRIND_CREATE_MEMPOOL(this, 0, true);
 #endif
@@ -867,6 +1123,9 @@ Heap::Base *MemoryManager::allocString(std::size_t unmanagedSize)
     if (aggressiveGC) {
         runGC();
         didGCRun = true;
+    } else if (Q_UNLIKELY(m_markStack) && ++allocationsSinceLastSlice >= IncrementalSliceAllocations) {
+        incrementalGCStep();
+        didGCRun = true;
     }
 
     unmanagedHeapSize += unmanagedSize;
@@ -886,9 +1145,10 @@ Heap::Base *MemoryManager::allocString(std::size_t unmanagedSize)
     HeapItem *m = blockAllocator.allocate(stringSize);
     if (!m) {
         if (!didGCRun && shouldRunGC())
-            runGC();
+            runAllocationTriggeredGC();
         m = blockAllocator.allocate(stringSize, true);
     }
+    colorNewItem(m);
 
 //    qDebug() << "allocated string" << m;
     memset(m, 0, stringSize);
@@ -906,6 +1166,9 @@ Heap::Base *MemoryManager::allocData(std::size_t size)
     if (aggressiveGC) {
         runGC();
         didRunGC = true;
+    } else if (Q_UNLIKELY(m_markStack) && ++allocationsSinceLastSlice >= IncrementalSliceAllocations) {
+        incrementalGCStep();
+        didRunGC = true;
     }
 #ifdef DETAILED_MM_STATS
     willAllocate(size);
@@ -918,6 +1181,7 @@ Heap::Base *MemoryManager::allocData(std::size_t size)
 
     if (size > Chunk::DataSize) {
         HeapItem *h = hugeItemAllocator.allocate(size);
+        colorNewItem(h);
 //        qDebug() << "allocating huge item" << h;
         return *h;
     }
@@ -925,9 +1189,10 @@ Heap::Base *MemoryManager::allocData(std::size_t size)
     HeapItem *m = blockAllocator.allocate(size);
     if (!m) {
         if (!didRunGC && shouldRunGC())
-            runGC();
+            runAllocationTriggeredGC();
         m = blockAllocator.allocate(size, true);
     }
+    colorNewItem(m);
 
     memset(m, 0, size);
 //    qDebug() << "allocating data" << m;
@@ -950,7 +1215,9 @@ Heap::Object *MemoryManager::allocObjectWithMemberData(const QV4::VTable *vtable
         Heap::MemberData *m;
         if (totalSize > Chunk::DataSize) {
             o = static_cast<Heap::Object *>(allocData(size));
-            m = hugeItemAllocator.allocate(memberSize)->as<Heap::MemberData>();
+            HeapItem *mh = hugeItemAllocator.allocate(memberSize);
+            colorNewItem(mh);
+            m = mh->as<Heap::MemberData>();
         } else {
             HeapItem *mh = reinterpret_cast<HeapItem *>(allocData(totalSize));
             Heap::Base *b = *mh;
@@ -961,6 +1228,7 @@ Heap::Object *MemoryManager::allocObjectWithMemberData(const QV4::VTable *vtable
             size_t index = mh - c->realBase();
             Chunk::setBit(c->objectBitmap, index);
             Chunk::clearBit(c->extendsBitmap, index);
+            colorNewItem(mh);
         }
         o->memberData.set(engine, m);
         m->internalClass = engine->internalClasses[EngineBase::Class_MemberData];
@@ -994,6 +1262,21 @@ void MarkStack::drain()
     }
 }
 
+bool MarkStack::drain(const QElapsedTimer &timer, qint64 budgetNSecs)
+{
+    uint n = 0;
+    while (top > base) {
+        Heap::Base *h = pop();
+        ++markStackSize;
+        Q_ASSERT(h);
+        h->markChildren(this);
+        // checking the time is comparatively expensive, only do it every now and then
+        if (!(++n & 0x3f) && timer.nsecsElapsed() >= budgetNSecs)
+            return top == base;
+    }
+    return true;
+}
+
 void MemoryManager::collectRoots(MarkStack *markStack)
 {
     engine->markObjects(markStack);
@@ -1039,8 +1322,52 @@ void MemoryManager::collectRoots(MarkStack *markStack)
     }
 }
 
+void MemoryManager::startIncrementalMark()
+{
+    Q_ASSERT(!m_markStack);
+    blockAllocator.finishConcurrentSweep();
+    markStackSize = 0;
+    incrementalSlices = 0;
+
+    // old objects need to be traced again during a full collection
+    if (generationalGC) {
+        blockAllocator.resetBlackBits();
+        hugeItemAllocator.resetBlackBits();
+    }
+
+    m_markStack = new MarkStack(engine);
+    // from here on, writes into black objects need to set them back to gray
+    engine->writeBarrierActive = true;
+    collectRoots(m_markStack);
+}
+
+void MemoryManager::abortIncrementalMark()
+{
+    if (!m_markStack)
+        return;
+    delete m_markStack;
+    m_markStack = nullptr;
+    engine->writeBarrierActive = generationalGC;
+    blockAllocator.resetBlackBits();
+    hugeItemAllocator.resetBlackBits();
+}
+
 void MemoryManager::mark()
 {
+    if (m_markStack) {
+        // Finish an incremental mark atomically: the roots might have changed since they were
+        // collected, and objects written to after they got marked have their gray bit set.
+        // Rescan both, and drain the stack completely.
+        engine->writeBarrierActive = generationalGC;
+        collectRoots(m_markStack);
+        blockAllocator.collectGrayItems(m_markStack);
+        hugeItemAllocator.collectGrayItems(m_markStack);
+        m_markStack->drain();
+        delete m_markStack;
+        m_markStack = nullptr;
+        return;
+    }
+
     markStackSize = 0;
 
     MarkStack markStack(engine);
@@ -1049,7 +1376,7 @@ void MemoryManager::mark()
     markStack.drain();
 }
 
-void MemoryManager::sweep(bool lastSweep, ClassDestroyStatsCallback classCountPtr)
+void MemoryManager::sweepWeakValues(bool lastSweep)
 {
     for (PersistentValueStorage::Iterator it = m_weakValues->begin(); it != m_weakValues->end(); ++it) {
         Managed *m = (*it).managed();
@@ -1095,19 +1422,56 @@ void MemoryManager::sweep(bool lastSweep, ClassDestroyStatsCallback classCountPt
                 ++it;
         }
     }
+}
 
-    blockAllocator.sweep(classCountPtr);
+void MemoryManager::sweep(bool lastSweep, ClassDestroyStatsCallback classCountPtr)
+{
+    sweepWeakValues(lastSweep);
+
+    // Statistics and the checks done by the aggressive GC need the heap to be fully swept.
+    // With the generational GC the write barrier is always active, and it can't set gray
+    // bits while the worker thread clears them.
+    if (concurrentSweep && !generationalGC && !lastSweep && !classCountPtr && !aggressiveGC)
+        blockAllocator.startConcurrentSweep();
+    else
+        blockAllocator.sweep(classCountPtr);
     hugeItemAllocator.sweep(classCountPtr);
 }
 
+void MemoryManager::sweepYoungGeneration()
+{
+    sweepWeakValues(false);
+    blockAllocator.sweepYoungChunks();
+    hugeItemAllocator.sweep(nullptr);
+}
+
 bool MemoryManager::shouldRunGC() const
 {
+    // the allocator picks up the memory of the chunks that are still being swept first
+    if (blockAllocator.isSweeping())
+        return false;
     size_t total = blockAllocator.totalSlots();
-    if (total > MinSlotsGCLimit && usedSlotsAfterLastFullSweep * GCOverallocation < total * 100)
+    if (total > MinSlotsGCLimit && blockAllocator.usedSlotsAfterLastSweep * GCOverallocation < total * 100)
         return true;
     return false;
 }
 
+bool MemoryManager::shouldRunIdleGC() const
+{
+    if (unmanagedHeapSize * 4 > unmanagedHeapSizeGCLimit * 3)
+        return true;
+    // Allocations trigger a collection once the heap is full, so collect a bit earlier
+    // A sweep still in progress means we just collected. Otherwise use the slot counters, so
+    // that idle time doesn't go into walking the bitmaps of every chunk.
+    if (blockAllocator.isSweeping())
+        return false;
+    size_t total = blockAllocator.totalSlots();
+    if (total <= MinSlotsGCLimit)
+        return false;
+    size_t used = blockAllocator.usedSlotsAfterLastSweep + blockAllocator.slotsAllocatedSinceLastSweep;
+    return used * 100 > total * IdleGCFillLevel;
+}
+
 size_t dumpBins(BlockAllocator *b, bool printOutput = true)
 {
     size_t totalSlotMem = 0;
@@ -1136,6 +1500,75 @@ size_t dumpBins(BlockAllocator *b, bool printOutput = true)
     return totalSlotMem*Chunk::SlotSize;
 }
 
+void GCPauseHistogram::record(qint64 nsecs)
+{
+    const qint64 us = nsecs/1000;
+    uint bucket = 0;
+    for (qint64 ms = us/1000; ms && bucket < NumBuckets - 1; ms >>= 1)
+        ++bucket;
+    ++buckets[bucket];
+    ++nPauses;
+    maxPause = qMax(maxPause, us);
+    totalPauseTime += us;
+}
+
+void GCPauseHistogram::dump() const
+{
+    qDebug() << "GC pause times:" << nPauses << "pauses," << totalPauseTime << "us in total, longest" << maxPause << "us";
+    for (uint i = 0; i < NumBuckets; ++i) {
+        if (!buckets[i])
+            continue;
+        if (i == 0)
+            qDebug() << "    < 1 ms:" << buckets[i];
+        else if (i == NumBuckets - 1)
+            qDebug().nospace() << "    >= " << (1 << (i - 1)) << " ms: " << buckets[i];
+        else
+            qDebug().nospace() << "    " << (1 << (i - 1)) << " - " << (1 << i) << " ms: " << buckets[i];
+    }
+}
+
+void MemoryManager::setIncrementalGC(bool enabled)
+{
+    if (incrementalGC == enabled)
+        return;
+    incrementalGC = enabled;
+    if (!enabled && m_markStack)
+        runGC();
+}
+
+void MemoryManager::incrementalGCStep(qint64 budgetUs)
+{
+    if (gcBlocked)
+        return;
+
+    if (!incrementalGC) {
+        runGC();
+        return;
+    }
+
+    if (budgetUs < 0)
+        budgetUs = incrementalGCSliceTime;
+    allocationsSinceLastSlice = 0;
+
+    QElapsedTimer t;
+    t.start();
+    bool markingDone;
+    {
+        QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
+        if (!m_markStack)
+            startIncrementalMark();
+        ++incrementalSlices;
+        markingDone = m_markStack->drain(t, budgetUs*1000);
+    }
+
+    // The final part of the mark phase and the sweep need to happen in one go
+    if (markingDone)
+        collectGarbage();
+    pauseHistogram.record(t.nsecsElapsed());
+    if (markingDone && gcStats)
+        pauseHistogram.dump();
+}
+
 void MemoryManager::runGC()
 {
     if (gcBlocked) {
@@ -1143,9 +1576,31 @@ void MemoryManager::runGC()
         return;
     }
 
+    QElapsedTimer t;
+    t.start();
+    collectGarbage();
+    const qint64 elapsed = t.nsecsElapsed();
+    lastFullGCTime = elapsed/1000;
+    pauseHistogram.record(elapsed);
+    if (gcStats)
+        pauseHistogram.dump();
+}
+
+void MemoryManager::collectGarbage()
+{
     QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
 //    qDebug() << "runGC";
 
+    // marking needs the bitmaps of all chunks
+    blockAllocator.finishConcurrentSweep();
+
+    // With the generational GC, mark bits are kept after a collection to tag old objects.
+    // A full collection needs to trace them again.
+    if (generationalGC && !m_markStack) {
+        blockAllocator.resetBlackBits();
+        hugeItemAllocator.resetBlackBits();
+    }
+
     if (!gcStats) {
 //        uint oldUsed = allocator.usedMem();
         mark();
@@ -1153,6 +1608,7 @@ void MemoryManager::runGC()
 //        DEBUG << "RUN GC: allocated:" << allocator.allocatedMem() << "used before" << oldUsed << "used now" << allocator.usedMem();
     } else {
         bool triggeredByUnmanagedHeap = (unmanagedHeapSize > unmanagedHeapSizeGCLimit);
+        const bool finishesIncrementalMark = (m_markStack != nullptr);
         size_t oldUnmanagedSize = unmanagedHeapSize;
         const size_t totalMem = getAllocatedMem();
         const size_t usedBefore = getUsedMem();
@@ -1190,8 +1646,13 @@ void MemoryManager::runGC()
             qDebug() << "   unmanaged heap limit:" << unmanagedHeapSizeGCLimit;
         }
         size_t memInBins = dumpBins(&blockAllocator);
-        qDebug() << "Marked object in" << markTime << "us.";
-        qDebug() << "   " << markStackSize << "objects marked";
+        if (finishesIncrementalMark) {
+            qDebug() << "Finished incremental mark in" << markTime << "us after" << incrementalSlices << "slices.";
+            qDebug() << "   " << markStackSize << "objects marked during the whole cycle";
+        } else {
+            qDebug() << "Marked object in" << markTime << "us.";
+            qDebug() << "   " << markStackSize << "objects marked";
+        }
         qDebug() << "Sweeped object in" << sweepTime << "us.";
 
         // sort our object types by number of freed instances
@@ -1232,15 +1693,127 @@ void MemoryManager::runGC()
         Q_ASSERT(blockAllocator.allocatedMem() == getUsedMem() + dumpBins(&blockAllocator, false));
     }
 
-    usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep;
+    if (generationalGC) {
+        // everything that survived is old now
+        oldGenerationLimit = qMax(std::size_t(MinSlotsGCLimit), OldGenerationGrowth*blockAllocator.usedSlotsAfterLastSweep);
+        minorGCsSinceLastMajorGC = 0;
+    } else {
+        // reset all black bits
+        blockAllocator.resetBlackBits();
+        hugeItemAllocator.resetBlackBits();
+    }
+}
+
+void MemoryManager::setGenerationalGC(bool enabled)
+{
+    if (generationalGC == enabled)
+        return;
+    // finish any running cycle with the old settings first
+    if (m_markStack)
+        runGC();
+    // The sweeper thread clears the gray bitmaps, which the write barrier sets from here on
+    blockAllocator.finishConcurrentSweep();
+    generationalGC = enabled;
+    engine->writeBarrierActive = enabled;
+    blockAllocator.setTrackYoungChunks(enabled);
+    if (!enabled) {
+        // forget about old objects and the remembered set
+        blockAllocator.resetBlackBits();
+        hugeItemAllocator.resetBlackBits();
+        for (auto c : blockAllocator.chunks)
+            memset(c->grayBitmap, 0, sizeof(c->grayBitmap));
+    }
+}
 
-    // reset all black bits
-    blockAllocator.resetBlackBits();
-    hugeItemAllocator.resetBlackBits();
+void MemoryManager::runAllocationTriggeredGC()
+{
+    if (generationalGC && !m_markStack && blockAllocator.usedSlotsAfterLastSweep < oldGenerationLimit)
+        runMinorGC();
+    else if (incrementalGC)
+        incrementalGCStep();
+    else
+        runGC();
+}
+
+void MemoryManager::runMinorGC()
+{
+    if (gcBlocked)
+        return;
+    if (!generationalGC || m_markStack) {
+        runGC();
+        return;
+    }
+
+    QElapsedTimer t;
+    t.start();
+    const size_t usedBefore = gcStats ? getUsedMem() : 0;
+    {
+        QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
+
+        markStackSize = 0;
+        MarkStack markStack(engine);
+        // Old objects are black already, so marking stops at them. Young objects that are only
+        // referenced from old ones are found through the remembered set.
+        collectRoots(&markStack);
+        blockAllocator.collectGrayItems(&markStack);
+        hugeItemAllocator.collectGrayItems(&markStack);
+        markStack.drain();
+
+        sweepYoungGeneration();
+        ++minorGCsSinceLastMajorGC;
+    }
+    const qint64 elapsed = t.nsecsElapsed();
+    lastMinorGCTime = elapsed/1000;
+    pauseHistogram.record(elapsed);
+
+    if (gcStats) {
+        qDebug() << "========== Minor GC ==========";
+        qDebug() << "Marked" << markStackSize << "young objects";
+        qDebug() << "Used memory before GC:" << usedBefore;
+        qDebug() << "Used memory after GC:" << getUsedMem();
+        qDebug() << "Minor GCs since last full GC:" << minorGCsSinceLastMajorGC;
+        pauseHistogram.dump();
+        qDebug() << "======== End Minor GC ========";
+    }
+}
+
+bool MemoryManager::collectDuringIdleTime(qint64 budgetUs)
+{
+    if (gcBlocked || budgetUs == 0)
+        return false;
+
+    // help the sweeper thread, but don't block on it
+    if (blockAllocator.isSweeping()) {
+        blockAllocator.adoptSweptChunks();
+        return true;
+    }
+
+    const bool unbounded = budgetUs < 0;
+    if (m_markStack) {
+        incrementalGCStep(unbounded ? incrementalGCSliceTime : budgetUs);
+        return true;
+    }
+
+    if (!shouldRunIdleGC())
+        return false;
+
+    if (generationalGC && blockAllocator.usedSlotsAfterLastSweep < oldGenerationLimit) {
+        if (!unbounded && lastMinorGCTime > budgetUs)
+            return false;
+        runMinorGC();
+    } else if (unbounded || lastFullGCTime <= budgetUs) {
+        runGC();
+    } else if (incrementalGC) {
+        incrementalGCStep(budgetUs);
+    } else {
+        return false;
+    }
+    return true;
 }
 
-size_t MemoryManager::getUsedMem() const
+size_t MemoryManager::getUsedMem()
 {
+    blockAllocator.finishConcurrentSweep();
     return blockAllocator.usedMem();
 }
 
@@ -1256,6 +1829,7 @@ size_t MemoryManager::getLargeItemsMem() const
 
 MemoryManager::~MemoryManager()
 {
+    abortIncrementalMark();
     delete m_persistentValues;
 
     sweep(/*lastSweep*/true);
@@ -57,12 +57,17 @@
 #include <private/qv4object_p.h>
 #include <private/qv4mmdefs_p.h>
 #include <QVector>
+#include <QSet>
 
 //#define DETAILED_MM_STATS
 
 #define QV4_MM_MAXBLOCK_SHIFT "QV4_MM_MAXBLOCK_SHIFT"
 #define QV4_MM_MAX_CHUNK_SIZE "QV4_MM_MAX_CHUNK_SIZE"
 #define QV4_MM_STATS "QV4_MM_STATS"
+#define QV4_MM_INCREMENTAL "QV4_MM_INCREMENTAL"
+#define QV4_MM_INCREMENTAL_SLICE "QV4_MM_INCREMENTAL_SLICE"
+#define QV4_MM_CONCURRENT_SWEEP "QV4_MM_CONCURRENT_SWEEP"
+#define QV4_MM_GENERATIONAL "QV4_MM_GENERATIONAL"
 
 #define MM_DEBUG 0
 
@@ -71,6 +76,7 @@ QT_BEGIN_NAMESPACE
 namespace QV4 {
 
 struct ChunkAllocator;
+struct SweepJob;
 
 template<typename T>
 struct StackAllocator {
@@ -158,16 +164,37 @@ struct BlockAllocator {
     void resetBlackBits();
     void collectGrayItems(MarkStack *markStack);
 
+    // Concurrent sweeping. Destructors of unmarked objects are run right away, then a worker
+    // thread clears the bitmaps and builds the free lists chunk by chunk. Swept chunks are
+    // picked up by allocate() as they become available.
+    void startConcurrentSweep();
+    bool adoptSweptChunks();
+    void finishConcurrentSweep();
+    bool isSweeping() const { return sweepJob != nullptr; }
+
+    // Generational GC. Old objects keep their black bit, so only chunks that received new
+    // objects since the last sweep can contain anything to free during a minor collection.
+    void setTrackYoungChunks(bool track);
+    void sweepYoungChunks();
+
     // bump allocations
     HeapItem *nextFree = 0;
     size_t nFree = 0;
     size_t usedSlotsAfterLastSweep = 0;
+    size_t slotsAllocatedSinceLastSweep = 0;
     HeapItem *freeBins[NumBins];
     ChunkAllocator *chunkAllocator;
     std::vector<Chunk *> chunks;
+    SweepJob *sweepJob = nullptr;
+    QSet<Chunk *> youngChunks;
+    Chunk *lastYoungChunk = nullptr;
+    bool trackYoungChunks = false;
 #if MM_DEBUG
     uint allocations[NumBins];
 #endif
+
+private:
+    bool adoptFinishedChunks();
 };
 
 struct HugeItemAllocator {
@@ -197,6 +224,20 @@ struct HugeItemAllocator {
     std::vector<HugeChunk> chunks;
 };
 
+struct GCPauseHistogram {
+    // bucket 0 counts pauses below 1ms, bucket n pauses between 2^(n-1) and 2^n ms,
+    // the last bucket everything above
+    enum { NumBuckets = 8 };
+
+    void record(qint64 nsecs);
+    void dump() const;
+    void reset() { *this = GCPauseHistogram(); }
+
+    uint buckets[NumBuckets] = {};
+    uint nPauses = 0;
+    qint64 maxPause = 0; // in us
+    qint64 totalPauseTime = 0; // in us
+};
 
 class Q_QML_EXPORT MemoryManager
 {
@@ -436,9 +477,35 @@ public:
 
     void runGC();
 
+    // Incremental marking. When enabled, collections triggered by allocations don't stop
+    // the world for the complete mark phase. Instead the mark stack is drained in time
+    // slices of at most incrementalGCSliceTime microseconds, while a Steele write barrier
+    // records changes to objects that have already been marked. Finishing the mark phase
+    // and sweeping happen atomically in the last slice.
+    void setIncrementalGC(bool enabled);
+    bool isIncrementalGCEnabled() const { return incrementalGC; }
+    bool isMarkingInProgress() const { return m_markStack != nullptr; }
+    void incrementalGCStep(qint64 budgetUs = -1);
+
+    // Generational collection. Objects that survived a collection keep their mark bit and are
+    // considered old. Minor collections only trace the young objects reachable from the roots
+    // and from the remembered set: old objects that the write barrier grayed since the last
+    // collection. Explicit calls to runGC() and the incremental GC always collect everything.
+    void setGenerationalGC(bool enabled);
+    bool isGenerationalGCEnabled() const { return generationalGC; }
+    void runMinorGC();
+
+    // Idle time collection. Embedders that know when the engine's thread has nothing to do,
+    // like the Qt Quick render loops between two frames, hand the remaining time to the memory
+    // manager. It is used to advance a running incremental mark, or to collect ahead of time
+    // when the heap is about to trigger an allocation driven collection anyway. A negative
+    // budget means the thread is idle without any deadline. Returns true if work was done.
+    bool collectDuringIdleTime(qint64 budgetUs);
+
     void dumpStats() const;
 
-    size_t getUsedMem() const;
+    // Finishes a concurrent sweep first, as the sweeper thread writes the bitmaps this counts.
+    size_t getUsedMem();
     size_t getAllocatedMem() const;
     size_t getLargeItemsMem() const;
 
@@ -457,11 +524,29 @@ protected:
 
 private:
     void collectFromJSStack(MarkStack *markStack) const;
+    void collectGarbage();
+    void runAllocationTriggeredGC();
+    void startIncrementalMark();
+    void abortIncrementalMark();
     void mark();
     void sweep(bool lastSweep = false, ClassDestroyStatsCallback classCountPtr = nullptr);
+    void sweepYoungGeneration();
+    void sweepWeakValues(bool lastSweep);
     bool shouldRunGC() const;
+    bool shouldRunIdleGC() const;
     void collectRoots(MarkStack *markStack);
 
+    // Items allocated while an incremental mark is running are colored black and gray. They
+    // survive the current cycle and get rescanned when marking finishes.
+    void colorNewItem(HeapItem *h)
+    {
+        if (Q_UNLIKELY(m_markStack)) {
+            Heap::Base *b = *h;
+            b->setMarkBit();
+            b->setGrayBit();
+        }
+    }
+
 public:
     QV4::ExecutionEngine *engine;
     ChunkAllocator *chunkAllocator;
@@ -474,11 +559,23 @@ public:
 
     std::size_t unmanagedHeapSize = 0; // the amount of bytes of heap that is not managed by the memory manager, but which is held onto by managed items.
     std::size_t unmanagedHeapSizeGCLimit;
-    std::size_t usedSlotsAfterLastFullSweep = 0;
+
+    MarkStack *m_markStack = nullptr;
+    uint allocationsSinceLastSlice = 0;
+    uint incrementalSlices = 0;
+    std::size_t oldGenerationLimit = 0; // in slots
+    uint minorGCsSinceLastMajorGC = 0;
+    int incrementalGCSliceTime; // in us
+    qint64 lastFullGCTime = 0; // in us
+    qint64 lastMinorGCTime = 0; // in us
+    GCPauseHistogram pauseHistogram;
 
     bool gcBlocked = false;
     bool aggressiveGC = false;
     bool gcStats = false;
+    bool incrementalGC = false;
+    bool concurrentSweep = false;
+    bool generationalGC = false;
 };
 
 }
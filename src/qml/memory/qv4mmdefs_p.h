@@ -57,6 +57,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QElapsedTimer;
+
 namespace QV4 {
 
 struct MarkStack;
@@ -186,12 +188,13 @@ struct Chunk {
         return usedSlots;
     }
 
-    bool sweep(ClassDestroyStatsCallback classCountPtr);
+    bool sweep(ClassDestroyStatsCallback classCountPtr, bool destructorsDone = false);
+    void runDestructors();
     void freeAll();
     void resetBlackBits();
     void collectGrayItems(QV4::MarkStack *markStack);
 
-    void sortIntoBins(HeapItem **bins, uint nBins);
+    void sortIntoBins(HeapItem **bins, uint nBins, HeapItem **tails = nullptr, const quintptr *usedBefore = nullptr);
 };
 
 struct HeapItem {
@@ -284,7 +287,8 @@ struct MarkStack {
         return *top;
     }
     void drain();
-
+    // returns true if the stack could be drained completely within the budget
+    bool drain(const QElapsedTimer &timer, qint64 budgetNSecs);
 };
 
 // Some helper classes and macros to automate the generation of our
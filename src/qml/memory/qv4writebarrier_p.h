@@ -52,10 +52,11 @@
 
 #include <private/qv4global_p.h>
 #include <private/qv4value_p.h>
+#include <private/qv4enginebase_p.h>
 
 QT_BEGIN_NAMESPACE
 
-#define WRITEBARRIER_none 1
+#define WRITEBARRIER_steele 1
 
 #define WRITEBARRIER(x) (1/WRITEBARRIER_##x == 1)
 
@@ -77,32 +78,46 @@ enum NewValueType {
 // ### this needs to be filled with a real memory fence once marking is concurrent
 Q_ALWAYS_INLINE void fence() {}
 
-#if WRITEBARRIER(none)
+#if WRITEBARRIER(steele)
+
+/*
+ * Steele style barrier: when a heap object gets written into while an incremental
+ * mark phase is in progress, the object is set back to gray. The memory manager
+ * then rescans all black and gray objects before it finishes marking. The barrier
+ * is only active while engine->writeBarrierActive is set, so the fast path is a
+ * single byte compare.
+ */
 
 template <NewValueType type>
 static Q_CONSTEXPR inline bool isRequired() {
-    return false;
+    return type != Primitive;
+}
+
+Q_ALWAYS_INLINE void markGray(Heap::Base *base)
+{
+    if (base->isMarked())
+        base->setGrayBit();
 }
 
 inline void write(EngineBase *engine, Heap::Base *base, Value *slot, Value value)
 {
-    Q_UNUSED(engine);
-    Q_UNUSED(base);
     *slot = value;
+    if (Q_UNLIKELY(engine->writeBarrierActive) && value.isManaged())
+        markGray(base);
 }
 
 inline void write(EngineBase *engine, Heap::Base *base, Value *slot, Heap::Base *value)
 {
-    Q_UNUSED(engine);
-    Q_UNUSED(base);
     *slot = value;
+    if (Q_UNLIKELY(engine->writeBarrierActive) && value)
+        markGray(base);
 }
 
 inline void write(EngineBase *engine, Heap::Base *base, Heap::Base **slot, Heap::Base *value)
 {
-    Q_UNUSED(engine);
-    Q_UNUSED(base);
     *slot = value;
+    if (Q_UNLIKELY(engine->writeBarrierActive) && value)
+        markGray(base);
 }
 
 #endif
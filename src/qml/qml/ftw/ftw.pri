@@ -13,6 +13,7 @@ HEADERS +=  \
     $$PWD/qlazilyallocated_p.h \
     $$PWD/qqmlnullablevalue_p.h \
     $$PWD/qdeferredcleanup_p.h \
+    $$PWD/qqmlpooledjob_p.h \
 
 SOURCES += \
     $$PWD/qintrusivelist.cpp \
@@ -0,0 +1,166 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QQMLPOOLEDJOB_P_H
+#define QQMLPOOLEDJOB_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+#ifndef QT_NO_THREAD
+#include <QtCore/qrunnable.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class QThreadPool;
+
+/*
+    A job on a thread pool that the thread which started it can wait for or
+    cancel. If no thread of the pool has picked the job up yet, waiting runs it
+    right away on the waiting thread, and cancelling takes it out of the queue.
+    Otherwise both block until the pool is done with it.
+
+    The pool does not delete the job. Its owner deletes it after waiting for it
+    or cancelling it, and is the only one calling anything but execute(). Without
+    thread support, start() runs the job right away.
+*/
+class QQmlPooledJob
+#ifndef QT_NO_THREAD
+    : public QRunnable
+#endif
+{
+public:
+    QQmlPooledJob()
+    {
+#ifndef QT_NO_THREAD
+        setAutoDelete(false);
+#endif
+    }
+    virtual ~QQmlPooledJob() {}
+
+    void start(QThreadPool *pool, int priority = 0)
+    {
+        Q_ASSERT(m_state == NotStarted);
+#ifndef QT_NO_THREAD
+        m_state = Started;
+        m_pool = pool;
+        pool->start(this, priority);
+#else
+        Q_UNUSED(pool);
+        Q_UNUSED(priority);
+        execute();
+        m_state = Finished;
+#endif
+    }
+
+    // Doesn't block
+    bool isFinished() const
+    {
+#ifndef QT_NO_THREAD
+        if (m_state == Started)
+            return m_finished.available() > 0;
+#endif
+        return m_state == Finished;
+    }
+
+    void waitForFinished()
+    {
+        if (m_state != Started)
+            return;
+#ifndef QT_NO_THREAD
+        if (m_pool->tryTake(this))
+            execute();
+        else
+            m_finished.acquire();
+#endif
+        m_state = Finished;
+    }
+
+    // Returns whether the job has run
+    bool cancel()
+    {
+        if (m_state == Started) {
+#ifndef QT_NO_THREAD
+            if (m_pool->tryTake(this)) {
+                m_state = Cancelled;
+                return false;
+            }
+            m_finished.acquire();
+#endif
+            m_state = Finished;
+        }
+        return m_state == Finished;
+    }
+
+protected:
+    // Runs on a thread of the pool, or on the thread waiting for the job
+    virtual void execute() = 0;
+
+private:
+#ifndef QT_NO_THREAD
+    void run() override
+    {
+        execute();
+        m_finished.release();
+    }
+
+    QThreadPool *m_pool = nullptr;
+    QSemaphore m_finished;
+#endif
+    enum State { NotStarted, Started, Finished, Cancelled };
+    State m_state = NotStarted;
+
+    Q_DISABLE_COPY(QQmlPooledJob)
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLPOOLEDJOB_P_H
@@ -51,6 +51,7 @@
 #include <private/qqmlpropertyvalidator_p.h>
 #include <private/qqmlpropertycachecreator_p.h>
 #include <private/qdeferredcleanup_p.h>
+#include <private/qqmlpooledjob_p.h>
 
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
@@ -62,6 +63,7 @@
 #include <QtCore/qdiriterator.h>
 #include <QtQml/qqmlcomponent.h>
 #include <QtCore/qwaitcondition.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qloggingcategory.h>
 #include <QtQml/qqmlextensioninterface.h>
 #include <QtCore/qcryptographichash.h>
@@ -102,6 +104,7 @@
 DEFINE_BOOL_CONFIG_OPTION(dumpErrors, QML_DUMP_ERRORS);
 DEFINE_BOOL_CONFIG_OPTION(disableDiskCache, QML_DISABLE_DISK_CACHE);
 DEFINE_BOOL_CONFIG_OPTION(forceDiskCache, QML_FORCE_DISK_CACHE);
+DEFINE_BOOL_CONFIG_OPTION(disableCompileAhead, QML_DISABLE_COMPILE_AHEAD);
 
 Q_DECLARE_LOGGING_CATEGORY(DBG_DISK_CACHE)
 Q_LOGGING_CATEGORY(DBG_DISK_CACHE, "qt.qml.diskcache")
@@ -949,6 +952,8 @@ void QQmlTypeLoader::invalidate()
 {
     if (m_thread) {
         shutdownThread();
+        // Compile-ahead jobs may still be using the engine.
+        cancelCompileAheadJobs();
         delete m_thread;
         m_thread = 0;
     }
@@ -1592,6 +1597,243 @@ bool QQmlTypeLoaderQmldirContent::designerSupported() const
     return m_parser.designerSupported();
 }
 
+struct EmptyCompilationUnit : public QV4::CompiledData::CompilationUnit
+{
+    void linkBackendToEngine(QV4::ExecutionEngine *) override {}
+};
+
+static bool parseQml(const QSet<QString> &illegalNames, const QString &source, const QUrl &url, const QString &urlString,
+                     QmlIR::Document *document, QList<QQmlError> *errors)
+{
+    QmlIR::IRBuilder compiler(illegalNames);
+    if (compiler.generateFromQml(source, urlString, document))
+        return true;
+
+    errors->reserve(compiler.errors.count());
+    for (const QQmlJS::DiagnosticMessage &msg : qAsConst(compiler.errors)) {
+        QQmlError e;
+        e.setUrl(url);
+        e.setLine(msg.loc.startLine);
+        e.setColumn(msg.loc.startColumn);
+        e.setDescription(msg.message);
+        *errors << e;
+    }
+    return false;
+}
+
+static QQmlRefPointer<QV4::CompiledData::CompilationUnit> compileScript(QV4::ExecutionEngine *v4, const QUrl &url, const QString &source,
+                                                                        const QDateTime &sourceTimeStamp, bool debugMode, QList<QQmlError> *errors)
+{
+    QmlIR::Document irUnit(debugMode);
+
+    irUnit.jsModule.sourceTimeStamp = sourceTimeStamp;
+
+    QmlIR::ScriptDirectivesCollector collector(&irUnit.jsParserEngine, &irUnit.jsGenerator);
+
+    QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit = QV4::Script::precompile(&irUnit.jsModule, &irUnit.jsGenerator, v4, url, source, errors, &collector);
+    // No need to addref on unit, it's initial refcount is 1
+    if (!errors->isEmpty())
+        return nullptr;
+    if (!unit) {
+        unit.adopt(new EmptyCompilationUnit);
+    }
+    irUnit.javaScriptCompilationUnit = unit;
+    irUnit.imports = collector.imports;
+    if (collector.hasPragmaLibrary)
+        irUnit.jsModule.unitFlags |= QV4::CompiledData::Unit::IsSharedLibrary;
+
+    QmlIR::QmlUnitGenerator qmlGenerator;
+    QV4::CompiledData::Unit *unitData = qmlGenerator.generate(irUnit);
+    Q_ASSERT(!unit->data);
+    // The js unit owns the data and will free the qml unit.
+    unit->data = unitData;
+    return unit;
+}
+
+/*
+A compile-ahead job parses a QML document, or compiles a JavaScript file, on a worker thread.
+
+Once a type has resolved its imported scripts and the types it references, the loader thread
+starts one of these for each of them before it loads them one after the other. By the time it
+gets to a dependency, its source has usually been compiled already, and all the loader thread
+is left with is resolving that dependency's own imports and types. Anything that needs the
+engine, such as the type compiler, stays on the loader thread.
+*/
+class QQmlTypeLoader::CompileAheadJob : public QQmlPooledJob
+{
+public:
+    CompileAheadJob(QQmlDataBlob::Type type, const QUrl &url, const QQmlDataBlob::SourceCodeData &source,
+                    QV4::ExecutionEngine *v4, const QSet<QString> &illegalNames, bool debugMode)
+        : type(type)
+        , url(url)
+        , source(source)
+        , sourceTimeStamp(source.sourceTimeStamp())
+        , v4(v4)
+        , illegalNames(illegalNames)
+        , debugMode(debugMode)
+        , compiled(false)
+    {
+    }
+
+    // Must not touch the loader. Script compilation only uses the engine's instruction
+    // selection and executable allocator, which are both fine to use from several threads.
+    void execute() override
+    {
+        QString error;
+        const QString sourceCode = source.readAll(&error);
+        // Leave it to the loader thread to report this when it reads the file itself.
+        if (!error.isEmpty())
+            return;
+
+        if (type == QQmlDataBlob::QmlFile) {
+            document.reset(new QmlIR::Document(debugMode));
+            document->jsModule.sourceTimeStamp = sourceTimeStamp;
+            parseQml(illegalNames, sourceCode, url, url.toString(), document.data(), &errors);
+        } else {
+            unit = compileScript(v4, url, sourceCode, sourceTimeStamp, debugMode, &errors);
+        }
+        compiled = true;
+    }
+
+    const QQmlDataBlob::Type type;
+    const QUrl url;
+    const QQmlDataBlob::SourceCodeData source;
+    const QDateTime sourceTimeStamp;
+    QV4::ExecutionEngine * const v4;
+    const QSet<QString> illegalNames;
+    const bool debugMode;
+
+    bool compiled;
+    QScopedPointer<QmlIR::Document> document;
+    QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit;
+    QList<QQmlError> errors;
+};
+
+#ifndef QT_NO_THREAD
+Q_GLOBAL_STATIC(QThreadPool, compileAheadThreadPool)
+#endif
+
+/*!
+Starts compiling the source of \a url on a worker thread, unless it has been loaded already.
+The loader picks the result up through takeCompileAheadJob() when it loads the file.
+
+Only local files are compiled ahead, and only if there is no cache file that the blob would
+rather load instead.
+*/
+void QQmlTypeLoader::compileAhead(const QUrl &url, QQmlDataBlob::Type type)
+{
+#ifndef QT_NO_THREAD
+    ASSERT_LOADTHREAD();
+    Q_ASSERT(type == QQmlDataBlob::QmlFile || type == QQmlDataBlob::JavaScriptFile);
+
+    if (disableCompileAhead() || !QQmlFile::isSynchronous(url) || m_engine->urlInterceptor())
+        return;
+
+    LockHolder<QQmlTypeLoader> holder(this);
+
+    if (m_thread->isShutdown() || m_compileAheadJobs.contains(url))
+        return;
+    if (type == QQmlDataBlob::QmlFile ? m_typeCache.contains(url) : m_scriptCache.contains(url))
+        return;
+    if (QQmlMetaType::findCachedCompilationUnit(url))
+        return;
+    if ((!disableDiskCache() || forceDiskCache()) && QFile::exists(QV4::CompiledData::CompilationUnit::cacheFilePath(url)))
+        return;
+
+    QQmlDataBlob::SourceCodeData source;
+    source.fileInfo = QFileInfo(QQmlFile::urlToLocalFileOrQrc(url));
+    if (!source.exists())
+        return;
+
+    QV4::ExecutionEngine *v4 = QV8Engine::getV4(m_engine);
+    CompileAheadJob *job = new CompileAheadJob(type, url, source, v4, QV8Engine::get(m_engine)->illegalNames(),
+                                               v4->debugger() != 0);
+    m_compileAheadJobs.insert(url, job);
+    job->start(compileAheadThreadPool());
+#else
+    Q_UNUSED(url);
+    Q_UNUSED(type);
+#endif
+}
+
+/*!
+Returns the finished compile-ahead job for \a url, waiting for it if necessary, or null if
+there is none. Results for sources that have changed since, as told by \a sourceTimeStamp,
+are dropped. The caller takes ownership of the job.
+*/
+QQmlTypeLoader::CompileAheadJob *QQmlTypeLoader::takeCompileAheadJob(const QUrl &url, const QDateTime &sourceTimeStamp)
+{
+#ifndef QT_NO_THREAD
+    ASSERT_LOADTHREAD();
+
+    CompileAheadJob *job;
+    {
+        LockHolder<QQmlTypeLoader> holder(this);
+        job = m_compileAheadJobs.take(url);
+    }
+    if (!job)
+        return nullptr;
+
+    // Compiles it right here if no worker got to it yet
+    job->waitForFinished();
+
+    const bool debugMode = QV8Engine::getV4(m_engine)->debugger() != 0;
+    if (!job->compiled || job->sourceTimeStamp != sourceTimeStamp || job->debugMode != debugMode) {
+        delete job;
+        return nullptr;
+    }
+    return job;
+#else
+    Q_UNUSED(url);
+    Q_UNUSED(sourceTimeStamp);
+    return nullptr;
+#endif
+}
+
+void QQmlTypeLoader::cancelCompileAheadJobs()
+{
+#ifndef QT_NO_THREAD
+    QHash<QUrl, CompileAheadJob *> jobs;
+    if (m_thread) {
+        LockHolder<QQmlTypeLoader> holder(this);
+        jobs.swap(m_compileAheadJobs);
+    } else {
+        jobs.swap(m_compileAheadJobs);
+    }
+    for (CompileAheadJob *job : qAsConst(jobs)) {
+        // Running jobs are still using the engine
+        job->cancel();
+        delete job;
+    }
+#endif
+}
+
+/*!
+Drops the compile-ahead jobs for \a urls, if they were not taken yet. Used when the blob that
+asked for them fails before loading the files.
+*/
+void QQmlTypeLoader::cancelCompileAheadJobs(const QList<QUrl> &urls)
+{
+#ifndef QT_NO_THREAD
+    ASSERT_LOADTHREAD();
+
+    QVector<CompileAheadJob *> jobs;
+    {
+        LockHolder<QQmlTypeLoader> holder(this);
+        for (const QUrl &url : urls) {
+            if (CompileAheadJob *job = m_compileAheadJobs.take(url))
+                jobs.append(job);
+        }
+    }
+    for (CompileAheadJob *job : qAsConst(jobs)) {
+        job->cancel();
+        delete job;
+    }
+#else
+    Q_UNUSED(urls);
+#endif
+}
+
 /*!
 Constructs a new type loader that uses the given \a engine.
 */
@@ -1928,6 +2170,8 @@ and qmldir information.
 */
 void QQmlTypeLoader::clearCache()
 {
+    cancelCompileAheadJobs();
+
     for (TypeCache::Iterator iter = m_typeCache.begin(), end = m_typeCache.end(); iter != end; ++iter)
         (*iter)->release();
     for (ScriptCache::Iterator iter = m_scriptCache.begin(), end = m_scriptCache.end(); iter != end; ++iter)
@@ -2406,29 +2650,28 @@ void QQmlTypeData::initializeFromCachedUnit(const QQmlPrivate::CachedQmlUnit *un
 
 bool QQmlTypeData::loadFromSource()
 {
-    m_document.reset(new QmlIR::Document(isDebugging()));
-    m_document->jsModule.sourceTimeStamp = m_backupSourceCode.sourceTimeStamp();
-    QQmlEngine *qmlEngine = typeLoader()->engine();
-    QmlIR::IRBuilder compiler(QV8Engine::get(qmlEngine)->illegalNames());
-
-    QString sourceError;
-    const QString source = m_backupSourceCode.readAll(&sourceError);
-    if (!sourceError.isEmpty()) {
-        setError(sourceError);
-        return false;
-    }
+    QList<QQmlError> errors;
 
-    if (!compiler.generateFromQml(source, finalUrlString(), m_document.data())) {
-        QList<QQmlError> errors;
-        errors.reserve(compiler.errors.count());
-        for (const QQmlJS::DiagnosticMessage &msg : qAsConst(compiler.errors)) {
-            QQmlError e;
-            e.setUrl(finalUrl());
-            e.setLine(msg.loc.startLine);
-            e.setColumn(msg.loc.startColumn);
-            e.setDescription(msg.message);
-            errors << e;
+    QScopedPointer<QQmlTypeLoader::CompileAheadJob> job(typeLoader()->takeCompileAheadJob(finalUrl(), m_backupSourceCode.sourceTimeStamp()));
+    if (job) {
+        m_document.reset(job->document.take());
+        errors = job->errors;
+    } else {
+        m_document.reset(new QmlIR::Document(isDebugging()));
+        m_document->jsModule.sourceTimeStamp = m_backupSourceCode.sourceTimeStamp();
+        QQmlEngine *qmlEngine = typeLoader()->engine();
+
+        QString sourceError;
+        const QString source = m_backupSourceCode.readAll(&sourceError);
+        if (!sourceError.isEmpty()) {
+            setError(sourceError);
+            return false;
         }
+
+        parseQml(QV8Engine::get(qmlEngine)->illegalNames(), source, finalUrl(), finalUrlString(), m_document.data(), &errors);
+    }
+
+    if (!errors.isEmpty()) {
         setError(errors);
         return false;
     }
@@ -2568,8 +2811,15 @@ void QQmlTypeData::compile(const QQmlRefPointer<QQmlTypeNameCache> &typeNameCach
 
 void QQmlTypeData::resolveTypes()
 {
+    // Files handed out to be compiled ahead, to be dropped again if we fail before loading them
+    QList<QUrl> compiledAhead;
+
     // Add any imported scripts to our resolved set
     const auto resolvedScripts = m_importCache.resolvedScripts();
+    for (const QQmlImports::ScriptReference &script : resolvedScripts) {
+        typeLoader()->compileAhead(script.location, QQmlDataBlob::JavaScriptFile);
+        compiledAhead.append(script.location);
+    }
     for (const QQmlImports::ScriptReference &script : resolvedScripts) {
         QQmlScriptBlob *blob = typeLoader()->getScript(script.location);
         addDependency(blob);
@@ -2605,8 +2855,10 @@ void QQmlTypeData::resolveTypes()
         int majorVersion = csRef.majorVersion > -1 ? csRef.majorVersion : -1;
         int minorVersion = csRef.minorVersion > -1 ? csRef.minorVersion : -1;
 
-        if (!resolveType(typeName, majorVersion, minorVersion, ref))
+        if (!resolveType(typeName, majorVersion, minorVersion, ref)) {
+            typeLoader()->cancelCompileAheadJobs(compiledAhead);
             return;
+        }
 
         if (ref.type.isCompositeSingleton()) {
             ref.typeData = typeLoader()->getType(ref.type.sourceUrl());
@@ -2633,12 +2885,14 @@ void QQmlTypeData::resolveTypes()
 
         const QString name = stringAt(unresolvedRef.key());
 
-        if (!resolveType(name, majorVersion, minorVersion, ref, unresolvedRef->location.line, unresolvedRef->location.column, reportErrors) && reportErrors)
+        if (!resolveType(name, majorVersion, minorVersion, ref, unresolvedRef->location.line, unresolvedRef->location.column, reportErrors) && reportErrors) {
+            typeLoader()->cancelCompileAheadJobs(compiledAhead);
             return;
+        }
 
         if (ref.type.isComposite()) {
-            ref.typeData = typeLoader()->getType(ref.type.sourceUrl());
-            addDependency(ref.typeData);
+            typeLoader()->compileAhead(ref.type.sourceUrl(), QQmlDataBlob::QmlFile);
+            compiledAhead.append(ref.type.sourceUrl());
         }
         ref.majorVersion = majorVersion;
         ref.minorVersion = minorVersion;
@@ -2651,6 +2905,14 @@ void QQmlTypeData::resolveTypes()
         m_resolvedTypes.insert(unresolvedRef.key(), ref);
     }
 
+    // Only load the composite types once they have all been handed out to be compiled ahead.
+    for (TypeReference &ref : m_resolvedTypes) {
+        if (ref.type.isComposite()) {
+            ref.typeData = typeLoader()->getType(ref.type.sourceUrl());
+            addDependency(ref.typeData);
+        }
+    }
+
     // ### this allows enums to work without explicit import or instantiation of the type
     if (!m_implicitImportLoaded)
         loadImplicitImport();
@@ -2913,11 +3175,6 @@ QQmlScriptData *QQmlScriptBlob::scriptData() const
     return m_scriptData;
 }
 
-struct EmptyCompilationUnit : public QV4::CompiledData::CompilationUnit
-{
-    void linkBackendToEngine(QV4::ExecutionEngine *) override {}
-};
-
 void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
 {
     QV4::ExecutionEngine *v4 = QV8Engine::getV4(m_typeLoader->engine());
@@ -2934,39 +3191,26 @@ void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
     }
 
 
-    QmlIR::Document irUnit(isDebugging());
+    QList<QQmlError> errors;
+    QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit;
 
-    irUnit.jsModule.sourceTimeStamp = data.sourceTimeStamp();
-    QString error;
-    QString source = data.readAll(&error);
-    if (!error.isEmpty()) {
-        setError(error);
-        return;
+    QScopedPointer<QQmlTypeLoader::CompileAheadJob> job(m_typeLoader->takeCompileAheadJob(finalUrl(), data.sourceTimeStamp()));
+    if (job) {
+        unit = job->unit;
+        errors = job->errors;
+    } else {
+        QString error;
+        const QString source = data.readAll(&error);
+        if (!error.isEmpty()) {
+            setError(error);
+            return;
+        }
+        unit = compileScript(v4, finalUrl(), source, data.sourceTimeStamp(), isDebugging(), &errors);
     }
-
-    QmlIR::ScriptDirectivesCollector collector(&irUnit.jsParserEngine, &irUnit.jsGenerator);
-
-    QList<QQmlError> errors;
-    QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit = QV4::Script::precompile(&irUnit.jsModule, &irUnit.jsGenerator, v4, finalUrl(), source, &errors, &collector);
-    // No need to addref on unit, it's initial refcount is 1
-    source.clear();
     if (!errors.isEmpty()) {
         setError(errors);
         return;
     }
-    if (!unit) {
-        unit.adopt(new EmptyCompilationUnit);
-    }
-    irUnit.javaScriptCompilationUnit = unit;
-    irUnit.imports = collector.imports;
-    if (collector.hasPragmaLibrary)
-        irUnit.jsModule.unitFlags |= QV4::CompiledData::Unit::IsSharedLibrary;
-
-    QmlIR::QmlUnitGenerator qmlGenerator;
-    QV4::CompiledData::Unit *unitData = qmlGenerator.generate(irUnit);
-    Q_ASSERT(!unit->data);
-    // The js unit owns the data and will free the qml unit.
-    unit->data = unitData;
 
     if (!disableDiskCache() || forceDiskCache()) {
         QString errorString;
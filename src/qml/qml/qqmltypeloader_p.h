@@ -322,6 +322,8 @@ public:
 
 private:
     friend class QQmlDataBlob;
+    friend class QQmlTypeData;
+    friend class QQmlScriptBlob;
     friend class QQmlTypeLoaderThread;
 #if QT_CONFIG(qml_network)
     friend class QQmlTypeLoaderNetworkReplyProxy;
@@ -344,6 +346,12 @@ private:
     void setData(QQmlDataBlob *, const QQmlDataBlob::SourceCodeData &);
     void setCachedUnit(QQmlDataBlob *blob, const QQmlPrivate::CachedQmlUnit *unit);
 
+    class CompileAheadJob;
+    void compileAhead(const QUrl &url, QQmlDataBlob::Type type);
+    CompileAheadJob *takeCompileAheadJob(const QUrl &url, const QDateTime &sourceTimeStamp);
+    void cancelCompileAheadJobs();
+    void cancelCompileAheadJobs(const QList<QUrl> &urls);
+
     template<typename T>
     struct TypedCallback
     {
@@ -377,6 +385,7 @@ private:
     QmldirCache m_qmldirCache;
     ImportDirCache m_importDirCache;
     ImportQmlDirCache m_importQmlDirCache;
+    QHash<QUrl, CompileAheadJob *> m_compileAheadJobs;
 
     template<typename Loader>
     void doLoad(const Loader &loader, QQmlDataBlob *blob, Mode mode);
@@ -264,6 +264,8 @@ QQmlDelegateModel::~QQmlDelegateModel()
 {
     Q_D(QQmlDelegateModel);
 
+    d->m_cache += d->m_reusableItemsPool;
+    d->m_reusableItemsPool.clear();
     for (QQmlDelegateModelItem *cacheItem : qAsConst(d->m_cache)) {
         if (cacheItem->object) {
             delete cacheItem->object;
@@ -374,6 +376,7 @@ void QQmlDelegateModel::setModel(const QVariant &model)
     if (d->m_complete)
         _q_itemsRemoved(0, d->m_count);
 
+    d->drainReusableItemsPool(0);
     d->m_adaptorModel.setModel(model, this, d->m_context->engine());
     d->m_adaptorModel.replaceWatchedRoles(QList<QByteArray>(), d->m_watchedRoles);
     for (int i = 0; d->m_parts && i < d->m_parts->models.count(); ++i) {
@@ -408,6 +411,7 @@ void QQmlDelegateModel::setDelegate(QQmlComponent *delegate)
         return;
     }
     bool wasValid = d->m_delegate != 0;
+    d->drainReusableItemsPool(0);
     d->m_delegate = delegate;
     d->m_delegateValidated = false;
     if (wasValid && d->m_complete) {
@@ -468,6 +472,7 @@ void QQmlDelegateModel::setRootIndex(const QVariant &root)
     const bool changed = d->m_adaptorModel.rootIndex != modelIndex;
     if (changed || !d->m_adaptorModel.isValid()) {
         const int oldCount = d->m_count;
+        d->drainReusableItemsPool(0);
         d->m_adaptorModel.rootIndex = modelIndex;
         if (!d->m_adaptorModel.isValid() && d->m_adaptorModel.aim())  // The previous root index was invalidated, so we need to reconnect the model.
             d->m_adaptorModel.setModel(d->m_adaptorModel.list.list(), this, d->m_context->engine());
@@ -533,14 +538,24 @@ int QQmlDelegateModel::count() const
     return d->m_compositor.count(d->m_compositorGroup);
 }
 
-QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *object)
+QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *object, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
+    Q_Q(QQmlDelegateModel);
     QQmlDelegateModel::ReleaseFlags stat = 0;
     if (!object)
         return stat;
 
     if (QQmlDelegateModelItem *cacheItem = QQmlDelegateModelItem::dataForObject(object)) {
         if (cacheItem->releaseObject()) {
+            if (reusableFlag == QQmlInstanceModel::Reusable && isReusable(cacheItem)) {
+                // Keep the object and its context alive, detached from any model row,
+                // until reuseItem() binds it to a new one or the pool is drained.
+                removeCacheItem(cacheItem);
+                cacheItem->poolTime = 0;
+                m_reusableItemsPool.append(cacheItem);
+                emit q->itemPooled(cacheItem->index, object);
+                return QQmlInstanceModel::Pooled;
+            }
             cacheItem->destroyObject();
             emitDestroyingItem(object);
             if (cacheItem->incubationTask) {
@@ -560,13 +575,84 @@ QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *objec
   Returns ReleaseStatus flags.
 */
 
-QQmlDelegateModel::ReleaseFlags QQmlDelegateModel::release(QObject *item)
+QQmlDelegateModel::ReleaseFlags QQmlDelegateModel::release(QObject *item, ReusableFlag reusableFlag)
 {
     Q_D(QQmlDelegateModel);
-    QQmlInstanceModel::ReleaseFlags stat = d->release(item);
+    QQmlInstanceModel::ReleaseFlags stat = d->release(item, reusableFlag);
     return stat;
 }
 
+/*
+  Only fully created delegates that are not packages can be reused, and only
+  if the adaptor model can point their model data at a different row.  Object
+  list models expose the row's object through a proxy context that is set up
+  once per delegate, so their items are never pooled.  Neither are delegates
+  that JavaScript still holds on to, e.g. through the items of a
+  DelegateModelGroup, since their index would change under the script.
+*/
+bool QQmlDelegateModelPrivate::isReusable(QQmlDelegateModelItem *cacheItem) const
+{
+    return cacheItem->object
+            && !cacheItem->incubationTask
+            && cacheItem->index != -1
+            && !(cacheItem->groups & Compositor::UnresolvedFlag)
+            && !cacheItem->scriptRef
+            && !m_adaptorModel.hasProxyObject()
+            && !qmlobject_cast<QQuickPackage *>(cacheItem->object);
+}
+
+void QQmlDelegateModelPrivate::reuseItem(QQmlDelegateModelItem *cacheItem, Compositor::iterator it)
+{
+    Q_Q(QQmlDelegateModel);
+    cacheItem->groups = it->flags;
+    cacheItem->rebind(m_adaptorModel, it.modelIndex());
+
+    if (QQmlDelegateModelAttached *attached = cacheItem->attached) {
+        for (int i = 1; i < m_groupCount; ++i)
+            attached->m_currentIndex[i] = it.index[i];
+        attached->emitChanges();
+    }
+
+    emit q->itemReused(it.index[m_compositorGroup], cacheItem->object);
+}
+
+void QQmlDelegateModelPrivate::destroyPooledItem(QQmlDelegateModelItem *cacheItem)
+{
+    QObject *object = cacheItem->object;
+    cacheItem->destroyObject();
+    emitDestroyingItem(object);
+    cacheItem->Dispose();
+}
+
+/*
+  Ages the items in the reuse pool and destroys the ones that have not been
+  reused within \a maxPoolTime calls.  A \a maxPoolTime of 0 empties the pool.
+*/
+void QQmlDelegateModelPrivate::drainReusableItemsPool(int maxPoolTime)
+{
+    for (int i = 0; i < m_reusableItemsPool.count();) {
+        QQmlDelegateModelItem *cacheItem = m_reusableItemsPool.at(i);
+        if (++cacheItem->poolTime <= maxPoolTime) {
+            ++i;
+            continue;
+        }
+        m_reusableItemsPool.removeAt(i);
+        destroyPooledItem(cacheItem);
+    }
+}
+
+void QQmlDelegateModel::drainReusableItemsPool(int maxPoolTime)
+{
+    Q_D(QQmlDelegateModel);
+    d->drainReusableItemsPool(maxPoolTime);
+}
+
+int QQmlDelegateModel::poolSize() const
+{
+    Q_D(const QQmlDelegateModel);
+    return d->m_reusableItemsPool.count();
+}
+
 // Cancel a requested async item
 void QQmlDelegateModel::cancel(int index)
 {
@@ -940,6 +1026,21 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
 
     QQmlDelegateModelItem *cacheItem = it->inCache() ? m_cache.at(it.cacheIndex) : 0;
 
+    if (!cacheItem && !m_reusableItemsPool.isEmpty()) {
+        // Rebind a delegate that a view released for reuse instead of creating a new one.
+        cacheItem = m_reusableItemsPool.takeFirst();
+        m_cache.insert(it.cacheIndex, cacheItem);
+        m_compositor.setFlags(it, 1, Compositor::CacheFlag);
+        Q_ASSERT(m_cache.count() == m_compositor.count(Compositor::Cache));
+
+        cacheItem->referenceObject();
+        reuseItem(cacheItem, it);
+
+        if (index == m_compositor.count(group) - 1)
+            requestMoreIfNecessary();
+        return cacheItem->object;
+    }
+
     if (!cacheItem) {
         cacheItem = m_adaptorModel.createItem(m_cacheMetaType, it.modelIndex());
         if (!cacheItem)
@@ -1903,6 +2004,7 @@ QQmlDelegateModelItem::QQmlDelegateModelItem(
     , scriptRef(0)
     , groups(0)
     , index(modelIndex)
+    , poolTime(0)
 {
     metaType->addref();
 }
@@ -3138,7 +3240,7 @@ QObject *QQmlPartsModel::object(int index, bool asynchronous)
     return 0;
 }
 
-QQmlInstanceModel::ReleaseFlags QQmlPartsModel::release(QObject *item)
+QQmlInstanceModel::ReleaseFlags QQmlPartsModel::release(QObject *item, ReusableFlag)
 {
     QQmlInstanceModel::ReleaseFlags flags = 0;
 
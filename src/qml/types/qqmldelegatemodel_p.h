@@ -110,7 +110,9 @@ public:
     int count() const override;
     bool isValid() const override { return delegate() != 0; }
     QObject *object(int index, bool asynchronous = false) override;
-    ReleaseFlags release(QObject *object) override;
+    ReleaseFlags release(QObject *object, ReusableFlag reusableFlag = NotReusable) override;
+    void drainReusableItemsPool(int maxPoolTime) override;
+    int poolSize() const override;
     void cancel(int index) override;
     QString stringValue(int index, const QString &role) override;
     void setWatchedRoles(const QList<QByteArray> &roles) override;
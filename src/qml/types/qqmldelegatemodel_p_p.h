@@ -125,6 +125,7 @@ public:
 
     virtual void setValue(const QString &role, const QVariant &value) { Q_UNUSED(role); Q_UNUSED(value); }
     virtual bool resolveIndex(const QQmlAdaptorModel &, int) { return false; }
+    virtual void rebind(const QQmlAdaptorModel &, int idx) { setModelIndex(idx); }
 
     static void get_model(const QV4::BuiltinFunction *, QV4::Scope &scope, QV4::CallData *callData);
     static void get_groups(const QV4::BuiltinFunction *, QV4::Scope &scope, QV4::CallData *callData);
@@ -143,6 +144,7 @@ public:
     int scriptRef;
     int groups;
     int index;
+    int poolTime;
 
 Q_SIGNALS:
     void modelIndexChanged();
@@ -257,7 +259,11 @@ public:
 
     void requestMoreIfNecessary();
     QObject *object(Compositor::Group group, int index, bool asynchronous);
-    QQmlDelegateModel::ReleaseFlags release(QObject *object);
+    QQmlDelegateModel::ReleaseFlags release(QObject *object, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
+    bool isReusable(QQmlDelegateModelItem *cacheItem) const;
+    void reuseItem(QQmlDelegateModelItem *cacheItem, Compositor::iterator it);
+    void destroyPooledItem(QQmlDelegateModelItem *cacheItem);
+    void drainReusableItemsPool(int maxPoolTime);
     QString stringValue(Compositor::Group group, int index, const QString &name);
     void emitCreatedPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
     void emitInitPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
@@ -310,6 +316,7 @@ public:
     QQmlDelegateModelGroupEmitterList m_pendingParts;
 
     QList<QQmlDelegateModelItem *> m_cache;
+    QList<QQmlDelegateModelItem *> m_reusableItemsPool;
     QList<QQDMIncubationTask *> m_finishedIncubating;
     QList<QByteArray> m_watchedRoles;
 
@@ -353,7 +360,7 @@ public:
     int count() const override;
     bool isValid() const override;
     QObject *object(int index, bool asynchronous = false) override;
-    ReleaseFlags release(QObject *item) override;
+    ReleaseFlags release(QObject *item, ReusableFlag reusableFlag = NotReusable) override;
     QString stringValue(int index, const QString &role) override;
     QList<QByteArray> watchedRoles() const { return m_watchedRoles; }
     void setWatchedRoles(const QList<QByteArray> &roles) override;
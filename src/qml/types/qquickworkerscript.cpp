@@ -73,15 +73,17 @@ class WorkerDataEvent : public QEvent
 public:
     enum Type { WorkerData = QEvent::User };
 
-    WorkerDataEvent(int workerId, const QByteArray &data);
+    WorkerDataEvent(int workerId, const QByteArray &data, QVector<QByteArray> buffers);
     virtual ~WorkerDataEvent();
 
     int workerId() const;
     QByteArray data() const;
+    QVector<QByteArray> *buffers();
 
 private:
     int m_id;
     QByteArray m_data;
+    QVector<QByteArray> m_buffers; // transferred ArrayBuffer contents
 };
 
 class WorkerLoadEvent : public QEvent
@@ -194,7 +196,7 @@ protected:
     bool event(QEvent *) override;
 
 private:
-    void processMessage(int, const QByteArray &);
+    void processMessage(int, const QByteArray &, QVector<QByteArray> *);
     void processLoad(int, const QUrl &);
     void reportScriptException(WorkerScript *, const QQmlError &error);
 };
@@ -231,8 +233,8 @@ void QQuickWorkerScriptEnginePrivate::WorkerEngine::init()
 #define SEND_MESSAGE_CREATE_SCRIPT \
     "(function(method, engine) { "\
         "return (function(id) { "\
-            "return (function(message) { "\
-                "if (arguments.length) method(engine, id, message); "\
+            "return (function(message, transfer) { "\
+                "if (arguments.length) method(engine, id, message, transfer); "\
             "}); "\
         "}); "\
     "})"
@@ -299,12 +301,14 @@ void QQuickWorkerScriptEnginePrivate::method_sendMessage(const QV4::BuiltinFunct
     int id = callData->argc > 1 ? callData->args[1].toInt32() : 0;
 
     QV4::ScopedValue v(scope, callData->argument(2));
-    QByteArray data = QV4::Serialize::serialize(v, scope.engine);
+    QV4::ScopedValue transfer(scope, callData->argument(3));
+    QVector<QByteArray> buffers;
+    QByteArray data = QV4::Serialize::serialize(v, scope.engine, transfer, &buffers);
 
     QMutexLocker locker(&engine->p->m_lock);
     WorkerScript *script = engine->p->workers.value(id);
     if (script && script->owner)
-        QCoreApplication::postEvent(script->owner, new WorkerDataEvent(0, data));
+        QCoreApplication::postEvent(script->owner, new WorkerDataEvent(0, data, std::move(buffers)));
 
     scope.result = QV4::Encode::undefined();
 }
@@ -327,7 +331,7 @@ bool QQuickWorkerScriptEnginePrivate::event(QEvent *event)
 {
     if (event->type() == (QEvent::Type)WorkerDataEvent::WorkerData) {
         WorkerDataEvent *workerEvent = static_cast<WorkerDataEvent *>(event);
-        processMessage(workerEvent->workerId(), workerEvent->data());
+        processMessage(workerEvent->workerId(), workerEvent->data(), workerEvent->buffers());
         return true;
     } else if (event->type() == (QEvent::Type)WorkerLoadEvent::WorkerLoad) {
         WorkerLoadEvent *workerEvent = static_cast<WorkerLoadEvent *>(event);
@@ -349,7 +353,7 @@ bool QQuickWorkerScriptEnginePrivate::event(QEvent *event)
     }
 }
 
-void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QByteArray &data)
+void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QByteArray &data, QVector<QByteArray> *buffers)
 {
     WorkerScript *script = workers.value(id);
     if (!script)
@@ -359,7 +363,7 @@ void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QByteArray &d
     QV4::Scope scope(v4);
     QV4::ScopedFunctionObject f(scope, workerEngine->onmessage.value());
 
-    QV4::ScopedValue value(scope, QV4::Serialize::deserialize(data, v4));
+    QV4::ScopedValue value(scope, QV4::Serialize::deserialize(data, v4, buffers));
     QV4::Scoped<QV4::QmlContext> qmlContext(scope, script->qmlContext.value());
     Q_ASSERT(!!qmlContext);
 
@@ -430,8 +434,8 @@ void QQuickWorkerScriptEnginePrivate::reportScriptException(WorkerScript *script
         QCoreApplication::postEvent(script->owner, new WorkerErrorEvent(error));
 }
 
-WorkerDataEvent::WorkerDataEvent(int workerId, const QByteArray &data)
-: QEvent((QEvent::Type)WorkerData), m_id(workerId), m_data(data)
+WorkerDataEvent::WorkerDataEvent(int workerId, const QByteArray &data, QVector<QByteArray> buffers)
+: QEvent((QEvent::Type)WorkerData), m_id(workerId), m_data(data), m_buffers(std::move(buffers))
 {
 }
 
@@ -449,6 +453,11 @@ QByteArray WorkerDataEvent::data() const
     return m_data;
 }
 
+QVector<QByteArray> *WorkerDataEvent::buffers()
+{
+    return &m_buffers;
+}
+
 WorkerLoadEvent::WorkerLoadEvent(int workerId, const QUrl &url)
 : QEvent((QEvent::Type)WorkerLoad), m_id(workerId), m_url(url)
 {
@@ -552,9 +561,9 @@ void QQuickWorkerScriptEngine::executeUrl(int id, const QUrl &url)
     QCoreApplication::postEvent(d, new WorkerLoadEvent(id, url));
 }
 
-void QQuickWorkerScriptEngine::sendMessage(int id, const QByteArray &data)
+void QQuickWorkerScriptEngine::sendMessage(int id, const QByteArray &data, QVector<QByteArray> buffers)
 {
-    QCoreApplication::postEvent(d, new WorkerDataEvent(id, data));
+    QCoreApplication::postEvent(d, new WorkerDataEvent(id, data, std::move(buffers)));
 }
 
 void QQuickWorkerScriptEngine::run()
@@ -658,7 +667,7 @@ void QQuickWorkerScript::setSource(const QUrl &source)
 }
 
 /*!
-    \qmlmethod WorkerScript::sendMessage(jsobject message)
+    \qmlmethod WorkerScript::sendMessage(jsobject message, list transfer)
 
     Sends the given \a message to a worker script handler in another
     thread. The other worker script handler can receive this message
@@ -670,12 +679,24 @@ void QQuickWorkerScript::setSource(const QUrl &source)
     \list
     \li boolean, number, string
     \li JavaScript objects and arrays
+    \li ArrayBuffer and typed array objects
     \li ListModel objects (any other type of QObject* is not allowed)
     \endlist
 
     All objects and arrays are copied to the \c message. With the exception
     of ListModel objects, any modifications by the other thread to an object
     passed in \c message will not be reflected in the original object.
+
+    The contents of the ArrayBuffers listed in the optional \a transfer array
+    are moved to the other thread instead of being copied. Afterwards the
+    ArrayBuffers and all typed arrays using them are empty in the sending
+    thread. The worker script can transfer ArrayBuffers back the same way
+    by passing a second argument to \c WorkerScript.sendMessage().
+
+    \code
+    var samples = new Float32Array(4 * 1024 * 1024)
+    worker.sendMessage({ samples: samples }, [ samples.buffer ])
+    \endcode
 */
 void QQuickWorkerScript::sendMessage(QQmlV4Function *args)
 {
@@ -688,8 +709,13 @@ void QQuickWorkerScript::sendMessage(QQmlV4Function *args)
     QV4::ScopedValue argument(scope, QV4::Primitive::undefinedValue());
     if (args->length() != 0)
         argument = (*args)[0];
+    QV4::ScopedValue transfer(scope, QV4::Primitive::undefinedValue());
+    if (args->length() > 1)
+        transfer = (*args)[1];
 
-    m_engine->sendMessage(m_scriptId, QV4::Serialize::serialize(argument, scope.engine));
+    QVector<QByteArray> buffers;
+    QByteArray data = QV4::Serialize::serialize(argument, scope.engine, transfer, &buffers);
+    m_engine->sendMessage(m_scriptId, data, std::move(buffers));
 }
 
 void QQuickWorkerScript::classBegin()
@@ -741,7 +767,8 @@ bool QQuickWorkerScript::event(QEvent *event)
             WorkerDataEvent *workerEvent = static_cast<WorkerDataEvent *>(event);
             QV8Engine *v8engine = QQmlEnginePrivate::get(engine)->v8engine();
             QV4::Scope scope(QV8Engine::getV4(v8engine));
-            QV4::ScopedValue value(scope, QV4::Serialize::deserialize(workerEvent->data(), scope.engine));
+            QV4::ScopedValue value(scope, QV4::Serialize::deserialize(workerEvent->data(), scope.engine,
+                                                                      workerEvent->buffers()));
             emit message(QQmlV4Handle(value));
         }
         return true;
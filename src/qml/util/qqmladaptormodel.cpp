@@ -104,6 +104,7 @@ public:
 
     void setValue(const QString &role, const QVariant &value) override;
     bool resolveIndex(const QQmlAdaptorModel &model, int idx) override;
+    void rebind(const QQmlAdaptorModel &model, int idx) override;
 
     static QV4::ReturnedValue get_property(QV4::CallContext *ctx, uint propertyId);
     static QV4::ReturnedValue set_property(QV4::CallContext *ctx, uint propertyId);
@@ -324,23 +325,28 @@ void QQmlDMCachedModelData::setValue(const QString &role, const QVariant &value)
     }
 }
 
-bool QQmlDMCachedModelData::resolveIndex(const QQmlAdaptorModel &, int idx)
+bool QQmlDMCachedModelData::resolveIndex(const QQmlAdaptorModel &model, int idx)
 {
     if (index == -1) {
         Q_ASSERT(idx >= 0);
-        index = idx;
-        cachedData.clear();
-        emit modelIndexChanged();
-        const QMetaObject *meta = metaObject();
-        const int propertyCount = type->propertyRoles.count();
-        for (int i = 0; i < propertyCount; ++i)
-            QMetaObject::activate(this, meta, i, 0);
+        rebind(model, idx);
         return true;
     } else {
         return false;
     }
 }
 
+void QQmlDMCachedModelData::rebind(const QQmlAdaptorModel &, int idx)
+{
+    index = idx;
+    cachedData.clear();
+    emit modelIndexChanged();
+    const QMetaObject *meta = metaObject();
+    const int propertyCount = type->propertyRoles.count();
+    for (int i = 0; i < propertyCount; ++i)
+        QMetaObject::activate(this, meta, i, 0);
+}
+
 QV4::ReturnedValue QQmlDMCachedModelData::get_property(QV4::CallContext *ctx, uint propertyId)
 {
     QV4::Scope scope(ctx);
@@ -621,16 +627,21 @@ public:
     bool resolveIndex(const QQmlAdaptorModel &model, int idx) override
     {
         if (index == -1) {
-            index = idx;
-            cachedData = model.list.at(idx);
-            emit modelIndexChanged();
-            emit modelDataChanged();
+            rebind(model, idx);
             return true;
         } else {
             return false;
         }
     }
 
+    void rebind(const QQmlAdaptorModel &model, int idx) override
+    {
+        index = idx;
+        cachedData = model.list.at(idx);
+        emit modelIndexChanged();
+        emit modelDataChanged();
+    }
+
 
 Q_SIGNALS:
     void modelDataChanged();
@@ -165,6 +165,22 @@ void QQmlProfilerClient::inputEvent(QQmlProfilerDefinitions::InputEventType type
     Q_UNUSED(b);
 }
 
+void QQmlProfilerClient::lookupStatistics(QQmlProfilerDefinitions::LookupType type, qint64 time,
+                                          QQmlProfilerDefinitions::LookupState state,
+                                          const QQmlEventLocation &location, const QString &name,
+                                          qint64 unit, int index, quint32 hitCount, quint32 missCount)
+{
+    Q_UNUSED(type);
+    Q_UNUSED(time);
+    Q_UNUSED(state);
+    Q_UNUSED(location);
+    Q_UNUSED(name);
+    Q_UNUSED(unit);
+    Q_UNUSED(index);
+    Q_UNUSED(hitCount);
+    Q_UNUSED(missCount);
+}
+
 void QQmlProfilerClient::complete()
 {
 }
@@ -322,6 +338,27 @@ void QQmlProfilerClient::messageReceived(const QByteArray &data)
         qint64 delta;
         stream >> type >> delta;
         memoryAllocation((QQmlProfilerDefinitions::MemoryType)type, time, delta);
+    } else if (messageType == QQmlProfilerDefinitions::LookupStatistics) {
+        if (!(d->features & one << QQmlProfilerDefinitions::ProfileLookups))
+            return;
+        int type;
+        int state;
+        quint32 hitCount;
+        quint32 missCount;
+        QQmlEventLocation location;
+        QString name;
+        qint64 unit;
+        int index;
+        stream >> type >> state >> hitCount >> missCount >> location.filename >> location.line
+               >> location.column >> name >> unit >> index;
+        if (type >= QQmlProfilerDefinitions::MaximumLookupType
+                || state >= QQmlProfilerDefinitions::MaximumLookupState) {
+            unknownEvent(QQmlProfilerDefinitions::LookupStatistics, time, type);
+            return;
+        }
+        lookupStatistics(static_cast<QQmlProfilerDefinitions::LookupType>(type), time,
+                         static_cast<QQmlProfilerDefinitions::LookupState>(state), location, name,
+                         unit, index, hitCount, missCount);
     } else {
         int range;
         stream >> range;
@@ -100,6 +100,11 @@ private:
     virtual void inputEvent(QQmlProfilerDefinitions::InputEventType type, qint64 time, int a,
                             int b);
 
+    virtual void lookupStatistics(QQmlProfilerDefinitions::LookupType type, qint64 time,
+                                  QQmlProfilerDefinitions::LookupState state,
+                                  const QQmlEventLocation &location, const QString &name,
+                                  qint64 unit, int index, quint32 hitCount, quint32 missCount);
+
     virtual void complete();
 
     virtual void unknownEvent(QQmlProfilerDefinitions::Message messageType, qint64 time,
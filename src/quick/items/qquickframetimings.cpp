@@ -0,0 +1,118 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qquickframetimings_p.h"
+
+#include <QtCore/qelapsedtimer.h>
+
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+static int frameTimingBufferSize()
+{
+    static const int size = []() {
+        bool ok = false;
+        const int frames = qEnvironmentVariableIntValue("QSG_FRAME_TIMINGS", &ok);
+        return ok ? qMax(0, frames) : 128;
+    }();
+    return size;
+}
+
+QQuickFrameTimingBuffer::QQuickFrameTimingBuffer()
+    : m_capacity(frameTimingBufferSize())
+    , m_slots(m_capacity > 0 ? new Slot[m_capacity] : nullptr)
+{
+}
+
+QQuickFrameTimingBuffer::~QQuickFrameTimingBuffer()
+{
+}
+
+/*
+    Stores \a timing as the newest frame, overwriting the oldest one when the
+    buffer is full. Frames of a window are only recorded by one thread at a time.
+ */
+void QQuickFrameTimingBuffer::record(const QQuickFrameTiming &timing)
+{
+    if (!m_capacity)
+        return;
+
+    const quint32 written = m_written.load();
+    Slot &slot = m_slots[written % quint32(m_capacity)];
+    const quint32 sequence = slot.sequence.load();
+    slot.sequence.fetchAndStoreOrdered(sequence + 1);
+
+    slot.timing = timing;
+    slot.timing.frame = written + 1;
+    slot.timing.timestamp = QElapsedTimer::msecsSinceReference();
+
+    slot.sequence.storeRelease(sequence + 2);
+    m_written.storeRelease(written + 1);
+}
+
+/*
+    Returns the last \a count frames, or all frames in the buffer if \a count
+    is negative, oldest first. Frames that are overwritten while they are read
+    are left out.
+ */
+QVector<QQuickFrameTiming> QQuickFrameTimingBuffer::frames(int count) const
+{
+    QVector<QQuickFrameTiming> result;
+    const quint32 written = m_written.loadAcquire();
+    const int available = int(qMin<quint32>(written, quint32(m_capacity)));
+    if (count < 0 || count > available)
+        count = available;
+    result.reserve(count);
+
+    for (quint32 frame = written - quint32(count); frame != written; ++frame) {
+        const Slot &slot = m_slots[frame % quint32(m_capacity)];
+        const quint32 sequence = slot.sequence.loadAcquire();
+        if (sequence & 1)
+            continue;
+        const QQuickFrameTiming timing = slot.timing;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load() != sequence || timing.frame != frame + 1)
+            continue;
+        result.append(timing);
+    }
+    return result;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,115 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QQUICKFRAMETIMINGS_P_H
+#define QQUICKFRAMETIMINGS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtquickglobal_p.h>
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+// The time spent in the phases of one frame, in nanoseconds
+struct QQuickFrameTiming
+{
+    quint32 frame = 0;          // counts from 1 for each window
+    qint64 timestamp = 0;       // when the frame was recorded, QElapsedTimer::msecsSinceReference()
+    qint64 polish = 0;
+    qint64 animations = 0;      // advancing the animations for this frame, if the render loop drives them
+    qint64 sync = 0;
+    qint64 render = 0;
+    qint64 swap = 0;
+    qint64 gc = 0;              // JavaScript garbage collection during polish and animations
+
+    qint64 total() const { return polish + animations + sync + render + swap; }
+};
+
+Q_DECLARE_TYPEINFO(QQuickFrameTiming, Q_PRIMITIVE_TYPE);
+
+/*
+    Keeps the timings of the last frames of a window. The render loop records
+    frames from the thread that finishes them, anyone can read them from any
+    thread at any time without taking a lock.
+
+    QML reads them through Window.frameTimings(), Qt's own tools and tests
+    through QQuickWindowPrivate::get(window)->frameTimings.
+ */
+class Q_QUICK_PRIVATE_EXPORT QQuickFrameTimingBuffer
+{
+public:
+    QQuickFrameTimingBuffer();
+    ~QQuickFrameTimingBuffer();
+
+    int capacity() const { return m_capacity; }
+    quint32 frameCount() const { return m_written.loadAcquire(); }
+
+    void record(const QQuickFrameTiming &timing);
+    QVector<QQuickFrameTiming> frames(int count = -1) const;
+
+private:
+    Q_DISABLE_COPY(QQuickFrameTimingBuffer)
+
+    // The sequence is odd while the slot is being written
+    struct Slot {
+        QAtomicInteger<quint32> sequence;
+        QQuickFrameTiming timing;
+    };
+
+    int m_capacity;
+    QScopedArrayPointer<Slot> m_slots;
+    QAtomicInteger<quint32> m_written;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQUICKFRAMETIMINGS_P_H
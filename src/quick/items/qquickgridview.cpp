@@ -182,10 +182,11 @@ public:
     bool addVisibleItems(qreal fillFrom, qreal fillTo, qreal bufferFrom, qreal bufferTo, bool doBuffer) override;
     bool removeNonVisibleItems(qreal bufferFrom, qreal bufferTo) override;
 
-    void removeItem(FxViewItem *item);
+    void removeItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
 
     FxViewItem *newViewItem(int index, QQuickItem *item) override;
     void initializeViewItem(FxViewItem *item) override;
+    QQuickItemViewAttached *getAttachedObject(const QObject *object) const override;
     void repositionItemAt(FxViewItem *item, int index, qreal sizeBuffer) override;
     void repositionPackageItemAt(QQuickItem *item, int index) override;
     void resetFirstItemPosition(qreal pos = 0.0) override;
@@ -472,6 +473,12 @@ void QQuickGridViewPrivate::initializeViewItem(FxViewItem *item)
     item->trackGeometry(true);
 }
 
+QQuickItemViewAttached *QQuickGridViewPrivate::getAttachedObject(const QObject *object) const
+{
+    QObject *attachedObject = qmlAttachedPropertiesObject<QQuickGridView>(object, false);
+    return static_cast<QQuickItemViewAttached *>(attachedObject);
+}
+
 bool QQuickGridViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal bufferFrom, qreal bufferTo, bool doBuffer)
 {
     qreal colPos = colPosAt(visibleIndex);
@@ -495,7 +502,7 @@ bool QQuickGridViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
         // We've jumped more than a page.  Estimate which items are now
         // visible and fill from there.
         int count = (fillFrom - (rowPos + rowSize())) / (rowSize()) * columns;
-        releaseVisibleItems();
+        releaseVisibleItems(reusableFlag());
         modelIndex += count;
         if (modelIndex >= model->count())
             modelIndex = model->count() - 1;
@@ -566,14 +573,14 @@ bool QQuickGridViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
     return changed;
 }
 
-void QQuickGridViewPrivate::removeItem(FxViewItem *item)
+void QQuickGridViewPrivate::removeItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     if (item->transitionScheduledOrRunning()) {
         qCDebug(lcItemViewDelegateLifecycle) << "\tnot releasing animating item:" << item->index << item->item->objectName();
         item->releaseAfterTransition = true;
         releasePendingTransition.append(item);
     } else {
-        releaseItem(item);
+        releaseItem(item, reusableFlag);
     }
 }
 
@@ -591,7 +598,7 @@ bool QQuickGridViewPrivate::removeNonVisibleItems(qreal bufferFrom, qreal buffer
         if (item->index != -1)
             visibleIndex++;
         visibleItems.removeFirst();
-        removeItem(item);
+        removeItem(item, reusableFlag());
         changed = true;
     }
     while (visibleItems.count() > 1
@@ -601,7 +608,7 @@ bool QQuickGridViewPrivate::removeNonVisibleItems(qreal bufferFrom, qreal buffer
             break;
         qCDebug(lcItemViewDelegateLifecycle) << "refill: remove last" << visibleIndex+visibleItems.count()-1;
         visibleItems.removeLast();
-        removeItem(item);
+        removeItem(item, reusableFlag());
         changed = true;
     }
 
@@ -1308,6 +1315,53 @@ void QQuickGridView::setHighlightFollowsCurrentItem(bool autoHighlight)
     The corresponding handler is \c onRemove.
 */
 
+/*!
+    \qmlattachedsignal QtQuick::GridView::pooled()
+    \since 5.10
+
+    This attached signal is emitted when the delegate instance is released
+    into the reuse pool instead of being destroyed.
+
+    The corresponding handler is \c onPooled.
+
+    \sa reuseItems
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::GridView::reused()
+    \since 5.10
+
+    This attached signal is emitted when the delegate instance is taken out
+    of the reuse pool and bound to a new model index. The \c index and model
+    role properties have already been updated when it is emitted.
+
+    The corresponding handler is \c onReused.
+
+    \sa reuseItems
+*/
+
+/*!
+    \qmlproperty bool QtQuick::GridView::reuseItems
+    \since 5.10
+
+    This property enables reusing delegate instances.
+
+    When true, delegates that scroll out of the view and its \l cacheBuffer are not destroyed, but kept in a pool
+    and handed out again, bound to the new model index, when the view needs
+    a delegate for another index. Flicking through a large model then mostly
+    updates existing delegates instead of creating new ones. The \l pooled()
+    and \l reused() attached signals are emitted when that happens, and
+    delegates that have not been reused within the next two refills of the
+    view are destroyed.
+
+    Delegates must not keep state that depends on the item they were
+    created for, since they can now show different model items over time.
+    Models that provide a list of objects, and delegates that are
+    \l Package items, do not support reuse.
+
+    The default value is false.
+*/
+
 
 /*!
   \qmlproperty model QtQuick::GridView::model
@@ -47,8 +47,15 @@
 #include <QtQml/qqmlinfo.h>
 #include <QtQml/qqmlfile.h>
 
+#include <QtCore/qset.h>
+
 QT_BEGIN_NAMESPACE
 
+// Images waiting for their pixmap, because it is being loaded or because its
+// pixel data has been evicted from the pixmap cache.
+typedef QSet<QQuickImageBase *> QQuickImageBaseSet;
+Q_GLOBAL_STATIC(QQuickImageBaseSet, pendingImages)
+
 // This function gives derived classes the chance set the devicePixelRatio
 // if they're not happy with our implementation of it.
 bool QQuickImageBasePrivate::updateDevicePixelRatio(qreal targetDevicePixelRatio)
@@ -73,20 +80,120 @@ bool QQuickImageBasePrivate::updateDevicePixelRatio(qreal targetDevicePixelRatio
     return setDevicePixelRatio;
 }
 
+bool QQuickImageBasePrivate::isPixmapDisplayed() const
+{
+    Q_Q(const QQuickImageBase);
+    if (!window || !effectiveVisible)
+        return false;
+    // delegates in the cacheBuffer of views are culled
+    for (const QQuickItem *item = q; item; item = item->parentItem()) {
+        if (QQuickItemPrivate::get(item)->culled)
+            return false;
+    }
+    return true;
+}
+
+// Images that are not displayed are decoded after the ones that are on screen.
+QQuickPixmap::Priority QQuickImageBasePrivate::effectiveLoadPriority() const
+{
+    return isPixmapDisplayed() ? QQuickPixmap::NormalPriority : QQuickPixmap::LowPriority;
+}
+
+void QQuickImageBasePrivate::pixmapEvicted()
+{
+    Q_Q(QQuickImageBase);
+    // The texture factory is gone, so the paint node has to let go of its
+    // texture before the next frame.
+    setPending(true);
+    q->update();
+}
+
+void QQuickImageBasePrivate::setPending(bool pending)
+{
+    Q_Q(QQuickImageBase);
+    QQuickImageBaseSet *images = pendingImages();
+    if (!images)
+        return;
+
+    if (pending)
+        images->insert(q);
+    else
+        images->remove(q);
+}
+
+void QQuickImageBasePrivate::updateLoadPriority()
+{
+    const QQuickPixmap::Priority priority = effectiveLoadPriority();
+    if (priority != loadPriority) {
+        loadPriority = priority;
+        pix.setPriority(priority);
+    }
+}
+
+// Loads an evicted pixmap again, without the status changes of a new source.
+void QQuickImageBasePrivate::reloadEvictedPixmap()
+{
+    Q_Q(QQuickImageBase);
+    const QUrl loadUrl = pix.url();
+    const QSize loadSize = pix.requestSize();
+    QQuickPixmap::Options options = QQuickPixmap::Asynchronous;
+    if (cache)
+        options |= QQuickPixmap::Cache;
+
+    pix.load(qmlEngine(q), loadUrl, loadSize, options, providerOptions);
+
+    if (pix.isLoading()) {
+        static int thisReloadFinished = -1;
+        if (thisReloadFinished == -1)
+            thisReloadFinished = QQuickImageBase::staticMetaObject.indexOfSlot("reloadFinished()");
+        pix.connectFinished(q, thisReloadFinished);
+        loadPriority = QQuickPixmap::NormalPriority;
+        updateLoadPriority();
+    } else {
+        q->reloadFinished();
+    }
+}
+
+// Called before each frame, once views have culled the delegates that are
+// outside of their visible area.
+void QQuickImageBasePrivate::updatePendingImages()
+{
+    if (!pendingImages.exists() || pendingImages->isEmpty())
+        return;
+
+    // reloading an image changes the set
+    const QList<QQuickImageBase *> images = pendingImages->values();
+    for (QQuickImageBase *image : images) {
+        QQuickImageBasePrivate *d = static_cast<QQuickImageBasePrivate *>(QQuickItemPrivate::get(image));
+        if (d->pix.isEvicted()) {
+            if (d->isPixmapDisplayed())
+                d->reloadEvictedPixmap();
+        } else if (d->pix.isLoading()) {
+            d->updateLoadPriority();
+        }
+    }
+}
+
 QQuickImageBase::QQuickImageBase(QQuickItem *parent)
 : QQuickImplicitSizeItem(*(new QQuickImageBasePrivate), parent)
 {
+    Q_D(QQuickImageBase);
     setFlag(ItemHasContents);
+    d->pix.setEvictionHandler(d);
 }
 
 QQuickImageBase::QQuickImageBase(QQuickImageBasePrivate &dd, QQuickItem *parent)
 : QQuickImplicitSizeItem(dd, parent)
 {
+    Q_D(QQuickImageBase);
     setFlag(ItemHasContents);
+    d->pix.setEvictionHandler(d);
 }
 
 QQuickImageBase::~QQuickImageBase()
 {
+    Q_D(QQuickImageBase);
+    d->setPending(false);
 }
 
 QQuickImageBase::Status QQuickImageBase::status() const
@@ -212,6 +319,8 @@ void QQuickImageBase::load()
 {
     Q_D(QQuickImageBase);
 
+    d->setPending(false);
+
     if (d->url.isEmpty()) {
         d->pix.clear(this);
         if (d->progress != 0.0) {
@@ -278,6 +387,9 @@ void QQuickImageBase::load()
 
             d->pix.connectFinished(this, thisRequestFinished);
             d->pix.connectDownloadProgress(this, thisRequestProgress);
+            d->setPending(true);
+            d->loadPriority = QQuickPixmap::NormalPriority;
+            d->updateLoadPriority();
             update(); //pixmap may have invalidated texture, updatePaintNode needs to be called before the next repaint
         } else {
             requestFinished();
@@ -289,6 +401,8 @@ void QQuickImageBase::requestFinished()
 {
     Q_D(QQuickImageBase);
 
+    d->setPending(false);
+
     if (d->pix.isError()) {
         qmlWarning(this) << d->pix.error();
         d->pix.clear(this);
@@ -317,6 +431,20 @@ void QQuickImageBase::requestFinished()
     update();
 }
 
+void QQuickImageBase::reloadFinished()
+{
+    Q_D(QQuickImageBase);
+
+    d->setPending(false);
+    if (d->pix.isError()) {
+        // report it like any failed load
+        requestFinished();
+        return;
+    }
+    pixmapChange();
+    update();
+}
+
 void QQuickImageBase::requestProgress(qint64 received, qint64 total)
 {
     Q_D(QQuickImageBase);
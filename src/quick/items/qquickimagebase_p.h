@@ -123,6 +123,7 @@ protected:
 private Q_SLOTS:
     virtual void requestFinished();
     void requestProgress(qint64,qint64);
+    void reloadFinished();
 
 private:
     Q_DISABLE_COPY(QQuickImageBase)
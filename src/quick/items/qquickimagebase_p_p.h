@@ -59,7 +59,8 @@
 QT_BEGIN_NAMESPACE
 
 class QNetworkReply;
-class Q_QUICK_PRIVATE_EXPORT QQuickImageBasePrivate : public QQuickImplicitSizeItemPrivate
+class Q_QUICK_PRIVATE_EXPORT QQuickImageBasePrivate : public QQuickImplicitSizeItemPrivate,
+                                                      public QQuickPixmapEvictionHandler
 {
     Q_DECLARE_PUBLIC(QQuickImageBase)
 
@@ -68,6 +69,7 @@ public:
       : status(QQuickImageBase::Null),
         progress(0.0),
         devicePixelRatio(1.0),
+        loadPriority(QQuickPixmap::NormalPriority),
         async(false),
         cache(true),
         mirror(false),
@@ -77,6 +79,15 @@ public:
 
     virtual bool updateDevicePixelRatio(qreal targetDevicePixelRatio);
 
+    bool isPixmapDisplayed() const override;
+    void pixmapEvicted() override;
+
+    QQuickPixmap::Priority effectiveLoadPriority() const;
+    void updateLoadPriority();
+    void setPending(bool pending);
+    void reloadEvictedPixmap();
+    static void updatePendingImages();
+
     QQuickPixmap pix;
     QQuickImageBase::Status status;
     QUrl url;
@@ -85,6 +96,7 @@ public:
     QSize oldSourceSize;
     qreal devicePixelRatio;
     QQuickImageProviderOptions providerOptions;
+    QQuickPixmap::Priority loadPriority;
     bool async : 1;
     bool cache : 1;
     bool mirror: 1;
@@ -3116,6 +3116,47 @@ void QQuickItemPrivate::itemToParentTransform(QTransform &t) const
     }
 }
 
+/*!
+    Returns the bounding rect of this item and all of its descendants, in the
+    coordinates of the parent item. QQuickWindow uses this to skip whole
+    subtrees when looking for the items under a point. It is computed on demand
+    and cached until the geometry of the item or one of its descendants changes.
+*/
+QRectF QQuickItemPrivate::subtreeRect()
+{
+    if (subtreeRectValid)
+        return cachedSubtreeRect;
+
+    QRectF rect = QRectF(0, 0, width, height).normalized();
+    for (QQuickItem *child : qAsConst(childItems))
+        rect |= QQuickItemPrivate::get(child)->subtreeRect();
+
+    QTransform t;
+    itemToParentTransform(t);
+    if (t.type() == QTransform::TxProject) {
+        // Points behind the projection can end up anywhere
+        const qreal unbounded = 1e12;
+        cachedSubtreeRect = QRectF(-unbounded, -unbounded, 2 * unbounded, 2 * unbounded);
+    } else {
+        cachedSubtreeRect = t.mapRect(rect);
+    }
+    subtreeRectValid = true;
+    return cachedSubtreeRect;
+}
+
+/*!
+    Invalidates the cached subtree rect of this item and its ancestors. An
+    item's cached rect is only ever valid if the ones of all its descendants
+    are, so the walk can stop at the first ancestor that is invalid already.
+*/
+void QQuickItemPrivate::invalidateSubtreeRect()
+{
+    for (QQuickItemPrivate *d = this; d && d->subtreeRectValid;
+         d = d->parentItem ? QQuickItemPrivate::get(d->parentItem) : nullptr) {
+        d->subtreeRectValid = false;
+    }
+}
+
 /*!
     Returns a transform that maps points from window space into global space.
 */
@@ -3195,6 +3236,7 @@ QQuickItemPrivate::QQuickItemPrivate()
 #else
     , touchEnabled(false)
 #endif
+    , subtreeRectValid(false)
     , dirtyAttributes(0)
     , nextDirtyItem(0)
     , prevDirtyItem(0)
@@ -6018,6 +6060,8 @@ void QQuickItemPrivate::dirty(DirtyType type)
     Q_Q(QQuickItem);
     if (type & (TransformOrigin | Transform | BasicTransform | Position | Size))
         transformChanged();
+    if (type & (TransformOrigin | Transform | BasicTransform | Position | Size | ChildrenChanged))
+        invalidateSubtreeRect();
 
     if (!(dirtyAttributes & type) || (window && !prevDirtyItem)) {
         dirtyAttributes |= type;
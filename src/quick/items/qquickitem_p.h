@@ -441,6 +441,7 @@ public:
     bool isTabFence:1;
     bool replayingPressEvent:1;
     bool touchEnabled:1;
+    bool subtreeRectValid:1;
 
     enum DirtyType {
         TransformOrigin         = 0x00000001,
@@ -512,6 +513,9 @@ public:
     QTransform globalToWindowTransform() const;
     QTransform windowToGlobalTransform() const;
 
+    QRectF subtreeRect();
+    void invalidateSubtreeRect();
+
     static bool focusNextPrev(QQuickItem *item, bool forward);
     static QQuickItem *nextTabChildItem(const QQuickItem *item, int start);
     static QQuickItem *prevTabChildItem(const QQuickItem *item, int start);
@@ -528,6 +532,9 @@ public:
 
     qreal baselineOffset;
 
+    // Bounding rect of the item and all of its descendants, in the parent's coordinates
+    QRectF cachedSubtreeRect;
+
     QList<QQuickTransform *> transforms;
 
     inline qreal z() const { return extra.isAllocated()?extra->z:0; }
@@ -399,6 +399,18 @@ static void qt_quickitems_defineModule(const char *uri, int major, int minor)
     qmlRegisterType<QQuickFlickable, 10>(uri, 2, 10, "Flickable");
     qmlRegisterType<QQuickTextEdit, 10>(uri, 2, 10, "TextEdit");
     qmlRegisterType<QQuickText, 10>(uri, 2, 10, "Text");
+#if QT_CONFIG(quick_listview)
+    qmlRegisterType<QQuickListView, 10>(uri, 2, 10, "ListView");
+#endif
+#if QT_CONFIG(quick_gridview)
+    qmlRegisterType<QQuickGridView, 10>(uri, 2, 10, "GridView");
+#endif
+#if QT_CONFIG(quick_pathview)
+    qmlRegisterType<QQuickPathView, 10>(uri, 2, 10, "PathView");
+#endif
+#if QT_CONFIG(quick_itemview)
+    qmlRegisterUncreatableType<QQuickItemView, 10>(uri, 2, 10, itemViewName, itemViewMessage);
+#endif
 }
 
 static void initResources()
@@ -299,6 +299,8 @@ void QQuickItemView::setModel(const QVariant &m)
         disconnect(d->model, SIGNAL(initItem(int,QObject*)), this, SLOT(initItem(int,QObject*)));
         disconnect(d->model, SIGNAL(createdItem(int,QObject*)), this, SLOT(createdItem(int,QObject*)));
         disconnect(d->model, SIGNAL(destroyingItem(QObject*)), this, SLOT(destroyingItem(QObject*)));
+        disconnect(d->model, SIGNAL(itemPooled(int,QObject*)), this, SLOT(onItemPooled(int,QObject*)));
+        disconnect(d->model, SIGNAL(itemReused(int,QObject*)), this, SLOT(onItemReused(int,QObject*)));
     }
 
     QQmlInstanceModel *oldModel = d->model;
@@ -334,6 +336,8 @@ void QQuickItemView::setModel(const QVariant &m)
         connect(d->model, SIGNAL(createdItem(int,QObject*)), this, SLOT(createdItem(int,QObject*)));
         connect(d->model, SIGNAL(initItem(int,QObject*)), this, SLOT(initItem(int,QObject*)));
         connect(d->model, SIGNAL(destroyingItem(QObject*)), this, SLOT(destroyingItem(QObject*)));
+        connect(d->model, SIGNAL(itemPooled(int,QObject*)), this, SLOT(onItemPooled(int,QObject*)));
+        connect(d->model, SIGNAL(itemReused(int,QObject*)), this, SLOT(onItemReused(int,QObject*)));
         if (isComponentComplete()) {
             d->updateSectionCriteria();
             d->refill();
@@ -796,6 +800,24 @@ void QQuickItemView::setHighlightMoveDuration(int duration)
     }
 }
 
+bool QQuickItemView::reuseItems() const
+{
+    Q_D(const QQuickItemView);
+    return d->reuseItems;
+}
+
+void QQuickItemView::setReuseItems(bool reuse)
+{
+    Q_D(QQuickItemView);
+    if (d->reuseItems == reuse)
+        return;
+
+    d->reuseItems = reuse;
+    if (!reuse && d->model)
+        d->model->drainReusableItemsPool(0);
+    emit reuseItemsChanged();
+}
+
 QQuickTransition *QQuickItemView::populateTransition() const
 {
     Q_D(const QQuickItemView);
@@ -1560,7 +1582,7 @@ QQuickItemViewPrivate::QQuickItemViewPrivate()
     , explicitKeyNavigationEnabled(false)
     , inLayout(false), inViewportMoved(false), forceLayout(false), currentIndexCleared(false)
     , haveHighlightRange(false), autoHighlight(true), highlightRangeStartValid(false), highlightRangeEndValid(false)
-    , fillCacheBuffer(false), inRequest(false)
+    , fillCacheBuffer(false), reuseItems(false), inRequest(false)
     , runDelayedRemoveTransition(false), delegateValidated(false)
 {
     bufferPause.addAnimationChangeListener(this, QAbstractAnimationJob::Completion);
@@ -1760,6 +1782,8 @@ void QQuickItemViewPrivate::clear()
             model->cancel(requestedIndex);
         requestedIndex = -1;
     }
+    if (model)
+        model->drainReusableItemsPool(0);
 
     markExtentsDirty();
     itemCount = 0;
@@ -1809,6 +1833,11 @@ void QQuickItemViewPrivate::refill(qreal from, qreal to)
     bool added = addVisibleItems(fillFrom, fillTo, bufferFrom, bufferTo, false);
     bool removed = removeNonVisibleItems(bufferFrom, bufferTo);
 
+    // Delegates released for reuse that were not picked up again by the
+    // next couple of refills are not needed for the current scroll.
+    if (reuseItems)
+        model->drainReusableItemsPool(2);
+
     if (requestedIndex == -1 && buffer && bufferMode != NoBuffer) {
         if (added) {
             // We've already created a new delegate this frame.
@@ -2402,7 +2431,23 @@ void QQuickItemView::destroyingItem(QObject *object)
     }
 }
 
-bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
+void QQuickItemView::onItemPooled(int modelIndex, QObject *object)
+{
+    Q_D(QQuickItemView);
+    Q_UNUSED(modelIndex);
+    if (QQuickItemViewAttached *attached = d->getAttachedObject(object))
+        emit attached->pooled();
+}
+
+void QQuickItemView::onItemReused(int modelIndex, QObject *object)
+{
+    Q_D(QQuickItemView);
+    Q_UNUSED(modelIndex);
+    if (QQuickItemViewAttached *attached = d->getAttachedObject(object))
+        emit attached->reused();
+}
+
+bool QQuickItemViewPrivate::releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     Q_Q(QQuickItemView);
     if (!item || !model)
@@ -2411,7 +2456,7 @@ bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
         trackedItem = 0;
     item->trackGeometry(false);
 
-    QQmlInstanceModel::ReleaseFlags flags = model->release(item->item);
+    QQmlInstanceModel::ReleaseFlags flags = model->release(item->item, reusableFlag);
     if (item->item) {
         if (flags == 0) {
             // item was not destroyed, and we no longer reference it.
@@ -2419,6 +2464,9 @@ bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
             unrequestedItems.insert(item->item, model->indexOf(item->item, q));
         } else if (flags & QQmlInstanceModel::Destroyed) {
             item->item->setParentItem(0);
+        } else if (flags & QQmlInstanceModel::Pooled) {
+            // keep it parented to the view, but out of the way until it is reused
+            QQuickItemPrivate::get(item->item)->setCulled(true);
         }
     }
     delete item;
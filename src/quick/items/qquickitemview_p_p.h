@@ -207,7 +207,11 @@ public:
     void mirrorChange() override;
 
     FxViewItem *createItem(int modelIndex, bool asynchronous = false);
-    virtual bool releaseItem(FxViewItem *item);
+    virtual bool releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
+    virtual QQuickItemViewAttached *getAttachedObject(const QObject *) const { return nullptr; }
+    QQmlInstanceModel::ReusableFlag reusableFlag() const {
+        return reuseItems ? QQmlInstanceModel::Reusable : QQmlInstanceModel::NotReusable;
+    }
 
     QQuickItem *createHighlightItem() const;
     QQuickItem *createComponentItem(QQmlComponent *component, qreal zValue, bool createDefault = false) const;
@@ -269,13 +273,13 @@ public:
         q->polish();
     }
 
-    void releaseVisibleItems() {
+    void releaseVisibleItems(QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable) {
         // make a copy and clear the visibleItems first to avoid destroyed
         // items being accessed during the loop (QTBUG-61294)
         const QList<FxViewItem *> oldVisible = visibleItems;
         visibleItems.clear();
         for (FxViewItem *item : oldVisible)
-            releaseItem(item);
+            releaseItem(item, reusableFlag);
     }
 
     QPointer<QQmlInstanceModel> model;
@@ -338,6 +342,7 @@ public:
     bool highlightRangeStartValid : 1;
     bool highlightRangeEndValid : 1;
     bool fillCacheBuffer : 1;
+    bool reuseItems : 1;
     bool inRequest : 1;
     bool runDelayedRemoveTransition : 1;
     bool delegateValidated : 1;
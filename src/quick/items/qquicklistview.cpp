@@ -87,11 +87,12 @@ public:
     bool removeNonVisibleItems(qreal bufferFrom, qreal bufferTo) override;
     void visibleItemsChanged() override;
 
-    void removeItem(FxViewItem *item);
+    void removeItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
 
     FxViewItem *newViewItem(int index, QQuickItem *item) override;
     void initializeViewItem(FxViewItem *item) override;
-    bool releaseItem(FxViewItem *item) override;
+    QQuickItemViewAttached *getAttachedObject(const QObject *object) const override;
+    bool releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable) override;
     void repositionItemAt(FxViewItem *item, int index, qreal sizeBuffer) override;
     void repositionPackageItemAt(QQuickItem *item, int index) override;
     void resetFirstItemPosition(qreal pos = 0.0) override;
@@ -613,7 +614,13 @@ void QQuickListViewPrivate::initializeViewItem(FxViewItem *item)
     }
 }
 
-bool QQuickListViewPrivate::releaseItem(FxViewItem *item)
+QQuickItemViewAttached *QQuickListViewPrivate::getAttachedObject(const QObject *object) const
+{
+    QObject *attachedObject = qmlAttachedPropertiesObject<QQuickListView>(object, false);
+    return static_cast<QQuickItemViewAttached *>(attachedObject);
+}
+
+bool QQuickListViewPrivate::releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     if (!item || !model)
         return true;
@@ -621,7 +628,7 @@ bool QQuickListViewPrivate::releaseItem(FxViewItem *item)
     QPointer<QQuickItem> it = item->item;
     QQuickListViewAttached *att = static_cast<QQuickListViewAttached*>(item->attached);
 
-    bool released = QQuickItemViewPrivate::releaseItem(item);
+    bool released = QQuickItemViewPrivate::releaseItem(item, reusableFlag);
     if (released && it && att && att->m_sectionItem) {
         // We hold no more references to this item
         int i = 0;
@@ -661,7 +668,7 @@ bool QQuickListViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
         int newModelIdx = qBound(0, modelIndex + count, model->count());
         count = newModelIdx - modelIndex;
         if (count) {
-            releaseVisibleItems();
+            releaseVisibleItems(reusableFlag());
             modelIndex = newModelIdx;
             visibleIndex = modelIndex;
             visiblePos = itemEnd + count * (averageSize + spacing);
@@ -706,7 +713,7 @@ bool QQuickListViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
     return changed;
 }
 
-void QQuickListViewPrivate::removeItem(FxViewItem *item)
+void QQuickListViewPrivate::removeItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     if (item->transitionScheduledOrRunning()) {
         qCDebug(lcItemViewDelegateLifecycle) << "\tnot releasing animating item" << item->index << (QObject *)(item->item);
@@ -714,7 +721,7 @@ void QQuickListViewPrivate::removeItem(FxViewItem *item)
         releasePendingTransition.append(item);
     } else {
         qCDebug(lcItemViewDelegateLifecycle) << "\treleasing stationary item" << item->index << (QObject *)(item->item);
-        releaseItem(item);
+        releaseItem(item, reusableFlag);
     }
 }
 
@@ -740,7 +747,7 @@ bool QQuickListViewPrivate::removeNonVisibleItems(qreal bufferFrom, qreal buffer
                 if (item->index != -1)
                     visibleIndex++;
                 visibleItems.removeAt(index);
-                removeItem(item);
+                removeItem(item, reusableFlag());
                 if (index == 0)
                     break;
                 item = visibleItems.at(--index);
@@ -756,7 +763,7 @@ bool QQuickListViewPrivate::removeNonVisibleItems(qreal bufferFrom, qreal buffer
             break;
         qCDebug(lcItemViewDelegateLifecycle) << "refill: remove last" << visibleIndex+visibleItems.count()-1 << item->position() << (QObject *)(item->item);
         visibleItems.removeLast();
-        removeItem(item);
+        removeItem(item, reusableFlag());
         changed = true;
     }
 
@@ -1972,6 +1979,53 @@ QQuickListView::~QQuickListView()
     The corresponding handler is \c onRemove.
 */
 
+/*!
+    \qmlattachedsignal QtQuick::ListView::pooled()
+    \since 5.10
+
+    This attached signal is emitted when the delegate instance is released
+    into the reuse pool instead of being destroyed.
+
+    The corresponding handler is \c onPooled.
+
+    \sa reuseItems
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::ListView::reused()
+    \since 5.10
+
+    This attached signal is emitted when the delegate instance is taken out
+    of the reuse pool and bound to a new model index. The \c index and model
+    role properties have already been updated when it is emitted.
+
+    The corresponding handler is \c onReused.
+
+    \sa reuseItems
+*/
+
+/*!
+    \qmlproperty bool QtQuick::ListView::reuseItems
+    \since 5.10
+
+    This property enables reusing delegate instances.
+
+    When true, delegates that scroll out of the view and its \l cacheBuffer are not destroyed, but kept in a pool
+    and handed out again, bound to the new model index, when the view needs
+    a delegate for another index. Flicking through a large model then mostly
+    updates existing delegates instead of creating new ones. The \l pooled()
+    and \l reused() attached signals are emitted when that happens, and
+    delegates that have not been reused within the next two refills of the
+    view are destroyed.
+
+    Delegates must not keep state that depends on the item they were
+    created for, since they can now show different model items over time.
+    Models that provide a list of objects, and delegates that are
+    \l Package items, do not support reuse.
+
+    The default value is false.
+*/
+
 /*!
     \qmlproperty model QtQuick::ListView::model
     This property holds the model providing data for the list.
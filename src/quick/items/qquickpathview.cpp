@@ -95,7 +95,7 @@ QQuickPathViewPrivate::QQuickPathViewPrivate()
     , stealMouse(false), ownModel(false), interactive(true), haveHighlightRange(true)
     , autoHighlight(true), highlightUp(false), layoutScheduled(false)
     , moving(false), flicking(false), dragging(false), inRequest(false), delegateValidated(false)
-    , inRefill(false)
+    , inRefill(false), reuseItems(false)
     , dragMargin(0), deceleration(100), maximumFlickVelocity(QML_FLICK_DEFAULTMAXVELOCITY)
     , moveOffset(this, &QQuickPathViewPrivate::setAdjustedOffset), flickDuration(0)
     , pathItems(-1), requestedIndex(-1), cacheSize(0), requestedZ(0)
@@ -195,14 +195,14 @@ void QQuickPathView::initItem(int index, QObject *object)
     }
 }
 
-void QQuickPathViewPrivate::releaseItem(QQuickItem *item)
+void QQuickPathViewPrivate::releaseItem(QQuickItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     if (!item || !model)
         return;
     qCDebug(lcItemViewDelegateLifecycle) << "release" << item;
     QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
     itemPrivate->removeItemChangeListener(this, QQuickItemPrivate::Geometry);
-    QQmlInstanceModel::ReleaseFlags flags = model->release(item);
+    QQmlInstanceModel::ReleaseFlags flags = model->release(item, reusableFlag);
     if (!flags) {
         // item was not destroyed, and we no longer reference it.
         if (QQuickPathViewAttached *att = attached(item))
@@ -210,6 +210,13 @@ void QQuickPathViewPrivate::releaseItem(QQuickItem *item)
     } else if (flags & QQmlInstanceModel::Destroyed) {
         // but we still reference it
         item->setParentItem(nullptr);
+    } else if (flags & QQmlInstanceModel::Pooled) {
+        // make sure updateItem() places it again once it is reused
+        if (QQuickPathViewAttached *att = attached(item)) {
+            att->m_percent = -1;
+            att->setOnPath(false);
+        }
+        itemPrivate->setCulled(true);
     }
 }
 
@@ -248,6 +255,8 @@ void QQuickPathViewPrivate::clear()
             model->cancel(requestedIndex);
         requestedIndex = -1;
     }
+    if (model)
+        model->drainReusableItemsPool(0);
 
     items.clear();
     tl.clear();
@@ -579,6 +588,27 @@ QQuickPathView::~QQuickPathView()
     It is attached to each instance of the delegate.
 */
 
+/*!
+    \qmlattachedsignal QtQuick::PathView::pooled()
+    \since 5.10
+
+    This attached signal is emitted when the delegate instance is released
+    into the reuse pool instead of being destroyed.
+
+    \sa reuseItems
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::PathView::reused()
+    \since 5.10
+
+    This attached signal is emitted when the delegate instance is taken out
+    of the reuse pool and bound to a new model index. The \c index and model
+    role properties have already been updated when it is emitted.
+
+    \sa reuseItems
+*/
+
 /*!
     \qmlattachedproperty bool QtQuick::PathView::isCurrentItem
     This attached property is true if this delegate is the current item; otherwise false.
@@ -625,6 +655,10 @@ void QQuickPathView::setModel(const QVariant &m)
                              this, QQuickPathView, SLOT(createdItem(int,QObject*)));
         qmlobject_disconnect(d->model, QQmlInstanceModel, SIGNAL(initItem(int,QObject*)),
                              this, QQuickPathView, SLOT(initItem(int,QObject*)));
+        qmlobject_disconnect(d->model, QQmlInstanceModel, SIGNAL(itemPooled(int,QObject*)),
+                             this, QQuickPathView, SLOT(onItemPooled(int,QObject*)));
+        qmlobject_disconnect(d->model, QQmlInstanceModel, SIGNAL(itemReused(int,QObject*)),
+                             this, QQuickPathView, SLOT(onItemReused(int,QObject*)));
         d->clear();
     }
 
@@ -656,6 +690,10 @@ void QQuickPathView::setModel(const QVariant &m)
                           this, QQuickPathView, SLOT(createdItem(int,QObject*)));
         qmlobject_connect(d->model, QQmlInstanceModel, SIGNAL(initItem(int,QObject*)),
                           this, QQuickPathView, SLOT(initItem(int,QObject*)));
+        qmlobject_connect(d->model, QQmlInstanceModel, SIGNAL(itemPooled(int,QObject*)),
+                          this, QQuickPathView, SLOT(onItemPooled(int,QObject*)));
+        qmlobject_connect(d->model, QQmlInstanceModel, SIGNAL(itemReused(int,QObject*)),
+                          this, QQuickPathView, SLOT(onItemReused(int,QObject*)));
         d->modelCount = d->model->count();
     }
     if (isComponentComplete()) {
@@ -1026,6 +1064,43 @@ void QQuickPathView::setHighlightMoveDuration(int duration)
     emit highlightMoveDurationChanged();
 }
 
+/*!
+    \qmlproperty bool QtQuick::PathView::reuseItems
+    \since 5.10
+
+    This property enables reusing delegate instances.
+
+    When true, delegates that move off the path are not destroyed, but kept
+    in a pool and handed out again, bound to the new model index, when the
+    view needs a delegate for another index. The \l {PathView::pooled()}{pooled()}
+    and \l {PathView::reused()}{reused()} attached signals are emitted
+    when that happens. Delegates that have not been reused within the
+    next two refills of the view are destroyed.
+
+    Delegates must not keep state that depends on the item they were
+    created for, since they can now show different model items over time.
+    Models that provide a list of objects do not support reuse.
+
+    The default value is false.
+*/
+bool QQuickPathView::reuseItems() const
+{
+    Q_D(const QQuickPathView);
+    return d->reuseItems;
+}
+
+void QQuickPathView::setReuseItems(bool reuse)
+{
+    Q_D(QQuickPathView);
+    if (d->reuseItems == reuse)
+        return;
+
+    d->reuseItems = reuse;
+    if (!reuse && d->model)
+        d->model->drainReusableItemsPool(0);
+    emit reuseItemsChanged();
+}
+
 /*!
     \qmlproperty real QtQuick::PathView::dragMargin
     This property holds the maximum distance from the path that initiates mouse dragging.
@@ -1974,7 +2049,7 @@ void QQuickPathView::refill()
                 att->setOnPath(pos < 1.0);
             if (!d->isInBound(pos, d->mappedRange - d->mappedCache, 1.0 + d->mappedCache)) {
                 qCDebug(lcItemViewDelegateLifecycle) << "release" << idx << "@" << pos << ", !isInBound: lower" << (d->mappedRange - d->mappedCache) << "upper" << (1.0 + d->mappedCache);
-                d->releaseItem(item);
+                d->releaseItem(item, d->reuseItems ? QQmlInstanceModel::Reusable : QQmlInstanceModel::NotReusable);
                 it = d->items.erase(it);
             } else {
                 ++it;
@@ -2159,6 +2234,8 @@ void QQuickPathView::refill()
     for (QQuickItem *item : qAsConst(d->itemCache))
         d->releaseItem(item);
     d->itemCache.clear();
+    if (d->reuseItems)
+        d->model->drainReusableItemsPool(2);
 
     d->inRefill = false;
     if (currentChanged)
@@ -2269,6 +2346,28 @@ void QQuickPathView::destroyingItem(QObject *item)
     Q_UNUSED(item);
 }
 
+void QQuickPathView::onItemPooled(int modelIndex, QObject *object)
+{
+    Q_D(QQuickPathView);
+    Q_UNUSED(modelIndex);
+    if (QQuickItem *item = qmlobject_cast<QQuickItem *>(object)) {
+        if (QQuickPathViewAttached *att = d->attached(item))
+            emit att->pooled();
+    }
+}
+
+void QQuickPathView::onItemReused(int modelIndex, QObject *object)
+{
+    Q_D(QQuickPathView);
+    QQuickItem *item = qmlobject_cast<QQuickItem *>(object);
+    if (!item)
+        return;
+    if (d->positionOfIndex(modelIndex) < 1.0)
+        item->setZ(d->requestedZ);
+    if (QQuickPathViewAttached *att = d->attached(item))
+        emit att->reused();
+}
+
 void QQuickPathView::ticked()
 {
     Q_D(QQuickPathView);
@@ -97,7 +97,7 @@ public:
     }
 
     QQuickItem *getItem(int modelIndex, qreal z = 0, bool async=false);
-    void releaseItem(QQuickItem *item);
+    void releaseItem(QQuickItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
     QQuickPathViewAttached *attached(QQuickItem *item);
     QQmlOpenMetaObjectType *attachedType();
     void clear();
@@ -157,6 +157,7 @@ public:
     bool inRequest : 1;
     bool delegateValidated : 1;
     bool inRefill : 1;
+    bool reuseItems : 1;
     QElapsedTimer timer;
     qint64 lastPosTime;
     QPointF lastPos;
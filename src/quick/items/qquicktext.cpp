@@ -64,6 +64,8 @@
 #include <private/qquickstyledtext_p.h>
 #include <QtQuick/private/qquickpixmapcache_p.h>
 
+#include <QtCore/qcache.h>
+
 #include <qmath.h>
 #include <limits.h>
 
@@ -359,6 +361,8 @@ void QQuickTextPrivate::updateSize()
             return;
     }
 
+    cachedLayout.reset();
+
     qreal hPadding = q->leftPadding() + q->rightPadding();
     qreal vPadding = q->topPadding() + q->bottomPadding();
 
@@ -639,6 +643,251 @@ void QQuickTextPrivate::clearFormats()
     already absolutely positioned horizontally).
 */
 
+bool operator==(const QQuickTextLayoutCacheKey &lhs, const QQuickTextLayoutCacheKey &rhs)
+{
+    return lhs.lineWidth == rhs.lineWidth
+            && lhs.availableWidth == rhs.availableWidth
+            && lhs.availableHeight == rhs.availableHeight
+            && lhs.lineHeight == rhs.lineHeight
+            && lhs.maximumLineCount == rhs.maximumLineCount
+            && lhs.lineHeightMode == rhs.lineHeightMode
+            && lhs.wrapMode == rhs.wrapMode
+            && lhs.elideMode == rhs.elideMode
+            && lhs.hAlign == rhs.hAlign
+            && lhs.renderType == rhs.renderType
+            && lhs.state == rhs.state
+            && lhs.text == rhs.text
+            && lhs.font == rhs.font;
+}
+
+uint qHash(const QQuickTextLayoutCacheKey &key, uint seed)
+{
+    seed = qHash(key.text, seed);
+    seed = qHash(key.font, seed);
+    seed = qHash(key.lineWidth, seed);
+    seed = qHash(key.availableWidth, seed);
+    seed = qHash(key.availableHeight, seed);
+    return qHash((key.wrapMode << 24) ^ (key.elideMode << 16) ^ (key.hAlign << 8) ^ key.state, seed);
+}
+
+QQuickTextLayoutCacheEntry::QQuickTextLayoutCacheEntry()
+    : layout(0), elideLayout(0), baseline(0), naturalWidth(0), naturalHeight(0), lineWidth(0)
+    , lineCount(0), truncated(false), widthExceeded(false), heightExceeded(false)
+    , widthValid(false), heightValid(false), availableWidth(0), availableHeight(0)
+{
+}
+
+QQuickTextLayoutCacheEntry::~QQuickTextLayoutCacheEntry()
+{
+    delete layout;
+    delete elideLayout;
+}
+
+// The cost of the layout cache is the number of characters of the cached texts.
+static int textLayoutCacheSize()
+{
+    bool ok = false;
+    const int size = qEnvironmentVariableIntValue("QML_TEXT_LAYOUT_CACHE_SIZE", &ok);
+    return ok ? qMax(0, size) : 32768;
+}
+
+// The cached layouts hold on to font engines, so the cache is cleared when the application
+// object goes away, before the fonts get cleaned up, rather than at exit.
+static void clearTextLayoutCache();
+static void addClearTextLayoutCache()
+{
+    qAddPostRoutine(clearTextLayoutCache);
+}
+
+typedef QCache<QQuickTextLayoutCacheKey, QSharedPointer<QQuickTextLayoutCacheEntry> > QQuickTextLayoutCacheBase;
+class QQuickTextLayoutCache : public QQuickTextLayoutCacheBase
+{
+public:
+    QQuickTextLayoutCache()
+        : QQuickTextLayoutCacheBase(textLayoutCacheSize())
+    {
+        qAddPostRoutine(clearTextLayoutCache);
+        qAddPreRoutine(addClearTextLayoutCache);
+    }
+
+    ~QQuickTextLayoutCache()
+    {
+        qRemovePostRoutine(clearTextLayoutCache);
+    }
+};
+Q_GLOBAL_STATIC(QQuickTextLayoutCache, textLayoutCache)
+
+static void clearTextLayoutCache()
+{
+    if (QQuickTextLayoutCache *cache = textLayoutCache())
+        cache->clear();
+}
+
+bool QQuickTextPrivate::canUseLayoutCache() const
+{
+    // Styled and rich text carry formats and images, and the font size modes and
+    // multi-length strings may lay the text out several times, only plain text
+    // laid out once can be shared.
+    if (richText || styledText || multilengthEos != -1 || fontSizeMode() != QQuickText::FixedSize)
+        return false;
+    if (extra.isAllocated() && !extra->imgTags.isEmpty())
+        return false;
+    const QQuickTextLayoutCache *cache = textLayoutCache();
+    return cache && cache->maxCost() > 0;
+}
+
+QQuickTextLayoutCacheKey QQuickTextPrivate::layoutCacheKey(qreal lineWidth) const
+{
+    Q_Q(const QQuickText);
+
+    QQuickTextLayoutCacheKey key;
+    key.text = layout.text();
+    key.font = font;
+    key.lineWidth = lineWidth;
+    key.availableWidth = availableWidth();
+    key.availableHeight = availableHeight();
+    key.lineHeight = lineHeight();
+    key.maximumLineCount = maximumLineCount();
+    key.lineHeightMode = lineHeightMode();
+    key.wrapMode = wrapMode;
+    key.elideMode = elideMode;
+    key.hAlign = q->effectiveHAlign();
+    key.renderType = renderType;
+    key.state = (q->widthValid() ? 0x01 : 0)
+            | (q->heightValid() ? 0x02 : 0)
+            | (implicitWidthValid ? 0x04 : 0)
+            | (implicitHeightValid ? 0x08 : 0)
+            | (requireImplicitSize ? 0x10 : 0)
+            | (maximumLineCountValid ? 0x20 : 0);
+    return key;
+}
+
+bool QQuickTextPrivate::applyCachedLayout(
+        const QQuickTextLayoutCacheKey &key, bool wasTruncated, qreal *baseline, QRectF *rect)
+{
+    Q_Q(QQuickText);
+
+    QQuickTextLayoutCache *cache = textLayoutCache();
+    const QSharedPointer<QQuickTextLayoutCacheEntry> *cached = cache ? cache->object(key) : 0;
+    if (!cached || cached->isNull())
+        return false;
+    const QSharedPointer<QQuickTextLayoutCacheEntry> entry = *cached;
+
+    bool wasInLayout = internalWidthUpdate;
+    internalWidthUpdate = true;
+    q->setImplicitSize(entry->naturalWidth + q->leftPadding() + q->rightPadding(), entry->naturalHeight + q->topPadding() + q->bottomPadding());
+    internalWidthUpdate = wasInLayout;
+
+    // A binding to the implicit size may have resized the item, in which case the
+    // text has to be laid out again.
+    if (q->widthValid() != entry->widthValid
+            || q->heightValid() != entry->heightValid
+            || availableWidth() != entry->availableWidth
+            || availableHeight() != entry->availableHeight) {
+        return false;
+    }
+
+    cachedLayout = entry;
+    delete elideLayout;
+    elideLayout = 0;
+
+    lineWidth = entry->lineWidth;
+    advance = entry->advance;
+    truncated = entry->truncated;
+    widthExceeded = entry->widthExceeded;
+    heightExceeded = entry->heightExceeded;
+    implicitWidthValid = true;
+    implicitHeightValid = true;
+
+    updateFontInfo(font);
+    assignedFont = QFontInfo(font).family();
+
+    *baseline = entry->baseline;
+    *rect = entry->boundingRect;
+
+    if (lineCount != entry->lineCount) {
+        lineCount = entry->lineCount;
+        emit q->lineCountChanged();
+    }
+
+    if (truncated != wasTruncated)
+        emit q->truncatedChanged();
+
+    return true;
+}
+
+static QTextLayout *copyTextLayout(const QTextLayout &source)
+{
+    QTextLayout *copy = new QTextLayout(source.text(), source.font());
+    copy->setCacheEnabled(true);
+    copy->setTextOption(source.textOption());
+    copy->setFormats(source.formats());
+    copy->beginLayout();
+    for (int i = 0; i < source.lineCount(); ++i) {
+        const QTextLine sourceLine = source.lineAt(i);
+        QTextLine line = copy->createLine();
+        if (!line.isValid())
+            break;
+        line.setLineWidth(sourceLine.width());
+        line.setPosition(sourceLine.position());
+        if (line.textStart() != sourceLine.textStart() || line.textLength() != sourceLine.textLength())
+            break;
+    }
+    copy->endLayout();
+
+    if (copy->lineCount() != source.lineCount()
+            || (copy->lineCount() > 0
+                && copy->lineAt(copy->lineCount() - 1).textLength() != source.lineAt(source.lineCount() - 1).textLength())) {
+        delete copy;
+        return 0;
+    }
+    return copy;
+}
+
+void QQuickTextPrivate::insertCachedLayout(
+        const QQuickTextLayoutCacheKey &key, const QSharedPointer<QQuickTextLayoutCacheEntry> &entry)
+{
+    QQuickTextLayoutCache *cache = textLayoutCache();
+    if (!cache)
+        return;
+
+    const QSharedPointer<QQuickTextLayoutCacheEntry> *cached = cache->object(key);
+    if (!cached) {
+        // Most texts are only shown once, so only remember having seen the text
+        // and copy the layout when another item lays out the same text.
+        cache->insert(key, new QSharedPointer<QQuickTextLayoutCacheEntry>, 1);
+        return;
+    } else if (!cached->isNull()) {
+        return;
+    }
+
+    entry->layout = copyTextLayout(layout);
+    if (!entry->layout)
+        return;
+    if (elideLayout) {
+        entry->elideLayout = copyTextLayout(*elideLayout);
+        if (!entry->elideLayout)
+            return;
+    }
+    cache->insert(key, new QSharedPointer<QQuickTextLayoutCacheEntry>(entry), key.text.length() + 1);
+}
+
+void QQuickTextPrivate::updateFontInfo(const QFont &scaledFont)
+{
+    Q_Q(QQuickText);
+
+    QFontInfo scaledFontInfo(scaledFont);
+    if (fontInfo.weight() != scaledFontInfo.weight()
+            || fontInfo.pixelSize() != scaledFontInfo.pixelSize()
+            || fontInfo.italic() != scaledFontInfo.italic()
+            || !qFuzzyCompare(fontInfo.pointSizeF(), scaledFontInfo.pointSizeF())
+            || fontInfo.family() != scaledFontInfo.family()
+            || fontInfo.styleName() != scaledFontInfo.styleName()) {
+        fontInfo = scaledFontInfo;
+        emit q->fontInfoChanged();
+    }
+}
+
 QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
 {
     Q_Q(QQuickText);
@@ -699,6 +948,21 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
     const bool customLayout = isLineLaidOutConnected();
     const bool wasTruncated = truncated;
 
+    // Items showing the same text with the same constraints share one layout.
+    QQuickTextLayoutCacheKey cacheKey;
+    QSharedPointer<QQuickTextLayoutCacheEntry> cacheRecord;
+    if (!customLayout && canUseLayoutCache()) {
+        cacheKey = layoutCacheKey(lineWidth);
+        QRectF cachedRect;
+        if (applyCachedLayout(cacheKey, wasTruncated, baseline, &cachedRect))
+            return cachedRect;
+        // Replaying a cached implicit size may have resized the item, only record
+        // the new layout if the key still describes it.
+        if (layoutCacheKey(lineWidth) == cacheKey)
+            cacheRecord.reset(new QQuickTextLayoutCacheEntry);
+    }
+    int layoutPasses = 0;
+
     bool canWrap = wrapMode != QQuickText::NoWrap && q->widthValid();
 
     bool horizontalFit = fontSizeMode() & QQuickText::HorizontalFit && q->widthValid();
@@ -736,6 +1000,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
     // doesn't fit within the item dimensions,  or a binding to implicitWidth/Height changes
     // the item dimensions.
     for (;;) {
+        ++layoutPasses;
         if (!once) {
             if (pixelSize)
                 scaledFont.setPixelSize(scaledFontSize);
@@ -909,6 +1174,15 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
             lineWidth = q->widthValid() && availWidth > 0 ? availWidth : naturalWidth;
             maxHeight = q->heightValid() ? availHeight : FLT_MAX;
 
+            if (cacheRecord) {
+                cacheRecord->naturalWidth = naturalWidth;
+                cacheRecord->naturalHeight = naturalHeight;
+                cacheRecord->widthValid = q->widthValid();
+                cacheRecord->heightValid = q->heightValid();
+                cacheRecord->availableWidth = availWidth;
+                cacheRecord->availableHeight = availHeight;
+            }
+
             // If the width of the item has changed and it's possible the result of wrapping,
             // eliding, scaling has changed, or the text is not left aligned do another layout.
             if ((!qFuzzyCompare(lineWidth, oldWidth) || (widthExceeded && lineWidth > oldWidth))
@@ -1041,16 +1315,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
     implicitWidthValid = true;
     implicitHeightValid = true;
 
-    QFontInfo scaledFontInfo(scaledFont);
-    if (fontInfo.weight() != scaledFontInfo.weight()
-            || fontInfo.pixelSize() != scaledFontInfo.pixelSize()
-            || fontInfo.italic() != scaledFontInfo.italic()
-            || !qFuzzyCompare(fontInfo.pointSizeF(), scaledFontInfo.pointSizeF())
-            || fontInfo.family() != scaledFontInfo.family()
-            || fontInfo.styleName() != scaledFontInfo.styleName()) {
-        fontInfo = scaledFontInfo;
-        emit q->fontInfoChanged();
-    }
+    updateFontInfo(scaledFont);
 
     if (eos != multilengthEos)
         truncated = true;
@@ -1131,6 +1396,19 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
     if (truncated != wasTruncated)
         emit q->truncatedChanged();
 
+    // Only layouts done in a single pass can be replayed from the item's state.
+    if (cacheRecord && layoutPasses == 1) {
+        cacheRecord->boundingRect = br;
+        cacheRecord->advance = advance;
+        cacheRecord->baseline = *baseline;
+        cacheRecord->lineWidth = lineWidth;
+        cacheRecord->lineCount = lineCount;
+        cacheRecord->truncated = truncated;
+        cacheRecord->widthExceeded = widthExceeded;
+        cacheRecord->heightExceeded = heightExceeded;
+        insertCachedLayout(cacheKey, cacheRecord);
+    }
+
     return br;
 }
 
@@ -2396,19 +2674,21 @@ QSGNode *QQuickText::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data
         node->addTextDocument(QPointF(dx, dy), d->extra->doc, color, d->style, styleColor, linkColor);
     } else if (d->layedOutTextRect.width() > 0) {
         const qreal dx = QQuickTextUtil::alignedX(d->lineWidth, d->availableWidth(), effectiveHAlign()) + leftPadding();
+        QTextLayout *layout = d->cachedLayout ? d->cachedLayout->layout : &d->layout;
+        QTextLayout *elideLayout = d->cachedLayout ? d->cachedLayout->elideLayout : d->elideLayout;
         int unelidedLineCount = d->lineCount;
-        if (d->elideLayout)
+        if (elideLayout)
             unelidedLineCount -= 1;
         if (unelidedLineCount > 0) {
             node->addTextLayout(
                         QPointF(dx, dy),
-                        &d->layout,
+                        layout,
                         color, d->style, styleColor, linkColor,
                         QColor(), QColor(), -1, -1,
                         0, unelidedLineCount);
         }
-        if (d->elideLayout)
-            node->addTextLayout(QPointF(dx, dy), d->elideLayout, color, d->style, styleColor, linkColor);
+        if (elideLayout)
+            node->addTextLayout(QPointF(dx, dy), elideLayout, color, d->style, styleColor, linkColor);
 
         if (d->extra.isAllocated()) {
             for (QQuickStyledTextImgTag *img : qAsConst(d->extra->visibleImgTags)) {
@@ -2927,6 +3207,12 @@ void QQuickText::invalidateFontCaches()
     } else {
         if (d->layout.engine() != 0)
             d->layout.engine()->resetFontEngineCache();
+        if (d->cachedLayout) {
+            if (d->cachedLayout->layout->engine() != 0)
+                d->cachedLayout->layout->engine()->resetFontEngineCache();
+            if (d->cachedLayout->elideLayout && d->cachedLayout->elideLayout->engine() != 0)
+                d->cachedLayout->elideLayout->engine()->resetFontEngineCache();
+        }
     }
 }
 
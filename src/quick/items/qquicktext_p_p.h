@@ -60,11 +60,66 @@
 #include <private/qquickstyledtext_p.h>
 #include <private/qlazilyallocated_p.h>
 
+#include <QtCore/qsharedpointer.h>
+
 QT_BEGIN_NAMESPACE
 
 class QTextLayout;
 class QQuickTextDocumentWithImageResources;
 
+// Identifies a plain text layout by everything setupTextLayout() reads
+// from the item when it lays out the text in a single pass.
+struct QQuickTextLayoutCacheKey
+{
+    QString text;
+    QFont font;
+    qreal lineWidth;
+    qreal availableWidth;
+    qreal availableHeight;
+    qreal lineHeight;
+    int maximumLineCount;
+    int lineHeightMode;
+    int wrapMode;
+    int elideMode;
+    int hAlign;
+    int renderType;
+    uint state; // the widthValid, heightValid, ... flags of the item
+};
+
+bool operator==(const QQuickTextLayoutCacheKey &lhs, const QQuickTextLayoutCacheKey &rhs);
+uint qHash(const QQuickTextLayoutCacheKey &key, uint seed = 0);
+
+// The result of a layout shared by all Text items with the same key.
+struct QQuickTextLayoutCacheEntry
+{
+    QQuickTextLayoutCacheEntry();
+    ~QQuickTextLayoutCacheEntry();
+
+    QTextLayout *layout;
+    QTextLayout *elideLayout;
+
+    QRectF boundingRect;
+    QSizeF advance;
+    qreal baseline;
+    qreal naturalWidth;
+    qreal naturalHeight;
+    qreal lineWidth;
+    int lineCount;
+    bool truncated;
+    bool widthExceeded;
+    bool heightExceeded;
+
+    // The state of the item after its implicit size was updated, the
+    // layout only holds for items that end up in the same state.
+    bool widthValid;
+    bool heightValid;
+    qreal availableWidth;
+    qreal availableHeight;
+
+private:
+    Q_DISABLE_COPY(QQuickTextLayoutCacheEntry)
+};
+
 class Q_QUICK_PRIVATE_EXPORT QQuickTextPrivate : public QQuickImplicitSizeItemPrivate
 {
     Q_DECLARE_PUBLIC(QQuickText)
@@ -89,6 +144,12 @@ public:
 
     void processHoverEvent(QHoverEvent *event);
 
+    bool canUseLayoutCache() const;
+    QQuickTextLayoutCacheKey layoutCacheKey(qreal lineWidth) const;
+    bool applyCachedLayout(const QQuickTextLayoutCacheKey &key, bool wasTruncated, qreal *baseline, QRectF *rect);
+    void insertCachedLayout(const QQuickTextLayoutCacheKey &key, const QSharedPointer<QQuickTextLayoutCacheEntry> &entry);
+    void updateFontInfo(const QFont &scaledFont);
+
     QRectF layedOutTextRect;
     QSizeF advance;
 
@@ -128,6 +189,7 @@ public:
 
     QTextLayout layout;
     QTextLayout *elideLayout;
+    QSharedPointer<QQuickTextLayoutCacheEntry> cachedLayout;
     QQuickTextLine *textLine;
 
     qreal lineWidth;
@@ -46,6 +46,7 @@
 #include "qquickevents_p_p.h"
 
 #include <private/qquickdrag_p.h>
+#include <private/qquickimagebase_p_p.h>
 #include <private/qquickpointerhandler_p.h>
 
 #include <QtQuick/private/qsgrenderer_p.h>
@@ -72,6 +73,9 @@
 #include <QtQuick/private/qquickpixmapcache_p.h>
 
 #include <private/qqmlmemoryprofiler_p.h>
+#include <private/qv8engine_p.h>
+#include <private/qv4engine_p.h>
+#include <private/qv4mm_p.h>
 #include <private/qqmldebugserviceinterfaces_p.h>
 #include <private/qqmldebugconnector_p.h>
 #if QT_CONFIG(opengl)
@@ -304,6 +308,8 @@ void QQuickWindowPrivate::polishItems()
     if (recursionSafeguard == 0)
         qWarning("QQuickWindow: possible QQuickItem::polish() loop");
 
+    QQuickImageBasePrivate::updatePendingImages();
+
 #if QT_CONFIG(im)
     if (QQuickItem *focusItem = q_func()->activeFocusItem()) {
         // If the current focus item, or any of its anchestors, has changed location
@@ -317,6 +323,68 @@ void QQuickWindowPrivate::polishItems()
 #endif
 }
 
+/*!
+    \internal
+
+    Called by the render loops on the GUI thread once a frame has been polished and
+    synchronized. \a budgetNSecs is the time left until the next frame is due, or -1 if
+    no further frame is scheduled. The JavaScript memory manager uses it to run garbage
+    collection work between frames rather than in the middle of an animation.
+ */
+void QQuickWindowPrivate::collectGarbageDuringIdleTime(qint64 budgetNSecs)
+{
+    static const bool disabled = qEnvironmentVariableIsSet("QSG_NO_IDLE_GC");
+    if (disabled || budgetNSecs == 0)
+        return;
+
+    if (QV4::ExecutionEngine *v4 = jsEngine())
+        v4->memoryManager->collectDuringIdleTime(budgetNSecs < 0 ? -1 : budgetNSecs / 1000);
+}
+
+/*!
+    \internal
+
+    Returns the JavaScript engine of the window's QML content, if there is any.
+    The render loops ask for it several times per frame, so while frame timings
+    are recorded an engine that was found is only looked up again once another
+    frame got recorded. Not finding one is not remembered, as the content may
+    get loaded at any time, and frames that get aborted are not recorded.
+ */
+QV4::ExecutionEngine *QQuickWindowPrivate::jsEngine() const
+{
+    const quint32 frame = frameTimings.frameCount() + 1;
+    if (frameTimings.capacity() == 0 || !frameQmlEngine || frameQmlEngineFrame != frame) {
+        Q_Q(const QQuickWindow);
+        QQmlEngine *engine = qmlEngine(q);
+        if (!engine) {
+            // Windows created from C++, like QQuickView, only have QML content
+            const auto children = contentItem->childItems();
+            for (QQuickItem *child : children) {
+                if ((engine = qmlEngine(child)))
+                    break;
+            }
+        }
+        frameQmlEngine = engine;
+        frameQmlEngineFrame = frame;
+    }
+    return frameQmlEngine ? QV8Engine::getV4(frameQmlEngine.data()) : nullptr;
+}
+
+/*!
+    \internal
+
+    Returns the total time in nanoseconds the JavaScript engine of the window's
+    content has spent collecting garbage. The render loops record the difference
+    over the parts of a frame on the GUI thread in the frame timings.
+ */
+qint64 QQuickWindowPrivate::garbageCollectionTime() const
+{
+    if (frameTimings.capacity() == 0)
+        return 0;
+    const QV4::ExecutionEngine *v4 = jsEngine();
+    return v4 ? v4->memoryManager->pauseHistogram.totalPauseTime * 1000 : 0;
+}
+
 /*!
  * Schedules the window to render another frame.
  *
@@ -480,6 +548,12 @@ void QQuickWindowPrivate::renderSceneGraph(const QSize &size)
     runAndClearJobs(&afterRenderingJobs);
 }
 
+static bool promoteAnimationsToAnimatorsByDefault()
+{
+    static const bool promote = qEnvironmentVariableIntValue("QT_QUICK_PROMOTE_ANIMATIONS");
+    return promote;
+}
+
 QQuickWindowPrivate::QQuickWindowPrivate()
     : contentItem(0)
     , activeFocusItem(0)
@@ -498,6 +572,7 @@ QQuickWindowPrivate::QQuickWindowPrivate()
     , renderer(0)
     , windowManager(0)
     , renderControl(0)
+    , frameQmlEngineFrame(0)
     , pointerEventRecursionGuard(0)
     , customRenderStage(0)
     , clearColor(Qt::white)
@@ -508,6 +583,7 @@ QQuickWindowPrivate::QQuickWindowPrivate()
     , componentCompleted(true)
     , allowChildEventFiltering(true)
     , allowDoubleClick(true)
+    , promoteAnimationsToAnimators(promoteAnimationsToAnimatorsByDefault())
     , lastFocusReason(Qt::OtherFocusReason)
     , renderTarget(0)
     , renderTargetId(0)
@@ -2254,22 +2330,32 @@ void QQuickWindowPrivate::deliverPointerEvent(QQuickPointerEvent *event)
 QVector<QQuickItem *> QQuickWindowPrivate::pointerTargets(QQuickItem *item, const QPointF &scenePos, bool checkMouseButtons, bool checkAcceptsTouch) const
 {
     QVector<QQuickItem *> targets;
+    findPointerTargets(item, scenePos, checkMouseButtons, checkAcceptsTouch, &targets);
+    return targets;
+}
+
+void QQuickWindowPrivate::findPointerTargets(QQuickItem *item, const QPointF &scenePos, bool checkMouseButtons, bool checkAcceptsTouch, QVector<QQuickItem *> *targets) const
+{
     auto itemPrivate = QQuickItemPrivate::get(item);
     QPointF itemPos = item->mapFromScene(scenePos);
     // if the item clips, we can potentially return early
     if (itemPrivate->flags & QQuickItem::ItemClipsChildrenToShape) {
         if (!item->contains(itemPos))
-            return targets;
+            return;
     }
 
     // recurse for children
-    QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
+    const QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
     for (int ii = children.count() - 1; ii >= 0; --ii) {
         QQuickItem *child = children.at(ii);
         auto childPrivate = QQuickItemPrivate::get(child);
         if (!child->isVisible() || !child->isEnabled() || childPrivate->culled)
             continue;
-        targets << pointerTargets(child, scenePos, checkMouseButtons, checkAcceptsTouch);
+        // Skip the whole subtree if none of it is under the point. The margin
+        // absorbs rounding differences between mapping in and out of the item.
+        if (!childPrivate->subtreeRect().adjusted(-1, -1, 1, 1).contains(itemPos))
+            continue;
+        findPointerTargets(child, scenePos, checkMouseButtons, checkAcceptsTouch, targets);
     }
 
     bool relevant = item->contains(itemPos);
@@ -2278,8 +2364,7 @@ QVector<QQuickItem *> QQuickWindowPrivate::pointerTargets(QQuickItem *item, cons
     if (relevant && checkAcceptsTouch && !(item->acceptTouchEvents() || item->acceptedMouseButtons()))
         relevant = false;
     if (relevant)
-        targets << item; // add this item last: children take precedence
-    return targets;
+        targets->append(item); // add this item last: children take precedence
 }
 
 // return the joined lists
@@ -4324,6 +4409,25 @@ void QQuickWindow::resetOpenGLState()
     The Window attached property can be attached to any Item.
 */
 
+/*!
+    \qmlattachedmethod list<object> Window::frameTimings(int count)
+    \since 5.10
+
+    Returns the timings of the last \a count frames of the item's window, or
+    of all the frames that are still kept if \a count is negative, oldest first.
+
+    Each entry has the number of the \c frame, the \c timestamp in milliseconds
+    at which it was finished, and the time in milliseconds spent in the
+    \c polish, \c animations, \c sync, \c render and \c swap phases of the
+    frame along with their \c total. \c gc is the part of the polish and
+    animations phases that was spent collecting JavaScript garbage.
+
+    The render loop only keeps the last 128 frames by default. The number can
+    be changed with the \c QSG_FRAME_TIMINGS environment variable, setting it
+    to \c 0 disables recording.
+    The Window attached property can be attached to any Item.
+*/
+
 /*!
     \qmlattachedproperty int Window::width
     \qmlattachedproperty int Window::height
@@ -54,9 +54,11 @@
 #include "qquickitem.h"
 #include "qquickwindow.h"
 #include "qquickevents_p_p.h"
+#include "qquickframetimings_p.h"
 
 #include <QtQuick/private/qsgcontext_p.h>
 
+#include <QtCore/qpointer.h>
 #include <QtCore/qthread.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qwaitcondition.h>
@@ -82,6 +84,11 @@ class QQuickWindowPrivate;
 class QQuickWindowRenderLoop;
 class QSGRenderLoop;
 class QTouchEvent;
+class QQmlEngine;
+
+namespace QV4 {
+struct ExecutionEngine;
+}
 
 //Make it easy to identify and customize the root item if needed
 class QQuickRootItem : public QQuickItem
@@ -177,6 +184,7 @@ public:
     void deliverMatchingPointsToItem(QQuickItem *item, QQuickPointerEvent *pointerEvent, bool handlersOnly = false);
 
     QVector<QQuickItem *> pointerTargets(QQuickItem *, const QPointF &, bool checkMouseButtons, bool checkAcceptsTouch) const;
+    void findPointerTargets(QQuickItem *, const QPointF &, bool checkMouseButtons, bool checkAcceptsTouch, QVector<QQuickItem *> *targets) const;
     QVector<QQuickItem *> mergePointerTargets(const QVector<QQuickItem *> &list1, const QVector<QQuickItem *> &list2) const;
     void updateFilteringParentItems(const QVector<QQuickItem *> &targetItems);
 
@@ -216,6 +224,9 @@ public:
     void forcePolish();
     void syncSceneGraph();
     void renderSceneGraph(const QSize &size);
+    void collectGarbageDuringIdleTime(qint64 budgetNSecs);
+    QV4::ExecutionEngine *jsEngine() const;
+    qint64 garbageCollectionTime() const;
 
     bool isRenderable() const;
 
@@ -252,6 +263,12 @@ public:
     QQuickAnimatorController *animationController;
     QScopedPointer<QTouchEvent> delayedTouch;
 
+    // Written by the render loop, see QQuickFrameTimingBuffer
+    QQuickFrameTimingBuffer frameTimings;
+    // Looked up by jsEngine() once per recorded frame, keyed by frameTimings.frameCount() + 1
+    mutable QPointer<QQmlEngine> frameQmlEngine;
+    mutable quint32 frameQmlEngineFrame;
+
     int pointerEventRecursionGuard;
     QQuickCustomRenderStage *customRenderStage;
 
@@ -267,6 +284,9 @@ public:
 
     bool allowChildEventFiltering : 1;
     bool allowDoubleClick : 1;
+    // Lets unobserved NumberAnimations on items of this window run as animators, see
+    // QQuickNumberAnimation::transition(). Defaults to QT_QUICK_PROMOTE_ANIMATIONS.
+    bool promoteAnimationsToAnimators : 1;
 
     Qt::FocusReason lastFocusReason;
 
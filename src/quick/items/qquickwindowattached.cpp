@@ -40,6 +40,7 @@
 #include "qquickwindow.h"
 #include "qquickitem.h"
 #include "qquickwindowattached_p.h"
+#include "qquickwindow_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -91,6 +92,31 @@ QQuickWindow *QQuickWindowAttached::window() const
     return m_window;
 }
 
+QVariantList QQuickWindowAttached::frameTimings(int count) const
+{
+    QVariantList list;
+    if (!m_window)
+        return list;
+
+    const auto toMSecs = [](qint64 nsecs) { return nsecs / qreal(1000000); };
+    const QVector<QQuickFrameTiming> frames = QQuickWindowPrivate::get(m_window)->frameTimings.frames(count);
+    list.reserve(frames.size());
+    for (const QQuickFrameTiming &timing : frames) {
+        QVariantMap map;
+        map.insert(QStringLiteral("frame"), timing.frame);
+        map.insert(QStringLiteral("timestamp"), timing.timestamp);
+        map.insert(QStringLiteral("polish"), toMSecs(timing.polish));
+        map.insert(QStringLiteral("animations"), toMSecs(timing.animations));
+        map.insert(QStringLiteral("sync"), toMSecs(timing.sync));
+        map.insert(QStringLiteral("render"), toMSecs(timing.render));
+        map.insert(QStringLiteral("swap"), toMSecs(timing.swap));
+        map.insert(QStringLiteral("gc"), toMSecs(timing.gc));
+        map.insert(QStringLiteral("total"), toMSecs(timing.total()));
+        list.append(map);
+    }
+    return list;
+}
+
 void QQuickWindowAttached::windowChange(QQuickWindow *window)
 {
     if (window != m_window) {
@@ -83,6 +83,8 @@ public:
     int height() const;
     QQuickWindow *window() const;
 
+    Q_INVOKABLE QVariantList frameTimings(int count = -1) const;
+
 Q_SIGNALS:
 
     void visibilityChanged();
@@ -45,13 +45,177 @@
 #include "qsgsoftwarerenderablenode_p.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtGui/QWindow>
+#include <QtGui/qpa/qplatformpixmap.h>
 #include <QtQuick/QSGSimpleRectNode>
+#include <QtQml/private/qqmlpooledjob_p.h>
 
 Q_LOGGING_CATEGORY(lc2DRender, "qt.scenegraph.softwarecontext.abstractrenderer")
 
 QT_BEGIN_NAMESPACE
 
+namespace {
+// 0 until it has been read from the environment
+QBasicAtomicInt rasterThreads = Q_BASIC_ATOMIC_INITIALIZER(0);
+QBasicAtomicInt tiledFrames = Q_BASIC_ATOMIC_INITIALIZER(0);
+}
+
+// for autotests, to compare tiled and serial rendering in one process
+Q_QUICK_PRIVATE_EXPORT void qsg_set_software_render_threads(int count)
+{
+    rasterThreads.storeRelease(count);
+}
+
+Q_QUICK_PRIVATE_EXPORT int qsg_software_tiled_frames()
+{
+    return tiledFrames.loadAcquire();
+}
+
+#ifndef QT_NO_THREAD
+namespace {
+
+// Tile size in device pixels
+const int TileSize = 128;
+
+Q_GLOBAL_STATIC(QThreadPool, rasterThreadPool)
+// The font engines' glyph caches are not thread safe
+Q_GLOBAL_STATIC(QMutex, glyphPaintMutex)
+
+int rasterThreadCount()
+{
+    int threads = rasterThreads.loadAcquire();
+    if (!threads) {
+        bool ok;
+        threads = qEnvironmentVariableIntValue("QSG_SOFTWARE_RENDER_THREADS", &ok);
+        if (!ok || threads <= 0)
+            threads = QThread::idealThreadCount();
+        rasterThreads.testAndSetRelease(0, threads);
+    }
+    return threads;
+}
+
+// Returns the image behind the painter's device, if it can be painted into from several threads.
+QImage *rasterTarget(QPainter *painter)
+{
+    QPaintDevice *device = painter->device();
+    QImage *image = nullptr;
+    if (device->devType() == QInternal::Image) {
+        image = static_cast<QImage *>(device);
+    } else if (device->devType() == QInternal::Pixmap) {
+        if (QPlatformPixmap *data = static_cast<QPixmap *>(device)->handle())
+            image = data->buffer();
+    }
+
+    // The tiles are views on the image's scanlines, which works for any format with whole
+    // bytes per pixel and no color table. Keep it simple and leave high DPI to the serial path.
+    if (!image || image->depth() < 16 || image->devicePixelRatio() != 1.0)
+        return nullptr;
+    if (painter->deviceTransform().type() > QTransform::TxScale)
+        return nullptr;
+    return image;
+}
+
+struct TiledNode
+{
+    QSGSoftwareRenderableNode *node;
+    QRegion dirtyRegion;
+    QRect bounds;
+    bool forceOpaque;
+};
+
+/*
+    Paints a list of nodes into the tiles of an image. Every tile gets its own
+    QPainter on a QImage that shares the tile's part of the target's pixels, so
+    there is nothing to composite afterwards. Threads grab tiles until all of
+    them are done.
+ */
+class TileRasterizer
+{
+public:
+    TileRasterizer(QPainter *painter, QImage *target)
+        : bits(target->bits())
+        , bytesPerLine(target->bytesPerLine())
+        , bytesPerPixel(target->depth() / 8)
+        , format(target->format())
+        , window(painter->window())
+        , viewport(painter->viewport())
+        , renderHints(painter->renderHints())
+        , inverseDeviceTransform(painter->deviceTransform().inverted())
+    {
+    }
+
+    void rasterizeTiles()
+    {
+        int i;
+        while ((i = nextTile.fetchAndAddRelaxed(1)) < tiles.count())
+            rasterize(tiles.at(i));
+    }
+
+    uchar *bits;
+    int bytesPerLine;
+    int bytesPerPixel;
+    QImage::Format format;
+    QRect window;
+    QRect viewport;
+    QPainter::RenderHints renderHints;
+    QTransform inverseDeviceTransform;
+
+    QVector<TiledNode> nodes;
+    QVector<QRect> tiles;
+    QAtomicInt nextTile;
+
+private:
+    void rasterize(const QRect &tile)
+    {
+        QImage image(bits + tile.y() * bytesPerLine + tile.x() * bytesPerPixel,
+                     tile.width(), tile.height(), bytesPerLine, format);
+        QPainter painter(&image);
+        painter.setRenderHints(renderHints);
+        // Map world coordinates the way the target's painter does, shifted to the tile
+        painter.setWindow(window);
+        painter.setViewport(viewport.translated(-tile.topLeft()));
+
+        const QRect tileRect = inverseDeviceTransform.mapRect(QRectF(tile)).toAlignedRect();
+        for (const TiledNode &tiledNode : nodes) {
+            if (!tiledNode.bounds.intersects(tileRect))
+                continue;
+            const QRegion clipRegion = tiledNode.dirtyRegion.intersected(tileRect);
+            if (clipRegion.isEmpty())
+                continue;
+            if (tiledNode.node->type() == QSGSoftwareRenderableNode::Glyph) {
+                QMutexLocker locker(glyphPaintMutex());
+                tiledNode.node->paint(&painter, clipRegion, tiledNode.forceOpaque);
+            } else {
+                tiledNode.node->paint(&painter, clipRegion, tiledNode.forceOpaque);
+            }
+        }
+    }
+};
+
+class TileJob : public QQmlPooledJob
+{
+public:
+    TileJob(TileRasterizer *rasterizer)
+        : rasterizer(rasterizer)
+    {
+    }
+
+protected:
+    void execute() override
+    {
+        rasterizer->rasterizeTiles();
+    }
+
+private:
+    TileRasterizer *rasterizer;
+};
+
+}
+#endif
+
 QSGAbstractSoftwareRenderer::QSGAbstractSoftwareRenderer(QSGRenderContext *context)
     : QSGRenderer(context)
     , m_background(new QSGSimpleRectNode)
@@ -123,6 +287,11 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     if (m_renderableNodes.isEmpty())
         return dirtyRegion;
 
+#ifndef QT_NO_THREAD
+    if (renderNodesTiled(painter, &dirtyRegion))
+        return dirtyRegion;
+#endif
+
     auto iterator = m_renderableNodes.begin();
     // First node is the background and needs to painted without blending
     auto backgroundNode = *iterator;
@@ -137,10 +306,82 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     return dirtyRegion;
 }
 
+#ifndef QT_NO_THREAD
+/*
+    Paints the dirty nodes on several threads at once by splitting the target
+    into tiles. Returns false, without painting anything, if the frame needs to
+    be painted on this thread, so the caller can fall back to renderNodes().
+ */
+bool QSGAbstractSoftwareRenderer::renderNodesTiled(QPainter *painter, QRegion *dirtyRegion)
+{
+    const int threadCount = rasterThreadCount();
+    if (threadCount < 2)
+        return false;
+
+    QImage *target = rasterTarget(painter);
+    if (!target)
+        return false;
+
+    TileRasterizer rasterizer(painter, target);
+    const QTransform deviceTransform = painter->deviceTransform();
+
+    QRect paintedRect;
+    for (QSGSoftwareRenderableNode *node : qAsConst(m_renderableNodes)) {
+        if (!node->needsPainting())
+            continue;
+        // Custom render nodes draw with the renderer's one painter
+        if (node->type() == QSGSoftwareRenderableNode::RenderNode)
+            return false;
+        const QRegion nodeDirtyRegion = node->dirtyRegion();
+        const QRect bounds = nodeDirtyRegion.boundingRect();
+        // The first node is the background and needs to painted without blending
+        rasterizer.nodes.append({ node, nodeDirtyRegion, bounds, node == m_renderableNodes.first() });
+        paintedRect |= deviceTransform.mapRect(QRectF(bounds)).toAlignedRect();
+    }
+
+    paintedRect &= target->rect();
+    if (paintedRect.isEmpty())
+        return false;
+
+    for (int y = paintedRect.top() / TileSize * TileSize; y <= paintedRect.bottom(); y += TileSize) {
+        for (int x = paintedRect.left() / TileSize * TileSize; x <= paintedRect.right(); x += TileSize)
+            rasterizer.tiles.append(QRect(x, y, TileSize, TileSize) & paintedRect);
+    }
+    // Not worth the overhead for small updates
+    if (rasterizer.tiles.count() < 2)
+        return false;
+
+    // Anything that the nodes would update lazily while painting has to happen here
+    for (const TiledNode &tiledNode : qAsConst(rasterizer.nodes))
+        tiledNode.node->prepareForPainting(painter->device()->devicePixelRatio());
+
+    // This thread rasterizes tiles as well
+    const int jobCount = qMin(threadCount, rasterizer.tiles.count()) - 1;
+    QVector<TileJob *> jobs;
+    jobs.reserve(jobCount);
+    for (int i = 0; i < jobCount; ++i) {
+        jobs.append(new TileJob(&rasterizer));
+        jobs.last()->start(rasterThreadPool());
+    }
+    rasterizer.rasterizeTiles();
+    // All tiles are taken by now, jobs no thread has picked up have nothing left to do
+    for (TileJob *job : qAsConst(jobs))
+        job->cancel();
+    qDeleteAll(jobs);
+
+    for (QSGSoftwareRenderableNode *node : qAsConst(m_renderableNodes))
+        *dirtyRegion += node->finishPainting();
+
+    tiledFrames.ref();
+    qCDebug(lc2DRender) << "rasterized" << rasterizer.tiles.count() << "tiles on" << jobCount + 1 << "threads";
+    return true;
+}
+#endif
+
 void QSGAbstractSoftwareRenderer::buildRenderList()
 {
-    // Clear the previous renderlist
-    m_renderableNodes.clear();
+    // Clear the previous renderlist, keeping its allocation
+    m_renderableNodes.resize(0);
     // Add the background renderable (always first)
     m_renderableNodes.append(renderableNode(m_background));
     // Build the renderlist
@@ -149,74 +390,50 @@ void QSGAbstractSoftwareRenderer::buildRenderList()
 
 QRegion QSGAbstractSoftwareRenderer::optimizeRenderList()
 {
-    // Iterate through the renderlist from front to back
-    // Objective is to update the dirty status and rects.
-    for (auto i = m_renderableNodes.rbegin(); i != m_renderableNodes.rend(); ++i) {
-        auto node = *i;
-        if (!m_dirtyRegion.isEmpty()) {
-            // See if the current dirty regions apply to the current node
-            node->addDirtyRegion(m_dirtyRegion, true);
-        }
-
-        if (!m_obscuredRegion.isEmpty()) {
-            // Don't try to paint things that are covered by opaque objects
-            node->subtractDirtyRegion(m_obscuredRegion);
-        }
-
-        // Keep up with obscured regions
-        if (node->isOpaque()) {
-            m_obscuredRegion += node->boundingRectMin();
-        }
+    // The dirty and obscured areas are tracked in tiles, a node's index in the
+    // render list is its depth. Don't paint things outside of the rendering area.
+    m_dirtyTiles.reset(m_background->rect().toRect());
+
+    // Areas uncovered by removed nodes need to be repainted whatever is in front
+    if (!m_dirtyRegion.isEmpty()) {
+        m_dirtyTiles.markDirty(m_dirtyRegion);
+        m_dirtyRegion = QRegion();
+    }
 
+    // Iterate through the renderlist from front to back
+    // Objective is to find the visible parts of what changed, so opaque
+    // nodes are recorded before the nodes behind them are looked at.
+    for (int depth = m_renderableNodes.count() - 1; depth >= 0; --depth) {
+        QSGSoftwareRenderableNode *node = m_renderableNodes.at(depth);
         if (node->isDirty()) {
-            // Don't paint things outside of the rendering area
-            if (!m_background->rect().toRect().contains(node->boundingRectMax(), /*proper*/ true)) {
-                // Some part(s) of node is(are) outside of the rendering area
-                QRegion renderArea(m_background->rect().toRect());
-                QRegion outsideRegions = node->dirtyRegion().subtracted(renderArea);
-                if (!outsideRegions.isEmpty())
-                    node->subtractDirtyRegion(outsideRegions);
-            }
-
-            // Get the dirty region's to pass to the next nodes
-            if (node->isOpaque()) {
-                // if isOpaque, subtract node's dirty rect from m_dirtyRegion
-                m_dirtyRegion -= node->boundingRectMin();
-            } else {
-                // if isAlpha, add node's dirty rect to m_dirtyRegion
-                m_dirtyRegion += node->dirtyRegion();
-            }
-            // if previousDirtyRegion has content outside of boundingRect add to m_dirtyRegion
-            QRegion prevDirty = node->previousDirtyRegion();
-            if (!prevDirty.isNull())
-                m_dirtyRegion += prevDirty;
+            m_dirtyTiles.markDirty(node->boundingRectMax(), depth);
+            // The area the node covered before it moved or resized
+            m_dirtyTiles.markDirty(node->previousDirtyRegion(true).boundingRect(), depth);
         }
-    }
-
-    // Empty dirtyRegion (for second pass)
-    m_dirtyRegion = QRegion();
-    m_obscuredRegion = QRegion();
 
-    // Iterate through the renderlist from back to front
-    // Objective is to make sure all non-opaque items are painted when an item under them is dirty
-    for (auto j = m_renderableNodes.begin(); j != m_renderableNodes.end(); ++j) {
-        auto node = *j;
+        // The bounding rects ignore complex clip regions, so such nodes can't hide anything
+        if (node->isOpaque() && node->clipRegion().rectCount() <= 1)
+            m_dirtyTiles.markOccluded(node->boundingRectMin(), depth);
+    }
 
-        if (!node->isOpaque() && !m_dirtyRegion.isEmpty()) {
-            // Only blended nodes need to be updated
-            node->addDirtyRegion(m_dirtyRegion, true);
+    if (m_dirtyTiles.isEmpty()) {
+        for (QSGSoftwareRenderableNode *node : qAsConst(m_renderableNodes)) {
+            if (node->isDirty())
+                node->setDirtyRegion(QRegion());
         }
-
-        m_dirtyRegion += node->dirtyRegion();
+        return QRegion();
     }
 
-    QRegion updateRegion = m_dirtyRegion;
-
-    // Empty dirtyRegion
-    m_dirtyRegion = QRegion();
-    m_obscuredRegion = QRegion();
+    // Every node repaints the dirty tiles it can be seen in, which makes sure
+    // nodes in front of a changed node are painted again on top of it.
+    for (int depth = 0; depth < m_renderableNodes.count(); ++depth) {
+        QSGSoftwareRenderableNode *node = m_renderableNodes.at(depth);
+        const QRegion dirtyRegion = m_dirtyTiles.dirtyRegion(node->boundingRectMax(), depth);
+        if (node->isDirty() || !dirtyRegion.isEmpty())
+            node->setDirtyRegion(dirtyRegion);
+    }
 
-    return updateRegion;
+    return m_dirtyTiles.dirtyRegion();
 }
 
 void QSGAbstractSoftwareRenderer::setBackgroundColor(const QColor &color)
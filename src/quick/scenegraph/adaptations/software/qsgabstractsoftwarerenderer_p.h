@@ -53,8 +53,10 @@
 
 #include <private/qsgrenderer_p.h>
 
+#include "qsgsoftwaredirtytilemap_p.h"
+
 #include <QtCore/QHash>
-#include <QtCore/QLinkedList>
+#include <QtCore/QVector>
 
 QT_BEGIN_NAMESPACE
 
@@ -88,6 +90,9 @@ protected:
     QSize backgroundSize();
 
 private:
+#ifndef QT_NO_THREAD
+    bool renderNodesTiled(QPainter *painter, QRegion *dirtyRegion);
+#endif
     void nodeAdded(QSGNode *node);
     void nodeRemoved(QSGNode *node);
     void nodeGeometryUpdated(QSGNode *node);
@@ -96,12 +101,12 @@ private:
     void nodeOpacityUpdated(QSGNode *node);
 
     QHash<QSGNode*, QSGSoftwareRenderableNode*> m_nodes;
-    QLinkedList<QSGSoftwareRenderableNode*> m_renderableNodes;
+    QVector<QSGSoftwareRenderableNode*> m_renderableNodes;
 
     QSGSimpleRectNode *m_background;
 
     QRegion m_dirtyRegion;
-    QRegion m_obscuredRegion;
+    QSGSoftwareDirtyTileMap m_dirtyTiles;
 
     QSGSoftwareRenderableNodeUpdater *m_nodeUpdater;
 };
@@ -0,0 +1,204 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsgsoftwaredirtytilemap_p.h"
+
+QT_BEGIN_NAMESPACE
+
+QSGSoftwareDirtyTileMap::QSGSoftwareDirtyTileMap(int tileSize)
+    : m_tileSize(qMax(1, tileSize))
+    , m_columns(0)
+    , m_rows(0)
+    , m_dirtyCount(0)
+{
+}
+
+void QSGSoftwareDirtyTileMap::reset(const QRect &area)
+{
+    m_area = area;
+    m_columns = area.isEmpty() ? 0 : (area.width() + m_tileSize - 1) / m_tileSize;
+    m_rows = area.isEmpty() ? 0 : (area.height() + m_tileSize - 1) / m_tileSize;
+    m_dirtyCount = 0;
+
+    // fill() keeps the allocation of the previous frame
+    const int tileCount = m_columns * m_rows;
+    m_dirty.fill(false, tileCount);
+    m_occluders.fill(-1, tileCount);
+}
+
+bool QSGSoftwareDirtyTileMap::tileRange(const QRect &rect, int *left, int *top, int *right, int *bottom) const
+{
+    const QRect r = rect & m_area;
+    if (r.isEmpty())
+        return false;
+    *left = (r.left() - m_area.left()) / m_tileSize;
+    *top = (r.top() - m_area.top()) / m_tileSize;
+    *right = (r.right() - m_area.left()) / m_tileSize;
+    *bottom = (r.bottom() - m_area.top()) / m_tileSize;
+    return true;
+}
+
+/*
+    Marks the tiles touching \a rect as dirty, unless they are hidden by an
+    opaque node in front of \a depth.
+ */
+void QSGSoftwareDirtyTileMap::markDirty(const QRect &rect, int depth)
+{
+    int left, top, right, bottom;
+    if (!tileRange(rect, &left, &top, &right, &bottom))
+        return;
+
+    for (int row = top; row <= bottom; ++row) {
+        const int begin = row * m_columns;
+        for (int i = begin + left; i <= begin + right; ++i) {
+            if (!m_dirty.at(i) && m_occluders.at(i) <= depth) {
+                m_dirty[i] = true;
+                ++m_dirtyCount;
+            }
+        }
+    }
+}
+
+void QSGSoftwareDirtyTileMap::markDirty(const QRegion &region)
+{
+    for (const QRect &rect : region)
+        markDirty(rect);
+}
+
+/*
+    Records that an opaque node at \a depth covers \a rect. Only the tiles that
+    lie entirely within \a rect are hidden by it.
+ */
+void QSGSoftwareDirtyTileMap::markOccluded(const QRect &rect, int depth)
+{
+    const QRect r = rect & m_area;
+    int left, top, right, bottom;
+    if (!tileRange(r, &left, &top, &right, &bottom))
+        return;
+
+    // Leave out the tiles that are only partially covered
+    if (m_area.left() + left * m_tileSize < r.left())
+        ++left;
+    if (m_area.top() + top * m_tileSize < r.top())
+        ++top;
+    if (qMin(m_area.left() + (right + 1) * m_tileSize - 1, m_area.right()) > r.right())
+        --right;
+    if (qMin(m_area.top() + (bottom + 1) * m_tileSize - 1, m_area.bottom()) > r.bottom())
+        --bottom;
+
+    for (int row = top; row <= bottom; ++row) {
+        const int begin = row * m_columns;
+        for (int i = begin + left; i <= begin + right; ++i) {
+            if (m_occluders.at(i) < depth)
+                m_occluders[i] = depth;
+        }
+    }
+}
+
+/*
+    Returns the part of \a rect that is covered by dirty tiles which a node at
+    \a depth can be seen through. Rows of tiles with the same dirty columns are
+    merged, so a full repaint results in a single rectangle.
+ */
+QRegion QSGSoftwareDirtyTileMap::dirtyRegion(const QRect &rect, int depth) const
+{
+    if (m_dirtyCount == 0)
+        return QRegion();
+
+    const QRect r = rect & m_area;
+    int left, top, right, bottom;
+    if (!tileRange(r, &left, &top, &right, &bottom))
+        return QRegion();
+
+    m_rects.resize(0);
+    int bandStart = 0;
+    int bandCount = 0;
+    for (int row = top; row <= bottom; ++row) {
+        const int y1 = qMax(m_area.top() + row * m_tileSize, r.top());
+        const int y2 = qMin(m_area.top() + (row + 1) * m_tileSize - 1, r.bottom());
+        const int rowStart = m_rects.count();
+        const int begin = row * m_columns;
+        for (int column = left; column <= right; ++column) {
+            const int i = begin + column;
+            if (!m_dirty.at(i) || m_occluders.at(i) > depth)
+                continue;
+            int last = column;
+            while (last < right && m_dirty.at(begin + last + 1) && m_occluders.at(begin + last + 1) <= depth)
+                ++last;
+            const int x1 = qMax(m_area.left() + column * m_tileSize, r.left());
+            const int x2 = qMin(m_area.left() + (last + 1) * m_tileSize - 1, r.right());
+            m_rects.append(QRect(QPoint(x1, y1), QPoint(x2, y2)));
+            column = last;
+        }
+
+        const int rowCount = m_rects.count() - rowStart;
+        bool sameSpans = rowCount > 0 && rowCount == bandCount
+                && m_rects.at(bandStart).bottom() + 1 == y1;
+        for (int i = 0; sameSpans && i < rowCount; ++i) {
+            const QRect &above = m_rects.at(bandStart + i);
+            const QRect &current = m_rects.at(rowStart + i);
+            sameSpans = above.left() == current.left() && above.right() == current.right();
+        }
+        if (sameSpans) {
+            for (int i = 0; i < rowCount; ++i)
+                m_rects[bandStart + i].setBottom(y2);
+            m_rects.resize(rowStart);
+        } else {
+            bandStart = rowStart;
+            bandCount = rowCount;
+        }
+    }
+
+    if (m_rects.isEmpty())
+        return QRegion();
+    if (m_rects.count() == 1)
+        return QRegion(m_rects.constFirst());
+
+    // The rectangles are banded and sorted, as setRects() expects
+    QRegion region;
+    region.setRects(m_rects.constData(), m_rects.count());
+    return region;
+}
+
+QRegion QSGSoftwareDirtyTileMap::dirtyRegion() const
+{
+    return dirtyRegion(m_area, INT_MAX);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,104 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSGSOFTWAREDIRTYTILEMAP_H
+#define QSGSOFTWAREDIRTYTILEMAP_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick/private/qtquickglobal_p.h>
+
+#include <QtCore/QRect>
+#include <QtCore/QVector>
+#include <QtGui/QRegion>
+
+#include <limits.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Tracks which parts of the render area need to be repainted in tiles of a
+    fixed size. Nodes are identified by their depth, their index in the render
+    list, so that nodes further back have a lower depth. For every tile the map
+    remembers whether it is dirty and the depth of the front-most opaque node
+    covering it completely, which hides everything behind it.
+ */
+class Q_QUICK_PRIVATE_EXPORT QSGSoftwareDirtyTileMap
+{
+public:
+    explicit QSGSoftwareDirtyTileMap(int tileSize = 32);
+
+    void reset(const QRect &area);
+
+    QRect area() const { return m_area; }
+    int tileSize() const { return m_tileSize; }
+    bool isEmpty() const { return m_dirtyCount == 0; }
+
+    void markDirty(const QRect &rect, int depth = INT_MAX);
+    void markDirty(const QRegion &region);
+    void markOccluded(const QRect &rect, int depth);
+
+    QRegion dirtyRegion(const QRect &rect, int depth) const;
+    QRegion dirtyRegion() const;
+
+private:
+    bool tileRange(const QRect &rect, int *left, int *top, int *right, int *bottom) const;
+
+    QRect m_area;
+    int m_tileSize;
+    int m_columns;
+    int m_rows;
+    int m_dirtyCount;
+    QVector<bool> m_dirty;
+    QVector<int> m_occluders;
+    mutable QVector<QRect> m_rects;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGSOFTWAREDIRTYTILEMAP_H
@@ -94,8 +94,7 @@ void QSGSoftwareImageNode::setTextureCoordinatesTransform(QSGImageNode::TextureC
 
 void QSGSoftwareImageNode::paint(QPainter *painter)
 {
-    if (m_cachedMirroredPixmapIsDirty)
-        updateCachedMirroredPixmap();
+    updateCachedMirroredPixmap();
 
     painter->setRenderHint(QPainter::SmoothPixmapTransform, (m_filtering == QSGTexture::Linear));
 
@@ -112,6 +111,9 @@ void QSGSoftwareImageNode::paint(QPainter *painter)
 
 void QSGSoftwareImageNode::updateCachedMirroredPixmap()
 {
+    if (!m_cachedMirroredPixmapIsDirty)
+        return;
+
     if (m_transformMode == NoTransform) {
         m_cachedPixmap = QPixmap();
     } else {
@@ -104,10 +104,9 @@ public:
     bool ownsTexture() const override { return m_owns; }
 
     void paint(QPainter *painter);
-
-private:
     void updateCachedMirroredPixmap();
 
+private:
     QPixmap m_cachedPixmap;
     QSGTexture *m_texture;
     QRectF m_rect;
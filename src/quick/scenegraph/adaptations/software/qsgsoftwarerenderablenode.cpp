@@ -261,50 +261,80 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
     Q_ASSERT(painter);
 
     // Check for don't paint conditions
-    if (m_nodeType != RenderNode) {
-        if (!m_isDirty || qFuzzyIsNull(m_opacity) || m_dirtyRegion.isEmpty()) {
-            m_isDirty = false;
-            m_dirtyRegion = QRegion();
-            return QRegion();
-        }
-    } else {
-        if (!m_isDirty || qFuzzyIsNull(m_opacity)) {
-            m_isDirty = false;
-            m_dirtyRegion = QRegion();
-            return QRegion();
-        } else {
-            QSGRenderNodePrivate *rd = QSGRenderNodePrivate::get(m_handle.renderNode);
-            QMatrix4x4 m = m_transform;
-            rd->m_matrix = &m;
-            rd->m_opacity = m_opacity;
-
-            // all the clip region below is in world coordinates, taking m_transform into account already
-            QRegion cr = m_dirtyRegion;
-            if (m_clipRegion.rectCount() > 1)
-                cr &= m_clipRegion;
-
-            painter->save();
-            RenderNodeState rs;
-            rs.cr = cr;
-            m_handle.renderNode->render(&rs);
-            painter->restore();
-
-            const QRect br = m_handle.renderNode->flags().testFlag(QSGRenderNode::BoundedRectRendering)
-                ? m_boundingRectMax // already mapped to world
-                : QRect(0, 0, painter->device()->width(), painter->device()->height());
-            m_previousDirtyRegion = QRegion(br);
-            m_isDirty = false;
-            m_dirtyRegion = QRegion();
-            return br;
-        }
+    if (!needsPainting())
+        return finishPainting();
+
+    if (m_nodeType == RenderNode) {
+        QSGRenderNodePrivate *rd = QSGRenderNodePrivate::get(m_handle.renderNode);
+        QMatrix4x4 m = m_transform;
+        rd->m_matrix = &m;
+        rd->m_opacity = m_opacity;
+
+        // all the clip region below is in world coordinates, taking m_transform into account already
+        QRegion cr = m_dirtyRegion;
+        if (m_clipRegion.rectCount() > 1)
+            cr &= m_clipRegion;
+
+        painter->save();
+        RenderNodeState rs;
+        rs.cr = cr;
+        m_handle.renderNode->render(&rs);
+        painter->restore();
+
+        const QRect br = m_handle.renderNode->flags().testFlag(QSGRenderNode::BoundedRectRendering)
+            ? m_boundingRectMax // already mapped to world
+            : QRect(0, 0, painter->device()->width(), painter->device()->height());
+        m_previousDirtyRegion = QRegion(br);
+        m_isDirty = false;
+        m_dirtyRegion = QRegion();
+        return br;
     }
 
+    // m_dirtyRegion already accounts for clipRegion
+    paint(painter, m_dirtyRegion, forceOpaquePainting);
+
+    return finishPainting();
+}
+
+bool QSGSoftwareRenderableNode::needsPainting() const
+{
+    if (!m_isDirty || qFuzzyIsNull(m_opacity))
+        return false;
+    return m_nodeType == RenderNode || !m_dirtyRegion.isEmpty();
+}
+
+/*
+    Brings caches that the nodes would otherwise update lazily from paint() up
+    to date, so that paint() can be called from several threads at once.
+ */
+void QSGSoftwareRenderableNode::prepareForPainting(int devicePixelRatio)
+{
+    switch (m_nodeType) {
+    case QSGSoftwareRenderableNode::Rectangle:
+        m_handle.rectangleNode->updateDevicePixelRatio(devicePixelRatio);
+        break;
+    case QSGSoftwareRenderableNode::SimpleImage:
+        static_cast<QSGSoftwareImageNode *>(m_handle.simpleImageNode)->updateCachedMirroredPixmap();
+        break;
+    default:
+        break;
+    }
+}
+
+/*
+    Paints the node, clipped to \a clipRegion in world coordinates. Unlike
+    renderNode() this leaves the dirty state alone, so a node can be painted in
+    parts, see finishPainting().
+ */
+void QSGSoftwareRenderableNode::paint(QPainter *painter, const QRegion &clipRegion, bool forceOpaquePainting) const
+{
+    Q_ASSERT(m_nodeType != RenderNode);
+
     painter->save();
     painter->setOpacity(m_opacity);
 
-    // Set clipRegion to m_dirtyRegion (in world coordinates, so must be done before the setTransform below)
-    // as m_dirtyRegion already accounts for clipRegion
-    painter->setClipRegion(m_dirtyRegion, Qt::ReplaceClip);
+    // Set clipRegion (in world coordinates, so must be done before the setTransform below)
+    painter->setClipRegion(clipRegion, Qt::ReplaceClip);
     if (m_clipRegion.rectCount() > 1)
         painter->setClipRegion(m_clipRegion, Qt::IntersectClip);
 
@@ -359,9 +389,19 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
     }
 
     painter->restore();
+}
 
-    QRegion areaToBeFlushed = m_dirtyRegion;
-    m_previousDirtyRegion = QRegion(m_boundingRectMax);
+/*
+    Resets the dirty state after the node was painted, and returns the area
+    that needs to be flushed because of it.
+ */
+QRegion QSGSoftwareRenderableNode::finishPainting()
+{
+    QRegion areaToBeFlushed;
+    if (needsPainting()) {
+        areaToBeFlushed = m_dirtyRegion;
+        m_previousDirtyRegion = QRegion(m_boundingRectMax);
+    }
     m_isDirty = false;
     m_dirtyRegion = QRegion();
 
@@ -410,30 +450,12 @@ void QSGSoftwareRenderableNode::markMaterialDirty()
     update();
 }
 
-void QSGSoftwareRenderableNode::addDirtyRegion(const QRegion &dirtyRegion, bool forceDirty)
+void QSGSoftwareRenderableNode::setDirtyRegion(const QRegion &dirtyRegion)
 {
-    // Check if the dirty region applies to this node
-    QRegion prev = m_dirtyRegion;
-    if (dirtyRegion.intersects(m_boundingRectMax)) {
-        if (forceDirty)
-            m_isDirty = true;
-        m_dirtyRegion += dirtyRegion.intersected(m_boundingRectMax);
-    }
-    qCDebug(lcRenderable) << "addDirtyRegion: " << dirtyRegion << "old dirtyRegion: " << prev << "new dirtyRegion: " << m_dirtyRegion;
-}
-
-void QSGSoftwareRenderableNode::subtractDirtyRegion(const QRegion &dirtyRegion)
-{
-    QRegion prev = m_dirtyRegion;
-    if (m_isDirty) {
-        // Check if this rect concerns us
-        if (dirtyRegion.intersects(m_boundingRectMax)) {
-            m_dirtyRegion -= dirtyRegion;
-            if (m_dirtyRegion.isEmpty())
-                m_isDirty = false;
-        }
-    }
-    qCDebug(lcRenderable) << "subtractDirtyRegion: " << dirtyRegion << "old dirtyRegion" << prev << "new dirtyRegion: " << m_dirtyRegion;
+    // The region is expected to be within m_boundingRectMax already
+    qCDebug(lcRenderable) << "setDirtyRegion: " << dirtyRegion << "old dirtyRegion: " << m_dirtyRegion;
+    m_dirtyRegion = dirtyRegion;
+    m_isDirty = !m_dirtyRegion.isEmpty();
 }
 
 QRegion QSGSoftwareRenderableNode::previousDirtyRegion(bool wasRemoved) const
@@ -98,6 +98,12 @@ public:
     void update();
 
     QRegion renderNode(QPainter *painter, bool forceOpaquePainting = false);
+
+    bool needsPainting() const;
+    void prepareForPainting(int devicePixelRatio);
+    void paint(QPainter *painter, const QRegion &clipRegion, bool forceOpaquePainting = false) const;
+    QRegion finishPainting();
+
     QRect boundingRectMin() const { return m_boundingRectMin; }
     QRect boundingRectMax() const { return m_boundingRectMax; }
     NodeType type() const { return m_nodeType; }
@@ -115,8 +121,7 @@ public:
     void markGeometryDirty();
     void markMaterialDirty();
 
-    void addDirtyRegion(const QRegion &dirtyRegion, bool forceDirty = true);
-    void subtractDirtyRegion(const QRegion &dirtyRegion);
+    void setDirtyRegion(const QRegion &dirtyRegion);
 
     QRegion previousDirtyRegion(bool wasRemoved = false) const;
     QRegion dirtyRegion() const;
@@ -131,17 +131,17 @@ void QSGSoftwareRenderLoop::renderWindow(QQuickWindow *window, bool isNewExpose)
         if (!m_windows.contains(window))
             return;
     }
+    const bool grabOnly = data.grabOnly;
     QElapsedTimer renderTimer;
     qint64 renderTime = 0, syncTime = 0, polishTime = 0;
-    bool profileFrames = QSG_RASTER_LOG_TIME_RENDERLOOP().isDebugEnabled();
-    if (profileFrames)
-        renderTimer.start();
+    // always needed for the frame timings
+    const qint64 gcTime = cd->garbageCollectionTime();
+    renderTimer.start();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishFrame);
 
     cd->polishItems();
 
-    if (profileFrames)
-        polishTime = renderTimer.nsecsElapsed();
+    polishTime = renderTimer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_SWITCH(QQuickProfiler::SceneGraphPolishFrame,
                               QQuickProfiler::SceneGraphRenderLoopFrame,
                               QQuickProfiler::SceneGraphPolishPolish);
@@ -151,8 +151,7 @@ void QSGSoftwareRenderLoop::renderWindow(QQuickWindow *window, bool isNewExpose)
     cd->syncSceneGraph();
     rc->endSync();
 
-    if (profileFrames)
-        syncTime = renderTimer.nsecsElapsed();
+    syncTime = renderTimer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
                               QQuickProfiler::SceneGraphRenderLoopSync);
 
@@ -163,8 +162,7 @@ void QSGSoftwareRenderLoop::renderWindow(QQuickWindow *window, bool isNewExpose)
 
     cd->renderSceneGraph(window->size());
 
-    if (profileFrames)
-        renderTime = renderTimer.nsecsElapsed();
+    renderTime = renderTimer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
                               QQuickProfiler::SceneGraphRenderLoopRender);
 
@@ -182,12 +180,21 @@ void QSGSoftwareRenderLoop::renderWindow(QQuickWindow *window, bool isNewExpose)
         cd->fireFrameSwapped();
     }
 
-    qint64 swapTime = 0;
-    if (profileFrames)
-        swapTime = renderTimer.nsecsElapsed();
+    const qint64 swapTime = renderTimer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_END(QQuickProfiler::SceneGraphRenderLoopFrame,
                            QQuickProfiler::SceneGraphRenderLoopSwap);
 
+    if (!grabOnly && m_windows.contains(window)) {
+        // Animations are driven by the default timer with this render loop
+        QQuickFrameTiming timing;
+        timing.polish = polishTime;
+        timing.sync = syncTime - polishTime;
+        timing.render = renderTime - syncTime;
+        timing.swap = swapTime - renderTime;
+        timing.gc = cd->garbageCollectionTime() - gcTime;
+        cd->frameTimings.record(timing);
+    }
+
     if (QSG_RASTER_LOG_TIME_RENDERLOOP().isDebugEnabled()) {
         static QTime lastFrameTime = QTime::currentTime();
         qCDebug(QSG_RASTER_LOG_TIME_RENDERLOOP,
@@ -43,6 +43,7 @@
 
 #include <private/qsgrenderer_p.h>
 #include <private/qquickwindow_p.h>
+#include <private/qquickframetimings_p.h>
 #include <private/qquickprofiler_p.h>
 #include <private/qquickanimatorcontroller_p.h>
 #include <private/qquickprofiler_p.h>
@@ -231,6 +232,10 @@ public:
     qint64 renderTime;
     qint64 sinceLastTime;
 
+    // The GUI thread's part of the next frame, handed over during sync
+    QQuickFrameTiming nextFrameTiming;
+    QQuickFrameTiming frameTiming;
+
 public slots:
     void onSceneGraphChanged() {
         syncResultedInChanges = true;
@@ -434,6 +439,9 @@ void QSGSoftwareRenderThread::sync(bool inExpose)
     mutex.lock();
     Q_ASSERT_X(renderLoop->lockedForSync, "QSGD3D12RenderThread::sync()", "sync triggered with gui not locked");
 
+    frameTiming = nextFrameTiming;
+    nextFrameTiming = QQuickFrameTiming();
+
     if (exposedWindow) {
         QQuickWindowPrivate *wd = QQuickWindowPrivate::get(exposedWindow);
         bool hadRenderer = wd->renderer != nullptr;
@@ -483,14 +491,17 @@ void QSGSoftwareRenderThread::syncAndRender()
     const bool exposeRequested = (pendingUpdate & ExposeRequest) == ExposeRequest;
     pendingUpdate = 0;
 
-    if (syncRequested)
+    if (syncRequested) {
         sync(exposeRequested);
+        frameTiming.sync = waitTimer.nsecsElapsed();
+    }
 
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
                               QQuickProfiler::SceneGraphRenderLoopSync);
 
     if (!syncResultedInChanges && !repaintRequested) {
         qCDebug(QSG_RASTER_LOG_RENDERLOOP, "RT - no changes, render aborted");
+        frameTiming = QQuickFrameTiming();
         int waitTime = vsyncDelta - (int) waitTimer.elapsed();
         if (waitTime > 0)
             msleep(waitTime);
@@ -498,6 +509,7 @@ void QSGSoftwareRenderThread::syncAndRender()
     }
 
     qCDebug(QSG_RASTER_LOG_RENDERLOOP, "RT - rendering started");
+    const qint64 renderStart = waitTimer.nsecsElapsed();
 
     if (rtAnim->isRunning()) {
         wd->animationController->lock();
@@ -512,6 +524,7 @@ void QSGSoftwareRenderThread::syncAndRender()
         if (softwareRenderer)
             softwareRenderer->setBackingStore(backingStore);
         wd->renderSceneGraph(exposedWindow->size());
+        const qint64 renderEnd = waitTimer.nsecsElapsed();
 
         Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
                                   QQuickProfiler::SceneGraphRenderLoopRender);
@@ -529,11 +542,17 @@ void QSGSoftwareRenderThread::syncAndRender()
         renderThrottleTimer.restart();
 
         wd->fireFrameSwapped();
+
+        // The throttling stands in for waiting for V-Sync and counts as swap
+        frameTiming.render = renderEnd - renderStart;
+        frameTiming.swap = waitTimer.nsecsElapsed() - renderEnd;
+        wd->frameTimings.record(frameTiming);
     } else {
         Q_QUICK_SG_PROFILE_SKIP(QQuickProfiler::SceneGraphRenderLoopFrame,
                                 QQuickProfiler::SceneGraphRenderLoopSync, 1);
         qCDebug(QSG_RASTER_LOG_RENDERLOOP, "RT - window not ready, skipping render");
     }
+    frameTiming = QQuickFrameTiming();
 
     qCDebug(QSG_RASTER_LOG_RENDERLOOP, "RT - rendering done");
 
@@ -957,10 +976,14 @@ void QSGSoftwareThreadedRenderLoop::polishAndSync(QSGSoftwareThreadedRenderLoop:
         return;
     }
 
+    QQuickWindowPrivate *wd = QQuickWindowPrivate::get(window);
+    QElapsedTimer timer;
+    const qint64 gcTime = wd->garbageCollectionTime();
+    timer.start();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishAndSync);
 
-    QQuickWindowPrivate *wd = QQuickWindowPrivate::get(window);
     wd->polishItems();
+    const qint64 polishTime = timer.nsecsElapsed();
 
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphPolishAndSync,
                               QQuickProfiler::SceneGraphPolishAndSyncPolish);
@@ -972,6 +995,8 @@ void QSGSoftwareThreadedRenderLoop::polishAndSync(QSGSoftwareThreadedRenderLoop:
     qCDebug(QSG_RASTER_LOG_RENDERLOOP, "polishAndSync - lock for sync");
     w->thread->mutex.lock();
     lockedForSync = true;
+    w->thread->nextFrameTiming.polish = polishTime;
+    w->thread->nextFrameTiming.gc += wd->garbageCollectionTime() - gcTime;
     w->thread->postEvent(new QSGSoftwareSyncEvent(window, inExpose, w->forceRenderPass));
     w->forceRenderPass = false;
 
@@ -989,7 +1014,12 @@ void QSGSoftwareThreadedRenderLoop::polishAndSync(QSGSoftwareThreadedRenderLoop:
 
     if (!animationTimer && m_anim->isRunning()) {
         qCDebug(QSG_RASTER_LOG_RENDERLOOP, "polishAndSync - advancing animations");
+        // The animations prepare the next frame, which is what they are recorded for
+        const qint64 animationStart = timer.nsecsElapsed();
+        const qint64 animationGCTime = wd->garbageCollectionTime();
         m_anim->advance();
+        w->thread->nextFrameTiming.animations = timer.nsecsElapsed() - animationStart;
+        w->thread->nextFrameTiming.gc = wd->garbageCollectionTime() - animationGCTime;
         // We need to trigger another sync to keep animations running...
         w->window->requestUpdate();
         emit timeToIncubate();
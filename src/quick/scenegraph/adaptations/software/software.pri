@@ -5,6 +5,7 @@ QT += gui-private core-private qml-private
 SOURCES += \
     $$PWD/qsgsoftwarecontext.cpp \
     $$PWD/qsgabstractsoftwarerenderer.cpp \
+    $$PWD/qsgsoftwaredirtytilemap.cpp \
     $$PWD/qsgsoftwareglyphnode.cpp \
     $$PWD/qsgsoftwareinternalimagenode.cpp \
     $$PWD/qsgsoftwarepublicnodes.cpp \
@@ -24,6 +25,7 @@ SOURCES += \
 HEADERS += \
     $$PWD/qsgsoftwarecontext_p.h \
     $$PWD/qsgabstractsoftwarerenderer_p.h \
+    $$PWD/qsgsoftwaredirtytilemap_p.h \
     $$PWD/qsgsoftwareglyphnode_p.h \
     $$PWD/qsgsoftwareinternalimagenode_p.h \
     $$PWD/qsgsoftwarepublicnodes_p.h \
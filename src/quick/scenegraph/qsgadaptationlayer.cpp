@@ -42,6 +42,7 @@
 #include <qmath.h>
 #include <QtQuick/private/qsgdistancefieldglyphnode_p.h>
 #include <QtQuick/private/qsgcontext_p.h>
+#include <QtQuick/private/qsgdistancefieldgenerator_p.h>
 #include <private/qrawfont_p.h>
 #include <QtGui/qguiapplication.h>
 #include <qdir.h>
@@ -76,6 +77,8 @@ QSGDistanceFieldGlyphCache::QSGDistanceFieldGlyphCache(QOpenGLContext *c, const
 #else
     Q_UNUSED(c)
 #endif
+
+    m_generator.reset(new QSGDistanceFieldGenerator(font, m_doubleGlyphResolution));
 }
 
 QSGDistanceFieldGlyphCache::~QSGDistanceFieldGlyphCache()
@@ -172,15 +175,21 @@ void QSGDistanceFieldGlyphCache::update()
         qsg_render_timer.start();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphAdaptationLayerFrame);
 
+    // The fields have been generated in the background since the glyphs were
+    // requested, only the ones that are not done yet are waited for.
+    QVector<glyph_t> glyphIndexes;
     QList<QDistanceField> distanceFields;
+    QSet<glyph_t> takenGlyphs;
     const int pendingGlyphsSize = m_pendingGlyphs.size();
+    glyphIndexes.reserve(pendingGlyphsSize);
     distanceFields.reserve(pendingGlyphsSize);
     for (int i = 0; i < pendingGlyphsSize; ++i) {
-        GlyphData &gd = glyphData(m_pendingGlyphs.at(i));
-        distanceFields.append(QDistanceField(gd.path,
-                                             m_pendingGlyphs.at(i),
-                                             m_doubleGlyphResolution));
-        gd.path = QPainterPath(); // no longer needed, so release memory used by the painter path
+        const glyph_t glyphIndex = m_pendingGlyphs.at(i);
+        if (takenGlyphs.contains(glyphIndex))
+            continue;
+        takenGlyphs.insert(glyphIndex);
+        glyphIndexes.append(glyphIndex);
+        distanceFields.append(m_generator->take(glyphIndex));
     }
 
     qint64 renderTime = 0;
@@ -192,7 +201,7 @@ void QSGDistanceFieldGlyphCache::update()
 
     m_pendingGlyphs.reset();
 
-    storeGlyphs(distanceFields);
+    storeGlyphs(glyphIndexes, distanceFields);
 
 #if defined(QSG_DISTANCEFIELD_CACHE_DEBUG)
     for (Texture texture : qAsConst(m_textures))
@@ -290,9 +299,23 @@ void QSGDistanceFieldGlyphCache::setGlyphsTexture(const QVector<glyph_t> &glyphs
 
 void QSGDistanceFieldGlyphCache::markGlyphsToRender(const QVector<glyph_t> &glyphs)
 {
+    QVector<QPainterPath> paths;
     int count = glyphs.count();
-    for (int i = 0; i < count; ++i)
-        m_pendingGlyphs.add(glyphs.at(i));
+    paths.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        glyph_t glyphIndex = glyphs.at(i);
+        m_pendingGlyphs.add(glyphIndex);
+
+        GlyphData &gd = glyphData(glyphIndex);
+        // the path is released once handed to the generator, a glyph that
+        // was removed from the cache needs it again
+        if (gd.path.isEmpty())
+            gd.path = m_referenceFont.pathForGlyph(glyphIndex);
+        paths.append(gd.path);
+        gd.path = QPainterPath();
+    }
+
+    m_generator->generate(glyphs, paths);
 }
 
 void QSGDistanceFieldGlyphCache::updateTexture(uint oldTex, uint newTex, const QSize &newTexSize)
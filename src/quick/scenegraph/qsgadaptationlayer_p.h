@@ -78,6 +78,7 @@ class QOpenGLContext;
 class QSGInternalImageNode;
 class QSGPainterNode;
 class QSGInternalRectangleNode;
+class QSGDistanceFieldGenerator;
 class QSGGlyphNode;
 class QSGRootNode;
 class QSGSpriteNode;
@@ -488,7 +489,9 @@ protected:
     };
 
     virtual void requestGlyphs(const QSet<glyph_t> &glyphs) = 0;
-    virtual void storeGlyphs(const QList<QDistanceField> &glyphs) = 0;
+    // Fields read back from the disk cache do not know their glyph index,
+    // glyphIndexes gives the glyph of each field.
+    virtual void storeGlyphs(const QVector<glyph_t> &glyphIndexes, const QList<QDistanceField> &glyphs) = 0;
     virtual void referenceGlyphs(const QSet<glyph_t> &glyphs) = 0;
     virtual void releaseGlyphs(const QSet<glyph_t> &glyphs) = 0;
 
@@ -522,6 +525,7 @@ private:
     QDataBuffer<glyph_t> m_pendingGlyphs;
     QSet<glyph_t> m_populatingGlyphs;
     QLinkedList<QSGDistanceFieldGlyphConsumer*> m_registeredNodes;
+    QScopedPointer<QSGDistanceFieldGenerator> m_generator;
 
     static Texture s_emptyTexture;
 };
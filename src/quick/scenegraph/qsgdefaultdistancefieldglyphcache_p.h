@@ -73,7 +73,7 @@ public:
     virtual ~QSGDefaultDistanceFieldGlyphCache();
 
     void requestGlyphs(const QSet<glyph_t> &glyphs) override;
-    void storeGlyphs(const QList<QDistanceField> &glyphs) override;
+    void storeGlyphs(const QVector<glyph_t> &glyphIndexes, const QList<QDistanceField> &glyphs) override;
     void referenceGlyphs(const QSet<glyph_t> &glyphs) override;
     void releaseGlyphs(const QSet<glyph_t> &glyphs) override;
 
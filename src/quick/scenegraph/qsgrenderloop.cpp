@@ -48,6 +48,7 @@
 #include <QtCore/private/qabstractanimation_p.h>
 
 #include <QtGui/QOffscreenSurface>
+#include <QtGui/QScreen>
 #include <QtGui/private/qguiapplication_p.h>
 #include <qpa/qplatformintegration.h>
 
@@ -86,6 +87,17 @@ extern Q_GUI_EXPORT QImage qt_gl_read_framebuffer(const QSize &size, bool alpha_
 
 DEFINE_BOOL_CONFIG_OPTION(qmlNoThreadedRenderer, QML_BAD_GUI_RENDER_LOOP);
 DEFINE_BOOL_CONFIG_OPTION(qmlForceThreadedRenderer, QML_FORCE_THREADED_RENDERER); // Might trigger graphics driver threading bugs, use at own risk
+
+// The time between two frames on the window's screen in ns
+static qint64 qsg_frame_interval(QQuickWindow *window)
+{
+    QScreen *screen = window->screen();
+    qreal refreshRate = screen ? screen->refreshRate() : 60;
+    // Some platforms report 0 or something bogus
+    if (refreshRate < 1)
+        refreshRate = 60;
+    return qint64(1000000000 / refreshRate);
+}
 #endif
 QSGRenderLoop *QSGRenderLoop::s_instance = 0;
 
@@ -399,17 +411,17 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
         if (!m_windows.contains(window))
             return;
     }
+    const bool grabOnly = data.grabOnly;
     QElapsedTimer renderTimer;
     qint64 renderTime = 0, syncTime = 0, polishTime = 0;
-    bool profileFrames = QSG_LOG_TIME_RENDERLOOP().isDebugEnabled();
-    if (profileFrames)
-        renderTimer.start();
+    // always needed for the frame timings and the garbage collector's frame budget
+    const qint64 gcTime = cd->garbageCollectionTime();
+    renderTimer.start();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishFrame);
 
     cd->polishItems();
 
-    if (profileFrames)
-        polishTime = renderTimer.nsecsElapsed();
+    polishTime = renderTimer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_SWITCH(QQuickProfiler::SceneGraphPolishFrame,
                               QQuickProfiler::SceneGraphRenderLoopFrame,
                               QQuickProfiler::SceneGraphPolishPolish);
@@ -420,18 +432,18 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
     if (lastDirtyWindow)
         rc->endSync();
 
-    if (profileFrames)
-        syncTime = renderTimer.nsecsElapsed();
+    syncTime = renderTimer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
                               QQuickProfiler::SceneGraphRenderLoopSync);
 
     cd->renderSceneGraph(window->size());
 
-    if (profileFrames)
-        renderTime = renderTimer.nsecsElapsed();
+    renderTime = renderTimer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
                               QQuickProfiler::SceneGraphRenderLoopRender);
 
+    const qint64 frameTime = renderTimer.nsecsElapsed();
+
     if (data.grabOnly) {
         bool alpha = window->format().alphaBufferSize() > 0 && window->color().alpha() != 255;
         grabContent = qt_gl_read_framebuffer(window->size() * window->effectiveDevicePixelRatio(), alpha, alpha);
@@ -445,12 +457,21 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
         cd->fireFrameSwapped();
     }
 
-    qint64 swapTime = 0;
-    if (profileFrames)
-        swapTime = renderTimer.nsecsElapsed();
+    const qint64 swapTime = renderTimer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_END(QQuickProfiler::SceneGraphRenderLoopFrame,
                            QQuickProfiler::SceneGraphRenderLoopSwap);
 
+    if (!grabOnly && m_windows.contains(window)) {
+        // Animations are driven by the default timer with this render loop
+        QQuickFrameTiming timing;
+        timing.polish = polishTime;
+        timing.sync = syncTime - polishTime;
+        timing.render = renderTime - syncTime;
+        timing.swap = swapTime - renderTime;
+        timing.gc = cd->garbageCollectionTime() - gcTime;
+        cd->frameTimings.record(timing);
+    }
+
     if (QSG_LOG_TIME_RENDERLOOP().isDebugEnabled()) {
         static QTime lastFrameTime = QTime::currentTime();
         qCDebug(QSG_LOG_TIME_RENDERLOOP,
@@ -467,6 +488,18 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
     // Might have been set during syncSceneGraph()
     if (data.updatePending)
         maybeUpdate(window);
+
+    // The next frame is going to take about as long as this one, the rest of the frame
+    // interval can be spent on garbage collection. If nothing is animating and no other
+    // frame is scheduled, the GUI thread is idle.
+    if (!grabOnly && m_windows.contains(window)) {
+        QUnifiedTimer *timer = QUnifiedTimer::instance(false);
+        const bool idle = !data.updatePending && (!timer || !timer->runningAnimationCount());
+        if (idle)
+            cd->collectGarbageDuringIdleTime(-1);
+        else
+            cd->collectGarbageDuringIdleTime(qMax<qint64>(0, qsg_frame_interval(window) - frameTime));
+    }
 }
 
 void QSGGuiThreadRenderLoop::exposureChanged(QQuickWindow *window)
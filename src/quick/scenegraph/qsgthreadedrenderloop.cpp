@@ -53,6 +53,7 @@
 
 #include <QtQuick/QQuickWindow>
 #include <private/qquickwindow_p.h>
+#include <private/qquickframetimings_p.h>
 
 #include <QtQuick/private/qsgrenderer_p.h>
 
@@ -345,6 +346,10 @@ public:
 
     QElapsedTimer m_timer;
 
+    // The GUI thread's part of the next frame, handed over during sync
+    QQuickFrameTiming nextFrameTiming;
+    QQuickFrameTiming frameTiming;
+
     QQuickWindow *window; // Will be 0 when window is not exposed
     QSize windowSize;
 
@@ -534,6 +539,9 @@ void QSGRenderThread::sync(bool inExpose)
 
     Q_ASSERT_X(wm->m_lockedForSync, "QSGRenderThread::sync()", "sync triggered on bad terms as gui is not already locked...");
 
+    frameTiming = nextFrameTiming;
+    nextFrameTiming = QQuickFrameTiming();
+
     bool current = false;
     if (windowSize.width() > 0 && windowSize.height() > 0)
         current = gl->makeCurrent(window);
@@ -600,6 +608,7 @@ void QSGRenderThread::syncAndRender()
     if (syncRequested) {
         qCDebug(QSG_LOG_RENDERLOOP) << QSG_RT_PAD << "- updatePending, doing sync";
         sync(exposeRequested);
+        frameTiming.sync = waitTimer.nsecsElapsed();
     }
 #ifndef QSG_NO_RENDER_TIMING
     if (profileFrames)
@@ -610,6 +619,7 @@ void QSGRenderThread::syncAndRender()
 
     if (!syncResultedInChanges && !repaintRequested && sgrc->isValid()) {
         qCDebug(QSG_LOG_RENDERLOOP) << QSG_RT_PAD << "- no changes, render aborted";
+        frameTiming = QQuickFrameTiming();
         int waitTime = vsyncDelta - (int) waitTimer.elapsed();
         if (waitTime > 0)
             msleep(waitTime);
@@ -617,6 +627,7 @@ void QSGRenderThread::syncAndRender()
     }
 
     qCDebug(QSG_LOG_RENDERLOOP) << QSG_RT_PAD << "- rendering started";
+    const qint64 renderStart = waitTimer.nsecsElapsed();
 
 
     if (animatorDriver->isRunning()) {
@@ -638,16 +649,22 @@ void QSGRenderThread::syncAndRender()
         d->renderSceneGraph(windowSize);
         if (profileFrames)
             renderTime = threadTimer.nsecsElapsed();
+        const qint64 renderEnd = waitTimer.nsecsElapsed();
         Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
                                   QQuickProfiler::SceneGraphRenderLoopRender);
         if (!d->customRenderStage || !d->customRenderStage->swap())
             gl->swapBuffers(window);
         d->fireFrameSwapped();
+
+        frameTiming.render = renderEnd - renderStart;
+        frameTiming.swap = waitTimer.nsecsElapsed() - renderEnd;
+        d->frameTimings.record(frameTiming);
     } else {
         Q_QUICK_SG_PROFILE_SKIP(QQuickProfiler::SceneGraphRenderLoopFrame,
                                 QQuickProfiler::SceneGraphRenderLoopSync, 1);
         qCDebug(QSG_LOG_RENDERLOOP) << QSG_RT_PAD << "- window not ready, skipping render";
     }
+    frameTiming = QQuickFrameTiming();
 
     qCDebug(QSG_LOG_RENDERLOOP) << QSG_RT_PAD << "- rendering done";
 
@@ -1173,15 +1190,15 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     qint64 waitTime = 0;
     qint64 syncTime = 0;
     bool profileFrames = QSG_LOG_TIME_RENDERLOOP().isDebugEnabled();
-    if (profileFrames)
-        timer.start();
+    QQuickWindowPrivate *d = QQuickWindowPrivate::get(window);
+    // always needed for the frame timings and the garbage collector's frame budget
+    const qint64 gcTime = d->garbageCollectionTime();
+    timer.start();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishAndSync);
 
-    QQuickWindowPrivate *d = QQuickWindowPrivate::get(window);
     d->polishItems();
 
-    if (profileFrames)
-        polishTime = timer.nsecsElapsed();
+    polishTime = timer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphPolishAndSync,
                               QQuickProfiler::SceneGraphPolishAndSyncPolish);
 
@@ -1192,6 +1209,8 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     qCDebug(QSG_LOG_RENDERLOOP) << "- lock for sync";
     w->thread->mutex.lock();
     m_lockedForSync = true;
+    w->thread->nextFrameTiming.polish = polishTime;
+    w->thread->nextFrameTiming.gc += d->garbageCollectionTime() - gcTime;
     w->thread->postEvent(new WMSyncEvent(window, inExpose, w->forceRenderPass));
     w->forceRenderPass = false;
 
@@ -1205,14 +1224,17 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     w->thread->mutex.unlock();
     qCDebug(QSG_LOG_RENDERLOOP) << "- unlock after sync";
 
-    if (profileFrames)
-        syncTime = timer.nsecsElapsed();
+    syncTime = timer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphPolishAndSync,
                               QQuickProfiler::SceneGraphPolishAndSyncSync);
 
     if (m_animation_timer == 0 && m_animation_driver->isRunning()) {
         qCDebug(QSG_LOG_RENDERLOOP) << "- advancing animations";
+        // The animations prepare the next frame, which is what they are recorded for
+        const qint64 animationGCTime = d->garbageCollectionTime();
         m_animation_driver->advance();
+        w->thread->nextFrameTiming.animations = timer.nsecsElapsed() - syncTime;
+        w->thread->nextFrameTiming.gc = d->garbageCollectionTime() - animationGCTime;
         qCDebug(QSG_LOG_RENDERLOOP) << "- animations done..";
         // We need to trigger another sync to keep animations running...
         maybePostPolishRequest(w);
@@ -1231,6 +1253,16 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
 
     Q_QUICK_SG_PROFILE_END(QQuickProfiler::SceneGraphPolishAndSync,
                            QQuickProfiler::SceneGraphPolishAndSyncAnimations);
+
+    // The render thread is busy with the frame now. Whatever is left of the frame
+    // interval on the GUI thread can be spent on garbage collection, all of it if
+    // no further frame is scheduled.
+    if (inExpose)
+        return;
+    if (!m_animation_driver->isRunning() && !w->updateDuringSync)
+        d->collectGarbageDuringIdleTime(-1);
+    else
+        d->collectGarbageDuringIdleTime(qMax<qint64>(0, qint64(qsgrl_animation_interval()) * 1000000 - timer.nsecsElapsed()));
 }
 
 bool QSGThreadedRenderLoop::event(QEvent *e)
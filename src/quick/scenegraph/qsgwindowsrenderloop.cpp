@@ -41,6 +41,7 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QLibraryInfo>
 #include <QtCore/QThread>
+#include <QtCore/QVarLengthArray>
 
 #include <QtGui/QScreen>
 #include <QtGui/QGuiApplication>
@@ -66,10 +67,9 @@ extern Q_GUI_EXPORT QImage qt_gl_read_framebuffer(const QSize &size, bool alpha_
 #define RLDEBUG(x) qCDebug(QSG_LOG_RENDERLOOP) << x;
 
 static QElapsedTimer qsg_render_timer;
+// The samples are always taken for the window's frame timings
 #define QSG_LOG_TIME_SAMPLE(sampleName) \
-    qint64 sampleName = 0;                                                  \
-    if (QSG_LOG_TIME_RENDERLOOP().isDebugEnabled())  \
-        sampleName = qsg_render_timer.nsecsElapsed(); \
+    const qint64 sampleName = qsg_render_timer.nsecsElapsed();
 
 #define QSG_RENDER_TIMING_SAMPLE(frameType, sampleName, position) \
     QSG_LOG_TIME_SAMPLE(sampleName) \
@@ -194,6 +194,8 @@ void QSGWindowsRenderLoop::show(QQuickWindow *window)
     WindowData data;
     data.window = window;
     data.pendingUpdate = false;
+    data.animationTime = 0;
+    data.animationGCTime = 0;
     m_windows << data;
 
     RLDEBUG(" - done with show");
@@ -397,11 +399,22 @@ void QSGWindowsRenderLoop::render()
 
     if (m_animationDriver->isRunning()) {
         RLDEBUG("advancing animations");
+        QVarLengthArray<qint64, 4> gcTimes;
+        for (const WindowData &wd : qAsConst(m_windows))
+            gcTimes.append(QQuickWindowPrivate::get(wd.window)->garbageCollectionTime());
         QSG_LOG_TIME_SAMPLE(time_start);
         Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphWindowsAnimations);
         m_animationDriver->advance();
         RLDEBUG("animations advanced");
 
+        // The animations prepare the next frame of every window
+        const qint64 animationTime = qsg_render_timer.nsecsElapsed() - time_start;
+        for (int i = 0; i < m_windows.size() && i < gcTimes.size(); ++i) {
+            WindowData &wd = m_windows[i];
+            wd.animationTime = animationTime;
+            wd.animationGCTime = QQuickWindowPrivate::get(wd.window)->garbageCollectionTime() - gcTimes.at(i);
+        }
+
         qCDebug(QSG_LOG_TIME_RENDERLOOP,
                 "animations ticked in %dms",
                 int((qsg_render_timer.nsecsElapsed() - time_start)/1000000));
@@ -458,6 +471,7 @@ void QSGWindowsRenderLoop::renderWindow(QQuickWindow *window)
     if (!windowData(window))
         return;
 
+    const qint64 gcTime = d->garbageCollectionTime();
     QSG_LOG_TIME_SAMPLE(time_start);
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishFrame);
 
@@ -491,6 +505,19 @@ void QSGWindowsRenderLoop::renderWindow(QQuickWindow *window)
     RLDEBUG(" - frameDone");
     d->fireFrameSwapped();
 
+    if (WindowData *wd = windowData(window)) {
+        QQuickFrameTiming timing;
+        timing.polish = time_polished - time_start;
+        timing.animations = wd->animationTime;
+        timing.sync = time_synced - time_polished;
+        timing.render = time_rendered - time_synced;
+        timing.swap = time_swapped - time_rendered;
+        timing.gc = wd->animationGCTime + d->garbageCollectionTime() - gcTime;
+        d->frameTimings.record(timing);
+        wd->animationTime = 0;
+        wd->animationGCTime = 0;
+    }
+
     qCDebug(QSG_LOG_TIME_RENDERLOOP()).nospace()
             << "Frame rendered with 'windows' renderloop in: " << (time_swapped - time_start) / 1000000 << "ms"
             << ", polish=" << (time_polished - time_start) / 1000000
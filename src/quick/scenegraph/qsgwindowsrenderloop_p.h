@@ -104,6 +104,8 @@ private:
     struct WindowData {
         QQuickWindow *window;
         bool pendingUpdate;
+        qint64 animationTime; // spent preparing the next frame
+        qint64 animationGCTime;
     };
 
     void handleObscurity();
@@ -38,6 +38,7 @@ qtConfig(opengl(es1|es2)?) {
 # Util API
 HEADERS += \
     $$PWD/util/qsgareaallocator_p.h \
+    $$PWD/util/qsgdistancefieldgenerator_p.h \
     $$PWD/util/qsgengine.h \
     $$PWD/util/qsgengine_p.h \
     $$PWD/util/qsgsimplerectnode.h \
@@ -56,6 +57,7 @@ HEADERS += \
 
 SOURCES += \
     $$PWD/util/qsgareaallocator.cpp \
+    $$PWD/util/qsgdistancefieldgenerator.cpp \
     $$PWD/util/qsgengine.cpp \
     $$PWD/util/qsgsimplerectnode.cpp \
     $$PWD/util/qsgsimpletexturenode.cpp \
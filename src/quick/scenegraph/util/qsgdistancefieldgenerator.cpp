@@ -0,0 +1,524 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsgdistancefieldgenerator_p.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qstandardpaths.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#include <QtQml/private/qqmlglobal_p.h>
+#include <QtQml/private/qqmlpooledjob_p.h>
+#include <private/qfontengine_p.h>
+#include <private/qrawfont_p.h>
+
+QT_BEGIN_NAMESPACE
+
+DEFINE_BOOL_CONFIG_OPTION(qsgDisableDistanceFieldDiskCache, QSG_DISABLE_DISTANCEFIELD_DISK_CACHE)
+
+#define QSG_DISTANCEFIELD_GENERATOR_MAX_BATCH 32
+#define QSG_DISTANCEFIELD_DISK_CACHE_MAX_NEW_FIELDS 256
+
+Q_GLOBAL_STATIC(QThreadPool, distanceFieldGeneratorPool)
+
+static int distanceFieldGeneratorThreadCount()
+{
+    int count = qEnvironmentVariableIntValue("QSG_DISTANCEFIELD_GENERATOR_THREADS");
+    if (count <= 0)
+        count = QThread::idealThreadCount();
+    return qMax(1, count);
+}
+
+// The disk cache is a header followed by one record per glyph, each record
+// being followed by the width * height bytes of the distance field. It is
+// only ever read by the machine that wrote it, so native byte order is used.
+struct QSGDistanceFieldDiskCacheHeader
+{
+    enum { Magic = 0x46445351, Version = 1 }; // "QSDF"
+
+    quint32 magic;
+    quint32 version;
+    quint32 qtVersion;
+    quint32 radius;
+    quint32 scale;
+    quint32 glyphCount;
+};
+
+struct QSGDistanceFieldDiskCacheRecord
+{
+    quint32 glyph;
+    quint32 width;
+    quint32 height;
+};
+
+struct QSGDistanceFieldDiskCacheRegistry
+{
+    QMutex mutex;
+    QHash<QString, QWeakPointer<QSGDistanceFieldDiskCache> > caches;
+};
+
+Q_GLOBAL_STATIC(QSGDistanceFieldDiskCacheRegistry, diskCacheRegistry)
+
+static QSGDistanceFieldDiskCacheHeader diskCacheHeader(bool doubleGlyphResolution, quint32 glyphCount)
+{
+    QSGDistanceFieldDiskCacheHeader header;
+    header.magic = QSGDistanceFieldDiskCacheHeader::Magic;
+    header.version = QSGDistanceFieldDiskCacheHeader::Version;
+    header.qtVersion = QT_VERSION;
+    header.radius = QT_DISTANCEFIELD_RADIUS(doubleGlyphResolution);
+    header.scale = QT_DISTANCEFIELD_SCALE(doubleGlyphResolution);
+    header.glyphCount = glyphCount;
+    return header;
+}
+
+QSGDistanceFieldDiskCache::QSGDistanceFieldDiskCache(const QString &fileName, bool doubleGlyphResolution)
+    : m_fileName(fileName)
+    , m_doubleGlyphResolution(doubleGlyphResolution)
+    , m_file(0)
+    , m_data(0)
+    , m_size(0)
+    , m_end(0)
+    , m_loaded(false)
+    , m_saveScheduled(false)
+{
+}
+
+QSGDistanceFieldDiskCache::~QSGDistanceFieldDiskCache()
+{
+    // Usually done already by the last save job, which also held on to the cache
+    write();
+    unmap();
+
+    if (QSGDistanceFieldDiskCacheRegistry *registry = diskCacheRegistry()) {
+        QMutexLocker locker(&registry->mutex);
+        if (registry->caches.value(m_fileName).isNull())
+            registry->caches.remove(m_fileName);
+    }
+}
+
+// Returns the cache for the file the font was loaded from, or null if the
+// font does not come from a file.
+QSharedPointer<QSGDistanceFieldDiskCache> QSGDistanceFieldDiskCache::forFont(const QRawFont &font, bool doubleGlyphResolution)
+{
+    if (qsgDisableDistanceFieldDiskCache() || !font.isValid())
+        return QSharedPointer<QSGDistanceFieldDiskCache>();
+
+    QFontEngine *fontEngine = QRawFontPrivate::get(font)->fontEngine;
+    const QFontEngine::FaceId faceId = fontEngine->faceId();
+    if (faceId.filename.isEmpty())
+        return QSharedPointer<QSGDistanceFieldDiskCache>();
+
+    const QFileInfo fontFile(QFile::decodeName(faceId.filename));
+    if (!fontFile.exists())
+        return QSharedPointer<QSGDistanceFieldDiskCache>();
+
+    const QString directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (directory.isEmpty())
+        return QSharedPointer<QSGDistanceFieldDiskCache>();
+
+    // A changed font file, or synthesized bold or italic, gives other outlines
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(faceId.filename);
+    hash.addData(QByteArray::number(faceId.index));
+    hash.addData(QByteArray::number(fontFile.size()));
+    hash.addData(QByteArray::number(fontFile.lastModified().toMSecsSinceEpoch()));
+    hash.addData(QByteArray::number(int(fontEngine->synthesized())));
+    hash.addData(QByteArray::number(int(doubleGlyphResolution)));
+    const QString fileName = directory + QLatin1String("/qtquick/distancefields/")
+            + QString::fromLatin1(hash.result().toHex()) + QLatin1String(".qsgdf");
+
+    QSGDistanceFieldDiskCacheRegistry *registry = diskCacheRegistry();
+    if (!registry)
+        return QSharedPointer<QSGDistanceFieldDiskCache>();
+
+    QMutexLocker locker(&registry->mutex);
+    QSharedPointer<QSGDistanceFieldDiskCache> cache = registry->caches.value(fileName).toStrongRef();
+    if (!cache) {
+        cache.reset(new QSGDistanceFieldDiskCache(fileName, doubleGlyphResolution));
+        registry->caches.insert(fileName, cache);
+    }
+    return cache;
+}
+
+// Called with m_mutex locked
+bool QSGDistanceFieldDiskCache::map()
+{
+    m_file = new QFile(m_fileName);
+    if (!m_file->open(QIODevice::ReadOnly))
+        return false;
+
+    m_size = m_file->size();
+    if (m_size < qint64(sizeof(QSGDistanceFieldDiskCacheHeader)))
+        return false;
+    m_data = m_file->map(0, m_size);
+    return m_data;
+}
+
+// Called with m_mutex locked
+void QSGDistanceFieldDiskCache::unmap()
+{
+    if (m_file) {
+        if (m_data)
+            m_file->unmap(const_cast<uchar *>(m_data));
+        delete m_file;
+        m_file = 0;
+    }
+    m_data = 0;
+    m_size = 0;
+}
+
+// Called with m_mutex locked
+void QSGDistanceFieldDiskCache::load()
+{
+    m_loaded = true;
+    m_end = 0;
+
+    if (!map())
+        return;
+
+    QSGDistanceFieldDiskCacheHeader header;
+    memcpy(&header, m_data, sizeof(header));
+    const QSGDistanceFieldDiskCacheHeader expected = diskCacheHeader(m_doubleGlyphResolution, header.glyphCount);
+    if (memcmp(&header, &expected, sizeof(header)) != 0)
+        return;
+
+    qint64 offset = sizeof(header);
+    for (quint32 i = 0; i < header.glyphCount; ++i) {
+        QSGDistanceFieldDiskCacheRecord record;
+        if (offset + qint64(sizeof(record)) > m_size)
+            break;
+        memcpy(&record, m_data + offset, sizeof(record));
+        const qint64 recordSize = sizeof(record) + qint64(record.width) * record.height;
+        if (offset + recordSize > m_size)
+            break;
+        m_offsets.insert(record.glyph, offset);
+        offset += recordSize;
+    }
+
+    // A truncated file is ignored as a whole, and written again
+    if (m_offsets.size() != int(header.glyphCount))
+        m_offsets.clear();
+    else
+        m_end = offset;
+}
+
+class QSGDistanceFieldDiskCacheSaveJob : public QRunnable
+{
+public:
+    QSGDistanceFieldDiskCacheSaveJob(const QSharedPointer<QSGDistanceFieldDiskCache> &cache)
+        : cache(cache)
+    {
+    }
+
+    void run() override
+    {
+        cache->save();
+    }
+
+    QSharedPointer<QSGDistanceFieldDiskCache> cache;
+};
+
+// Writes the new fields to the file on a thread of the pool, as the render
+// thread should not wait for the disk.
+void QSGDistanceFieldDiskCache::scheduleSave()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_newFields.isEmpty() || m_saveScheduled)
+            return;
+        m_saveScheduled = true;
+    }
+    distanceFieldGeneratorPool()->start(new QSGDistanceFieldDiskCacheSaveJob(sharedFromThis()));
+}
+
+void QSGDistanceFieldDiskCache::save()
+{
+    QMutexLocker locker(&m_mutex);
+    m_saveScheduled = false;
+    write();
+}
+
+// Called with m_mutex locked, or from the destructor. The new fields are
+// appended to a valid file, a new file is only written if there is none yet or
+// the old one cannot be used.
+void QSGDistanceFieldDiskCache::write()
+{
+    if (m_newFields.isEmpty())
+        return;
+    if (!m_loaded)
+        load();
+
+    // Not all platforms can resize a file while it is mapped
+    unmap();
+
+    QHash<glyph_t, qint64> newOffsets;
+    qint64 end = 0;
+    bool written;
+    if (m_end > 0) {
+        QFile file(m_fileName);
+        written = file.open(QIODevice::ReadWrite) && file.resize(m_end) && file.seek(m_end)
+                && writeNewFields(&file, m_end, &newOffsets, &end) && file.flush();
+        if (written) {
+            // The header goes last, an interrupted append leaves the old fields readable
+            const QSGDistanceFieldDiskCacheHeader header = diskCacheHeader(m_doubleGlyphResolution, m_offsets.size() + m_newFields.size());
+            written = file.seek(0) && file.write(reinterpret_cast<const char *>(&header), sizeof(header)) == qint64(sizeof(header));
+        }
+    } else {
+        QDir::root().mkpath(QFileInfo(m_fileName).absolutePath());
+        QSaveFile file(m_fileName);
+        const QSGDistanceFieldDiskCacheHeader header = diskCacheHeader(m_doubleGlyphResolution, m_newFields.size());
+        written = file.open(QIODevice::WriteOnly)
+                && file.write(reinterpret_cast<const char *>(&header), sizeof(header)) == qint64(sizeof(header))
+                && writeNewFields(&file, sizeof(header), &newOffsets, &end) && file.commit();
+    }
+
+    // Keep the memory bounded even if the file could not be written, the
+    // fields get generated again next time
+    m_newFields.clear();
+
+    if (!written) {
+        // The next lookup loads whatever made it to the disk
+        m_offsets.clear();
+        m_end = 0;
+        m_loaded = false;
+        return;
+    }
+
+    for (QHash<glyph_t, qint64>::const_iterator it = newOffsets.constBegin(); it != newOffsets.constEnd(); ++it)
+        m_offsets.insert(it.key(), it.value());
+    m_end = end;
+    if (!map()) {
+        unmap();
+        m_offsets.clear();
+        m_end = 0;
+        m_loaded = false;
+    }
+}
+
+bool QSGDistanceFieldDiskCache::writeNewFields(QIODevice *device, qint64 offset, QHash<glyph_t, qint64> *offsets, qint64 *end) const
+{
+    for (QHash<glyph_t, QDistanceField>::const_iterator it = m_newFields.constBegin(); it != m_newFields.constEnd(); ++it) {
+        QSGDistanceFieldDiskCacheRecord record;
+        record.glyph = it.key();
+        record.width = it->width();
+        record.height = it->height();
+        const qint64 size = qint64(record.width) * record.height;
+        if (device->write(reinterpret_cast<const char *>(&record), sizeof(record)) != qint64(sizeof(record))
+                || device->write(reinterpret_cast<const char *>(it->constBits()), size) != size) {
+            return false;
+        }
+        offsets->insert(it.key(), offset);
+        offset += sizeof(record) + size;
+    }
+    *end = offset;
+    return true;
+}
+
+QDistanceField QSGDistanceFieldDiskCache::find(glyph_t glyph)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_loaded)
+        load();
+
+    const qint64 offset = m_offsets.value(glyph, -1);
+    if (offset < 0)
+        return m_newFields.value(glyph);
+
+    QSGDistanceFieldDiskCacheRecord record;
+    memcpy(&record, m_data + offset, sizeof(record));
+    QDistanceField field(record.width, record.height);
+    if (!field.isNull())
+        memcpy(field.bits(), m_data + offset + sizeof(record), size_t(record.width) * record.height);
+    return field;
+}
+
+void QSGDistanceFieldDiskCache::insert(glyph_t glyph, const QDistanceField &field)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_offsets.contains(glyph))
+        return;
+    m_newFields.insert(glyph, field);
+    const bool full = m_newFields.size() >= QSG_DISTANCEFIELD_DISK_CACHE_MAX_NEW_FIELDS;
+    locker.unlock();
+
+    if (full)
+        scheduleSave();
+}
+
+class QSGDistanceFieldGenerationJob : public QQmlPooledJob
+{
+public:
+    QSGDistanceFieldGenerationJob(bool doubleGlyphResolution, const QSharedPointer<QSGDistanceFieldDiskCache> &diskCache)
+        : doubleGlyphResolution(doubleGlyphResolution)
+        , diskCache(diskCache)
+    {
+    }
+
+    // Runs on a thread of the pool, or in take()
+    void execute() override
+    {
+        fields.reserve(glyphs.size());
+        for (int i = 0; i < glyphs.size(); ++i) {
+            const glyph_t glyph = glyphs.at(i);
+            QDistanceField field;
+            if (diskCache)
+                field = diskCache->find(glyph);
+            if (field.isNull()) {
+                field = QDistanceField(paths.at(i), glyph, doubleGlyphResolution);
+                if (diskCache)
+                    diskCache->insert(glyph, field);
+            }
+            fields.append(field);
+        }
+    }
+
+    const bool doubleGlyphResolution;
+    const QSharedPointer<QSGDistanceFieldDiskCache> diskCache;
+    QVector<glyph_t> glyphs;
+    QVector<QPainterPath> paths;
+    QVector<QDistanceField> fields;
+};
+
+QSGDistanceFieldGenerator::QSGDistanceFieldGenerator(const QRawFont &font, bool doubleGlyphResolution)
+    : m_doubleGlyphResolution(doubleGlyphResolution)
+    , m_diskCache(QSGDistanceFieldDiskCache::forFont(font, doubleGlyphResolution))
+{
+    distanceFieldGeneratorPool()->setMaxThreadCount(distanceFieldGeneratorThreadCount());
+}
+
+QSGDistanceFieldGenerator::~QSGDistanceFieldGenerator()
+{
+    // Drop the jobs no thread has picked up, and wait for the others
+    for (QSGDistanceFieldGenerationJob *job : qAsConst(m_jobs)) {
+        job->cancel();
+        delete job;
+    }
+
+    if (m_diskCache)
+        m_diskCache->scheduleSave();
+}
+
+// Starts generating the distance fields of the glyphs, the paths being in
+// the reference font size.
+void QSGDistanceFieldGenerator::generate(const QVector<glyph_t> &glyphs, const QVector<QPainterPath> &paths)
+{
+    Q_ASSERT(glyphs.size() == paths.size());
+
+    collectFinishedJobs();
+
+    QThreadPool *pool = distanceFieldGeneratorPool();
+    const int threadCount = pool->maxThreadCount();
+    const int batchSize = qBound(1, (glyphs.size() + threadCount - 1) / threadCount,
+                                 QSG_DISTANCEFIELD_GENERATOR_MAX_BATCH);
+
+    QSGDistanceFieldGenerationJob *job = 0;
+    for (int i = 0; i < glyphs.size(); ++i) {
+        const glyph_t glyph = glyphs.at(i);
+        // Already generated, or on its way
+        if (m_fields.contains(glyph) || m_glyphJobs.contains(glyph))
+            continue;
+
+        if (!job)
+            job = new QSGDistanceFieldGenerationJob(m_doubleGlyphResolution, m_diskCache);
+        job->glyphs.append(glyph);
+        job->paths.append(paths.at(i));
+        m_glyphJobs.insert(glyph, job);
+
+        if (job->glyphs.size() == batchSize) {
+            m_jobs.insert(job);
+            job->start(pool);
+            job = 0;
+        }
+    }
+
+    if (job) {
+        m_jobs.insert(job);
+        job->start(pool);
+    }
+}
+
+// Returns the distance field of a glyph passed to generate(), waiting for it
+// if needed. Each field is handed out once.
+QDistanceField QSGDistanceFieldGenerator::take(glyph_t glyph)
+{
+    QHash<glyph_t, QDistanceField>::iterator it = m_fields.find(glyph);
+    if (it == m_fields.end()) {
+        QSGDistanceFieldGenerationJob *job = m_glyphJobs.value(glyph);
+        if (!job)
+            return QDistanceField();
+
+        // Rather than waiting for a busy pool, this generates the batch right here
+        job->waitForFinished();
+        collect(job);
+        it = m_fields.find(glyph);
+    }
+
+    const QDistanceField field = it.value();
+    m_fields.erase(it);
+    return field;
+}
+
+void QSGDistanceFieldGenerator::collect(QSGDistanceFieldGenerationJob *job)
+{
+    for (int i = 0; i < job->glyphs.size(); ++i) {
+        m_fields.insert(job->glyphs.at(i), job->fields.at(i));
+        m_glyphJobs.remove(job->glyphs.at(i));
+    }
+    m_jobs.remove(job);
+    delete job;
+}
+
+void QSGDistanceFieldGenerator::collectFinishedJobs()
+{
+    const QSet<QSGDistanceFieldGenerationJob *> jobs = m_jobs;
+    for (QSGDistanceFieldGenerationJob *job : jobs) {
+        if (job->isFinished()) {
+            job->waitForFinished();
+            collect(job);
+        }
+    }
+}
+
+QT_END_NAMESPACE
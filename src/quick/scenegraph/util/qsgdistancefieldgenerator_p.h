@@ -0,0 +1,134 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSGDISTANCEFIELDGENERATOR_P_H
+#define QSGDISTANCEFIELDGENERATOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtquickglobal_p.h>
+#include <private/qdistancefield_p.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qvector.h>
+#include <QtGui/qpainterpath.h>
+#include <QtGui/qrawfont.h>
+
+QT_BEGIN_NAMESPACE
+
+class QFile;
+class QIODevice;
+class QSGDistanceFieldGenerationJob;
+
+// Distance fields of one font file, kept on disk across runs. Shared by all
+// the glyph caches using the same font file.
+class Q_QUICK_PRIVATE_EXPORT QSGDistanceFieldDiskCache : public QEnableSharedFromThis<QSGDistanceFieldDiskCache>
+{
+public:
+    ~QSGDistanceFieldDiskCache();
+
+    static QSharedPointer<QSGDistanceFieldDiskCache> forFont(const QRawFont &font, bool doubleGlyphResolution);
+
+    QString fileName() const { return m_fileName; }
+
+    QDistanceField find(glyph_t glyph);
+    void insert(glyph_t glyph, const QDistanceField &field);
+
+    void scheduleSave();
+    void save();
+
+private:
+    QSGDistanceFieldDiskCache(const QString &fileName, bool doubleGlyphResolution);
+
+    bool map();
+    void unmap();
+    void load();
+    void write();
+    bool writeNewFields(QIODevice *device, qint64 offset, QHash<glyph_t, qint64> *offsets, qint64 *end) const;
+
+    const QString m_fileName;
+    const bool m_doubleGlyphResolution;
+    QMutex m_mutex;
+    QFile *m_file;
+    const uchar *m_data;
+    qint64 m_size;
+    qint64 m_end; // of the last field in a valid file, 0 if there is none
+    bool m_loaded;
+    bool m_saveScheduled;
+    QHash<glyph_t, qint64> m_offsets;
+    QHash<glyph_t, QDistanceField> m_newFields;
+};
+
+// Generates distance fields on a pool of threads, so that the render thread
+// only has to upload them. Only used from the render thread.
+class Q_QUICK_PRIVATE_EXPORT QSGDistanceFieldGenerator
+{
+public:
+    QSGDistanceFieldGenerator(const QRawFont &font, bool doubleGlyphResolution);
+    ~QSGDistanceFieldGenerator();
+
+    void generate(const QVector<glyph_t> &glyphs, const QVector<QPainterPath> &paths);
+    QDistanceField take(glyph_t glyph);
+
+private:
+    void collect(QSGDistanceFieldGenerationJob *job);
+    void collectFinishedJobs();
+
+    bool m_doubleGlyphResolution;
+    QSharedPointer<QSGDistanceFieldDiskCache> m_diskCache;
+
+    QSet<QSGDistanceFieldGenerationJob *> m_jobs;
+    QHash<glyph_t, QSGDistanceFieldGenerationJob *> m_glyphJobs;
+    QHash<glyph_t, QDistanceField> m_fields;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGDISTANCEFIELDGENERATOR_P_H
@@ -42,6 +42,9 @@
 
 #include "qquickanimatorjob_p.h"
 
+#include <private/qquickitem_p.h>
+#include <private/qquickwindow_p.h>
+
 #include <private/qquickstatechangescript_p.h>
 #include <private/qqmlcontext_p.h>
 
@@ -66,6 +69,7 @@
 #include <QtCore/qpoint.h>
 #include <QtCore/qsize.h>
 #include <QtCore/qmath.h>
+#include <QtCore/private/qmetaobject_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -1322,6 +1326,15 @@ QAbstractAnimationJob* QQuickPropertyAction::transition(QQuickStateActions &acti
     changes in the number value that it is tracking. If this is the case, use
     SmoothedAnimation instead.
 
+    If the \c QT_QUICK_PROMOTE_ANIMATIONS environment variable is set to \c 1
+    when a window is created, a NumberAnimation that is not part of an animation group and animates
+    exactly one of \c x, \c y, \c scale or \c opacity of an Item in a window
+    runs as the corresponding \l Animator instead, for example in a Behavior.
+    This only happens when nothing observes the property while it animates: no
+    bindings, signal handlers or connections to its change signal, and no anchors
+    or positioners that follow it. Like with Animators, the property is only
+    updated when the animation ends or is stopped.
+
     \sa {Animation and Transitions in Qt Quick}, {Qt Quick Examples - Animation}
 */
 QQuickNumberAnimation::QQuickNumberAnimation(QObject *parent)
@@ -1407,6 +1420,94 @@ void QQuickNumberAnimation::setTo(qreal t)
     QQuickPropertyAnimation::setTo(t);
 }
 
+/*
+    Creates the animator job that can animate the property of action instead,
+    or returns null if the intermediate values could be observed, in which
+    case they must still be written on every frame.
+*/
+static QQuickAnimatorJob *createPromotedJob(const QQuickStateAction &action)
+{
+    QQuickItem *item = qobject_cast<QQuickItem *>(action.property.object());
+    if (!item || !item->window() || !QQuickWindowPrivate::get(item->window())->promoteAnimationsToAnimators)
+        return 0;
+
+    const QQmlPropertyPrivate *property = QQmlPropertyPrivate::get(action.property);
+    if (!property || property->valueTypeData.isValid() || property->core.isAlias())
+        return 0;
+
+    const QString name = action.property.name();
+    if (property->core.coreIndex() != QQuickItem::staticMetaObject.indexOfProperty(name.toLatin1().constData()))
+        return 0; //redeclared in a subclass
+
+    QQuickItemPrivate::ChangeTypes observedChanges = 0;
+    QQuickGeometryChange observedGeometry;
+    if (name == QLatin1String("x")) {
+        observedChanges = QQuickItemPrivate::Geometry;
+        observedGeometry.setXChange(true);
+    } else if (name == QLatin1String("y")) {
+        observedChanges = QQuickItemPrivate::Geometry;
+        observedGeometry.setYChange(true);
+    } else if (name == QLatin1String("opacity")) {
+        observedChanges = QQuickItemPrivate::Opacity;
+    } else if (name != QLatin1String("scale")) {
+        return 0;
+    }
+
+    QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+    const QMetaMethod notifySignal = action.property.property().notifySignal();
+    if (itemPrivate->isSignalConnected(QMetaObjectPrivate::signalIndex(notifySignal)))
+        return 0; //includes bindings and signal handlers
+    for (const QQuickItemPrivate::ChangeListener &listener : qAsConst(itemPrivate->changeListeners)) {
+        if (!(listener.types & observedChanges))
+            continue;
+        if (!(observedChanges & QQuickItemPrivate::Geometry) || listener.gTypes.matches(observedGeometry))
+            return 0;
+    }
+
+    if (name == QLatin1String("x"))
+        return new QQuickXAnimatorJob;
+    if (name == QLatin1String("y"))
+        return new QQuickYAnimatorJob;
+    if (name == QLatin1String("opacity"))
+        return new QQuickOpacityAnimatorJob;
+    return new QQuickScaleAnimatorJob;
+}
+
+QQuickAbstractAnimation::ThreadingModel QQuickNumberAnimation::threadingModel() const
+{
+    Q_D(const QQuickPropertyAnimation);
+    //decided by transition(), which is always called before this outside of animation groups
+    return d->promotedToAnimator ? RenderThread : GuiThread;
+}
+
+QAbstractAnimationJob* QQuickNumberAnimation::transition(QQuickStateActions &actions,
+                                                         QQmlProperties &modified,
+                                                         TransitionDirection direction,
+                                                         QObject *defaultTarget)
+{
+    Q_D(QQuickPropertyAnimation);
+    d->promotedToAnimator = false;
+
+    // Groups ask for the threading model before creating the jobs, and the
+    // animation system cannot handle backwards animators.
+    if (d->group || direction == Backward)
+        return QQuickPropertyAnimation::transition(actions, modified, direction, defaultTarget);
+
+    QQuickStateActions dataActions = createTransitionActions(actions, modified, defaultTarget);
+    QQuickAnimatorJob *job = dataActions.count() == 1 ? createPromotedJob(dataActions.first()) : 0;
+    if (!job)
+        return createBulkValueAnimator(dataActions, direction);
+
+    const QQuickStateAction &action = dataActions.first();
+    job->setTarget(qobject_cast<QQuickItem *>(action.property.object()));
+    job->setFrom(action.fromValue.isValid() ? action.fromValue.toReal() : action.property.read().toReal());
+    job->setTo(action.toValue.isValid() ? action.toValue.toReal() : action.property.read().toReal());
+    job->setDuration(d->duration);
+    job->setEasingCurve(d->easing);
+    d->promotedToAnimator = true;
+    return initInstance(job);
+}
+
 
 
 /*!
@@ -2525,6 +2626,98 @@ QQmlListProperty<QObject> QQuickPropertyAnimation::exclude()
     return QQmlListProperty<QObject>(this, d->exclude);
 }
 
+template<typename T>
+static inline T _q_interpolateTyped(const T &f, const T &t, qreal progress)
+{
+    return T(f + (t - f) * progress);
+}
+
+template<>
+inline QRectF _q_interpolateTyped(const QRectF &f, const QRectF &t, qreal progress)
+{
+    return QRectF(_q_interpolateTyped(f.x(), t.x(), progress), _q_interpolateTyped(f.y(), t.y(), progress),
+                  _q_interpolateTyped(f.width(), t.width(), progress), _q_interpolateTyped(f.height(), t.height(), progress));
+}
+
+template<>
+inline QColor _q_interpolateTyped(const QColor &f, const QColor &t, qreal progress)
+{
+    return QColor(qBound(0, _q_interpolateTyped(f.red(), t.red(), progress), 255),
+                  qBound(0, _q_interpolateTyped(f.green(), t.green(), progress), 255),
+                  qBound(0, _q_interpolateTyped(f.blue(), t.blue(), progress), 255),
+                  qBound(0, _q_interpolateTyped(f.alpha(), t.alpha(), progress), 255));
+}
+
+template<typename T>
+static inline void writeInterpolated(const QQmlPropertyPrivate *property, const QQuickStateAction &action, qreal progress)
+{
+    T value = _q_interpolateTyped(*static_cast<const T *>(action.fromValue.constData()),
+                                  *static_cast<const T *>(action.toValue.constData()), progress);
+    property->core.writeProperty(property->object, &value, QQmlPropertyData::BypassInterceptor | QQmlPropertyData::DontRemoveBinding);
+}
+
+/*
+    Interpolates the common types with the same arithmetic as their standard
+    interpolators, and writes the result straight through the metacall, so
+    that no QVariant is created per frame. Returns false if the action needs
+    the generic path: a custom interpolator (e.g. RotationAnimation), a value
+    type member like font.pixelSize, an alias, an enum or differing types.
+*/
+bool QQuickAnimationPropertyUpdater::writeTyped(const QQuickStateAction &action, qreal v)
+{
+    const int type = action.fromValue.userType();
+    if (type != action.toValue.userType())
+        return false;
+
+    if (interpolator != checkedInterpolator || type != checkedInterpolatorType) {
+        checkedInterpolator = interpolator;
+        checkedInterpolatorType = type;
+        switch (type) {
+        case QMetaType::Double:
+        case QMetaType::Int:
+        case QMetaType::QColor:
+        case QMetaType::QPointF:
+        case QMetaType::QSizeF:
+        case QMetaType::QRectF:
+            typedInterpolation = interpolator == QVariantAnimationPrivate::getInterpolator(type);
+            break;
+        default:
+            typedInterpolation = false;
+        }
+    }
+    if (!typedInterpolation)
+        return false;
+
+    const QQmlPropertyPrivate *property = QQmlPropertyPrivate::get(action.property);
+    if (!property || !property->object || !property->core.isValid() || property->valueTypeData.isValid()
+            || property->core.isFunction() || property->core.isAlias() || property->core.isEnum()
+            || !property->core.isWritable() || property->core.propType() != type) {
+        return false;
+    }
+
+    switch (type) {
+    case QMetaType::Double:
+        writeInterpolated<double>(property, action, v);
+        break;
+    case QMetaType::Int:
+        writeInterpolated<int>(property, action, v);
+        break;
+    case QMetaType::QColor:
+        writeInterpolated<QColor>(property, action, v);
+        break;
+    case QMetaType::QPointF:
+        writeInterpolated<QPointF>(property, action, v);
+        break;
+    case QMetaType::QSizeF:
+        writeInterpolated<QSizeF>(property, action, v);
+        break;
+    case QMetaType::QRectF:
+        writeInterpolated<QRectF>(property, action, v);
+        break;
+    }
+    return true;
+}
+
 void QQuickAnimationPropertyUpdater::setValue(qreal v)
 {
     bool deleted = false;
@@ -2550,7 +2743,7 @@ void QQuickAnimationPropertyUpdater::setValue(qreal v)
                     interpolator = QVariantAnimationPrivate::getInterpolator(prevInterpolatorType);
                 }
             }
-            if (interpolator)
+            if (interpolator && !writeTyped(action, v))
                 QQmlPropertyPrivate::write(action.property, interpolator(action.fromValue.constData(), action.toValue.constData(), v), QQmlPropertyData::BypassInterceptor | QQmlPropertyData::DontRemoveBinding);
         }
         if (deleted)
@@ -2688,9 +2881,14 @@ QAbstractAnimationJob* QQuickPropertyAnimation::transition(QQuickStateActions &a
                                                                      TransitionDirection direction,
                                                                      QObject *defaultTarget)
 {
-    Q_D(QQuickPropertyAnimation);
-
     QQuickStateActions dataActions = createTransitionActions(actions, modified, defaultTarget);
+    return createBulkValueAnimator(dataActions, direction);
+}
+
+QAbstractAnimationJob *QQuickPropertyAnimation::createBulkValueAnimator(const QQuickStateActions &dataActions,
+                                                                        TransitionDirection direction)
+{
+    Q_D(QQuickPropertyAnimation);
 
     QQuickBulkValueAnimator *animator = new QQuickBulkValueAnimator;
     animator->setDuration(d->duration);
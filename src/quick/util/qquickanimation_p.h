@@ -301,6 +301,8 @@ protected:
     QQuickStateActions createTransitionActions(QQuickStateActions &actions,
                                                      QQmlProperties &modified,
                                                      QObject *defaultTarget = 0);
+    QAbstractAnimationJob *createBulkValueAnimator(const QQuickStateActions &dataActions,
+                                                   TransitionDirection direction);
 
     QQuickPropertyAnimation(QQuickPropertyAnimationPrivate &dd, QObject *parent);
     QAbstractAnimationJob* transition(QQuickStateActions &actions,
@@ -355,6 +357,11 @@ public:
 
 protected:
     QQuickNumberAnimation(QQuickPropertyAnimationPrivate &dd, QObject *parent);
+    ThreadingModel threadingModel() const override;
+    QAbstractAnimationJob* transition(QQuickStateActions &actions,
+                            QQmlProperties &modified,
+                            TransitionDirection direction,
+                            QObject *defaultTarget = 0) override;
 
 private:
     void init();
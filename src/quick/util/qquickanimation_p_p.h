@@ -266,7 +266,7 @@ class QQuickPropertyAnimationPrivate : public QQuickAbstractAnimationPrivate
 public:
     QQuickPropertyAnimationPrivate()
     : QQuickAbstractAnimationPrivate(), target(0), fromSourced(false), fromIsDefined(false), toIsDefined(false),
-      defaultToInterpolatorType(0), interpolatorType(0), interpolator(0), duration(250), actions(0) {}
+      defaultToInterpolatorType(0), promotedToAnimator(false), interpolatorType(0), interpolator(0), duration(250), actions(0) {}
 
     QVariant from;
     QVariant to;
@@ -282,6 +282,7 @@ public:
     bool fromIsDefined:1;
     bool toIsDefined:1;
     bool defaultToInterpolatorType:1;
+    bool promotedToAnimator:1; //the last transition() created an animator job, see QQuickNumberAnimation
     int interpolatorType;
     QVariantAnimation::Interpolator interpolator;
     int duration;
@@ -306,7 +307,8 @@ public:
 class Q_AUTOTEST_EXPORT QQuickAnimationPropertyUpdater : public QQuickBulkValueUpdater
 {
 public:
-    QQuickAnimationPropertyUpdater() : interpolatorType(0), interpolator(0), prevInterpolatorType(0), reverse(false), fromSourced(false), fromDefined(false), wasDeleted(0) {}
+    QQuickAnimationPropertyUpdater() : interpolatorType(0), interpolator(0), prevInterpolatorType(0), reverse(false), fromSourced(false), fromDefined(false), wasDeleted(0)
+        , checkedInterpolator(0), checkedInterpolatorType(0), typedInterpolation(false) {}
     ~QQuickAnimationPropertyUpdater();
 
     void setValue(qreal v) override;
@@ -321,6 +323,14 @@ public:
     bool fromSourced;
     bool fromDefined;
     bool *wasDeleted;
+
+private:
+    bool writeTyped(const QQuickStateAction &action, qreal v);
+
+    //whether interpolator is the standard one for checkedInterpolatorType
+    QVariantAnimation::Interpolator checkedInterpolator;
+    int checkedInterpolatorType;
+    bool typedInterpolation;
 };
 
 QT_END_NAMESPACE
@@ -55,9 +55,13 @@
 #include <QCoreApplication>
 #include <QImageReader>
 #include <QHash>
+#include <QSet>
 #include <QPixmapCache>
 #include <QFile>
 #include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QElapsedTimer>
 #include <QMutex>
 #include <QMutexLocker>
 #include <QWaitCondition>
@@ -65,6 +69,8 @@
 #include <QWaitCondition>
 #include <QtCore/qdebug.h>
 #include <private/qobject_p.h>
+
+#include <algorithm>
 #include <QQmlFile>
 #include <QMetaMethod>
 
@@ -78,6 +84,7 @@
 
 #define IMAGEREQUEST_MAX_NETWORK_REQUEST_COUNT 8
 #define IMAGEREQUEST_MAX_REDIRECT_RECURSION 16
+#define IMAGEREQUEST_MAX_DECODER_THREADS 4
 #define CACHE_EXPIRE_TIME 30
 #define CACHE_REMOVAL_FRACTION 4
 
@@ -94,6 +101,24 @@ static const bool qsg_leak_check = !qEnvironmentVariableIsEmpty("QML_LEAK_CHECK"
 // The cache limit describes the maximum "junk" in the cache.
 static int cache_limit = 2048 * 1024; // 2048 KB cache limit for embedded in qpixmapcache.cpp
 
+// Decoding of local files, network payloads and synchronous image providers
+// is spread over a pool of threads shared by all readers.
+Q_GLOBAL_STATIC(QThreadPool, pixmapDecoderPool)
+
+static int pixmapDecoderThreadCount()
+{
+    int count = qEnvironmentVariableIntValue("QML_PIXMAP_DECODER_THREADS");
+    if (count <= 0)
+        count = qBound(1, QThread::idealThreadCount() - 1, IMAGEREQUEST_MAX_DECODER_THREADS);
+    return count;
+}
+
+static int pixmapDecoderCount()
+{
+    static const int count = pixmapDecoderThreadCount();
+    return count;
+}
+
 static inline QString imageProviderId(const QUrl &url)
 {
     return url.host();
@@ -140,8 +165,11 @@ public:
     QQmlEngine *engineForReader; // always access reader inside readerMutex
     QSize requestSize;
     QUrl url;
+    QString localFile;
 
     bool loading;
+    bool providerRequest;
+    int priority; // always access inside the reader's mutex
     QQuickImageProviderOptions providerOptions;
     int redirectCount;
 
@@ -186,6 +214,31 @@ private:
     QQuickPixmapReader *reader;
 };
 
+class QQuickPixmapDecodeJob : public QRunnable
+{
+public:
+    QQuickPixmapDecodeJob(QQuickPixmapReader *reader, QQuickPixmapReply *reply,
+                          QQuickImageProvider::ImageType imageType, QQuickImageProvider *provider)
+        : reader(reader), reply(reply), imageType(imageType), provider(provider)
+    {
+    }
+
+    void run() override;
+
+    void abort() { aborted.store(1); }
+    bool isAborted() const { return aborted.load(); }
+
+    QQuickPixmapReader *reader;
+    QQuickPixmapReply *reply;
+    QQuickImageProvider::ImageType imageType;
+    QQuickImageProvider *provider;
+    QByteArray networkData;
+    QUrl networkUrl;
+
+private:
+    QAtomicInt aborted;
+};
+
 class QQuickPixmapData;
 class QQuickPixmapReader : public QThread
 {
@@ -196,6 +249,8 @@ public:
 
     QQuickPixmapReply *getImage(QQuickPixmapData *);
     void cancel(QQuickPixmapReply *rep);
+    void setPriority(QQuickPixmapReply *rep, int priority);
+    QQuickPixmapDecodeStatistics statistics();
 
     static QQuickPixmapReader *instance(QQmlEngine *engine);
     static QQuickPixmapReader *existingInstance(QQmlEngine *engine);
@@ -205,8 +260,14 @@ protected:
 
 private:
     friend class QQuickPixmapReaderThreadObject;
+    friend class QQuickPixmapDecodeJob;
     void processJobs();
+    bool canStart(QQuickPixmapReply *, QQuickImageProvider::ImageType, QQuickImageProvider *) const;
     void processJob(QQuickPixmapReply *, const QUrl &, const QString &, QQuickImageProvider::ImageType, QQuickImageProvider *);
+    void startDecode(QQuickPixmapDecodeJob *);
+    void decode(QQuickPixmapDecodeJob *);
+    void decodeFinished(QQuickPixmapDecodeJob *, QQuickPixmapReply::ReadError, const QString &,
+                        const QSize &, QQuickTextureFactory *, qint64 elapsed);
 #if QT_CONFIG(qml_network)
     void networkRequestDone(QNetworkReply *);
 #endif
@@ -221,6 +282,15 @@ private:
     QQuickPixmapReaderThreadObject *threadObject;
     QWaitCondition waitCondition;
 
+    // Decodes running or queued on the decoder pool. A reply stays alive
+    // while it is referenced from here, even if it has been cancelled.
+    QHash<QQuickPixmapReply*,QQuickPixmapDecodeJob*> decodes;
+    // Image providers are not required to be reentrant, so each of them
+    // serves one request at a time.
+    QSet<QQuickImageProvider*> busyProviders;
+    int maxDecodes;
+    QQuickPixmapDecodeStatistics stats;
+
 #if QT_CONFIG(qml_network)
     QNetworkAccessManager *networkAccessManager();
     QNetworkAccessManager *accessManager;
@@ -241,7 +311,7 @@ class QQuickPixmapData
 {
 public:
     QQuickPixmapData(QQuickPixmap *pixmap, const QUrl &u, const QSize &s, const QQuickImageProviderOptions &po, const QString &e)
-    : refCount(1), inCache(false), pixmapStatus(QQuickPixmap::Error),
+    : refCount(1), lastUse(0), inCache(false), evicted(false), pixmapStatus(QQuickPixmap::Error),
       url(u), errorString(e), requestSize(s),
       providerOptions(po), appliedTransform(QQuickImageProviderOptions::UsePluginDefaultTransform),
       textureFactory(0), reply(0), prevUnreferenced(0),
@@ -251,7 +321,7 @@ public:
     }
 
     QQuickPixmapData(QQuickPixmap *pixmap, const QUrl &u, const QSize &r, const QQuickImageProviderOptions &po, QQuickImageProviderOptions::AutoTransform aTransform)
-    : refCount(1), inCache(false), pixmapStatus(QQuickPixmap::Loading),
+    : refCount(1), lastUse(0), inCache(false), evicted(false), pixmapStatus(QQuickPixmap::Loading),
       url(u), requestSize(r),
       providerOptions(po), appliedTransform(aTransform),
       textureFactory(0), reply(0), prevUnreferenced(0), prevUnreferencedPtr(0),
@@ -262,17 +332,19 @@ public:
 
     QQuickPixmapData(QQuickPixmap *pixmap, const QUrl &u, QQuickTextureFactory *texture,
                      const QSize &s, const QSize &r, const QQuickImageProviderOptions &po, QQuickImageProviderOptions::AutoTransform aTransform)
-    : refCount(1), inCache(false), pixmapStatus(QQuickPixmap::Ready),
+    : refCount(1), lastUse(0), inCache(false), evicted(false), pixmapStatus(QQuickPixmap::Ready),
       url(u), implicitSize(s), requestSize(r),
       providerOptions(po), appliedTransform(aTransform),
       textureFactory(texture), reply(0), prevUnreferenced(0),
       prevUnreferencedPtr(0), nextUnreferenced(0)
     {
         declarativePixmaps.insert(pixmap);
+        if (texture)
+            trackCost();
     }
 
     QQuickPixmapData(QQuickPixmap *pixmap, QQuickTextureFactory *texture)
-    : refCount(1), inCache(false), pixmapStatus(QQuickPixmap::Ready),
+    : refCount(1), lastUse(0), inCache(false), evicted(false), pixmapStatus(QQuickPixmap::Ready),
       appliedTransform(QQuickImageProviderOptions::UsePluginDefaultTransform),
       textureFactory(texture), reply(0), prevUnreferenced(0),
       prevUnreferencedPtr(0), nextUnreferenced(0)
@@ -280,6 +352,8 @@ public:
         if (texture)
             requestSize = implicitSize = texture->textureSize();
         declarativePixmaps.insert(pixmap);
+        if (texture)
+            trackCost();
     }
 
     ~QQuickPixmapData()
@@ -289,6 +363,8 @@ public:
             declarativePixmaps.remove(referencer);
             referencer->d = 0;
         }
+        if (textureFactory)
+            untrackCost();
         delete textureFactory;
     }
 
@@ -297,10 +373,17 @@ public:
     void release();
     void addToCache();
     void removeFromCache();
+    void trackCost();
+    void untrackCost();
+    bool isEvictable();
+    bool isDisplayed();
+    void evict();
 
     uint refCount;
+    quint64 lastUse;
 
     bool inCache:1;
+    bool evicted:1;
 
     QQuickPixmap::Status pixmapStatus;
     QUrl url;
@@ -311,6 +394,7 @@ public:
     QQuickImageProviderOptions::AutoTransform appliedTransform;
 
     QQuickTextureFactory *textureFactory;
+    QSize evictedSize;
 
     QIntrusiveList<QQuickPixmap, &QQuickPixmap::dataListNode> declarativePixmaps;
     QQuickPixmapReply *reply;
@@ -414,12 +498,46 @@ static bool readImage(const QUrl& url, QIODevice *dev, QImage *image, QString *e
     }
 }
 
+// Fails the image reader's next read once the decode has been aborted, so
+// that a cancelled request does not keep a decoder thread busy.
+template <typename Device>
+class QQuickPixmapAbortableDevice : public Device
+{
+public:
+    template <typename Arg>
+    QQuickPixmapAbortableDevice(Arg arg, const QQuickPixmapDecodeJob *job)
+        : Device(arg), job(job)
+    {
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        if (job->isAborted()) {
+            this->setErrorString(QStringLiteral("Decoding aborted"));
+            return -1;
+        }
+        return Device::readData(data, maxSize);
+    }
+
+private:
+    const QQuickPixmapDecodeJob *job;
+};
+
+void QQuickPixmapDecodeJob::run()
+{
+    reader->decode(this);
+}
+
 QQuickPixmapReader::QQuickPixmapReader(QQmlEngine *eng)
-: QThread(eng), engine(eng), threadObject(0)
+: QThread(eng), engine(eng), threadObject(0), maxDecodes(pixmapDecoderCount())
 #if QT_CONFIG(qml_network)
 , accessManager(0)
 #endif
 {
+    stats.maxDecodes = maxDecodes;
+    pixmapDecoderPool()->setMaxThreadCount(maxDecodes);
+
     eventLoopQuitHack = new QObject;
     eventLoopQuitHack->moveToThread(this);
     connect(eventLoopQuitHack, SIGNAL(destroyed(QObject*)), SLOT(quit()), Qt::DirectConnection);
@@ -440,21 +558,31 @@ QQuickPixmapReader::~QQuickPixmapReader()
         delete reply;
     }
     jobs.clear();
-#if QT_CONFIG(qml_network)
 
     const auto cancelJob = [this](QQuickPixmapReply *reply) {
-        if (reply->loading) {
+        if (reply->loading && !cancelled.contains(reply)) {
             cancelled.append(reply);
             reply->data = 0;
         }
     };
 
+#if QT_CONFIG(qml_network)
     for (auto *reply : qAsConst(networkJobs))
         cancelJob(reply);
 
     for (auto *reply : qAsConst(asyncResponses))
         cancelJob(reply);
 #endif
+
+    // The decoder threads cannot be stopped, but they drop aborted decodes
+    // at their next read. Wait for them before the engine goes away.
+    for (auto it = decodes.cbegin(), end = decodes.cend(); it != end; ++it) {
+        it.value()->abort();
+        cancelJob(it.key());
+    }
+    while (stats.activeDecodes > 0)
+        waitCondition.wait(&mutex);
+
     if (threadObject) threadObject->processJobs();
     mutex.unlock();
 
@@ -487,25 +615,18 @@ void QQuickPixmapReader::networkRequestDone(QNetworkReply *reply)
             }
         }
 
-        QImage image;
-        QQuickPixmapReply::ReadError error = QQuickPixmapReply::NoError;
-        QString errorString;
-        QSize readSize;
         if (reply->error()) {
-            error = QQuickPixmapReply::Loading;
-            errorString = reply->errorString();
+            // send completion event to the QQuickPixmapReply
+            mutex.lock();
+            if (!cancelled.contains(job))
+                job->postReply(QQuickPixmapReply::Loading, reply->errorString(), QSize(), 0);
+            mutex.unlock();
         } else {
-            QByteArray all = reply->readAll();
-            QBuffer buff(&all);
-            buff.open(QIODevice::ReadOnly);
-            if (!readImage(reply->url(), &buff, &image, &errorString, &readSize, job->requestSize, job->providerOptions))
-                error = QQuickPixmapReply::Decoding;
-       }
-        // send completion event to the QQuickPixmapReply
-        mutex.lock();
-        if (!cancelled.contains(job))
-            job->postReply(error, errorString, readSize, QQuickTextureFactory::textureFactoryForImage(image));
-        mutex.unlock();
+            QQuickPixmapDecodeJob *decodeJob = new QQuickPixmapDecodeJob(this, job, QQuickImageProvider::Invalid, 0);
+            decodeJob->networkData = reply->readAll();
+            decodeJob->networkUrl = reply->url();
+            startDecode(decodeJob);
+        }
     }
     reply->deleteLater();
 
@@ -579,80 +700,109 @@ void QQuickPixmapReader::processJobs()
 {
     QMutexLocker locker(&mutex);
 
-    while (true) {
-        if (cancelled.isEmpty() && jobs.isEmpty())
-            return; // Nothing else to do
-
-        // Clean cancelled jobs
-        if (!cancelled.isEmpty()) {
+    // Clean cancelled jobs
+    if (!cancelled.isEmpty()) {
+        QList<QQuickPixmapReply*> decoding;
+        for (int i = 0; i < cancelled.count(); ++i) {
+            QQuickPixmapReply *job = cancelled.at(i);
+            if (QQuickPixmapDecodeJob *decodeJob = decodes.value(job)) {
+                // the decoder thread still refers to the reply, so keep it
+                // around until the aborted decode has returned
+                decodeJob->abort();
+                decoding.append(job);
+                continue;
+            }
 #if QT_CONFIG(qml_network)
-            for (int i = 0; i < cancelled.count(); ++i) {
-                QQuickPixmapReply *job = cancelled.at(i);
-                QNetworkReply *reply = networkJobs.key(job, 0);
-                if (reply) {
-                    networkJobs.remove(reply);
-                    if (reply->isRunning()) {
-                        // cancel any jobs already started
-                        reply->close();
-                    }
-                } else {
-                    QQuickImageResponse *asyncResponse = asyncResponses.key(job);
-                    if (asyncResponse) {
-                        asyncResponses.remove(asyncResponse);
-                        asyncResponse->cancel();
-                    }
+            QNetworkReply *reply = networkJobs.key(job, 0);
+            if (reply) {
+                networkJobs.remove(reply);
+                if (reply->isRunning()) {
+                    // cancel any jobs already started
+                    reply->close();
                 }
-                PIXMAP_PROFILE(pixmapStateChanged<QQuickProfiler::PixmapLoadingError>(job->url));
-                // deleteLater, since not owned by this thread
-                job->deleteLater();
-            }
-            cancelled.clear();
+            } else
 #endif
+            {
+                QQuickImageResponse *asyncResponse = asyncResponses.key(job);
+                if (asyncResponse) {
+                    asyncResponses.remove(asyncResponse);
+                    asyncResponse->cancel();
+                }
+            }
+            PIXMAP_PROFILE(pixmapStateChanged<QQuickProfiler::PixmapLoadingError>(job->url));
+            // deleteLater, since not owned by this thread
+            job->deleteLater();
         }
+        cancelled = decoding;
+    }
 
-        if (!jobs.isEmpty()) {
-            // Find a job we can use
-            bool usableJob = false;
-            for (int i = jobs.count() - 1; !usableJob && i >= 0; i--) {
-                QQuickPixmapReply *job = jobs.at(i);
-                const QUrl url = job->url;
-                QString localFile;
-                QQuickImageProvider::ImageType imageType = QQuickImageProvider::Invalid;
-                QQuickImageProvider *provider = 0;
-
-                if (url.scheme() == QLatin1String("image")) {
-                    provider = static_cast<QQuickImageProvider *>(engine->imageProvider(imageProviderId(url)));
-                    if (provider)
-                        imageType = provider->imageType();
-
-                    usableJob = true;
-                } else {
-                    localFile = QQmlFile::urlToLocalFileOrQrc(url);
-                    usableJob = !localFile.isEmpty()
-#if QT_CONFIG(qml_network)
-                            || networkJobs.count() < IMAGEREQUEST_MAX_NETWORK_REQUEST_COUNT
-#endif
-                            ;
-                }
+    while (!jobs.isEmpty()) {
+        // Find the most urgent job we can use. Among jobs of the same
+        // priority, the most recent request wins.
+        int jobIndex = -1;
+        QQuickImageProvider::ImageType imageType = QQuickImageProvider::Invalid;
+        QQuickImageProvider *provider = 0;
+        for (int i = jobs.count() - 1; i >= 0; i--) {
+            QQuickPixmapReply *job = jobs.at(i);
+            if (jobIndex != -1 && job->priority <= jobs.at(jobIndex)->priority)
+                continue;
+
+            QQuickImageProvider::ImageType jobImageType = QQuickImageProvider::Invalid;
+            QQuickImageProvider *jobProvider = 0;
+            if (job->providerRequest) {
+                jobProvider = static_cast<QQuickImageProvider *>(engine->imageProvider(imageProviderId(job->url)));
+                if (jobProvider)
+                    jobImageType = jobProvider->imageType();
+            }
 
+            if (canStart(job, jobImageType, jobProvider)) {
+                jobIndex = i;
+                imageType = jobImageType;
+                provider = jobProvider;
+            }
+        }
 
-                if (usableJob) {
-                    jobs.removeAt(i);
+        if (jobIndex == -1)
+            return;
 
-                    job->loading = true;
+        QQuickPixmapReply *job = jobs.takeAt(jobIndex);
+        const QUrl url = job->url;
 
-                    PIXMAP_PROFILE(pixmapStateChanged<QQuickProfiler::PixmapLoadingStarted>(url));
+        job->loading = true;
 
-                    locker.unlock();
-                    processJob(job, url, localFile, imageType, provider);
-                    locker.relock();
-                }
-            }
+        PIXMAP_PROFILE(pixmapStateChanged<QQuickProfiler::PixmapLoadingStarted>(url));
 
-            if (!usableJob)
-                return;
+        locker.unlock();
+        processJob(job, url, job->localFile, imageType, provider);
+        locker.relock();
+    }
+}
+
+// Must be called with the mutex locked
+bool QQuickPixmapReader::canStart(QQuickPixmapReply *job, QQuickImageProvider::ImageType imageType,
+                                  QQuickImageProvider *provider) const
+{
+    if (job->providerRequest) {
+        switch (imageType) {
+        case QQuickImageProvider::Image:
+        case QQuickImageProvider::Pixmap:
+        case QQuickImageProvider::Texture:
+            return stats.activeDecodes < maxDecodes && !busyProviders.contains(provider);
+        default:
+            // Invalid providers fail immediately, ImageResponse providers
+            // do their own threading.
+            return true;
         }
     }
+
+    if (!job->localFile.isEmpty())
+        return stats.activeDecodes < maxDecodes;
+
+#if QT_CONFIG(qml_network)
+    return networkJobs.count() < IMAGEREQUEST_MAX_NETWORK_REQUEST_COUNT;
+#else
+    return false;
+#endif
 }
 
 void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &url, const QString &localFile,
@@ -661,26 +811,102 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
     // fetch
     if (url.scheme() == QLatin1String("image")) {
         // Use QQuickImageProvider
-        QSize readSize;
-
-        if (imageType == QQuickImageProvider::Invalid) {
-            QString errorStr = QQuickPixmap::tr("Invalid image provider: %1").arg(url.toString());
-            mutex.lock();
-            if (!cancelled.contains(runningJob))
-                runningJob->postReply(QQuickPixmapReply::Loading, errorStr, readSize, 0);
-            mutex.unlock();
-            return;
-        }
-
-        QQuickImageProviderWithOptions *providerV2 = QQuickImageProviderWithOptions::checkedCast(provider);
-
         switch (imageType) {
             case QQuickImageProvider::Invalid:
             {
-                // Already handled
+                QString errorStr = QQuickPixmap::tr("Invalid image provider: %1").arg(url.toString());
+                mutex.lock();
+                if (!cancelled.contains(runningJob))
+                    runningJob->postReply(QQuickPixmapReply::Loading, errorStr, QSize(), 0);
+                mutex.unlock();
                 break;
             }
 
+            case QQuickImageProvider::Image:
+            case QQuickImageProvider::Pixmap:
+            case QQuickImageProvider::Texture:
+            {
+                startDecode(new QQuickPixmapDecodeJob(this, runningJob, imageType, provider));
+                break;
+            }
+
+            case QQuickImageProvider::ImageResponse:
+            {
+                QQuickImageProviderWithOptions *providerV2 = QQuickImageProviderWithOptions::checkedCast(provider);
+                QQuickImageResponse *response;
+                if (providerV2) {
+                    response = providerV2->requestImageResponse(imageId(url), runningJob->requestSize, runningJob->providerOptions);
+                } else {
+                    QQuickAsyncImageProvider *asyncProvider = static_cast<QQuickAsyncImageProvider*>(provider);
+                    response = asyncProvider->requestImageResponse(imageId(url), runningJob->requestSize);
+                }
+
+                QObject::connect(response, SIGNAL(finished()), threadObject, SLOT(asyncResponseFinished()));
+
+                asyncResponses.insert(response, runningJob);
+                break;
+            }
+        }
+
+    } else {
+        if (!localFile.isEmpty()) {
+            // Image is local - load/decode on a decoder thread
+            startDecode(new QQuickPixmapDecodeJob(this, runningJob, QQuickImageProvider::Invalid, 0));
+        } else {
+#if QT_CONFIG(qml_network)
+            // Network resource
+            QNetworkRequest req(url);
+            req.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+            QNetworkReply *reply = networkAccessManager()->get(req);
+
+            QMetaObject::connect(reply, replyDownloadProgress, runningJob, downloadProgress);
+            QMetaObject::connect(reply, replyFinished, threadObject, threadNetworkRequestDone);
+
+            networkJobs.insert(reply, runningJob);
+#else
+// Silently fail if compiled with no_network
+#endif
+        }
+    }
+}
+
+void QQuickPixmapReader::startDecode(QQuickPixmapDecodeJob *job)
+{
+    mutex.lock();
+    decodes.insert(job->reply, job);
+    if (job->provider)
+        busyProviders.insert(job->provider);
+    ++stats.activeDecodes;
+    const int priority = job->reply->priority;
+    mutex.unlock();
+
+    pixmapDecoderPool()->start(job, priority);
+}
+
+// Runs on a decoder thread
+void QQuickPixmapReader::decode(QQuickPixmapDecodeJob *job)
+{
+    QThread::currentThread()->setPriority(QThread::LowestPriority);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // The reply is not deleted before decodeFinished() has been called, and
+    // the fields used here do not change after it has been created.
+    QQuickPixmapReply *runningJob = job->reply;
+    const QUrl &url = runningJob->url;
+    QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
+    QString errorStr;
+    QSize readSize;
+    QQuickTextureFactory *factory = 0;
+
+    if (job->isAborted()) {
+        // cancelled while waiting for a decoder thread
+    } else if (runningJob->providerRequest) {
+        QQuickImageProvider *provider = job->provider;
+        QQuickImageProviderWithOptions *providerV2 = QQuickImageProviderWithOptions::checkedCast(provider);
+
+        switch (job->imageType) {
             case QQuickImageProvider::Image:
             {
                 QImage image;
@@ -689,16 +915,11 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
                 } else {
                     image = provider->requestImage(imageId(url), &readSize, runningJob->requestSize);
                 }
-                QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
-                QString errorStr;
                 if (image.isNull()) {
                     errorCode = QQuickPixmapReply::Loading;
                     errorStr = QQuickPixmap::tr("Failed to get image from provider: %1").arg(url.toString());
                 }
-                mutex.lock();
-                if (!cancelled.contains(runningJob))
-                    runningJob->postReply(errorCode, errorStr, readSize, QQuickTextureFactory::textureFactoryForImage(image));
-                mutex.unlock();
+                factory = QQuickTextureFactory::textureFactoryForImage(image);
                 break;
             }
 
@@ -710,112 +931,96 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
                 } else {
                     pixmap = provider->requestPixmap(imageId(url), &readSize, runningJob->requestSize);
                 }
-                QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
-                QString errorStr;
                 if (pixmap.isNull()) {
                     errorCode = QQuickPixmapReply::Loading;
                     errorStr = QQuickPixmap::tr("Failed to get image from provider: %1").arg(url.toString());
                 }
-                mutex.lock();
-                if (!cancelled.contains(runningJob))
-                    runningJob->postReply(errorCode, errorStr, readSize, QQuickTextureFactory::textureFactoryForImage(pixmap.toImage()));
-                mutex.unlock();
+                factory = QQuickTextureFactory::textureFactoryForImage(pixmap.toImage());
                 break;
             }
 
             case QQuickImageProvider::Texture:
             {
-                QQuickTextureFactory *t;
                 if (providerV2) {
-                    t = providerV2->requestTexture(imageId(url), &readSize, runningJob->requestSize, runningJob->providerOptions);
+                    factory = providerV2->requestTexture(imageId(url), &readSize, runningJob->requestSize, runningJob->providerOptions);
                 } else {
-                    t = provider->requestTexture(imageId(url), &readSize, runningJob->requestSize);
+                    factory = provider->requestTexture(imageId(url), &readSize, runningJob->requestSize);
                 }
-                QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
-                QString errorStr;
-                if (!t) {
+                if (!factory) {
                     errorCode = QQuickPixmapReply::Loading;
                     errorStr = QQuickPixmap::tr("Failed to get texture from provider: %1").arg(url.toString());
                 }
-                mutex.lock();
-                if (!cancelled.contains(runningJob))
-                    runningJob->postReply(errorCode, errorStr, readSize, t);
-                else
-                    delete t;
-                mutex.unlock();
                 break;
             }
 
-            case QQuickImageProvider::ImageResponse:
-            {
-                QQuickImageResponse *response;
-                if (providerV2) {
-                    response = providerV2->requestImageResponse(imageId(url), runningJob->requestSize, runningJob->providerOptions);
-                } else {
-                    QQuickAsyncImageProvider *asyncProvider = static_cast<QQuickAsyncImageProvider*>(provider);
-                    response = asyncProvider->requestImageResponse(imageId(url), runningJob->requestSize);
-                }
-
-                QObject::connect(response, SIGNAL(finished()), threadObject, SLOT(asyncResponseFinished()));
-
-                asyncResponses.insert(response, runningJob);
+            default:
+                Q_UNREACHABLE();
                 break;
-            }
         }
 
-    } else {
-        if (!localFile.isEmpty()) {
-            // Image is local - load/decode immediately
-            QImage image;
-            QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
-            QString errorStr;
-            QFile f(localFile);
-            QSize readSize;
-            if (f.open(QIODevice::ReadOnly)) {
-
-                // for now, purely use suffix information to determine whether we are working with a compressed texture
-                QByteArray suffix = QFileInfo(f).suffix().toLower().toLatin1();
-                if (QSGTextureReader::isTexture(&f, suffix)) {
-                    QQuickTextureFactory *factory = QSGTextureReader::read(&f, suffix);
-                    if (factory) {
-                        readSize = factory->textureSize();
-                    } else {
-                        errorStr = QQuickPixmap::tr("Error decoding: %1").arg(url.toString());
-                        errorCode = QQuickPixmapReply::Decoding;
-                    }
-                    mutex.lock();
-                    if (!cancelled.contains(runningJob))
-                        runningJob->postReply(errorCode, errorStr, readSize, factory);
-                    mutex.unlock();
-                    return;
+    } else if (!runningJob->localFile.isEmpty()) {
+        QQuickPixmapAbortableDevice<QFile> f(runningJob->localFile, job);
+        if (f.open(QIODevice::ReadOnly)) {
+            // for now, purely use suffix information to determine whether we are working with a compressed texture
+            QByteArray suffix = QFileInfo(f).suffix().toLower().toLatin1();
+            if (QSGTextureReader::isTexture(&f, suffix)) {
+                factory = QSGTextureReader::read(&f, suffix);
+                if (factory) {
+                    readSize = factory->textureSize();
                 } else {
-                    if (!readImage(url, &f, &image, &errorStr, &readSize, runningJob->requestSize, runningJob->providerOptions))
-                        errorCode = QQuickPixmapReply::Loading;
+                    errorStr = QQuickPixmap::tr("Error decoding: %1").arg(url.toString());
+                    errorCode = QQuickPixmapReply::Decoding;
                 }
             } else {
-                errorStr = QQuickPixmap::tr("Cannot open: %1").arg(url.toString());
-                errorCode = QQuickPixmapReply::Loading;
+                QImage image;
+                if (!readImage(url, &f, &image, &errorStr, &readSize, runningJob->requestSize, runningJob->providerOptions))
+                    errorCode = QQuickPixmapReply::Loading;
+                factory = QQuickTextureFactory::textureFactoryForImage(image);
             }
-            mutex.lock();
-            if (!cancelled.contains(runningJob))
-                runningJob->postReply(errorCode, errorStr, readSize, QQuickTextureFactory::textureFactoryForImage(image));
-            mutex.unlock();
         } else {
-#if QT_CONFIG(qml_network)
-            // Network resource
-            QNetworkRequest req(url);
-            req.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
-            QNetworkReply *reply = networkAccessManager()->get(req);
+            errorStr = QQuickPixmap::tr("Cannot open: %1").arg(url.toString());
+            errorCode = QQuickPixmapReply::Loading;
+        }
 
-            QMetaObject::connect(reply, replyDownloadProgress, runningJob, downloadProgress);
-            QMetaObject::connect(reply, replyFinished, threadObject, threadNetworkRequestDone);
+    } else {
+        // Network resource, downloaded by the reader thread
+        QQuickPixmapAbortableDevice<QBuffer> buff(&job->networkData, job);
+        buff.open(QIODevice::ReadOnly);
+        QImage image;
+        if (!readImage(job->networkUrl, &buff, &image, &errorStr, &readSize, runningJob->requestSize, runningJob->providerOptions))
+            errorCode = QQuickPixmapReply::Decoding;
+        factory = QQuickTextureFactory::textureFactoryForImage(image);
+    }
 
-            networkJobs.insert(reply, runningJob);
-#else
-// Silently fail if compiled with no_network
-#endif
-        }
+    decodeFinished(job, errorCode, errorStr, readSize, factory, timer.nsecsElapsed() / 1000);
+}
+
+void QQuickPixmapReader::decodeFinished(QQuickPixmapDecodeJob *job, QQuickPixmapReply::ReadError error,
+                                        const QString &errorString, const QSize &readSize,
+                                        QQuickTextureFactory *factory, qint64 elapsed)
+{
+    QMutexLocker locker(&mutex);
+
+    // send completion event to the QQuickPixmapReply
+    if (job->isAborted() || cancelled.contains(job->reply)) {
+        delete factory;
+        ++stats.abortedDecodes;
+    } else {
+        job->reply->postReply(error, errorString, readSize, factory);
+        ++stats.decodedImages;
+        stats.totalDecodeTime += elapsed;
+        stats.maxDecodeTime = qMax(stats.maxDecodeTime, elapsed);
     }
+
+    decodes.remove(job->reply);
+    if (job->provider)
+        busyProviders.remove(job->provider);
+    --stats.activeDecodes;
+    waitCondition.wakeAll();
+
+    // kick off event loop again to start the next job, or to delete the
+    // reply if it was cancelled
+    if (threadObject) threadObject->processJobs();
 }
 
 QQuickPixmapReader *QQuickPixmapReader::instance(QQmlEngine *engine)
@@ -854,6 +1059,8 @@ void QQuickPixmapReader::cancel(QQuickPixmapReply *reply)
     if (reply->loading) {
         cancelled.append(reply);
         reply->data = 0;
+        if (QQuickPixmapDecodeJob *decodeJob = decodes.value(reply))
+            decodeJob->abort();
         // XXX
         if (threadObject) threadObject->processJobs();
     } else {
@@ -867,6 +1074,29 @@ void QQuickPixmapReader::cancel(QQuickPixmapReply *reply)
     mutex.unlock();
 }
 
+void QQuickPixmapReader::setPriority(QQuickPixmapReply *reply, int priority)
+{
+    QMutexLocker locker(&mutex);
+    if (reply->priority == priority)
+        return;
+
+    // queued jobs are picked by priority in processJobs(), and a decode
+    // that has not reached a decoder thread yet is queued again
+    reply->priority = priority;
+    if (QQuickPixmapDecodeJob *decodeJob = decodes.value(reply)) {
+        if (pixmapDecoderPool()->tryTake(decodeJob))
+            pixmapDecoderPool()->start(decodeJob, priority);
+    }
+}
+
+QQuickPixmapDecodeStatistics QQuickPixmapReader::statistics()
+{
+    QMutexLocker locker(&mutex);
+    QQuickPixmapDecodeStatistics result = stats;
+    result.queuedRequests = jobs.count();
+    return result;
+}
+
 void QQuickPixmapReader::run()
 {
     if (replyDownloadProgress == -1) {
@@ -920,11 +1150,19 @@ public:
 
     void purgeCache();
 
+    void pixmapDecoded(QQuickPixmapData *);
+    void pixmapFreed(QQuickPixmapData *);
+    void touch(QQuickPixmapData *data) { data->lastUse = ++m_useCounter; }
+    void enforceBudget(QQuickPixmapData *keep = 0);
+    QQuickPixmapCacheStatistics statistics() const;
+
 protected:
     void timerEvent(QTimerEvent *) override;
 
 public:
     QHash<QQuickPixmapKey, QQuickPixmapData *> m_cache;
+    QQuickPixmapCacheStatistics m_statistics;
+    bool m_destroying;
 
 private:
     void shrinkCache(int remove);
@@ -932,16 +1170,22 @@ private:
     QQuickPixmapData *m_unreferencedPixmaps;
     QQuickPixmapData *m_lastUnreferencedPixmap;
 
+    // every pixmap that holds a texture factory, referenced or not
+    QSet<QQuickPixmapData *> m_decodedPixmaps;
+    quint64 m_useCounter;
+
     int m_unreferencedCost;
     int m_timerId;
-    bool m_destroying;
 };
 Q_GLOBAL_STATIC(QQuickPixmapStore, pixmapStore);
 
 
 QQuickPixmapStore::QQuickPixmapStore()
-    : m_unreferencedPixmaps(0), m_lastUnreferencedPixmap(0), m_unreferencedCost(0), m_timerId(-1), m_destroying(false)
+    : m_destroying(false), m_unreferencedPixmaps(0), m_lastUnreferencedPixmap(0), m_useCounter(0),
+      m_unreferencedCost(0), m_timerId(-1)
 {
+    // QML_PIXMAP_CACHE_BUDGET is in kilobytes, like cache_limit
+    m_statistics.memoryBudget = qint64(qEnvironmentVariableIntValue("QML_PIXMAP_CACHE_BUDGET")) * 1024;
 }
 
 QQuickPixmapStore::~QQuickPixmapStore()
@@ -1042,12 +1286,69 @@ void QQuickPixmapStore::shrinkCache(int remove)
         if (!m_destroying) {
             remove -= data->cost();
             m_unreferencedCost -= data->cost();
+            ++m_statistics.evictions;
         }
         data->removeFromCache();
         delete data;
     }
 }
 
+void QQuickPixmapStore::pixmapDecoded(QQuickPixmapData *data)
+{
+    m_decodedPixmaps.insert(data);
+    m_statistics.totalCost += data->cost();
+    touch(data);
+}
+
+void QQuickPixmapStore::pixmapFreed(QQuickPixmapData *data)
+{
+    if (m_decodedPixmaps.remove(data))
+        m_statistics.totalCost -= data->cost();
+}
+
+static bool lessRecentlyUsed(const QQuickPixmapData *lhs, const QQuickPixmapData *rhs)
+{
+    return lhs->lastUse < rhs->lastUse;
+}
+
+// Brings the decoded pixmaps back under the memory budget. Unreferenced
+// pixmaps go first, least recently used first. Then the pixel data of the
+// least recently used pixmaps that are not displayed anywhere is dropped.
+// The pixmap that has just been loaded is kept.
+void QQuickPixmapStore::enforceBudget(QQuickPixmapData *keep)
+{
+    const qint64 budget = m_statistics.memoryBudget;
+    if (budget <= 0 || m_statistics.totalCost <= budget || m_destroying)
+        return;
+
+    shrinkCache(int(qMin<qint64>(m_statistics.totalCost - budget, INT_MAX)));
+    if (m_statistics.totalCost <= budget)
+        return;
+
+    QVector<QQuickPixmapData *> candidates;
+    for (QQuickPixmapData *data : qAsConst(m_decodedPixmaps)) {
+        if (data != keep && data->refCount > 0 && data->isEvictable())
+            candidates.append(data);
+    }
+    std::sort(candidates.begin(), candidates.end(), lessRecentlyUsed);
+
+    for (QQuickPixmapData *data : qAsConst(candidates)) {
+        if (m_statistics.totalCost <= budget)
+            break;
+        if (data->isDisplayed())
+            touch(data);
+        else
+            data->evict();
+    }
+}
+
+QQuickPixmapCacheStatistics QQuickPixmapStore::statistics() const
+{
+    QQuickPixmapCacheStatistics result = m_statistics;
+    result.unreferencedCost = m_unreferencedCost;
+    return result;
+}
+
 void QQuickPixmapStore::timerEvent(QTimerEvent *)
 {
     int removalCost = m_unreferencedCost / CACHE_REMOVAL_FRACTION;
@@ -1065,14 +1366,101 @@ void QQuickPixmapStore::purgeCache()
     shrinkCache(m_unreferencedCost);
 }
 
+void QQuickPixmapData::trackCost()
+{
+    pixmapStore()->pixmapDecoded(this);
+}
+
+void QQuickPixmapData::untrackCost()
+{
+    QQuickPixmapStore *store = pixmapStore();
+    if (store && !store->m_destroying) // the texture factories may have been cleaned up already.
+        store->pixmapFreed(this);
+}
+
+// Only pixmaps that can be loaded again from their url, and whose users all
+// know how to reload them, can lose their pixel data.
+bool QQuickPixmapData::isEvictable()
+{
+    if (pixmapStatus != QQuickPixmap::Ready || !textureFactory || reply
+            || url.isEmpty() || url.scheme() == QQuickPixmap::itemGrabberScheme) {
+        return false;
+    }
+    for (QQuickPixmap *pixmap : declarativePixmaps) {
+        if (!pixmap->evictionHandler)
+            return false;
+    }
+    return true;
+}
+
+bool QQuickPixmapData::isDisplayed()
+{
+    for (QQuickPixmap *pixmap : declarativePixmaps) {
+        if (pixmap->evictionHandler->isPixmapDisplayed())
+            return true;
+    }
+    return false;
+}
+
+void QQuickPixmapData::evict()
+{
+    QQuickPixmapStore *store = pixmapStore();
+    store->pixmapFreed(this);
+    ++store->m_statistics.droppedPixmaps;
+
+    // Nobody else may pick up this data from the cache. The users load the
+    // pixmap again once they display it.
+    removeFromCache();
+    evicted = true;
+    evictedSize = textureFactory->textureSize();
+    delete textureFactory;
+    textureFactory = 0;
+
+    for (QQuickPixmap *pixmap : declarativePixmaps)
+        pixmap->evictionHandler->pixmapEvicted();
+}
+
 void QQuickPixmap::purgeCache()
 {
     pixmapStore()->purgeCache();
 }
 
+QQuickPixmapCacheStatistics QQuickPixmap::cacheStatistics()
+{
+    return pixmapStore()->statistics();
+}
+
+qint64 QQuickPixmap::memoryBudget()
+{
+    return pixmapStore()->m_statistics.memoryBudget;
+}
+
+// Limits the memory held by all decoded pixmaps, in bytes. 0 means no limit.
+void QQuickPixmap::setMemoryBudget(qint64 bytes)
+{
+    QQuickPixmapStore *store = pixmapStore();
+    store->m_statistics.memoryBudget = qMax<qint64>(bytes, 0);
+    store->enforceBudget();
+}
+
+QQuickPixmapDecodeStatistics QQuickPixmap::decodeStatistics(QQmlEngine *engine)
+{
+    QMutexLocker locker(&QQuickPixmapReader::readerMutex);
+    if (QQuickPixmapReader *reader = QQuickPixmapReader::existingInstance(engine))
+        return reader->statistics();
+
+    QQuickPixmapDecodeStatistics statistics;
+    statistics.maxDecodes = pixmapDecoderCount();
+    return statistics;
+}
+
 QQuickPixmapReply::QQuickPixmapReply(QQuickPixmapData *d)
-: data(d), engineForReader(0), requestSize(d->requestSize), url(d->url), loading(false), providerOptions(d->providerOptions), redirectCount(0)
+: data(d), engineForReader(0), requestSize(d->requestSize), url(d->url), loading(false),
+  providerRequest(d->url.scheme() == QLatin1String("image")), priority(QQuickPixmap::NormalPriority),
+  providerOptions(d->providerOptions), redirectCount(0)
 {
+    if (!providerRequest)
+        localFile = QQmlFile::urlToLocalFileOrQrc(url);
     if (finishedIndex == -1) {
         finishedIndex = QMetaMethod::fromSignal(&QQuickPixmapReply::finished).methodIndex();
         downloadProgressIndex = QMetaMethod::fromSignal(&QQuickPixmapReply::downloadProgress).methodIndex();
@@ -1096,6 +1484,10 @@ bool QQuickPixmapReply::event(QEvent *event)
                 data->textureFactory = de->textureFactory;
                 de->textureFactory = 0;
                 data->implicitSize = de->implicitSize;
+                if (data->textureFactory) {
+                    data->trackCost();
+                    pixmapStore()->enforceBudget(data);
+                }
                 PIXMAP_PROFILE(pixmapLoadingFinished(data->url,
                         data->textureFactory != 0 && data->textureFactory->textureSize().isValid() ?
                         data->textureFactory->textureSize() :
@@ -1284,26 +1676,28 @@ struct QQuickPixmapNull {
 Q_GLOBAL_STATIC(QQuickPixmapNull, nullPixmap);
 
 QQuickPixmap::QQuickPixmap()
-: d(0)
+: d(0), evictionHandler(0)
 {
 }
 
 QQuickPixmap::QQuickPixmap(QQmlEngine *engine, const QUrl &url)
-: d(0)
+: d(0), evictionHandler(0)
 {
     load(engine, url);
 }
 
 QQuickPixmap::QQuickPixmap(QQmlEngine *engine, const QUrl &url, const QSize &size)
-: d(0)
+: d(0), evictionHandler(0)
 {
     load(engine, url, size);
 }
 
 QQuickPixmap::QQuickPixmap(const QUrl &url, const QImage &image)
+: evictionHandler(0)
 {
     d = new QQuickPixmapData(this, url, new QQuickDefaultTextureFactory(image), image.size(), QSize(), QQuickImageProviderOptions(), QQuickImageProviderOptions::UsePluginDefaultTransform);
     d->addToCache();
+    pixmapStore()->enforceBudget(d);
 }
 
 QQuickPixmap::~QQuickPixmap()
@@ -1351,6 +1745,13 @@ QQuickPixmap::Status QQuickPixmap::status() const
         return Null;
 }
 
+// An evicted pixmap is still Ready, but its pixel data has been dropped to
+// stay within the memory budget.
+bool QQuickPixmap::isEvicted() const
+{
+    return d && d->evicted;
+}
+
 const QUrl &QQuickPixmap::url() const
 {
     if (d)
@@ -1402,8 +1803,10 @@ void QQuickPixmap::setImage(const QImage &p)
 {
     clear();
 
-    if (!p.isNull())
+    if (!p.isNull()) {
         d = new QQuickPixmapData(this, QQuickTextureFactory::textureFactoryForImage(p));
+        pixmapStore()->enforceBudget(d);
+    }
 }
 
 void QQuickPixmap::setPixmap(const QQuickPixmap &other)
@@ -1421,6 +1824,8 @@ int QQuickPixmap::width() const
 {
     if (d && d->textureFactory)
         return d->textureFactory->textureSize().width();
+    else if (d && d->evicted)
+        return d->evictedSize.width();
     else
         return 0;
 }
@@ -1429,6 +1834,8 @@ int QQuickPixmap::height() const
 {
     if (d && d->textureFactory)
         return d->textureFactory->textureSize().height();
+    else if (d && d->evicted)
+        return d->evictedSize.height();
     else
         return 0;
 }
@@ -1437,6 +1844,8 @@ QRect QQuickPixmap::rect() const
 {
     if (d && d->textureFactory)
         return QRect(QPoint(), d->textureFactory->textureSize());
+    else if (d && d->evicted)
+        return QRect(QPoint(), d->evictedSize);
     else
         return QRect();
 }
@@ -1486,6 +1895,13 @@ void QQuickPixmap::load(QQmlEngine *engine, const QUrl &url, const QSize &reques
     } else if (options & QQuickPixmap::Cache)
         iter = store->m_cache.find(key);
 
+    if (url.scheme() == itemGrabberScheme || (options & QQuickPixmap::Cache)) {
+        if (iter == store->m_cache.end())
+            ++store->m_statistics.misses;
+        else
+            ++store->m_statistics.hits;
+    }
+
     if (iter == store->m_cache.end()) {
         if (url.scheme() == QLatin1String("image")) {
             if (QQuickImageProvider *provider = static_cast<QQuickImageProvider *>(engine->imageProvider(imageProviderId(url)))) {
@@ -1507,6 +1923,7 @@ void QQuickPixmap::load(QQmlEngine *engine, const QUrl &url, const QSize &reques
                 PIXMAP_PROFILE(pixmapLoadingFinished(url, QSize(width(), height())));
                 if (options & QQuickPixmap::Cache)
                     d->addToCache();
+                store->enforceBudget(d);
                 return;
             }
             if (d) { // loadable, but encountered error while loading
@@ -1530,6 +1947,7 @@ void QQuickPixmap::load(QQmlEngine *engine, const QUrl &url, const QSize &reques
         d = *iter;
         d->addref();
         d->declarativePixmaps.insert(this);
+        store->touch(d);
     }
 }
 
@@ -1561,6 +1979,23 @@ bool QQuickPixmap::isCached(const QUrl &url, const QSize &requestSize, const QQu
     return store->m_cache.contains(key);
 }
 
+// Requests of a higher priority are decoded first. A pixmap shared by several
+// QQuickPixmaps has the priority that was set last.
+void QQuickPixmap::setPriority(Priority priority)
+{
+    if (!d || !d->reply)
+        return;
+
+    QMutexLocker locker(&QQuickPixmapReader::readerMutex);
+    if (QQuickPixmapReader *reader = QQuickPixmapReader::existingInstance(d->reply->engineForReader))
+        reader->setPriority(d->reply, priority);
+}
+
+void QQuickPixmap::setEvictionHandler(QQuickPixmapEvictionHandler *handler)
+{
+    evictionHandler = handler;
+}
+
 bool QQuickPixmap::connectFinished(QObject *object, const char *method)
 {
     if (!d || !d->reply) {
@@ -121,6 +121,39 @@ private:
     QSharedDataPointer<QQuickImageProviderOptionsPrivate> d;
 };
 
+struct QQuickPixmapDecodeStatistics
+{
+    int queuedRequests = 0;     // requests waiting for a decoder
+    int activeDecodes = 0;      // requests running on the decoder threads
+    int maxDecodes = 0;         // number of decoder threads per engine
+    quint64 decodedImages = 0;
+    quint64 abortedDecodes = 0;
+    qint64 totalDecodeTime = 0; // in microseconds
+    qint64 maxDecodeTime = 0;   // in microseconds
+};
+
+struct QQuickPixmapCacheStatistics
+{
+    qint64 memoryBudget = 0;        // in bytes, 0 if there is no budget
+    qint64 totalCost = 0;           // bytes held by all decoded pixmaps
+    qint64 unreferencedCost = 0;    // bytes held by unreferenced cached pixmaps
+    quint64 hits = 0;
+    quint64 misses = 0;
+    quint64 evictions = 0;          // unreferenced pixmaps removed from the cache
+    quint64 droppedPixmaps = 0;     // referenced pixmaps whose pixel data was dropped
+};
+
+// Lets the pixmap store drop the pixel data of a referenced pixmap that is
+// not displayed, when decoded pixmaps exceed the memory budget. The owner
+// is expected to load the pixmap again once it is displayed.
+class QQuickPixmapEvictionHandler
+{
+public:
+    virtual ~QQuickPixmapEvictionHandler() {}
+    virtual bool isPixmapDisplayed() const = 0;
+    virtual void pixmapEvicted() = 0;
+};
+
 class Q_QUICK_PRIVATE_EXPORT QQuickPixmap
 {
     Q_DECLARE_TR_FUNCTIONS(QQuickPixmap)
@@ -139,12 +172,18 @@ public:
     };
     Q_DECLARE_FLAGS(Options, Option)
 
+    enum Priority {
+        LowPriority = -1,
+        NormalPriority = 0
+    };
+
     bool isNull() const;
     bool isReady() const;
     bool isError() const;
     bool isLoading() const;
 
     Status status() const;
+    bool isEvicted() const;
     QString error() const;
     const QUrl &url() const;
     const QSize &implicitSize() const;
@@ -174,7 +213,14 @@ public:
     bool connectDownloadProgress(QObject *, const char *);
     bool connectDownloadProgress(QObject *, int);
 
+    void setPriority(Priority priority);
+    void setEvictionHandler(QQuickPixmapEvictionHandler *handler);
+
     static void purgeCache();
+    static QQuickPixmapDecodeStatistics decodeStatistics(QQmlEngine *engine);
+    static QQuickPixmapCacheStatistics cacheStatistics();
+    static qint64 memoryBudget();
+    static void setMemoryBudget(qint64 bytes);
     static bool isCached(const QUrl &url, const QSize &requestSize, const QQuickImageProviderOptions &options);
 
     static const QLatin1String itemGrabberScheme;
@@ -182,6 +228,7 @@ public:
 private:
     Q_DISABLE_COPY(QQuickPixmap)
     QQuickPixmapData *d;
+    QQuickPixmapEvictionHandler *evictionHandler;
     QIntrusiveListNode dataListNode;
     friend class QQuickPixmapData;
 };
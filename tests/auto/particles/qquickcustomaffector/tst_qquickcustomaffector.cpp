@@ -44,6 +44,7 @@ private slots:
     void test_basic();
     void test_move();
     void test_affectedSignal();
+    void test_batch();
 };
 
 void tst_qquickcustomaffector::initTestCase()
@@ -125,6 +126,37 @@ void tst_qquickcustomaffector::test_affectedSignal()
     delete view;
 }
 
+void tst_qquickcustomaffector::test_batch()
+{
+    QQuickView* view = createView(testFileUrl("batch.qml"), 600);
+    QQuickParticleSystem* system = view->rootObject()->findChild<QQuickParticleSystem*>("system");
+    ensureAnimTime(600, system->m_animation);
+
+    QVERIFY(extremelyFuzzyCompare(system->groupData[0]->size(), 500, 10));
+    for (QQuickParticleData *d : qAsConst(system->groupData[0]->data)) {
+        if (d->t == -1)
+            continue; //Particle data unused
+        if (!d->stillAlive(system))
+            continue; //parameters no longer get set once you die
+
+        QCOMPARE(d->x, 100.f);
+        QCOMPARE(d->y, 100.f);
+        QCOMPARE(d->vx, 100.f);
+        QCOMPARE(d->vy, 100.f);
+        QCOMPARE(d->ax, 100.f);
+        QCOMPARE(d->ay, 100.f);
+        QCOMPARE(d->lifeSpan, 0.5f);
+        QCOMPARE(d->size, 100.f);
+        QCOMPARE(d->endSize, 100.f);
+        QCOMPARE(d->color.r, (uchar)0);
+        QCOMPARE(d->color.g, (uchar)255);
+        QCOMPARE(d->color.b, (uchar)0);
+        QCOMPARE(d->color.a, (uchar)0);
+        QVERIFY(myFuzzyLEQ(d->t, ((qreal)system->timeInt/1000.0)));
+    }
+    delete view;
+}
+
 QTEST_MAIN(tst_qquickcustomaffector);
 
 #include "tst_qquickcustomaffector.moc"
@@ -0,0 +1,79 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+import QtQuick 2.0
+import QtQuick.Particles 2.0
+
+Rectangle {
+    color: "black"
+    width: 320
+    height: 320
+
+    ParticleSystem {
+        id: sys
+        objectName: "system"
+        anchors.fill: parent
+
+        ImageParticle {
+            source: "../../shared/star.png"
+        }
+
+        //Enabled by the test one at a time
+        Gravity {
+            objectName: "gravity"
+            enabled: false
+            acceleration: 1000
+            angle: 45
+        }
+        Friction {
+            objectName: "friction"
+            enabled: false
+            factor: 0.5
+            threshold: 50
+        }
+        Attractor {
+            objectName: "attractor"
+            enabled: false
+            pointX: 160
+            pointY: 160
+            strength: 100
+        }
+        Age {
+            objectName: "age"
+            enabled: false
+            lifeLeft: 200
+        }
+        Emitter {
+            size: 32
+            emitRate: 1000
+            lifeSpan: 1000
+            velocity: AngleDirection { angleVariation: 360; magnitude: 100; magnitudeVariation: 50 }
+        }
+    }
+}
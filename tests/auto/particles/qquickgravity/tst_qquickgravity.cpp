@@ -29,10 +29,16 @@
 #include <QtTest/QtTest>
 #include "../shared/particlestestsshared.h"
 #include <private/qquickparticlesystem_p.h>
+#include <private/qquickparticleaffector_p.h>
 #include <private/qabstractanimation_p.h>
 
 #include "../../shared/util.h"
 
+QT_BEGIN_NAMESPACE
+extern void qt_quick_particles_set_thread_count(int count);
+extern void qt_quick_particles_set_batching(bool enabled);
+QT_END_NAMESPACE
+
 class tst_qquickgravity : public QQmlDataTest
 {
     Q_OBJECT
@@ -42,12 +48,18 @@ public:
 private slots:
     void initTestCase();
     void test_basic();
+    void test_threaded_data();
+    void test_threaded();
+    void test_batch_data();
+    void test_batch();
 };
 
 void tst_qquickgravity::initTestCase()
 {
     QQmlDataTest::initTestCase();
     QUnifiedTimer::instance()->setConsistentTiming(true);
+    //Affectors that allow it split large batches across threads
+    qputenv("QT_QUICK_PARTICLE_THREADS", "3");
 }
 
 void tst_qquickgravity::test_basic()
@@ -73,6 +85,124 @@ void tst_qquickgravity::test_basic()
     delete view;
 }
 
+void tst_qquickgravity::test_threaded_data()
+{
+    QTest::addColumn<QString>("affectorName");
+
+    QTest::newRow("gravity") << QStringLiteral("gravity");
+    QTest::newRow("friction") << QStringLiteral("friction");
+}
+
+void tst_qquickgravity::test_threaded()
+{
+    QFETCH(QString, affectorName);
+
+    QQuickView* view = createView(testFileUrl("threaded.qml"), 600);
+    QQuickParticleSystem* system = view->rootObject()->findChild<QQuickParticleSystem*>("system");
+    QQuickParticleAffector* affector = view->rootObject()->findChild<QQuickParticleAffector*>(affectorName);
+    QVERIFY(affector);
+    ensureAnimTime(600, system->m_animation);
+
+    QQuickParticleGroupData *group = system->groupData[0];
+    int alive = 0;
+    for (QQuickParticleData *d : qAsConst(group->data)) {
+        if (d->t != -1 && d->stillAlive(system))
+            ++alive;
+    }
+    QVERIFY2(alive > 2048, QByteArray::number(alive));
+
+    //The system doesn't advance without the event loop, so both runs start from the same state
+    QVector<QQuickParticleData> start;
+    for (QQuickParticleData *d : qAsConst(group->data))
+        start << *d;
+
+    qt_quick_particles_set_thread_count(0);
+    affector->affectSystem(0.1);
+    QVector<QQuickParticleData> singleThreaded;
+    for (int i = 0; i < group->data.size(); ++i) {
+        singleThreaded << *group->data.at(i);
+        group->data.at(i)->clone(start.at(i));
+    }
+
+    qt_quick_particles_set_thread_count(3);
+    affector->affectSystem(0.1);
+    for (int i = 0; i < group->data.size(); ++i) {
+        const QQuickParticleData *d = group->data.at(i);
+        const QQuickParticleData &expected = singleThreaded.at(i);
+        QCOMPARE(d->x, expected.x);
+        QCOMPARE(d->y, expected.y);
+        QCOMPARE(d->vx, expected.vx);
+        QCOMPARE(d->vy, expected.vy);
+        QCOMPARE(d->ax, expected.ax);
+        QCOMPARE(d->ay, expected.ay);
+        QCOMPARE(d->t, expected.t);
+    }
+    delete view;
+}
+
+void tst_qquickgravity::test_batch_data()
+{
+    QTest::addColumn<QString>("affectorName");
+
+    QTest::newRow("gravity") << QStringLiteral("gravity");
+    QTest::newRow("friction") << QStringLiteral("friction");
+    QTest::newRow("attractor") << QStringLiteral("attractor");
+    QTest::newRow("age") << QStringLiteral("age");
+}
+
+static bool fuzzyEqual(qreal actual, qreal expected)
+{
+    //The batch implementations avoid some trigonometry, so allow for rounding
+    return qAbs(actual - expected) <= 1e-3 * qMax(qreal(1), qAbs(expected));
+}
+
+void tst_qquickgravity::test_batch()
+{
+    QFETCH(QString, affectorName);
+
+    QQuickView* view = createView(testFileUrl("batch.qml"), 600);
+    QQuickParticleSystem* system = view->rootObject()->findChild<QQuickParticleSystem*>("system");
+    QQuickParticleAffector* affector = view->rootObject()->findChild<QQuickParticleAffector*>(affectorName);
+    QVERIFY(affector);
+    ensureAnimTime(600, system->m_animation);
+    qt_quick_particles_set_thread_count(0);
+
+    QQuickParticleGroupData *group = system->groupData[0];
+    QVector<QQuickParticleData> start;
+    for (QQuickParticleData *d : qAsConst(group->data))
+        start << *d;
+    affector->setEnabled(true);
+
+    qt_quick_particles_set_batching(false);
+    affector->affectSystem(0.1);
+    qt_quick_particles_set_batching(true);
+    QVector<QQuickParticleData> perParticle;
+    for (int i = 0; i < group->data.size(); ++i) {
+        perParticle << *group->data.at(i);
+        group->data.at(i)->clone(start.at(i));
+    }
+
+    affector->affectSystem(0.1);
+    int changed = 0;
+    for (int i = 0; i < group->data.size(); ++i) {
+        const QQuickParticleData *d = group->data.at(i);
+        const QQuickParticleData &expected = perParticle.at(i);
+        const QQuickParticleData &before = start.at(i);
+        if (expected.x != before.x || expected.y != before.y || expected.vx != before.vx
+                || expected.vy != before.vy || expected.t != before.t)
+            ++changed;
+        QVERIFY2(fuzzyEqual(d->x, expected.x), qPrintable(QString::number(i)));
+        QVERIFY2(fuzzyEqual(d->y, expected.y), qPrintable(QString::number(i)));
+        QVERIFY2(fuzzyEqual(d->vx, expected.vx), qPrintable(QString::number(i)));
+        QVERIFY2(fuzzyEqual(d->vy, expected.vy), qPrintable(QString::number(i)));
+        QVERIFY2(fuzzyEqual(d->ax, expected.ax), qPrintable(QString::number(i)));
+        QVERIFY2(fuzzyEqual(d->ay, expected.ay), qPrintable(QString::number(i)));
+        QCOMPARE(d->t, expected.t);
+    }
+    QVERIFY(changed > 0);
+    delete view;
+}
+
 QTEST_MAIN(tst_qquickgravity);
 
 #include "tst_qquickgravity.moc"
@@ -39,6 +39,12 @@
 #include <qqmlcomponent.h>
 #include <stdlib.h>
 #include <private/qv4alloca_p.h>
+#include <private/qv4functionobject_p.h>
+#include <private/qv4function_p.h>
+#include <private/qv4lookup_p.h>
+#include <private/qv4profiling_p.h>
+#include <private/qv4script_p.h>
+#include <private/qv8engine_p.h>
 
 #ifdef Q_CC_MSVC
 #define NO_INLINE __declspec(noinline)
@@ -200,6 +206,10 @@ private slots:
 
     void malformedExpression();
 
+    void tieredExecution();
+    void polymorphicLookups();
+    void lookupStatistics();
+
 signals:
     void testSignal();
 };
@@ -4095,6 +4105,217 @@ void tst_QJSEngine::malformedExpression()
     engine.evaluate("5%55555&&5555555\n7-0");
 }
 
+void tst_QJSEngine::tieredExecution()
+{
+    QJSEngine engine;
+    QV4::ExecutionEngine *v4 = QV8Engine::getV4(&engine);
+    if (!v4->interpreterFactory)
+        QSKIP("Tiered execution needs the JIT");
+    v4->jitCallThreshold = 5;
+    v4->jitLoopThreshold = 100;
+
+    engine.evaluate("function product(a, b) { return a * b + 1; }\n"
+                    "function sum(n) { var s = 0; for (var i = 0; i < n; ++i) s += i; return s; }");
+
+    QV4::Scope scope(v4);
+    QV4::ScopedString name(scope);
+    name = v4->newString(QStringLiteral("product"));
+    QV4::ScopedFunctionObject product(scope, v4->globalObject->get(name));
+    name = v4->newString(QStringLiteral("sum"));
+    QV4::ScopedFunctionObject sum(scope, v4->globalObject->get(name));
+    QVERIFY(product);
+    QVERIFY(sum);
+    QVERIFY(product->function()->tierUpCandidate);
+    QVERIFY(!product->function()->optimizedFunction);
+
+    // Hot through calls. The JIT runs on a worker thread, so the interpreter keeps going
+    // until the compiled code is there.
+    QJSValue productFunction = engine.globalObject().property("product");
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; !product->function()->optimizedFunction && timer.elapsed() < 5000; ++i) {
+        QCOMPARE(productFunction.call(QJSValueList() << i << 3).toInt(), i * 3 + 1);
+        if (i >= 5)
+            QTest::qSleep(1);
+    }
+    QVERIFY(product->function()->optimizedFunction);
+    QVERIFY(product->function()->optimizedFunction->compilationUnit != product->function()->compilationUnit);
+    QVERIFY(!product->function()->compilationUnit->tierUpJob);
+    QVERIFY(!product->function()->compilationUnit->tierUpSource);
+    QCOMPARE(productFunction.call(QJSValueList() << 7 << 3).toInt(), 22);
+
+    // Hot through a loop. The unit was compiled already, so the compiled code gets picked up
+    // on the next entry.
+    QJSValue sumFunction = engine.globalObject().property("sum");
+    QCOMPARE(sumFunction.call(QJSValueList() << 1000).toInt(), 499500);
+    QVERIFY(sum->function()->backEdgeCount >= 1000u);
+    QVERIFY(!sum->function()->optimizedFunction);
+    QCOMPARE(sumFunction.call(QJSValueList() << 10).toInt(), 45);
+    QVERIFY(sum->function()->optimizedFunction);
+    QCOMPARE(sumFunction.call(QJSValueList() << 100).toInt(), 4950);
+
+    // Loops in eval code don't count for the function calling eval
+    engine.evaluate("function evalLoop(n) { return eval('var s = 0; for (var i = 0; i < n; ++i) s += i; s'); }");
+    name = v4->newString(QStringLiteral("evalLoop"));
+    QV4::ScopedFunctionObject evalLoop(scope, v4->globalObject->get(name));
+    QVERIFY(evalLoop);
+    QVERIFY(evalLoop->function()->tierUpCandidate);
+    QCOMPARE(engine.globalObject().property("evalLoop").call(QJSValueList() << 1000).toInt(), 499500);
+    QCOMPARE(evalLoop->function()->backEdgeCount, 0u);
+
+    // Code without functions only runs once, so it doesn't keep its source around
+    QV4::Script script(v4->rootContext(), QStringLiteral("var s = 0; for (var i = 0; i < 1000; ++i) s += i; s"));
+    script.parse();
+    QVERIFY(script.function());
+    QVERIFY(!script.function()->compilationUnit->tierUpSource);
+    QVERIFY(!script.function()->tierUpCandidate);
+}
+
+static QV4::Lookup *findLookup(QV4::Function *function, QV4::ReturnedValue (*getter)(QV4::Lookup *, QV4::ExecutionEngine *, const QV4::Value &))
+{
+    QV4::CompiledData::CompilationUnit *unit = function->compilationUnit;
+    for (uint i = 0; i < unit->data->lookupTableSize; ++i) {
+        if (unit->runtimeLookups[i].getter == getter)
+            return unit->runtimeLookups + i;
+    }
+    return nullptr;
+}
+
+static QV4::Lookup *findLookup(QV4::Function *function, void (*setter)(QV4::Lookup *, QV4::ExecutionEngine *, QV4::Value &, const QV4::Value &))
+{
+    QV4::CompiledData::CompilationUnit *unit = function->compilationUnit;
+    for (uint i = 0; i < unit->data->lookupTableSize; ++i) {
+        if (unit->runtimeLookups[i].setter == setter)
+            return unit->runtimeLookups + i;
+    }
+    return nullptr;
+}
+
+void tst_QJSEngine::polymorphicLookups()
+{
+    QJSEngine engine;
+    QV4::ExecutionEngine *v4 = QV8Engine::getV4(&engine);
+    // keep all calls in one compilation unit, and so on the same lookups
+    v4->interpreterFactory.reset();
+    v4->countLookups = true;
+
+    // Objects of 6 different classes, one of them finding x on its prototype
+    engine.evaluate("function getX(o) { return o.x; }\n"
+                    "function setX(o, v) { o.x = v; }\n"
+                    "function getY(o) { return o.y; }\n"
+                    "function shapes(n) {\n"
+                    "    var result = [];\n"
+                    "    for (var i = 0; i < n; ++i) {\n"
+                    "        var o = {};\n"
+                    "        o['p' + i] = i;\n"
+                    "        o.x = i;\n"
+                    "        o.y = i;\n"
+                    "        result.push(o);\n"
+                    "    }\n"
+                    "    return result;\n"
+                    "}\n"
+                    "var poly = shapes(5);\n"
+                    "poly.push(Object.create({ x: 5, y: 5 }));\n"
+                    "var mega = shapes(20);\n"
+                    "function sum(f, objects, iterations) {\n"
+                    "    var s = 0;\n"
+                    "    for (var i = 0; i < iterations; ++i)\n"
+                    "        s += f(objects[i % objects.length]);\n"
+                    "    return s;\n"
+                    "}");
+
+    QV4::Scope scope(v4);
+    QV4::ScopedString name(scope, v4->newString(QStringLiteral("getX")));
+    QV4::ScopedFunctionObject getX(scope, v4->globalObject->get(name));
+    name = v4->newString(QStringLiteral("setX"));
+    QV4::ScopedFunctionObject setX(scope, v4->globalObject->get(name));
+    name = v4->newString(QStringLiteral("getY"));
+    QV4::ScopedFunctionObject getY(scope, v4->globalObject->get(name));
+    QVERIFY(getX);
+    QVERIFY(setX);
+    QVERIFY(getY);
+
+    QCOMPARE(engine.evaluate("sum(getX, poly, 600)").toInt(), 1500);
+    QV4::Lookup *l = findLookup(getX->function(), QV4::Lookup::getterPolymorphic);
+    QVERIFY(l);
+    QCOMPARE(l->polymorphicCache->nEntries, 6u);
+#ifndef QT_NO_QML_DEBUGGER // only counted for the profiler
+    QVERIFY(l->hitCount >= 590u);
+    QVERIFY(l->missCount <= 10u);
+#endif
+
+    // The prototype changing its class invalidates the entry
+    QCOMPARE(engine.evaluate("Object.getPrototypeOf(poly[5]).x = 11; Object.getPrototypeOf(poly[5]).z = 0; getX(poly[5])").toInt(), 11);
+
+    QCOMPARE(engine.evaluate("for (var i = 0; i < 60; ++i) setX(poly[i % 5], i); sum(getX, poly, 6)").toInt(), 55 + 56 + 57 + 58 + 59 + 11);
+    l = findLookup(setX->function(), QV4::Lookup::setterPolymorphic);
+    QVERIFY(l);
+    QCOMPARE(l->polymorphicCache->nEntries, 5u);
+#ifndef QT_NO_QML_DEBUGGER
+    QVERIFY(l->hitCount >= 50u);
+#endif
+
+    // Too many classes for the site to keep track of
+    QCOMPARE(engine.evaluate("sum(getY, mega, 2000)").toInt(), 19000);
+    l = findLookup(getY->function(), QV4::Lookup::getterMegamorphic);
+    QVERIFY(l);
+    QVERIFY(v4->megamorphicLookupCache);
+#ifndef QT_NO_QML_DEBUGGER
+    QVERIFY(l->hitCount > l->missCount);
+#endif
+    QCOMPARE(engine.evaluate("mega[3].y = 42; Object.freeze(mega[4]); getY(mega[3]) + getY(mega[4])").toInt(), 46);
+}
+
+void tst_QJSEngine::lookupStatistics()
+{
+#ifdef QT_NO_QML_DEBUGGER
+    QSKIP("Lookup statistics are reported through the profiler");
+#else
+    QJSEngine engine;
+    QV4::ExecutionEngine *v4 = QV8Engine::getV4(&engine);
+    v4->interpreterFactory.reset();
+    v4->countLookups = true;
+
+    engine.evaluate("function getX(o) {\n"
+                    "    return o.x;\n"
+                    "}\n"
+                    "var objects = [{ x: 1 }, { a: 0, x: 2 }, { b: 0, x: 3 }, { c: 0, x: 4 }];\n"
+                    "for (var i = 0; i < 100; ++i)\n"
+                    "    getX(objects[i % 4]);\n", QStringLiteral("lookups.js"));
+
+    QVector<QV4::Profiling::LookupProperties> statistics
+            = QV4::Profiling::Profiler::lookupStatistics(v4);
+    const QV4::Profiling::LookupProperties *getX = nullptr;
+    for (const QV4::Profiling::LookupProperties &props : qAsConst(statistics)) {
+        QVERIFY(props.hitCount + props.missCount > 0);
+        if (props.name == QLatin1String("x") && props.file == QLatin1String("lookups.js"))
+            getX = &props;
+    }
+    QVERIFY(getX);
+    QCOMPARE(getX->type, int(QV4::CompiledData::Lookup::Type_Getter));
+    QCOMPARE(getX->state, int(QV4::Lookup::Polymorphic));
+    QCOMPARE(getX->hitCount + getX->missCount, 100u);
+    QCOMPARE(getX->line, 2);
+    QVERIFY(getX->unit != 0);
+    const quint32 unit = getX->unit;
+    const int index = getX->index;
+
+    QV4::Profiling::Profiler::resetLookupStatistics(v4);
+    engine.evaluate("getX(objects[0])");
+    statistics = QV4::Profiling::Profiler::lookupStatistics(v4);
+    getX = nullptr;
+    for (const QV4::Profiling::LookupProperties &props : qAsConst(statistics)) {
+        if (props.name == QLatin1String("x") && props.file == QLatin1String("lookups.js"))
+            getX = &props;
+    }
+    QVERIFY(getX);
+    QCOMPARE(getX->unit, unit);
+    QCOMPARE(getX->index, index);
+    QCOMPARE(getX->hitCount, 1u);
+    QCOMPARE(getX->missCount, 0u);
+#endif
+}
+
 QTEST_MAIN(tst_QJSEngine)
 
 #include "tst_qjsengine.moc"
@@ -52,6 +52,7 @@ private slots:
     void regenerateAfterChange();
     void registerImportForImplicitComponent();
     void basicVersionChecks();
+    void codeIntegrityChecks();
     void recompileAfterChange();
     void recompileAfterDirectoryChange();
     void fileSelectors();
@@ -367,6 +368,69 @@ void tst_qmldiskcache::basicVersionChecks()
     }
 }
 
+void tst_qmldiskcache::codeIntegrityChecks()
+{
+    QQmlEngine engine;
+
+    TestCompiler testCompiler(&engine);
+    QVERIFY(testCompiler.tempDir.isValid());
+
+    const QByteArray contents = QByteArrayLiteral("import QtQml 2.0\n"
+                                                  "QtObject {\n"
+                                                  "    function add(a, b) { return a + b; }\n"
+                                                  "    property int value: add(20, 22)\n"
+                                                  "}");
+
+    {
+        testCompiler.clearCache();
+        QVERIFY2(testCompiler.compile(contents), qPrintable(testCompiler.lastErrorString));
+
+        testCompiler.tweakHeader([](QV4::CompiledData::Unit *header) {
+            header->codeMD5Checksum[0] ^= 1;
+        });
+
+        QVERIFY(!testCompiler.verify());
+        QCOMPARE(testCompiler.lastErrorString, QString::fromUtf8("Checksum mismatch of the code in the cache file."));
+    }
+
+    {
+        testCompiler.clearCache();
+        QVERIFY2(testCompiler.compile(contents), qPrintable(testCompiler.lastErrorString));
+
+        const QV4::CompiledData::Unit *unit = testCompiler.mapUnit();
+        QVERIFY(unit);
+        QVERIFY(unit->functionTableSize > 0);
+        const quint64 codeOffset = unit->functionAt(unit->functionTableSize - 1)->codeOffset;
+        testCompiler.closeMapping();
+
+        QFile f(testCompiler.cacheFilePath);
+        QVERIFY(f.open(QIODevice::ReadWrite));
+        QVERIFY(f.seek(codeOffset));
+        char byte;
+        QCOMPARE(f.read(&byte, 1), qint64(1));
+        byte ^= 0xff;
+        QVERIFY(f.seek(codeOffset));
+        QCOMPARE(f.write(&byte, 1), qint64(1));
+        f.close();
+
+        QVERIFY(!testCompiler.verify());
+        QCOMPARE(testCompiler.lastErrorString, QString::fromUtf8("Checksum mismatch of the code in the cache file."));
+    }
+
+    {
+        testCompiler.clearCache();
+        QVERIFY2(testCompiler.compile(contents), qPrintable(testCompiler.lastErrorString));
+        QVERIFY2(testCompiler.verify(), qPrintable(testCompiler.lastErrorString));
+
+        // the code from the cache file is executable
+        engine.clearComponentCache();
+        CleanlyLoadingComponent component(&engine, testCompiler.testFilePath);
+        QScopedPointer<QObject> obj(component.create());
+        QVERIFY(!obj.isNull());
+        QCOMPARE(obj->property("value").toInt(), 42);
+    }
+}
+
 class TypeVersion1 : public QObject
 {
     Q_OBJECT
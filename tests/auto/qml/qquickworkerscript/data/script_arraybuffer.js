@@ -0,0 +1,15 @@
+WorkerScript.onMessage = function(msg) {
+    var sum = 0
+    for (var i = 0; i < msg.data.length; ++i)
+        sum += msg.data[i]
+    msg.data[0] = 42
+
+    WorkerScript.sendMessage({
+        data: msg.data,
+        sum: sum,
+        sameBuffer: msg.data.buffer === msg.view.buffer,
+        viewOffset: msg.view.byteOffset,
+        viewLength: msg.view.length,
+        copyLength: msg.copy.length
+    }, [ msg.data.buffer ])
+}
@@ -0,0 +1,27 @@
+import QtQuick 2.0
+
+WorkerScript {
+    id: worker
+    source: "script_arraybuffer.js"
+
+    property var response
+    property int lengthAfterSend: -1
+    property int byteLengthAfterSend: -1
+
+    signal done()
+
+    function testTransfer() {
+        var data = new Uint8Array(1024)
+        for (var i = 0; i < data.length; ++i)
+            data[i] = i % 256
+        var view = new Uint16Array(data.buffer, 2, 4)
+        worker.sendMessage({ data: data, view: view, copy: new Int8Array(8) }, [ data.buffer ])
+        lengthAfterSend = data.length
+        byteLengthAfterSend = data.buffer.byteLength
+    }
+
+    onMessage: {
+        worker.response = messageObject
+        worker.done()
+    }
+}
@@ -51,6 +51,7 @@ private slots:
     void messaging_sendQObjectList();
     void messaging_sendJsObject();
     void messaging_sendExternalObject();
+    void messaging_transferArrayBuffer();
     void script_with_pragma();
     void script_included();
     void scriptError_onLoad();
@@ -198,6 +199,33 @@ void tst_QQuickWorkerScript::messaging_sendExternalObject()
     delete obj;
 }
 
+void tst_QQuickWorkerScript::messaging_transferArrayBuffer()
+{
+    QQmlComponent component(&m_engine, testFileUrl("worker_arraybuffer.qml"));
+    QQuickWorkerScript *worker = qobject_cast<QQuickWorkerScript*>(component.create());
+    QVERIFY(worker != 0);
+
+    QVERIFY(QMetaObject::invokeMethod(worker, "testTransfer"));
+    QCOMPARE(worker->property("lengthAfterSend").toInt(), 0);
+    QCOMPARE(worker->property("byteLengthAfterSend").toInt(), 0);
+    waitForEchoMessage(worker);
+
+    QJSValue response = worker->property("response").value<QJSValue>();
+    QCOMPARE(response.property("sum").toInt(), 4 * (255 * 256 / 2));
+    QVERIFY(response.property("sameBuffer").toBool());
+    QCOMPARE(response.property("viewOffset").toInt(), 2);
+    QCOMPARE(response.property("viewLength").toInt(), 4);
+    QCOMPARE(response.property("copyLength").toInt(), 8);
+
+    QJSValue data = response.property("data");
+    QCOMPARE(data.property("length").toInt(), 1024);
+    QCOMPARE(data.property(0).toInt(), 42);
+    QCOMPARE(data.property(1023).toInt(), 255);
+
+    qApp->processEvents();
+    delete worker;
+}
+
 void tst_QQuickWorkerScript::script_with_pragma()
 {
     QVariant value(100);
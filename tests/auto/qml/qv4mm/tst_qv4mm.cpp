@@ -28,7 +28,9 @@
 
 #include <qtest.h>
 #include <QQmlEngine>
+#include <QJSEngine>
 #include <private/qv4mm_p.h>
+#include <private/qv8engine_p.h>
 
 class tst_qv4mm : public QObject
 {
@@ -37,6 +39,12 @@ class tst_qv4mm : public QObject
 private slots:
     void gcStats();
     void tweaks();
+    void incrementalGC();
+    void writeArgumentsWhileMarking();
+    void concurrentSweep();
+    void generationalGC();
+    void toggleGenerationalGCWhileSweeping();
+    void idleTimeGC();
 };
 
 void tst_qv4mm::gcStats()
@@ -53,6 +61,212 @@ void tst_qv4mm::tweaks()
     QQmlEngine engine;
 }
 
+void tst_qv4mm::incrementalGC()
+{
+    QJSEngine engine;
+    QV4::MemoryManager *mm = QV8Engine::getV4(&engine)->memoryManager;
+    mm->setIncrementalGC(true);
+    QVERIFY(mm->isIncrementalGCEnabled());
+
+    QJSValue result = engine.evaluate(
+                "var kept = [];\n"
+                "for (var i = 0; i < 20000; ++i) {\n"
+                "    var garbage = { value: i, text: 'item' + i };\n"
+                "    if (i % 10 == 0)\n"
+                "        kept.push(garbage);\n"
+                "}\n"
+                "kept.length");
+    QCOMPARE(result.toInt(), 2000);
+
+    // run a complete cycle in small slices, mutating the heap in between
+    mm->incrementalGCStep(1);
+    int steps = 1;
+    while (mm->isMarkingInProgress()) {
+        engine.evaluate(QStringLiteral("kept[%1 % kept.length] = { value: -1, text: 'new' }").arg(steps));
+        mm->incrementalGCStep(1);
+        ++steps;
+    }
+
+    result = engine.evaluate("var sum = 0; for (var i = 0; i < kept.length; ++i) sum += kept[i].text.length; sum");
+    QVERIFY(result.toInt() > 0);
+    QVERIFY(mm->pauseHistogram.nPauses > 0);
+
+    mm->setIncrementalGC(false);
+    QVERIFY(!mm->isIncrementalGCEnabled());
+}
+
+void tst_qv4mm::writeArgumentsWhileMarking()
+{
+    QJSEngine engine;
+    QV4::MemoryManager *mm = QV8Engine::getV4(&engine)->memoryManager;
+    mm->setIncrementalGC(true);
+
+    // The formals of a call context are stored inside the context. They get written through
+    // the arguments object, through the accessors of a fully created arguments object, and
+    // through eval code assigning to the name of a formal.
+    engine.evaluate("function makeHolder(fullyCreate, a, b) {\n"
+                    "    var args = arguments;\n"
+                    "    if (fullyCreate)\n"
+                    "        delete args[10];\n"
+                    "    return {\n"
+                    "        setA: function(v) { args[1] = v; },\n"
+                    "        getA: function() { return a; },\n"
+                    "        setB: function(v) { eval('b = v'); },\n"
+                    "        getB: function() { return b; }\n"
+                    "    };\n"
+                    "}\n"
+                    "var holders = [makeHolder(false, null, null), makeHolder(true, null, null)];\n"
+                    "function assign(text) {\n"
+                    "    for (var i = 0; i < holders.length; ++i) {\n"
+                    "        holders[i].setA({ text: 'a' + text });\n"
+                    "        holders[i].setB({ text: 'b' + text });\n"
+                    "    }\n"
+                    "}\n"
+                    "var garbage;\n"
+                    "for (var i = 0; i < 20000; ++i)\n"
+                    "    garbage = { text: 'garbage' + i };\n");
+
+    QString text = QStringLiteral("start");
+    engine.globalObject().property("assign").call(QJSValueList() << text);
+    mm->incrementalGCStep(1);
+    for (int step = 0; mm->isMarkingInProgress(); ++step) {
+        // the holders' contexts are black by now, the new values are only reachable from them
+        text = QString::number(step);
+        engine.globalObject().property("assign").call(QJSValueList() << text);
+        mm->incrementalGCStep(1);
+    }
+
+    // reuse the memory of anything that got swept
+    engine.evaluate("for (var i = 0; i < 20000; ++i) garbage = { text: 'garbage' + i };");
+
+    for (int i = 0; i < 2; ++i) {
+        QCOMPARE(engine.evaluate(QStringLiteral("holders[%1].getA().text").arg(i)).toString(),
+                 QLatin1Char('a') + text);
+        QCOMPARE(engine.evaluate(QStringLiteral("holders[%1].getB().text").arg(i)).toString(),
+                 QLatin1Char('b') + text);
+    }
+
+    mm->setIncrementalGC(false);
+}
+
+void tst_qv4mm::concurrentSweep()
+{
+    QJSEngine engine;
+    QV4::MemoryManager *mm = QV8Engine::getV4(&engine)->memoryManager;
+    mm->concurrentSweep = true;
+
+    const QString script = QStringLiteral(
+                "var kept = [];\n"
+                "for (var i = 0; i < 50000; ++i) {\n"
+                "    var garbage = { value: i, text: 'item' + i };\n"
+                "    if (i % 100 == 0)\n"
+                "        kept.push(garbage);\n"
+                "}\n"
+                "kept.length");
+    QCOMPARE(engine.evaluate(script).toInt(), 500);
+
+    mm->runGC();
+    // allocate while the chunks are being swept, this picks up swept chunks as they finish
+    QCOMPARE(engine.evaluate(script).toInt(), 500);
+    mm->runGC();
+
+    QJSValue result = engine.evaluate("var sum = 0; for (var i = 0; i < kept.length; ++i) sum += kept[i].value; sum");
+    QCOMPARE(result.toInt(), 12475000);
+
+    mm->blockAllocator.finishConcurrentSweep();
+    QVERIFY(!mm->blockAllocator.isSweeping());
+}
+
+void tst_qv4mm::generationalGC()
+{
+    QJSEngine engine;
+    QV4::MemoryManager *mm = QV8Engine::getV4(&engine)->memoryManager;
+    mm->setGenerationalGC(true);
+    QVERIFY(mm->isGenerationalGCEnabled());
+
+    engine.evaluate("var old = []; for (var i = 0; i < 1000; ++i) old.push({ value: i });");
+    // promote everything to the old generation
+    mm->runGC();
+
+    // Young objects that are only referenced from old objects must survive a minor collection
+    engine.evaluate("for (var i = 0; i < old.length; ++i) old[i].child = { text: 'child' + i };");
+    mm->runMinorGC();
+    engine.evaluate("for (var i = 0; i < 10000; ++i) var garbage = { value: i };");
+    QVERIFY(!mm->blockAllocator.youngChunks.isEmpty());
+    mm->runMinorGC();
+    // only the chunks that got new objects are swept, but the accounting covers the whole heap
+    QVERIFY(mm->blockAllocator.youngChunks.isEmpty());
+    QCOMPARE(mm->blockAllocator.usedSlotsAfterLastSweep, mm->blockAllocator.usedMem() >> QV4::Chunk::SlotSizeShift);
+
+    QJSValue result = engine.evaluate("var ok = true; for (var i = 0; i < old.length; ++i) ok = ok && old[i].child.text === 'child' + i; ok");
+    QVERIFY(result.toBool());
+
+    mm->setGenerationalGC(false);
+    mm->runGC();
+    QVERIFY(engine.evaluate("old[999].child.text").toString() == QLatin1String("child999"));
+}
+
+void tst_qv4mm::toggleGenerationalGCWhileSweeping()
+{
+    QJSEngine engine;
+    QV4::MemoryManager *mm = QV8Engine::getV4(&engine)->memoryManager;
+    mm->concurrentSweep = true;
+    QVERIFY(!mm->isGenerationalGCEnabled());
+
+    engine.evaluate("var old = []; for (var i = 0; i < 1000; ++i) old.push({ value: i });"
+                    "for (var i = 0; i < 50000; ++i) var garbage = { value: i };");
+    mm->runGC();
+    QVERIFY(mm->blockAllocator.isSweeping());
+
+    // The sweep has to be done before the write barrier starts recording old-to-young references
+    mm->setGenerationalGC(true);
+    QVERIFY(!mm->blockAllocator.isSweeping());
+    mm->runGC();
+
+    engine.evaluate("for (var i = 0; i < old.length; ++i) old[i].child = { text: 'child' + i };");
+    mm->runMinorGC();
+    engine.evaluate("for (var i = 0; i < 10000; ++i) var garbage = { value: i };");
+    mm->runMinorGC();
+    QJSValue result = engine.evaluate("var ok = true; for (var i = 0; i < old.length; ++i) ok = ok && old[i].child.text === 'child' + i; ok");
+    QVERIFY(result.toBool());
+
+    // and the other way around
+    mm->setGenerationalGC(false);
+    mm->runGC();
+    QVERIFY(mm->blockAllocator.isSweeping());
+    mm->setGenerationalGC(true);
+    QVERIFY(!mm->blockAllocator.isSweeping());
+    mm->setGenerationalGC(false);
+    QCOMPARE(engine.evaluate("old[999].child.text").toString(), QLatin1String("child999"));
+}
+
+void tst_qv4mm::idleTimeGC()
+{
+    QJSEngine engine;
+    QV4::MemoryManager *mm = QV8Engine::getV4(&engine)->memoryManager;
+    mm->concurrentSweep = false;
+
+    // nothing to do without a budget or with an almost empty heap
+    QVERIFY(!mm->collectDuringIdleTime(0));
+    mm->runGC();
+    QVERIFY(!mm->collectDuringIdleTime(-1));
+
+    // idle time advances a running incremental mark
+    mm->setIncrementalGC(true);
+    engine.evaluate("var garbage = []; for (var i = 0; i < 20000; ++i) garbage.push({ value: i })");
+    mm->incrementalGCStep(1);
+    while (mm->isMarkingInProgress())
+        QVERIFY(mm->collectDuringIdleTime(1));
+    mm->setIncrementalGC(false);
+
+    // a heap that is about to run full gets collected ahead of time
+    engine.evaluate("garbage = []; for (var i = 0; i < 200000; ++i) garbage.push({ value: i }); garbage = null");
+    const size_t usedBefore = mm->getUsedMem();
+    QVERIFY(mm->collectDuringIdleTime(-1));
+    QVERIFY(mm->getUsedMem() < usedBefore);
+    QVERIFY(!mm->collectDuringIdleTime(-1));
+}
+
 QTEST_MAIN(tst_qv4mm)
 
 #include "tst_qv4mm.moc"
@@ -44,6 +44,22 @@
 
 #include "../../shared/util.h"
 
+class TypedPropertyObject : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int intValue MEMBER m_int)
+    Q_PROPERTY(QPointF point MEMBER m_point)
+    Q_PROPERTY(QSizeF size MEMBER m_size)
+    Q_PROPERTY(QRectF rect MEMBER m_rect)
+public:
+    TypedPropertyObject() : m_int(0) {}
+
+    int m_int;
+    QPointF m_point;
+    QSizeF m_size;
+    QRectF m_rect;
+};
+
 class tst_qquickanimations : public QQmlDataTest
 {
     Q_OBJECT
@@ -61,6 +77,8 @@ private slots:
     void simpleNumber();
     void simpleColor();
     void simpleRotation();
+    void simpleTypedProperty_data();
+    void simpleTypedProperty();
     void simplePath();
     void simpleAnchor();
     void reparent();
@@ -198,6 +216,43 @@ void tst_qquickanimations::simpleColor()
     QCOMPARE(rect.color(), QColor::fromRgbF(0.498039, 0, 0.498039, 1));
 }
 
+void tst_qquickanimations::simpleTypedProperty_data()
+{
+    QTest::addColumn<QByteArray>("property");
+    QTest::addColumn<QVariant>("from");
+    QTest::addColumn<QVariant>("to");
+    QTest::addColumn<QVariant>("halfway");
+
+    QTest::newRow("int") << QByteArray("intValue") << QVariant(0) << QVariant(11) << QVariant(5);
+    QTest::newRow("point") << QByteArray("point") << QVariant(QPointF(0, 10)) << QVariant(QPointF(100, 50))
+                           << QVariant(QPointF(50, 30));
+    QTest::newRow("size") << QByteArray("size") << QVariant(QSizeF(10, 10)) << QVariant(QSizeF(30, 50))
+                          << QVariant(QSizeF(20, 30));
+    QTest::newRow("rect") << QByteArray("rect") << QVariant(QRectF(0, 0, 10, 10)) << QVariant(QRectF(20, 40, 30, 50))
+                          << QVariant(QRectF(10, 20, 20, 30));
+}
+
+void tst_qquickanimations::simpleTypedProperty()
+{
+    QFETCH(QByteArray, property);
+    QFETCH(QVariant, from);
+    QFETCH(QVariant, to);
+    QFETCH(QVariant, halfway);
+
+    TypedPropertyObject object;
+    QQuickPropertyAnimation animation;
+    animation.setTargetObject(&object);
+    animation.setProperty(QString::fromLatin1(property));
+    animation.setFrom(from);
+    animation.setTo(to);
+    animation.start();
+    animation.pause();
+    animation.setCurrentTime(125);
+    QCOMPARE(object.property(property), halfway);
+    animation.setCurrentTime(250);
+    QCOMPARE(object.property(property), to);
+}
+
 void tst_qquickanimations::simpleRotation()
 {
     QQuickRectangle rect;
@@ -0,0 +1,104 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.2
+
+Item {
+    id: root
+    width: 400
+    height: 300
+
+    // Only the first rectangle is not observed while its x animates
+    property alias freeRect: freeRect
+    property QtObject freeAnimation: freeAnimation
+    property alias boundRect: boundRect
+    property QtObject boundAnimation: boundAnimation
+    property alias handledRect: handledRect
+    property QtObject handledAnimation: handledAnimation
+    property alias anchoredRect: anchoredRect
+    property QtObject anchoredAnimation: anchoredAnimation
+
+    property real boundX: boundRect.x
+    property int handledChanges: 0
+
+    Rectangle {
+        id: freeRect
+        width: 50
+        height: 50
+        color: "red"
+
+        Behavior on x {
+            NumberAnimation { id: freeAnimation; duration: 1000 }
+        }
+    }
+
+    Rectangle {
+        id: boundRect
+        y: 60
+        width: 50
+        height: 50
+        color: "green"
+
+        Behavior on x {
+            NumberAnimation { id: boundAnimation; duration: 1000 }
+        }
+    }
+
+    Rectangle {
+        id: handledRect
+        y: 120
+        width: 50
+        height: 50
+        color: "blue"
+        onXChanged: root.handledChanges++
+
+        Behavior on x {
+            NumberAnimation { id: handledAnimation; duration: 1000 }
+        }
+    }
+
+    Rectangle {
+        id: anchoredRect
+        y: 180
+        width: 50
+        height: 50
+        color: "yellow"
+
+        Behavior on x {
+            NumberAnimation { id: anchoredAnimation; duration: 1000 }
+        }
+    }
+
+    Rectangle {
+        anchors.left: anchoredRect.right
+        y: 180
+        width: 50
+        height: 50
+        color: "black"
+    }
+}
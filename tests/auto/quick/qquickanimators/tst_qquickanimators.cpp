@@ -29,9 +29,11 @@
 #include <qtest.h>
 
 #include <QtQuick>
+#include <private/qquickanimation_p.h>
 #include <private/qquickanimator_p.h>
 #include <private/qquickrepeater_p.h>
 #include <private/qquicktransition_p.h>
+#include <private/qquickwindow_p.h>
 
 #include <QtQml>
 
@@ -43,6 +45,8 @@ private slots:
     void testMultiWinAnimator_data();
     void testMultiWinAnimator();
     void testTransitions();
+    void testPromotedBehavior_data();
+    void testPromotedBehavior();
 };
 
 void tst_Animators::testMultiWinAnimator_data()
@@ -119,6 +123,52 @@ void tst_Animators::testTransitions()
     QCOMPARE(child->scale(), qreal(1.0));
 }
 
+void tst_Animators::testPromotedBehavior_data()
+{
+    QTest::addColumn<bool>("promote");
+    QTest::addColumn<QString>("item");
+    QTest::addColumn<bool>("promoted");
+
+    QTest::newRow("unobserved") << true << "free" << true;
+    QTest::newRow("binding") << true << "bound" << false;
+    QTest::newRow("handler") << true << "handled" << false;
+    QTest::newRow("anchor") << true << "anchored" << false;
+    QTest::newRow("not enabled") << false << "free" << false;
+}
+
+void tst_Animators::testPromotedBehavior()
+{
+    QFETCH(bool, promote);
+    QFETCH(QString, item);
+    QFETCH(bool, promoted);
+
+    QQuickView view;
+    QQuickWindowPrivate::get(&view)->promoteAnimationsToAnimators = promote;
+    view.setSource(QUrl::fromLocalFile("data/promotedBehavior.qml"));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+    QVERIFY(view.rootObject());
+
+    QQuickItem *rect = view.rootObject()->property(qPrintable(item + QLatin1String("Rect"))).value<QQuickItem *>();
+    QVERIFY(rect);
+    QQuickAbstractAnimation *animation = qobject_cast<QQuickAbstractAnimation *>(
+                view.rootObject()->property(qPrintable(item + QLatin1String("Animation"))).value<QObject *>());
+    QVERIFY(animation);
+    QCOMPARE(rect->x(), qreal(0.0));
+
+    rect->setProperty("x", 100);
+    QCOMPARE(animation->threadingModel(), promoted ? QQuickAbstractAnimation::RenderThread
+                                                   : QQuickAbstractAnimation::GuiThread);
+    if (promoted) {
+        // Animators only write the value back when they are done
+        QTest::qWait(300);
+        QCOMPARE(rect->x(), qreal(0.0));
+    } else {
+        QTRY_VERIFY(rect->x() > 0 && rect->x() < 100);
+    }
+    QTRY_COMPARE(rect->x(), qreal(100.0));
+}
+
 #include "tst_qquickanimators.moc"
 
 QTEST_MAIN(tst_Animators)
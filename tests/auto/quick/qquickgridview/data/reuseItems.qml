@@ -0,0 +1,25 @@
+import QtQuick 2.10
+
+GridView {
+    id: grid
+    width: 240
+    height: 320
+    cellWidth: 80
+    cellHeight: 20
+    cacheBuffer: 0
+    reuseItems: true
+
+    property int createdCount: 0
+    property int pooledCount: 0
+    property int reusedCount: 0
+
+    delegate: Text {
+        objectName: "wrapper"
+        width: grid.cellWidth
+        height: grid.cellHeight
+        text: modelData
+        Component.onCompleted: grid.createdCount++
+        GridView.onPooled: grid.pooledCount++
+        GridView.onReused: grid.reusedCount++
+    }
+}
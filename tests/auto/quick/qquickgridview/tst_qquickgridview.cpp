@@ -210,6 +210,7 @@ private slots:
 
     void keyNavigationEnabled();
     void releaseItems();
+    void reuseItems();
 
 private:
     QList<int> toIntList(const QVariantList &list);
@@ -6679,6 +6680,48 @@ void tst_QQuickGridView::releaseItems()
     gridview->setModel(123);
 }
 
+void tst_QQuickGridView::reuseItems()
+{
+    QStringList strings;
+    for (int i = 0; i < 1000; ++i)
+        strings << QString::fromLatin1("Item %1").arg(i);
+
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickGridView *gridview = qobject_cast<QQuickGridView *>(window->rootObject());
+    QVERIFY(gridview);
+    QVERIFY(gridview->reuseItems());
+    gridview->setModel(strings);
+
+    QQuickItemViewPrivate *gridviewPrivate = QQuickItemViewPrivate::get(gridview);
+    QTRY_VERIFY(gridviewPrivate->visibleItems.count() > 0);
+    const int initialCount = gridview->property("createdCount").toInt();
+    QVERIFY(initialCount > 0);
+
+    for (int y = 0; y < 5000; y += 30)
+        gridview->setContentY(y);
+    gridviewPrivate->layout();
+
+    // Scrolling by less than a page at a time is mostly served from the pool
+    QVERIFY(gridview->property("createdCount").toInt() < 2 * initialCount);
+    QVERIFY(gridview->property("reusedCount").toInt() > 0);
+    QVERIFY(gridview->property("pooledCount").toInt() >= gridview->property("reusedCount").toInt());
+
+    // Reused delegates show the data of their new index
+    for (FxViewItem *item : qAsConst(gridviewPrivate->visibleItems)) {
+        QQuickText *text = qobject_cast<QQuickText *>(item->item);
+        QVERIFY(text);
+        QCOMPARE(text->text(), strings.at(item->index));
+        QVERIFY(!QQuickItemPrivate::get(text)->culled);
+    }
+
+    gridview->setReuseItems(false);
+    QCOMPARE(gridviewPrivate->model->poolSize(), 0);
+}
+
 QTEST_MAIN(tst_QQuickGridView)
 
 #include "tst_qquickgridview.moc"
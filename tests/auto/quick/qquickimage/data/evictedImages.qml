@@ -0,0 +1,18 @@
+import QtQuick 2.0
+
+Item {
+    width: 240
+    height: 120
+
+    Image {
+        objectName: "shown"
+        source: "colors.png"
+    }
+
+    Image {
+        objectName: "hidden"
+        x: 120
+        source: "colors1.png"
+        visible: false
+    }
+}
@@ -36,6 +36,7 @@
 #include <QtQuick/qquickview.h>
 #include <private/qquickimage_p.h>
 #include <private/qquickimagebase_p.h>
+#include <private/qquickimagebase_p_p.h>
 #include <private/qquickloader_p.h>
 #include <QtQml/qqmlcontext.h>
 #include <QtQml/qqmlexpression.h>
@@ -94,6 +95,7 @@ private slots:
     void highDpiFillModesAndSizes_data();
     void highDpiFillModesAndSizes();
     void hugeImages();
+    void evictedImageReload();
 
 private:
     QQmlEngine engine;
@@ -1047,6 +1049,41 @@ void tst_qquickimage::hugeImages()
     QCOMPARE(contents.pixel(199, 99), qRgba(0, 0, 255, 255));
 }
 
+void tst_qquickimage::evictedImageReload()
+{
+    QQuickView window;
+    window.setSource(testFileUrl("evictedImages.qml"));
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QQuickImage *shown = window.rootObject()->findChild<QQuickImage *>("shown");
+    QQuickImage *hidden = window.rootObject()->findChild<QQuickImage *>("hidden");
+    QVERIFY(shown && hidden);
+    QQuickImageBasePrivate *shownPrivate = static_cast<QQuickImageBasePrivate *>(QQuickItemPrivate::get(shown));
+    QQuickImageBasePrivate *hiddenPrivate = static_cast<QQuickImageBasePrivate *>(QQuickItemPrivate::get(hidden));
+    QCOMPARE(hidden->status(), QQuickImage::Ready);
+
+    QSignalSpy statusSpy(hidden, SIGNAL(statusChanged(QQuickImageBase::Status)));
+    const qint64 oldBudget = QQuickPixmap::memoryBudget();
+
+    // Only the image that is not on screen gives up its pixmap
+    QQuickPixmap::setMemoryBudget(1);
+    QVERIFY(hiddenPrivate->pix.isEvicted());
+    QVERIFY(!shownPrivate->pix.isEvicted());
+    QCOMPARE(hidden->status(), QQuickImage::Ready);
+    QCOMPARE(hidden->implicitWidth(), 120.0);
+    QCOMPARE(hidden->implicitHeight(), 120.0);
+
+    // Showing it again decodes the pixmap without going through Loading
+    QQuickPixmap::setMemoryBudget(oldBudget);
+    hidden->setVisible(true);
+    QTRY_VERIFY(!hiddenPrivate->pix.isEvicted());
+    QVERIFY(hiddenPrivate->pix.isReady());
+    QCOMPARE(hidden->status(), QQuickImage::Ready);
+    QCOMPARE(hidden->implicitWidth(), 120.0);
+    QCOMPARE(statusSpy.count(), 0);
+}
+
 QTEST_MAIN(tst_qquickimage)
 
 #include "tst_qquickimage.moc"
@@ -0,0 +1,25 @@
+import QtQuick 2.10
+
+ListView {
+    id: list
+    width: 240
+    height: 320
+    cacheBuffer: 0
+    reuseItems: true
+
+    property int createdCount: 0
+    property int pooledCount: 0
+    property int reusedCount: 0
+    // item models with several roles have no modelData
+    property string textRole: "modelData"
+
+    delegate: Text {
+        objectName: "wrapper"
+        width: list.width
+        height: 20
+        text: model[list.textRole]
+        Component.onCompleted: list.createdCount++
+        ListView.onPooled: list.pooledCount++
+        ListView.onReused: list.reusedCount++
+    }
+}
@@ -256,6 +256,8 @@ private slots:
     void QTBUG_50097_stickyHeader_positionViewAtIndex();
     void itemFiltered();
     void releaseItems();
+    void reuseItems_data();
+    void reuseItems();
 
 private:
     template <class T> void items(const QUrl &source);
@@ -8545,6 +8547,64 @@ void tst_QQuickListView::releaseItems()
     listview->setModel(123);
 }
 
+void tst_QQuickListView::reuseItems_data()
+{
+    QTest::addColumn<bool>("useItemModel");
+
+    QTest::newRow("string list") << false;
+    QTest::newRow("item model") << true;
+}
+
+void tst_QQuickListView::reuseItems()
+{
+    QFETCH(bool, useItemModel);
+
+    QStringList strings;
+    for (int i = 0; i < 1000; ++i)
+        strings << QString::fromLatin1("Item %1").arg(i);
+    QStringListModel itemModel(strings);
+
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickListView *listview = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listview);
+    QVERIFY(listview->reuseItems());
+    if (useItemModel) {
+        listview->setProperty("textRole", QStringLiteral("display"));
+        listview->setModel(QVariant::fromValue<QObject *>(&itemModel));
+    } else {
+        listview->setModel(strings);
+    }
+
+    QQuickItemViewPrivate *listviewPrivate = QQuickItemViewPrivate::get(listview);
+    QTRY_VERIFY(listviewPrivate->visibleItems.count() > 0);
+    const int initialCount = listview->property("createdCount").toInt();
+    QVERIFY(initialCount > 0);
+
+    for (int y = 0; y < 5000; y += 30)
+        listview->setContentY(y);
+    listviewPrivate->layout();
+
+    // Scrolling by less than a page at a time is mostly served from the pool
+    QVERIFY(listview->property("createdCount").toInt() < 2 * initialCount);
+    QVERIFY(listview->property("reusedCount").toInt() > 0);
+    QVERIFY(listview->property("pooledCount").toInt() >= listview->property("reusedCount").toInt());
+
+    // Reused delegates show the data of their new index
+    for (FxViewItem *item : qAsConst(listviewPrivate->visibleItems)) {
+        QQuickText *text = qobject_cast<QQuickText *>(item->item);
+        QVERIFY(text);
+        QCOMPARE(text->text(), strings.at(item->index));
+        QVERIFY(!QQuickItemPrivate::get(text)->culled);
+    }
+
+    listview->setReuseItems(false);
+    QCOMPARE(listviewPrivate->model->poolSize(), 0);
+}
+
 QTEST_MAIN(tst_QQuickListView)
 
 #include "tst_qquicklistview.moc"
@@ -0,0 +1,29 @@
+import QtQuick 2.10
+
+PathView {
+    id: view
+    width: 320
+    height: 100
+    pathItemCount: 8
+    reuseItems: true
+
+    property int createdCount: 0
+    property int pooledCount: 0
+    property int reusedCount: 0
+
+    delegate: Text {
+        objectName: "wrapper"
+        width: 40
+        height: 20
+        text: modelData
+        property int itemIndex: index
+        Component.onCompleted: view.createdCount++
+        PathView.onPooled: view.pooledCount++
+        PathView.onReused: view.reusedCount++
+    }
+
+    path: Path {
+        startX: 0; startY: 50
+        PathLine { x: 320; y: 50 }
+    }
+}
@@ -33,6 +33,7 @@
 #include <QtQml/qqmlcontext.h>
 #include <QtQml/qqmlexpression.h>
 #include <QtQml/qqmlincubator.h>
+#include <QtQuick/private/qquickitem_p.h>
 #include <QtQuick/private/qquickpathview_p.h>
 #include <QtQuick/private/qquickflickable_p.h>
 #include <QtQuick/private/qquickpath_p.h>
@@ -142,6 +143,7 @@ private slots:
     void movementDirection_data();
     void movementDirection();
     void removePath();
+    void reuseItems();
 };
 
 class TestObject : public QObject
@@ -2518,6 +2520,48 @@ void tst_QQuickPathView::removePath()
     QVERIFY(QMetaObject::invokeMethod(pathview, "setPath"));
 }
 
+void tst_QQuickPathView::reuseItems()
+{
+    QStringList strings;
+    for (int i = 0; i < 1000; ++i)
+        strings << QString::fromLatin1("Item %1").arg(i);
+
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickPathView *pathview = qobject_cast<QQuickPathView *>(window->rootObject());
+    QVERIFY(pathview);
+    QVERIFY(pathview->reuseItems());
+    pathview->setModel(strings);
+
+    QTRY_VERIFY(pathview->property("createdCount").toInt() > 0);
+    const int initialCount = pathview->property("createdCount").toInt();
+
+    for (qreal offset = 0; offset < 200; offset += 0.5)
+        pathview->setOffset(offset);
+
+    // Moving by less than the path at a time is mostly served from the pool
+    QVERIFY(pathview->property("createdCount").toInt() < 2 * initialCount);
+    QVERIFY(pathview->property("reusedCount").toInt() > 0);
+    QVERIFY(pathview->property("pooledCount").toInt() >= pathview->property("reusedCount").toInt());
+
+    // Reused delegates on the path show the data of their new index
+    int onPath = 0;
+    const QList<QQuickText *> texts = findItems<QQuickText>(pathview, "wrapper");
+    for (QQuickText *text : texts) {
+        if (QQuickItemPrivate::get(text)->culled)
+            continue;
+        ++onPath;
+        QCOMPARE(text->text(), strings.at(text->property("itemIndex").toInt()));
+    }
+    QVERIFY(onPath >= pathview->pathItemCount());
+
+    pathview->setReuseItems(false);
+    QTRY_COMPARE(findItems<QQuickText>(pathview, "wrapper").count(), onPath);
+}
+
 QTEST_MAIN(tst_QQuickPathView)
 
 #include "tst_qquickpathview.moc"
@@ -62,6 +62,10 @@ private slots:
 #endif
     void lockingCrash();
     void uncached();
+    void decodeStatistics();
+    void decodePriority();
+    void abortCancelledDecode();
+    void memoryBudget();
 #if PIXMAP_DATA_LEAK_TEST
     void dataLeak();
 #endif
@@ -473,6 +477,188 @@ void tst_qquickpixmapcache::uncached()
     }
 }
 
+void tst_qquickpixmapcache::decodeStatistics()
+{
+    QQmlEngine engine;
+    QQuickPixmapDecodeStatistics statistics = QQuickPixmap::decodeStatistics(&engine);
+    QVERIFY(statistics.maxDecodes > 0);
+    QCOMPARE(statistics.decodedImages, quint64(0));
+
+    const int count = 10;
+    QList<QQuickPixmap *> pixmaps;
+    for (int ii = 0; ii < count; ++ii) {
+        QQuickPixmap *pixmap = new QQuickPixmap;
+        pixmap->load(&engine, testFileUrl("exists.png"), QQuickPixmap::Asynchronous);
+        QVERIFY(pixmap->isLoading());
+        pixmaps.append(pixmap);
+    }
+
+    QTRY_COMPARE(QQuickPixmap::decodeStatistics(&engine).decodedImages, quint64(count));
+    for (QQuickPixmap *pixmap : qAsConst(pixmaps))
+        QTRY_VERIFY(pixmap->isReady());
+
+    statistics = QQuickPixmap::decodeStatistics(&engine);
+    QCOMPARE(statistics.queuedRequests, 0);
+    QCOMPARE(statistics.activeDecodes, 0);
+    QCOMPARE(statistics.abortedDecodes, quint64(0));
+    QVERIFY(statistics.totalDecodeTime >= statistics.maxDecodeTime);
+
+    qDeleteAll(pixmaps);
+}
+
+class BlockingImageProvider : public QQuickImageProvider
+{
+public:
+    BlockingImageProvider()
+    : QQuickImageProvider(Image) {}
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &) override
+    {
+        {
+            QMutexLocker locker(&mutex);
+            requested.append(id);
+        }
+        entered.release();
+        proceed.acquire();
+
+        QImage image(10, 10, QImage::Format_RGB32);
+        image.fill(Qt::red);
+        if (size)
+            *size = image.size();
+        return image;
+    }
+
+    QStringList requestedIds()
+    {
+        QMutexLocker locker(&mutex);
+        return requested;
+    }
+
+    QSemaphore entered;
+    QSemaphore proceed;
+
+private:
+    QMutex mutex;
+    QStringList requested;
+};
+
+void tst_qquickpixmapcache::decodePriority()
+{
+    QQmlEngine engine;
+    BlockingImageProvider *provider = new BlockingImageProvider;
+    engine.addImageProvider(QLatin1String("blocking"), provider);
+
+    // Keep the provider busy, so that the next requests queue up behind it
+    QQuickPixmap first;
+    first.load(&engine, QUrl("image://blocking/first"), QQuickPixmap::Asynchronous);
+    QVERIFY(first.isLoading());
+    QVERIFY(provider->entered.tryAcquire(1, 5000));
+
+    QQuickPixmap low1;
+    low1.load(&engine, QUrl("image://blocking/low1"), QQuickPixmap::Asynchronous);
+    low1.setPriority(QQuickPixmap::LowPriority);
+    QQuickPixmap normal;
+    normal.load(&engine, QUrl("image://blocking/normal"), QQuickPixmap::Asynchronous);
+    QQuickPixmap low2;
+    low2.load(&engine, QUrl("image://blocking/low2"), QQuickPixmap::Asynchronous);
+    low2.setPriority(QQuickPixmap::LowPriority);
+    QCOMPARE(QQuickPixmap::decodeStatistics(&engine).queuedRequests, 3);
+
+    provider->proceed.release(4);
+    QTRY_VERIFY(first.isReady());
+    QTRY_VERIFY(low1.isReady());
+    QTRY_VERIFY(normal.isReady());
+    QTRY_VERIFY(low2.isReady());
+
+    // Higher priorities first, then the most recent request
+    QCOMPARE(provider->requestedIds(), QStringList() << "first" << "normal" << "low2" << "low1");
+}
+
+void tst_qquickpixmapcache::abortCancelledDecode()
+{
+    QQmlEngine engine;
+    BlockingImageProvider *provider = new BlockingImageProvider;
+    engine.addImageProvider(QLatin1String("blocking"), provider);
+
+    QQuickPixmap *pixmap = new QQuickPixmap;
+    pixmap->load(&engine, QUrl("image://blocking/cancelled"), QQuickPixmap::Asynchronous);
+    QVERIFY(provider->entered.tryAcquire(1, 5000));
+    QCOMPARE(QQuickPixmap::decodeStatistics(&engine).activeDecodes, 1);
+
+    // The decode is in flight, its result must be dropped
+    delete pixmap;
+    provider->proceed.release();
+
+    QTRY_COMPARE(QQuickPixmap::decodeStatistics(&engine).abortedDecodes, quint64(1));
+    QQuickPixmapDecodeStatistics statistics = QQuickPixmap::decodeStatistics(&engine);
+    QCOMPARE(statistics.activeDecodes, 0);
+    QCOMPARE(statistics.decodedImages, quint64(0));
+}
+
+class EvictionHandler : public QQuickPixmapEvictionHandler
+{
+public:
+    EvictionHandler(bool displayed) : displayed(displayed), evictions(0) {}
+
+    bool isPixmapDisplayed() const override { return displayed; }
+    void pixmapEvicted() override { ++evictions; }
+
+    bool displayed;
+    int evictions;
+};
+
+void tst_qquickpixmapcache::memoryBudget()
+{
+    QQmlEngine engine;
+    const qint64 oldBudget = QQuickPixmap::memoryBudget();
+    QQuickPixmap::purgeCache();
+
+    QQuickPixmapCacheStatistics before = QQuickPixmap::cacheStatistics();
+    QQuickPixmap hidden(&engine, testFileUrl("exists.png"));
+    QQuickPixmap shown(&engine, testFileUrl("exists1.png"));
+    QQuickPixmap unhandled(&engine, testFileUrl("exists2.png"));
+    QQuickPixmap shared(&engine, testFileUrl("exists.png"));
+    QVERIFY(hidden.isReady() && shown.isReady() && unhandled.isReady());
+
+    QQuickPixmapCacheStatistics statistics = QQuickPixmap::cacheStatistics();
+    QCOMPARE(statistics.misses - before.misses, quint64(3));
+    QCOMPARE(statistics.hits - before.hits, quint64(1));
+    QVERIFY(statistics.totalCost > 0);
+
+    EvictionHandler hiddenHandler(false);
+    EvictionHandler sharedHandler(false);
+    EvictionHandler shownHandler(true);
+    hidden.setEvictionHandler(&hiddenHandler);
+    shared.setEvictionHandler(&sharedHandler);
+    shown.setEvictionHandler(&shownHandler);
+    const QSize hiddenSize = hidden.rect().size();
+
+    // Only pixmaps whose every user can reload them are dropped
+    QQuickPixmap::setMemoryBudget(1);
+    QVERIFY(hidden.isEvicted());
+    QVERIFY(shared.isEvicted());
+    QCOMPARE(hiddenHandler.evictions, 1);
+    QCOMPARE(sharedHandler.evictions, 1);
+    QCOMPARE(hidden.status(), QQuickPixmap::Ready);
+    QCOMPARE(hidden.rect().size(), hiddenSize);
+    QVERIFY(!hidden.textureFactory());
+
+    QVERIFY(!shown.isEvicted());
+    QCOMPARE(shownHandler.evictions, 0);
+    QVERIFY(!unhandled.isEvicted());
+
+    statistics = QQuickPixmap::cacheStatistics();
+    QCOMPARE(statistics.droppedPixmaps - before.droppedPixmaps, quint64(1));
+    QCOMPARE(statistics.memoryBudget, qint64(1));
+
+    // An evicted pixmap is decoded again on the next load
+    QQuickPixmap reloaded(&engine, testFileUrl("exists.png"));
+    QVERIFY(reloaded.isReady());
+    QVERIFY(!reloaded.isEvicted());
+    QCOMPARE(QQuickPixmap::cacheStatistics().misses - before.misses, quint64(4));
+
+    QQuickPixmap::setMemoryBudget(oldBudget);
+}
 
 #if PIXMAP_DATA_LEAK_TEST
 // This test should not be enabled by default as it
@@ -156,6 +156,8 @@ private slots:
 
     void fontInfo();
 
+    void sharedLayout();
+
 private:
     QStringList standard;
     QStringList richText;
@@ -4327,6 +4329,46 @@ void tst_qquicktext::fontInfo()
     QVERIFY(copy->font().pixelSize() < 1000);
 }
 
+void tst_qquicktext::sharedLayout()
+{
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.0\n"
+                      "Column {\n"
+                      "    Repeater {\n"
+                      "        model: 4\n"
+                      "        Text { width: 60; wrapMode: Text.Wrap; text: \"the same text in every delegate\" }\n"
+                      "    }\n"
+                      "}\n", QUrl());
+
+    QScopedPointer<QObject> object(component.create());
+    QQuickItem *column = qobject_cast<QQuickItem *>(object.data());
+    QVERIFY(column);
+
+    const QList<QQuickText *> texts = column->findChildren<QQuickText *>();
+    QCOMPARE(texts.count(), 4);
+
+    // The first item leaves a marker in the cache, the second one stores its
+    // layout and the ones after that reuse it.
+    QQuickTextPrivate *first = QQuickTextPrivate::get(texts.at(0));
+    QQuickTextPrivate *third = QQuickTextPrivate::get(texts.at(2));
+    QQuickTextPrivate *fourth = QQuickTextPrivate::get(texts.at(3));
+    QVERIFY(!first->cachedLayout);
+    QVERIFY(third->cachedLayout);
+    QCOMPARE(third->cachedLayout, fourth->cachedLayout);
+
+    for (QQuickText *text : texts) {
+        QCOMPARE(text->lineCount(), texts.at(0)->lineCount());
+        QCOMPARE(text->implicitWidth(), texts.at(0)->implicitWidth());
+        QCOMPARE(text->implicitHeight(), texts.at(0)->implicitHeight());
+        QCOMPARE(text->contentHeight(), texts.at(0)->contentHeight());
+    }
+    QVERIFY(texts.at(0)->lineCount() > 1);
+
+    texts.at(3)->setText(QStringLiteral("x"));
+    QVERIFY(!fourth->cachedLayout);
+    QCOMPARE(texts.at(3)->lineCount(), 1);
+}
+
 QTEST_MAIN(tst_qquicktext)
 
 #include "tst_qquicktext.moc"
@@ -0,0 +1,14 @@
+import QtQuick 2.4
+import QtQuick.Window 2.2
+
+Rectangle {
+    width: 100
+    height: 100
+    color: "steelblue"
+
+    function lastFrames(count) {
+        return Window.frameTimings(count)
+    }
+
+    NumberAnimation on rotation { from: 0; to: 360; duration: 1000; loops: Animation.Infinite }
+}
@@ -17,4 +17,5 @@ OTHER_FILES += \
     data/Headless.qml \
     data/showHideAnimate.qml \
     data/windoworder.qml \
-    data/grabContentItemToImage.qml
+    data/grabContentItemToImage.qml \
+    data/frameTimings.qml
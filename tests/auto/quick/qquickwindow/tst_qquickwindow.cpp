@@ -377,6 +377,7 @@ private slots:
     void defaultSurfaceFormat();
 
     void attachedProperty();
+    void frameTimings();
 
     void testRenderJob();
 
@@ -392,6 +393,8 @@ private slots:
 
     void findChild();
 
+    void pointerTargets();
+
 private:
     QTouchDevice *touchDevice;
     QTouchDevice *touchDeviceWithVelocity;
@@ -2265,6 +2268,40 @@ void tst_qquickwindow::attachedProperty()
     QVERIFY(!text->property("window").value<QQuickWindow*>());
 }
 
+void tst_qquickwindow::frameTimings()
+{
+    QQuickView view(testFileUrl("frameTimings.qml"));
+    view.setTitle(QTest::currentTestFunction());
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QQuickFrameTimingBuffer &buffer = QQuickWindowPrivate::get(&view)->frameTimings;
+    if (!buffer.capacity())
+        QSKIP("Frame timings are disabled");
+    QTRY_VERIFY(buffer.frameCount() >= 3);
+
+    const QVector<QQuickFrameTiming> frames = buffer.frames();
+    QVERIFY(frames.size() >= 3);
+    QVERIFY(frames.size() <= buffer.capacity());
+    for (int i = 1; i < frames.size(); ++i) {
+        QCOMPARE(frames.at(i).frame, frames.at(i - 1).frame + 1);
+        QVERIFY(frames.at(i).timestamp >= frames.at(i - 1).timestamp);
+    }
+    QVERIFY(frames.last().render >= 0);
+    QVERIFY(frames.last().total() >= frames.last().render);
+    QCOMPARE(buffer.frames(2).size(), 2);
+
+    QVariant result;
+    QVERIFY(QMetaObject::invokeMethod(view.rootObject(), "lastFrames",
+                                      Q_RETURN_ARG(QVariant, result), Q_ARG(QVariant, 2)));
+    const QVariantList list = result.toList();
+    QCOMPARE(list.size(), 2);
+    const QVariantMap last = list.last().toMap();
+    QVERIFY(last.value(QStringLiteral("frame")).toUInt() > list.first().toMap().value(QStringLiteral("frame")).toUInt());
+    for (const char *key : { "timestamp", "polish", "animations", "sync", "render", "swap", "gc", "total" })
+        QVERIFY2(last.contains(QLatin1String(key)), key);
+}
+
 class RenderJob : public QRunnable
 {
 public:
@@ -3001,6 +3038,53 @@ void tst_qquickwindow::findChild()
     QCOMPARE(window.contentItem()->findChild<QObject *>("contentItemChild"), contentItemChild);
 }
 
+void tst_qquickwindow::pointerTargets()
+{
+    QQuickWindow window;
+    window.contentItem()->setSize(QSizeF(300, 300));
+    QQuickWindowPrivate *wd = QQuickWindowPrivate::get(&window);
+
+    // contentItem
+    // |_ a (0, 0, 100, 100)
+    //    |_ b (10, 10, 20, 20)
+    //       |_ c (100, 100, 10, 10), outside of both a and b
+    QQuickItem *a = new QQuickItem(window.contentItem());
+    a->setSize(QSizeF(100, 100));
+    QQuickItem *b = new QQuickItem(a);
+    b->setPosition(QPointF(10, 10));
+    b->setSize(QSizeF(20, 20));
+    QQuickItem *c = new QQuickItem(b);
+    c->setPosition(QPointF(100, 100));
+    c->setSize(QSizeF(10, 10));
+
+    auto targetsAt = [&](const QPointF &scenePos) {
+        return wd->pointerTargets(window.contentItem(), scenePos, false, false);
+    };
+
+    QCOMPARE(targetsAt(QPointF(115, 115)), (QVector<QQuickItem *>() << c << window.contentItem()));
+    QCOMPARE(targetsAt(QPointF(15, 15)), (QVector<QQuickItem *>() << b << a << window.contentItem()));
+
+    // Moving a descendant has to be picked up by the cached bounds of its ancestors
+    c->setPosition(QPointF(150, 150));
+    QCOMPARE(targetsAt(QPointF(115, 115)), (QVector<QQuickItem *>() << window.contentItem()));
+    QCOMPARE(targetsAt(QPointF(165, 165)), (QVector<QQuickItem *>() << c << window.contentItem()));
+
+    // So do transforms...
+    b->setScale(0.5);
+    QVERIFY(!targetsAt(QPointF(165, 165)).contains(c));
+    QVERIFY(targetsAt(QPointF(92, 92)).contains(c));
+    b->setScale(1);
+
+    // ...and reparenting
+    QQuickItem *d = new QQuickItem(window.contentItem());
+    d->setPosition(QPointF(50, 50));
+    d->setSize(QSizeF(10, 10));
+    c->setParentItem(d);
+    QCOMPARE(targetsAt(QPointF(205, 205)), (QVector<QQuickItem *>() << c << window.contentItem()));
+    c->setParentItem(a);
+    QCOMPARE(targetsAt(QPointF(155, 155)), (QVector<QQuickItem *>() << c << a << window.contentItem()));
+}
+
 QTEST_MAIN(tst_qquickwindow)
 
 #include "tst_qquickwindow.moc"
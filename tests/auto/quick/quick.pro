@@ -88,7 +88,8 @@ QUICKTESTS =  \
     qquickscreen \
     touchmouse \
     scenegraph \
-    sharedimage
+    sharedimage \
+    softwarerenderer
 
 SUBDIRS += $$PUBLICTESTS
 
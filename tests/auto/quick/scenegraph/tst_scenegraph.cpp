@@ -43,6 +43,7 @@
 
 #include <private/qsgcontext_p.h>
 #include <private/qsgrenderloop_p.h>
+#include <private/qsgdistancefieldgenerator_p.h>
 
 #include "../../shared/util.h"
 #include "../shared/visualtestutil.h"
@@ -110,6 +111,7 @@ private slots:
 #endif
     void createTextureFromImage_data();
     void createTextureFromImage();
+    void distanceFieldGenerator();
 
 private:
     bool m_brokenMipmapSupport;
@@ -550,6 +552,76 @@ void tst_SceneGraph::createTextureFromImage()
 }
 
 
+static bool sameDistanceField(const QDistanceField &a, const QDistanceField &b)
+{
+    return a.width() == b.width() && a.height() == b.height()
+            && memcmp(a.constBits(), b.constBits(), a.width() * a.height()) == 0;
+}
+
+void tst_SceneGraph::distanceFieldGenerator()
+{
+    QStandardPaths::setTestModeEnabled(true);
+
+    const QRawFont font = QRawFont::fromFont(QFont());
+    if (!font.isValid())
+        QSKIP("No font available");
+
+    const QVector<quint32> glyphs = font.glyphIndexesForString(QStringLiteral("Quick"));
+    QVector<QPainterPath> paths;
+    QList<QDistanceField> expected;
+    for (quint32 glyph : glyphs) {
+        paths.append(font.pathForGlyph(glyph));
+        expected.append(QDistanceField(paths.last(), glyph, false));
+    }
+
+    QSharedPointer<QSGDistanceFieldDiskCache> diskCache = QSGDistanceFieldDiskCache::forFont(font, false);
+    if (diskCache)
+        QFile::remove(diskCache->fileName());
+
+    {
+        QSGDistanceFieldGenerator generator(font, false);
+        generator.generate(glyphs, paths);
+        for (int i = 0; i < glyphs.size(); ++i)
+            QVERIFY(sameDistanceField(generator.take(glyphs.at(i)), expected.at(i)));
+        // each field is handed out once
+        QVERIFY(generator.take(glyphs.first()).isNull());
+    }
+
+    if (!diskCache)
+        QSKIP("The font does not come from a file, there is no disk cache");
+
+    // The generator leaves saving to a thread of the pool, do it right here instead
+    const QString fileName = diskCache->fileName();
+    diskCache->save();
+    QVERIFY(QFile::exists(fileName));
+    const qint64 size = QFileInfo(fileName).size();
+
+    // Fields of more glyphs are appended to the file
+    const QVector<quint32> moreGlyphs = font.glyphIndexesForString(QStringLiteral("Graph"));
+    QVector<QPainterPath> morePaths;
+    QList<QDistanceField> moreExpected;
+    for (quint32 glyph : moreGlyphs) {
+        morePaths.append(font.pathForGlyph(glyph));
+        moreExpected.append(QDistanceField(morePaths.last(), glyph, false));
+    }
+    {
+        QSGDistanceFieldGenerator generator(font, false);
+        generator.generate(moreGlyphs, morePaths);
+        for (int i = 0; i < moreGlyphs.size(); ++i)
+            QVERIFY(sameDistanceField(generator.take(moreGlyphs.at(i)), moreExpected.at(i)));
+    }
+    diskCache->save();
+    QVERIFY(QFileInfo(fileName).size() > size);
+
+    for (int i = 0; i < glyphs.size(); ++i)
+        QVERIFY(sameDistanceField(diskCache->find(glyphs.at(i)), expected.at(i)));
+    for (int i = 0; i < moreGlyphs.size(); ++i)
+        QVERIFY(sameDistanceField(diskCache->find(moreGlyphs.at(i)), moreExpected.at(i)));
+    diskCache.clear();
+    QFile::remove(fileName);
+}
+
+
 #include "tst_scenegraph.moc"
 
 QTEST_MAIN(tst_SceneGraph)
@@ -0,0 +1,86 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.2
+
+// Overlapping content that crosses the 128 pixel tiles of the software renderer
+Rectangle {
+    width: 400
+    height: 400
+    color: "white"
+
+    property alias mover: mover
+    property alias label: label
+
+    Rectangle {
+        x: 20; y: 20
+        width: 300; height: 200
+        radius: 24
+        border.width: 5
+        border.color: "navy"
+        gradient: Gradient {
+            GradientStop { position: 0; color: "lightsteelblue" }
+            GradientStop { position: 1; color: "steelblue" }
+        }
+    }
+
+    Rectangle {
+        x: 90; y: 100
+        width: 180; height: 180
+        rotation: 30
+        antialiasing: true
+        opacity: 0.6
+        color: "orange"
+    }
+
+    Repeater {
+        model: 12
+        Rectangle {
+            x: 10 + index * 31; y: 250 + (index % 3) * 20
+            width: 40; height: 40
+            radius: index % 2 ? 20 : 0
+            color: Qt.hsla(index / 12, 0.8, 0.5, 0.8)
+        }
+    }
+
+    Text {
+        id: label
+        x: 100; y: 120
+        text: "Tiled text crossing tiles"
+        font.pixelSize: 24
+        color: "black"
+    }
+
+    Rectangle {
+        id: mover
+        x: 110; y: 110
+        width: 50; height: 50
+        radius: 8
+        color: "crimson"
+    }
+}
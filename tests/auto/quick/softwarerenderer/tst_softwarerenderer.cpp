@@ -0,0 +1,124 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtQuick/qquickview.h>
+#include <QtQuick/qquickitem.h>
+
+#include "../../shared/util.h"
+
+QT_BEGIN_NAMESPACE
+extern void qsg_set_software_render_threads(int count);
+extern int qsg_software_tiled_frames();
+QT_END_NAMESPACE
+
+class tst_SoftwareRenderer : public QQmlDataTest
+{
+    Q_OBJECT
+public:
+    tst_SoftwareRenderer();
+
+private slots:
+    void cleanup();
+    void tiledRendering_data();
+    void tiledRendering();
+};
+
+tst_SoftwareRenderer::tst_SoftwareRenderer()
+{
+    QQuickWindow::setSceneGraphBackend(QSGRendererInterface::Software);
+}
+
+void tst_SoftwareRenderer::cleanup()
+{
+    qsg_set_software_render_threads(0);
+}
+
+void tst_SoftwareRenderer::tiledRendering_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("7 threads") << 7;
+}
+
+// Renders the same scene serially and in tiles on several threads, both the
+// initial full frame and a partial update, and compares the results.
+void tst_SoftwareRenderer::tiledRendering()
+{
+    QFETCH(int, threads);
+
+    QQuickView serialView(testFileUrl("tiles.qml"));
+    QQuickView tiledView(testFileUrl("tiles.qml"));
+    QVERIFY(serialView.rootObject());
+    QVERIFY(tiledView.rootObject());
+
+    // Nothing animates, so each window renders its full first frame when it gets exposed
+    qsg_set_software_render_threads(1);
+    const int tiledFramesBefore = qsg_software_tiled_frames();
+    serialView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&serialView));
+    QCOMPARE(qsg_software_tiled_frames(), tiledFramesBefore);
+
+    qsg_set_software_render_threads(threads);
+    tiledView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&tiledView));
+    if (qsg_software_tiled_frames() == tiledFramesBefore)
+        QSKIP("The backing store of this platform can't be rendered in tiles");
+
+    const QImage serialFull = serialView.grabWindow();
+    const QImage tiledFull = tiledView.grabWindow();
+    QCOMPARE(tiledFull.size(), serialFull.size());
+    QCOMPARE(tiledFull, serialFull);
+
+    // Only the dirty tiles are repainted, on top of the previous frame. Grabbing renders
+    // the pending changes right away, with the thread count set at that time.
+    for (QQuickView *view : { &serialView, &tiledView }) {
+        QQuickItem *mover = view->rootObject()->property("mover").value<QQuickItem *>();
+        QVERIFY(mover);
+        mover->setPosition(QPointF(200, 90));
+        mover->setRotation(15);
+        QQuickItem *label = view->rootObject()->property("label").value<QQuickItem *>();
+        QVERIFY(label);
+        label->setProperty("color", QColor(Qt::darkGreen));
+    }
+
+    qsg_set_software_render_threads(1);
+    const QImage serialUpdate = serialView.grabWindow();
+    qsg_set_software_render_threads(threads);
+    const int tiledFramesBeforeUpdate = qsg_software_tiled_frames();
+    const QImage tiledUpdate = tiledView.grabWindow();
+    QVERIFY(qsg_software_tiled_frames() > tiledFramesBeforeUpdate);
+    QVERIFY(serialUpdate != serialFull);
+    QCOMPARE(tiledUpdate, serialUpdate);
+}
+
+QTEST_MAIN(tst_SoftwareRenderer)
+
+#include "tst_softwarerenderer.moc"
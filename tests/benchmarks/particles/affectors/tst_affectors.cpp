@@ -42,6 +42,8 @@ private slots:
     void test_basic_data();
     void test_filtered();
     void test_filtered_data();
+    void test_gravity();
+    void test_gravity_data();
 };
 
 tst_affectors::tst_affectors()
@@ -71,6 +73,15 @@ void tst_affectors::test_filtered_data()
     QTest::newRow("500ms") << 500;
 }
 
+void tst_affectors::test_gravity_data()
+{
+    QTest::addColumn<int> ("dt");
+    QTest::newRow("16ms") << 16;
+    QTest::newRow("32ms") << 32;
+    QTest::newRow("100ms") << 100;
+    QTest::newRow("500ms") << 500;
+}
+
 void tst_affectors::test_basic()
 {
     QFETCH(int, dt);
@@ -151,6 +162,41 @@ void tst_affectors::test_filtered()
     delete view;
 }
 
+void tst_affectors::test_gravity()
+{
+    QFETCH(int, dt);
+    QQuickView* view = createView(TEST_FILE("gravity.qml"));
+    QQuickParticleSystem* system = view->rootObject()->findChild<QQuickParticleSystem*>("system");
+    //Pretend we're running, but we manually advance the simulation
+    system->m_running = true;
+    system->m_animation = 0;
+    system->reset();
+
+    int curTime = 1;
+    system->updateCurrentTime(curTime);//Fixed point and get init out of the way - including emission
+
+    QBENCHMARK {
+        curTime += dt;
+        system->updateCurrentTime(curTime);
+    }
+
+    int stillAlive = 0;
+    QVERIFY(extremelyFuzzyCompare(system->groupData[0]->size(), 1000, 10));//Small simulation variance is permissible.
+    for (QQuickParticleData *d : qAsConst(system->groupData[0]->data)) {
+        if (d->t == -1)
+            continue; //Particle data unused
+
+        if (!d->stillAlive(system))
+            continue;
+        stillAlive++;
+        float expected = ((qreal)system->timeInt/1000.0 - d->t) * 100;
+        QVERIFY(qAbs(d->curVX(system)) < 0.01f);
+        QVERIFY(qAbs(d->curVY(system) - expected) <= expected / 100 + 1);
+    }
+    QVERIFY(extremelyFuzzyCompare(stillAlive, 1000, 10));//Small simulation variance is permissible.
+    delete view;
+}
+
 QTEST_MAIN(tst_affectors);
 
 #include "tst_affectors.moc"
@@ -54,6 +54,9 @@ private slots:
     void bigimport_data();
     void bigimport();
 
+    void componenttree_data();
+    void componenttree();
+
 private:
     QQmlEngine engine;
 };
@@ -186,6 +189,74 @@ void tst_compilation::bigimport()
     }
 }
 
+void tst_compilation::componenttree_data()
+{
+    QTest::addColumn<bool>("withScripts");
+
+    QTest::newRow("qml") << false;
+    QTest::newRow("qml+js") << true;
+}
+
+// Loads a tree of 1000 components where each one instantiates up to ten others, so that the type
+// loader has plenty of dependencies to compile at the same time.
+void tst_compilation::componenttree()
+{
+    QFETCH(bool, withScripts);
+    QTemporaryDir d;
+
+    const int nodeCount = 1000;
+    const int fanOut = 10;
+
+    for (int i = 0; i < nodeCount; ++i) {
+        QFile f(d.path() + QDir::separator() + QString::fromLatin1("Node%1.qml").arg(i));
+        QVERIFY(f.open(QIODevice::WriteOnly));
+        QTextStream qml(&f);
+        qml << "import QtQml 2.0\n";
+        if (withScripts)
+            qml << "import \"node" << i << ".js\" as Logic\n";
+        qml << "QtObject {\n"
+            << "    property int index: " << i << "\n"
+            << "    property real weight: index * 1.5 + Math.sqrt(index)\n"
+            << "    property string label: \"node\" + index + \":\" + weight.toFixed(2)\n"
+            << "    function describe(prefix) { return prefix + label + \" (\" + size + \")\"; }\n";
+        if (withScripts)
+            qml << "    property real scaled: Logic.scale(weight)\n";
+
+        QStringList sizes(QStringLiteral("1"));
+        for (int child = i * fanOut + 1; child <= i * fanOut + fanOut && child < nodeCount; ++child) {
+            qml << (sizes.count() == 1 ? "    property list<QtObject> nodes: [\n" : ",\n")
+                << "        Node" << child << " { id: node" << child << " }";
+            sizes << QString::fromLatin1("node%1.size").arg(child);
+        }
+        if (sizes.count() > 1)
+            qml << "\n    ]\n";
+        qml << "    property int size: " << sizes.join(QLatin1String(" + ")) << "\n"
+            << "}\n";
+
+        if (withScripts) {
+            QFile js(d.path() + QDir::separator() + QString::fromLatin1("node%1.js").arg(i));
+            QVERIFY(js.open(QIODevice::WriteOnly));
+            QTextStream script(&js);
+            script << "function scale(value) {\n"
+                   << "    var result = 0;\n"
+                   << "    for (var i = 0; i < " << (i % 16 + 1) << "; ++i)\n"
+                   << "        result += value / (i + 1);\n"
+                   << "    return result;\n"
+                   << "}\n";
+        }
+    }
+
+    // Only measure a single run, later ones would load everything from the disk cache.
+    QBENCHMARK_ONCE {
+        QQmlEngine e;
+        QQmlComponent c(&e, QUrl::fromLocalFile(d.path() + QDir::separator() + QLatin1String("Node0.qml")));
+        QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+        QScopedPointer<QObject> o(c.create());
+        QVERIFY(o);
+        QCOMPARE(o->property("size").toInt(), nodeCount);
+    }
+}
+
 QTEST_MAIN(tst_compilation)
 
 #include "tst_compilation.moc"
@@ -3,6 +3,7 @@ SUBDIRS = \
         qjsengine \
         qjsvalue \
         qjsvalueiterator \
+        qv4mm \
 
 TRUSTED_BENCHMARKS += \
     qjsvalue \
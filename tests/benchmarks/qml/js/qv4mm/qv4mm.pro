@@ -0,0 +1,8 @@
+CONFIG += benchmark
+TEMPLATE = app
+TARGET = tst_bench_qv4mm
+
+SOURCES += tst_qv4mm.cpp
+
+QT += qml qml-private testlib
+macos:CONFIG -= app_bundle
@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtQml/qjsengine.h>
+#include <QtCore/qelapsedtimer.h>
+#include <private/qv4mm_p.h>
+#include <private/qv8engine_p.h>
+
+class tst_qv4mm : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fullGC_data();
+    void fullGC();
+    void minorGC_data();
+    void minorGC();
+
+private:
+    void populate(QJSEngine *engine, int oldObjects);
+    void measure(QJSEngine *engine, bool minor);
+};
+
+static const int iterations = 20;
+
+void tst_qv4mm::populate(QJSEngine *engine, int oldObjects)
+{
+    engine->globalObject().setProperty(QStringLiteral("oldObjects"), oldObjects);
+    engine->evaluate(QStringLiteral(
+                         "var old = [];\n"
+                         "for (var i = 0; i < oldObjects; ++i)\n"
+                         "    old.push({ index: i, name: 'object' + i, children: [i, i + 1] });\n"));
+}
+
+void tst_qv4mm::measure(QJSEngine *engine, bool minor)
+{
+    QV4::MemoryManager *mm = QV8Engine::getV4(engine)->memoryManager;
+    mm->runGC();
+
+    // temporaries as created by bindings and signal handlers, which all die young
+    const QString garbage = QStringLiteral(
+                "for (var i = 0; i < 20000; ++i) {\n"
+                "    var tmp = [i, i * 2, 'temp' + i];\n"
+                "    var obj = { a: tmp, b: tmp.length };\n"
+                "}\n");
+
+    qint64 total = 0;
+    for (int i = 0; i < iterations; ++i) {
+        engine->evaluate(garbage);
+        QElapsedTimer t;
+        t.start();
+        if (minor)
+            mm->runMinorGC();
+        else
+            mm->runGC();
+        total += t.nsecsElapsed();
+    }
+    QTest::setBenchmarkResult(qreal(total) / iterations / 1000000, QTest::WalltimeMilliseconds);
+}
+
+void tst_qv4mm::fullGC_data()
+{
+    QTest::addColumn<int>("oldObjects");
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+    QTest::newRow("500k") << 500000;
+}
+
+void tst_qv4mm::fullGC()
+{
+    QFETCH(int, oldObjects);
+    QJSEngine engine;
+    populate(&engine, oldObjects);
+    measure(&engine, false);
+}
+
+void tst_qv4mm::minorGC_data()
+{
+    fullGC_data();
+}
+
+void tst_qv4mm::minorGC()
+{
+    QFETCH(int, oldObjects);
+    QJSEngine engine;
+    QV8Engine::getV4(&engine)->memoryManager->setGenerationalGC(true);
+    populate(&engine, oldObjects);
+    measure(&engine, true);
+}
+
+QTEST_MAIN(tst_qv4mm)
+
+#include "tst_qv4mm.moc"
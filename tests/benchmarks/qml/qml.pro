@@ -8,6 +8,7 @@ SUBDIRS += \
            qqmlchangeset \
            qqmlcomponent \
            qqmlmetaproperty \
+           qsgsoftwaredirtytilemap \
            librarymetrics_performance \
            script \
            js \
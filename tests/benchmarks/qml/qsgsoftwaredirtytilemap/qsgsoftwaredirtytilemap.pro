@@ -0,0 +1,7 @@
+CONFIG += benchmark
+TEMPLATE = app
+TARGET = tst_qsgsoftwaredirtytilemap
+QT += quick-private testlib
+osx:CONFIG -= app_bundle
+
+SOURCES += tst_qsgsoftwaredirtytilemap.cpp
@@ -0,0 +1,190 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+
+#include <QtGui/QRegion>
+
+#include <private/qsgsoftwaredirtytilemap_p.h>
+
+// A stand-in for the renderable nodes of the software renderer
+struct Node
+{
+    QRect boundingRectMin;
+    QRect boundingRectMax;
+    QRect previousRect;
+    bool isOpaque;
+    bool isDirty;
+    QRegion dirtyRegion;
+};
+
+class tst_qsgsoftwaredirtytilemap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void optimizeRenderList_data();
+    void optimizeRenderList();
+
+private:
+    static QVector<Node> createScene(int count, int changed, const QRect &area);
+    static QRegion regionPasses(QVector<Node> &nodes, const QRect &area);
+    static QRegion tilePasses(QVector<Node> &nodes, QSGSoftwareDirtyTileMap &tiles, const QRect &area);
+};
+
+QVector<Node> tst_qsgsoftwaredirtytilemap::createScene(int count, int changed, const QRect &area)
+{
+    // The same pseudo random scene on every run
+    quint32 seed = 1;
+    auto random = [&seed](int range) {
+        seed = seed * 1103515245 + 12345;
+        return int((seed >> 16) % quint32(range));
+    };
+
+    QVector<Node> nodes;
+    nodes.reserve(count + 1);
+    nodes.append({ area, area, QRect(), true, false, QRegion() });
+    for (int i = 0; i < count; ++i) {
+        const QRect rect(random(area.width()), random(area.height()), 8 + random(120), 8 + random(60));
+        const bool dirty = random(count) < changed;
+        nodes.append({ rect.adjusted(1, 1, -1, -1), rect,
+                       dirty ? rect.translated(random(9) - 4, random(9) - 4) : QRect(),
+                       random(10) < 4, dirty, dirty ? QRegion(rect) : QRegion() });
+    }
+    return nodes;
+}
+
+// The region based passes the renderer used to make over the render list
+QRegion tst_qsgsoftwaredirtytilemap::regionPasses(QVector<Node> &nodes, const QRect &area)
+{
+    QRegion dirtyRegion;
+    QRegion obscuredRegion;
+    for (int i = nodes.count() - 1; i >= 0; --i) {
+        Node &node = nodes[i];
+        if (!dirtyRegion.isEmpty() && dirtyRegion.intersects(node.boundingRectMax)) {
+            node.isDirty = true;
+            node.dirtyRegion += dirtyRegion.intersected(node.boundingRectMax);
+        }
+        if (!obscuredRegion.isEmpty() && node.isDirty && obscuredRegion.intersects(node.boundingRectMax)) {
+            node.dirtyRegion -= obscuredRegion;
+            node.isDirty = !node.dirtyRegion.isEmpty();
+        }
+        if (node.isOpaque)
+            obscuredRegion += node.boundingRectMin;
+        if (node.isDirty) {
+            if (!area.contains(node.boundingRectMax, true))
+                node.dirtyRegion &= area;
+            if (node.isOpaque)
+                dirtyRegion -= node.boundingRectMin;
+            else
+                dirtyRegion += node.dirtyRegion;
+            const QRegion previous = QRegion(node.previousRect).subtracted(node.boundingRectMax);
+            if (!previous.isNull())
+                dirtyRegion += previous;
+        }
+    }
+
+    dirtyRegion = QRegion();
+    for (Node &node : nodes) {
+        if (!node.isOpaque && !dirtyRegion.isEmpty() && dirtyRegion.intersects(node.boundingRectMax)) {
+            node.isDirty = true;
+            node.dirtyRegion += dirtyRegion.intersected(node.boundingRectMax);
+        }
+        dirtyRegion += node.dirtyRegion;
+    }
+    return dirtyRegion;
+}
+
+// The tile based passes the renderer makes now
+QRegion tst_qsgsoftwaredirtytilemap::tilePasses(QVector<Node> &nodes, QSGSoftwareDirtyTileMap &tiles, const QRect &area)
+{
+    tiles.reset(area);
+    for (int depth = nodes.count() - 1; depth >= 0; --depth) {
+        const Node &node = nodes.at(depth);
+        if (node.isDirty) {
+            tiles.markDirty(node.boundingRectMax, depth);
+            tiles.markDirty(node.previousRect, depth);
+        }
+        if (node.isOpaque)
+            tiles.markOccluded(node.boundingRectMin, depth);
+    }
+
+    for (int depth = 0; depth < nodes.count(); ++depth) {
+        Node &node = nodes[depth];
+        const QRegion dirtyRegion = tiles.dirtyRegion(node.boundingRectMax, depth);
+        if (node.isDirty || !dirtyRegion.isEmpty()) {
+            node.dirtyRegion = dirtyRegion;
+            node.isDirty = !dirtyRegion.isEmpty();
+        }
+    }
+    return tiles.dirtyRegion();
+}
+
+void tst_qsgsoftwaredirtytilemap::optimizeRenderList_data()
+{
+    QTest::addColumn<bool>("useTiles");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("changed");
+
+    for (int count : { 300, 3000 }) {
+        for (int changed : { 1, count / 20 }) {
+            const QByteArray scene = QByteArray::number(count) + " nodes, " + QByteArray::number(changed) + " changed";
+            QTest::newRow(("regions, " + scene).constData()) << false << count << changed;
+            QTest::newRow(("tiles, " + scene).constData()) << true << count << changed;
+        }
+    }
+}
+
+void tst_qsgsoftwaredirtytilemap::optimizeRenderList()
+{
+    QFETCH(bool, useTiles);
+    QFETCH(int, count);
+    QFETCH(int, changed);
+
+    const QRect area(0, 0, 1920, 1080);
+    const QVector<Node> scene = createScene(count, changed, area);
+    QSGSoftwareDirtyTileMap tiles;
+
+    // Whatever the tiles add to the repainted area, they must cover everything that changed
+    QVector<Node> nodes = scene;
+    const QRegion regionResult = regionPasses(nodes, area);
+    nodes = scene;
+    const QRegion tileResult = tilePasses(nodes, tiles, area);
+    QVERIFY(regionResult.intersected(area).subtracted(tileResult).isEmpty());
+
+    QBENCHMARK {
+        nodes = scene;
+        if (useTiles)
+            tilePasses(nodes, tiles, area);
+        else
+            regionPasses(nodes, area);
+    }
+}
+
+QTEST_MAIN(tst_qsgsoftwaredirtytilemap)
+#include "tst_qsgsoftwaredirtytilemap.moc"
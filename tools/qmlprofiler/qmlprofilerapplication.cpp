@@ -67,12 +67,18 @@ static const char *features[] = {
     "binding",
     "handlingsignal",
     "inputevents",
-    "debugmessages"
+    "debugmessages",
+    "lookups"
 };
 
 Q_STATIC_ASSERT(sizeof(features) ==
                 QQmlProfilerDefinitions::MaximumProfileFeature * sizeof(char *));
 
+// Lookup statistics walk all lookups of the application on every flush, so they have to be
+// requested explicitly.
+static const quint64 defaultFeatures = std::numeric_limits<quint64>::max()
+        & ~(static_cast<quint64>(1) << QQmlProfilerDefinitions::ProfileLookups);
+
 QmlProfilerApplication::QmlProfilerApplication(int &argc, char **argv) :
     QCoreApplication(argc, argv),
     m_runMode(LaunchMode),
@@ -164,8 +170,9 @@ void QmlProfilerApplication::parseArguments()
 
     QCommandLineOption include(QLatin1String("include"),
                                tr("Comma-separated list of features to record. By default all "
-                                  "features supported by the QML engine are recorded. If --include "
-                                  "is specified, only the given features will be recorded. "
+                                  "features supported by the QML engine except for 'lookups' are "
+                                  "recorded. If --include is specified, only the given features "
+                                  "will be recorded. "
                                   "The following features are unserstood by qmlprofiler: %1").arg(
                                    featureList.join(", ")),
                                QLatin1String("feature,..."));
@@ -173,7 +180,8 @@ void QmlProfilerApplication::parseArguments()
 
     QCommandLineOption exclude(QLatin1String("exclude"),
                             tr("Comma-separated list of features to exclude when recording. By "
-                               "default all features supported by the QML engine are recorded. "
+                               "default all features supported by the QML engine except for "
+                               "'lookups' are recorded. "
                                "See --include for the features understood by qmlprofiler."),
                             QLatin1String("feature,..."));
     parser.addOption(exclude);
@@ -224,7 +232,7 @@ void QmlProfilerApplication::parseArguments()
     m_recording = (parser.value(record) == QLatin1String("on"));
     m_interactive = parser.isSet(interactive);
 
-    quint64 features = std::numeric_limits<quint64>::max();
+    quint64 features = defaultFeatures;
     if (parser.isSet(include)) {
         if (parser.isSet(exclude)) {
             logError(tr("qmlprofiler can only process either --include or --exclude, not both."));
@@ -273,7 +281,7 @@ bool QmlProfilerApplication::isInteractive() const
 quint64 QmlProfilerApplication::parseFeatures(const QStringList &featureList, const QString &values,
                                               bool exclude)
 {
-    quint64 features = exclude ? std::numeric_limits<quint64>::max() : 0;
+    quint64 features = exclude ? defaultFeatures : 0;
     const QStringList givenFeatures = values.split(QLatin1Char(','));
     for (const QString &f : givenFeatures) {
         int index =  featureList.indexOf(f);
@@ -282,7 +290,7 @@ quint64 QmlProfilerApplication::parseFeatures(const QStringList &featureList, co
             return 0;
         }
         quint64 flag = static_cast<quint64>(1) << index;
-        features = (exclude ? (features ^ flag) : (features | flag));
+        features = (exclude ? (features & ~flag) : (features | flag));
     }
     if (features == 0) {
         logError(exclude ? tr("No features remaining to record after processing --exclude.") :
@@ -193,6 +193,16 @@ void QmlProfilerClient::inputEvent(QQmlProfilerDefinitions::InputEventType type,
     d->data->addInputEvent(type, time, a, b);
 }
 
+void QmlProfilerClient::lookupStatistics(QQmlProfilerDefinitions::LookupType type, qint64 time,
+                                         QQmlProfilerDefinitions::LookupState state,
+                                         const QQmlEventLocation &location, const QString &name,
+                                         qint64 unit, int index, quint32 hitCount, quint32 missCount)
+{
+    Q_D(QmlProfilerClient);
+    Q_UNUSED(time);
+    d->data->addLookupStatistics(type, state, location, name, unit, index, hitCount, missCount);
+}
+
 void QmlProfilerClient::complete()
 {
     Q_D(QmlProfilerClient);
@@ -67,6 +67,10 @@ private:
                           const QString &url, int numericData1, int numericData2) override;
     void memoryAllocation(QQmlProfilerDefinitions::MemoryType type, qint64 time, qint64 amount) override;
     void inputEvent(QQmlProfilerDefinitions::InputEventType type, qint64 time, int a, int b) override;
+    void lookupStatistics(QQmlProfilerDefinitions::LookupType type, qint64 time,
+                          QQmlProfilerDefinitions::LookupState state,
+                          const QQmlEventLocation &location, const QString &name,
+                          qint64 unit, int index, quint32 hitCount, quint32 missCount) override;
     void complete() override;
 };
 
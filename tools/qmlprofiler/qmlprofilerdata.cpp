@@ -31,10 +31,13 @@
 #include <QStringList>
 #include <QUrl>
 #include <QHash>
+#include <QPair>
+#include <QVector>
 #include <QFile>
 #include <QXmlStreamReader>
 #include <QRegularExpression>
 
+#include <algorithm>
 #include <limits>
 
 const char PROFILER_FILE_VERSION[] = "1.02";
@@ -60,7 +63,8 @@ static const char *MESSAGE_STRINGS[] = {
     "Complete",
     "PixmapCache",
     "SceneGraph",
-    "MemoryAllocation"
+    "MemoryAllocation",
+    "LookupStatistics"
 };
 
 Q_STATIC_ASSERT(sizeof(MESSAGE_STRINGS) ==
@@ -121,6 +125,44 @@ struct QmlRangeEventStartInstance {
     QmlRangeEventData *data;
 };
 
+static const char *LOOKUP_TYPE_STRINGS[] = {
+    "Getter",
+    "Setter",
+    "GlobalGetter",
+    "IndexedGetter",
+    "IndexedSetter"
+};
+
+Q_STATIC_ASSERT(sizeof(LOOKUP_TYPE_STRINGS) ==
+                QQmlProfilerDefinitions::MaximumLookupType * sizeof(const char *));
+
+static const char *LOOKUP_STATE_STRINGS[] = {
+    "Unresolved",
+    "Monomorphic",
+    "TwoClasses",
+    "Polymorphic",
+    "Megamorphic",
+    "Generic"
+};
+
+Q_STATIC_ASSERT(sizeof(LOOKUP_STATE_STRINGS) ==
+                QQmlProfilerDefinitions::MaximumLookupState * sizeof(const char *));
+
+// Latest statistics for one lookup site. The engine sends cumulative counts, so they replace
+// the ones of the previous snapshot of the same site. Different sites can share a location, for
+// example if a file is compiled more than once, and are told apart by compilation unit and index
+// in its lookup table.
+typedef QPair<qint64, int> QmlLookupSite;
+
+struct QmlLookupData {
+    QQmlProfilerDefinitions::LookupType type;
+    QQmlProfilerDefinitions::LookupState state;
+    QQmlEventLocation location;
+    QString name;
+    quint32 hitCount;
+    quint32 missCount;
+};
+
 QT_BEGIN_NAMESPACE
 Q_DECLARE_TYPEINFO(QmlRangeEventData, Q_MOVABLE_TYPE);
 Q_DECLARE_TYPEINFO(QmlRangeEventStartInstance, Q_MOVABLE_TYPE);
@@ -135,6 +177,7 @@ public:
     // data storage
     QHash<QString, QmlRangeEventData *> eventDescriptions;
     QVector<QmlRangeEventStartInstance> startInstanceList;
+    QHash<QmlLookupSite, QmlLookupData> lookups;
 
     qint64 traceStartTime;
     qint64 traceEndTime;
@@ -163,6 +206,7 @@ void QmlProfilerData::clear()
     qDeleteAll(d->eventDescriptions);
     d->eventDescriptions.clear();
     d->startInstanceList.clear();
+    d->lookups.clear();
 
     d->traceEndTime = std::numeric_limits<qint64>::min();
     d->traceStartTime = std::numeric_limits<qint64>::max();
@@ -364,6 +408,17 @@ void QmlProfilerData::addMemoryEvent(QQmlProfilerDefinitions::MemoryType type, q
     d->startInstanceList.append(rangeEventStartInstance);
 }
 
+void QmlProfilerData::addLookupStatistics(QQmlProfilerDefinitions::LookupType type,
+                                          QQmlProfilerDefinitions::LookupState state,
+                                          const QQmlEventLocation &location, const QString &name,
+                                          qint64 unit, int index, quint32 hitCount,
+                                          quint32 missCount)
+{
+    setState(AcquiringData);
+    QmlLookupData data = { type, state, location, name, hitCount, missCount };
+    d->lookups.insert(qMakePair(unit, index), data);
+}
+
 void QmlProfilerData::addInputEvent(QQmlProfilerDefinitions::InputEventType type, qint64 time,
                                     int a, int b)
 {
@@ -479,7 +534,7 @@ void QmlProfilerData::complete()
 
 bool QmlProfilerData::isEmpty() const
 {
-    return d->startInstanceList.isEmpty();
+    return d->startInstanceList.isEmpty() && d->lookups.isEmpty();
 }
 
 bool QmlProfilerData::save(const QString &filename)
@@ -636,6 +691,38 @@ bool QmlProfilerData::save(const QString &filename)
     }
     stream.writeEndElement(); // profilerDataModel
 
+    if (!d->lookups.isEmpty()) {
+        stream.writeStartElement(QStringLiteral("lookupStatistics"));
+        QVector<QmlLookupData> lookups;
+        lookups.reserve(d->lookups.size());
+        for (const QmlLookupData &lookup : qAsConst(d->lookups))
+            lookups.append(lookup);
+        std::sort(lookups.begin(), lookups.end(), [](const QmlLookupData &a, const QmlLookupData &b) {
+            if (a.location.filename != b.location.filename)
+                return a.location.filename < b.location.filename;
+            if (a.location.line != b.location.line)
+                return a.location.line < b.location.line;
+            return a.location.column < b.location.column;
+        });
+        for (const QmlLookupData &lookup : qAsConst(lookups)) {
+            stream.writeStartElement(QStringLiteral("lookup"));
+            stream.writeAttribute(QStringLiteral("type"),
+                                  QLatin1String(LOOKUP_TYPE_STRINGS[lookup.type]));
+            stream.writeAttribute(QStringLiteral("state"),
+                                  QLatin1String(LOOKUP_STATE_STRINGS[lookup.state]));
+            stream.writeAttribute(QStringLiteral("hits"), QString::number(lookup.hitCount));
+            stream.writeAttribute(QStringLiteral("misses"), QString::number(lookup.missCount));
+            stream.writeAttribute(QStringLiteral("filename"), lookup.location.filename);
+            stream.writeAttribute(QStringLiteral("line"), QString::number(lookup.location.line));
+            stream.writeAttribute(QStringLiteral("column"),
+                                  QString::number(lookup.location.column));
+            if (!lookup.name.isEmpty())
+                stream.writeAttribute(QStringLiteral("name"), lookup.name);
+            stream.writeEndElement();
+        }
+        stream.writeEndElement(); // lookupStatistics
+    }
+
     stream.writeEndElement(); // trace
     stream.writeEndDocument();
 
@@ -73,6 +73,10 @@ public:
                              const QString &location, int numericData1, int numericData2);
     void addMemoryEvent(QQmlProfilerDefinitions::MemoryType type, qint64 time, qint64 size);
     void addInputEvent(QQmlProfilerDefinitions::InputEventType type, qint64 time, int a, int b);
+    void addLookupStatistics(QQmlProfilerDefinitions::LookupType type,
+                             QQmlProfilerDefinitions::LookupState state,
+                             const QQmlEventLocation &location, const QString &name,
+                             qint64 unit, int index, quint32 hitCount, quint32 missCount);
 
     void complete();
     bool save(const QString &filename);